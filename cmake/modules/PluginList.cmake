@@ -31,6 +31,7 @@ SET(LMMS_PLUGIN_LIST
 	CarlaPatchbay
 	CarlaRack
 	Compressor
+	ConvolutionReverb
 	CrossoverEQ
 	Delay
 	Dispersion
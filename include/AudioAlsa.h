@@ -81,6 +81,12 @@ public:
 
 	static DeviceInfoCollection getAvailableDevices();
 
+	//! The device thread blocks on the PCM anyway, so it may as well render the periods
+	bool canRenderInCallback() const override
+	{
+		return true;
+	}
+
 private:
 	void startProcessing() override;
 	void stopProcessing() override;
@@ -99,6 +105,7 @@ private:
 	snd_pcm_hw_params_t * m_hwParams;
 	snd_pcm_sw_params_t * m_swParams;
 
+	SampleConversion::Format m_format;
 	bool m_convertEndian;
 
 } ;
@@ -30,6 +30,7 @@
 #include <QString>
 #include <QMutex>
 
+#include "LatencyCompensator.h"
 #include "PlayHandle.h"
 
 namespace lmms
@@ -75,6 +76,13 @@ public:
 	EffectChain* effects() { return m_effects.get(); }
 	bool processEffects();
 
+	//! Latency of the signal feeding this handle, e.g. of a single-streamed instrument
+	void setSourceLatency(f_cnt_t frames) { m_sourceLatency = frames; }
+	//! Latency of the source plus the effect chain
+	f_cnt_t latency() const;
+	//! Delay the output by @p frames to line up with slower paths into the same mixer channel
+	void setLatencyCompensation(f_cnt_t frames) { m_latencyCompensator.setDelay(frames); }
+
 	// ThreadableJob stuff
 	void doProcessing() override;
 	bool requiresProcessing() const override { return true; }
@@ -86,6 +94,7 @@ private:
 	volatile bool m_bufferUsage;
 
 	SampleFrame* const m_buffer;
+	bool m_bufferCleared = false;
 
 	bool m_extOutputEnabled;
 	mix_ch_t m_nextMixerChannel;
@@ -94,6 +103,9 @@ private:
 
 	std::unique_ptr<EffectChain> m_effects;
 
+	f_cnt_t m_sourceLatency = 0;
+	LatencyCompensator m_latencyCompensator;
+
 	PlayHandleList m_playHandles;
 	QMutex m_playHandleLock;
 
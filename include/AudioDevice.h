@@ -27,8 +27,10 @@
 
 #include <QMutex>
 #include <samplerate.h>
+#include <vector>
 
 #include "LmmsTypes.h"
+#include "SampleConversion.h"
 
 class QThread;
 
@@ -84,6 +86,13 @@ public:
 
 	virtual void stopProcessing();
 
+	//! Whether the engine may render right in the thread the device fetches its periods from, instead of
+	//! having a fifo writer thread render ahead. The device has to keep fetching until it gets no more periods.
+	virtual bool canRenderInCallback() const
+	{
+		return false;
+	}
+
 protected:
 	// subclasses can re-implement this for being used in conjunction with
 	// processNextBuffer()
@@ -92,6 +101,32 @@ protected:
 	// called by according driver for fetching new sound-data
 	fpp_t getNextBuffer(SampleFrame* _ab);
 
+	//! Whether the device outputs the engine's multichannel bus instead of its stereo output, which is the case
+	//! if it was created with as many channels as the engine's output layout has and that layout is not stereo
+	bool usesBus() const;
+
+	//! The output bus of the period last fetched by getNextBuffer(), with channels() interleaved channels.
+	//! Only valid if usesBus() returns true.
+	const sample_t* busBuffer() const
+	{
+		return m_busBuffer.data();
+	}
+
+	/**
+	 * Writes @p frames frames of output into one float buffer per channel, fetching as many periods from the
+	 * engine as needed. Devices with more than two channels get the output bus if usesBus() is true. The samples are deinterleaved straight from the engine's buffers, without a copy in between.
+	 * Returns the number of frames written, which is less than @p frames once the engine stopped.
+	 */
+	fpp_t readPlanar(float* const* out, fpp_t frames);
+
+	//! Same as readPlanar(), but writes interleaved samples of @p format, dithered if enabled in the settings
+	fpp_t readInterleaved(void* out, fpp_t frames, SampleConversion::Format format, bool swapEndian = false);
+
+	SampleConversion::TpdfDither* dither()
+	{
+		return m_ditherEnabled ? &m_dither : nullptr;
+	}
+
 	// convert a given audio-buffer to a buffer in signed 16-bit samples
 	// returns num of bytes in outbuf
 	int convertToS16(const SampleFrame* _ab,
@@ -120,6 +155,11 @@ protected:
 
 	static void stopProcessingThread( QThread * thread );
 
+private:
+	template<class Write>
+	fpp_t read(fpp_t frames, Write write);
+	void releasePendingBuffer();
+
 
 protected:
 	bool m_supportsCapture;
@@ -134,6 +174,17 @@ private:
 	QMutex m_devMutex;
 
 	SampleFrame* m_buffer;
+	std::vector<sample_t> m_busBuffer;
+
+	// The period that readPlanar() and readInterleaved() are consuming
+	const SampleFrame* m_pendingBuffer;
+	const sample_t* m_pendingBus;
+	bool m_pendingBufferPooled;
+	fpp_t m_pendingFrames;
+	fpp_t m_pendingPos;
+
+	SampleConversion::TpdfDither m_dither;
+	bool m_ditherEnabled;
 
 };
 
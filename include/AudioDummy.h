@@ -101,7 +101,7 @@ private:
 			}
 			if( audioEngine()->hasFifoWriter() )
 			{
-				delete[] b;
+				audioEngine()->releaseBuffer( b );
 			}
 
 			const int microseconds = static_cast<int>( audioEngine()->framesPerPeriod() * 1000000.0f / audioEngine()->outputSampleRate() - timer.elapsed() );
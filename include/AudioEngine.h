@@ -25,6 +25,7 @@
 #ifndef LMMS_AUDIO_ENGINE_H
 #define LMMS_AUDIO_ENGINE_H
 
+#include <atomic>
 #include <mutex>
 
 #include <QThread>
@@ -38,8 +39,11 @@
 #include "SampleFrame.h"
 #include "LocklessList.h"
 #include "FifoBuffer.h"
+#include "MultiChannelBuffer.h"
+#include "MidiInputQueue.h"
 #include "AudioEngineProfiler.h"
 #include "PlayHandle.h"
+#include "ThreadScheduling.h"
 
 
 namespace lmms
@@ -214,12 +218,29 @@ public:
 		return m_framesPerPeriod;
 	}
 
+	//! Speaker layout of the output bus, read from the configuration on startup
+	ChannelLayout outputLayout() const
+	{
+		return static_cast<ChannelLayout>(m_outputChannels);
+	}
+
+	ch_cnt_t outputChannels() const
+	{
+		return m_outputChannels;
+	}
+
 
 	AudioEngineProfiler& profiler()
 	{
 		return m_profiler;
 	}
 
+	//! Scheduling of the rendering threads, read from the configuration on startup
+	const ThreadScheduling::Settings& schedulingSettings() const
+	{
+		return m_schedulingSettings;
+	}
+
 	int cpuLoad() const
 	{
 		return m_profiler.cpuLoad();
@@ -295,9 +316,33 @@ public:
 		return m_inputBufferFrames[ m_inputBufferRead ];
 	}
 
+	//! Returns the next period of output, or nullptr once processing stopped. Buffers from the fifo
+	//! have to be handed back with releaseBuffer().
 	inline const SampleFrame* nextBuffer()
 	{
-		return hasFifoWriter() ? m_fifo->read() : renderNextBuffer();
+		return hasFifoWriter() ? m_fifo->read() : renderDirectly();
+	}
+
+	/**
+	 * Returns the interleaved output bus with outputChannels() channels that belongs to @p period, which must have
+	 * been returned by nextBuffer(). Returns nullptr for a stereo layout, where @p period is all there is.
+	 */
+	const sample_t* busOutput(const SampleFrame* period) const
+	{
+		if (!m_busOutputRead) { return nullptr; }
+		return hasFifoWriter() ? (period + m_framesPerPeriod)->data() : m_busOutputRead->data();
+	}
+
+	//! Returns a buffer obtained from nextBuffer() while the fifo writer was running to its pool
+	void releaseBuffer(const SampleFrame* buffer)
+	{
+		m_freeFifoBuffers->write(const_cast<SampleFrame*>(buffer));
+	}
+
+	//! Frames of output the fifo holds in addition to the period the device is processing
+	f_cnt_t fifoLatency() const
+	{
+		return hasFifoWriter() ? (m_fifo->size() + 1) * m_framesPerPeriod : 0;
 	}
 
 	void changeQuality(const struct qualitySettings & qs);
@@ -327,7 +372,7 @@ private:
 	class fifoWriter : public QThread
 	{
 	public:
-		fifoWriter( AudioEngine * audioEngine, Fifo * fifo );
+		fifoWriter( AudioEngine * audioEngine, Fifo * fifo, Fifo * freeBuffers );
 
 		void finish();
 
@@ -335,6 +380,7 @@ private:
 	private:
 		AudioEngine * m_audioEngine;
 		Fifo * m_fifo;
+		Fifo * m_freeBuffers;
 		volatile bool m_writing;
 
 		void run() override;
@@ -359,6 +405,8 @@ private:
 	void renderStageMix();
 
 	const SampleFrame* renderNextBuffer();
+	//! Renders the next period in the device's thread, unless processing stopped
+	const SampleFrame* renderDirectly();
 
 	void swapBuffers();
 
@@ -380,7 +428,13 @@ private:
 	std::unique_ptr<SampleFrame[]> m_outputBufferRead;
 	std::unique_ptr<SampleFrame[]> m_outputBufferWrite;
 
+	ch_cnt_t m_outputChannels;
+	//! Output of all speakers for layouts other than stereo, swapped along with the output buffers
+	std::unique_ptr<MultiChannelBuffer> m_busOutputRead;
+	std::unique_ptr<MultiChannelBuffer> m_busOutputWrite;
+
 	// worker thread stuff
+	ThreadScheduling::Settings m_schedulingSettings;
 	std::vector<AudioEngineWorkerThread *> m_workers;
 	int m_numWorkers;
 
@@ -404,10 +458,20 @@ private:
 	// MIDI device stuff
 	MidiClient * m_midiClient;
 	QString m_midiClientName;
+	MidiInputQueue::Clock::time_point m_lastPeriodStart;
 
 	// FIFO stuff
 	Fifo * m_fifo;
+	//! Preallocated buffers the fifo writer renders into, so no period needs to be allocated.
+	//! With an output bus, its samples follow the stereo frames of each buffer.
+	std::vector<std::unique_ptr<SampleFrame[]>> m_fifoBuffers;
+	Fifo * m_freeFifoBuffers;
 	fifoWriter * m_fifoWriter;
+	//! Whether the device renders in its own thread, only changed with m_changeMutex held
+	std::atomic<bool> m_renderingDirectly;
+	//! Whether the thread rendering directly is a realtime device callback, which outputs silence
+	//! instead of waiting for changes in the model
+	std::atomic<bool> m_renderingInCallback;
 
 	AudioEngineProfiler m_profiler;
 
@@ -31,6 +31,7 @@
 
 #include "LmmsTypes.h"
 #include "MicroTimer.h"
+#include "ThreadScheduling.h"
 
 namespace lmms
 {
@@ -70,6 +71,64 @@ public:
 		return m_detailLoad[static_cast<std::size_t>(type)].load(std::memory_order_relaxed);
 	}
 
+	//! Queues between the audio threads and helper threads
+	enum class QueueType {
+		Lv2WorkRequests,
+		Lv2WorkResponses,
+		Count
+	};
+
+	constexpr static auto QueueCount = static_cast<std::size_t>(QueueType::Count);
+
+	//! Number of entries currently waiting in all queues of the given type
+	int queueDepth(const QueueType type) const
+	{
+		return m_queueDepth[static_cast<std::size_t>(type)].load(std::memory_order_relaxed);
+	}
+
+	//! Track entries being added to (@p delta > 0) or removed from a queue.
+	//! This is realtime safe and may be called from any thread.
+	void changeQueueDepth(const QueueType type, int delta)
+	{
+		m_queueDepth[static_cast<std::size_t>(type)].fetch_add(delta, std::memory_order_relaxed);
+	}
+
+	//! Count a track or mixer channel which skipped processing since it was silent.
+	//! This is realtime safe and may be called from any thread.
+	void countSkippedNode()
+	{
+		m_skippedNodes.fetch_add(1, std::memory_order_relaxed);
+	}
+
+	//! Number of tracks and mixer channels skipped in the last period
+	int skippedNodes() const
+	{
+		return m_skippedNodesLastPeriod.load(std::memory_order_relaxed);
+	}
+
+	//! Count a buffer underrun reported by the audio device.
+	//! This is realtime safe and may be called from any thread.
+	void countXrun()
+	{
+		m_xruns.fetch_add(1, std::memory_order_relaxed);
+	}
+
+	//! Number of buffer underruns the audio device reported so far
+	int xruns() const
+	{
+		return m_xruns.load(std::memory_order_relaxed);
+	}
+
+	//! Called by each rendering thread with the scheduling policy it effectively runs with.
+	//! If the threads got different policies, the default one is reported.
+	void reportSchedulingPolicy(ThreadScheduling::Policy policy);
+
+	ThreadScheduling::Policy schedulingPolicy() const
+	{
+		const int policy = m_schedulingPolicy.load(std::memory_order_relaxed);
+		return policy < 0 ? ThreadScheduling::Policy::Default : static_cast<ThreadScheduling::Policy>(policy);
+	}
+
 	class Probe
 	{
 	public:
@@ -104,6 +163,12 @@ private:
 	std::array<MicroTimer, DetailCount> m_detailTimer;
 	std::array<int, DetailCount> m_detailTime{0};
 	std::array<std::atomic<float>, DetailCount> m_detailLoad{0};
+	std::array<std::atomic<int>, QueueCount> m_queueDepth{};
+	std::atomic<int> m_skippedNodes = 0;
+	std::atomic<int> m_skippedNodesLastPeriod = 0;
+	std::atomic<int> m_xruns = 0;
+	std::atomic<int> m_schedulingPolicy = -1;
+	int m_writtenSchedulingPolicy = -1;
 };
 
 } // namespace lmms
@@ -116,6 +116,7 @@ private:
 	static QWaitCondition * queueReadyWaitCond;
 	static QList<AudioEngineWorkerThread *> workerThreads;
 
+	AudioEngine* m_audioEngine;
 	volatile bool m_quit;
 } ;
 
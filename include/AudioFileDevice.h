@@ -27,9 +27,12 @@
 #define LMMS_AUDIO_FILE_DEVICE_H
 
 #include <QFile>
+#include <cstddef>
+#include <memory>
 
 #include "AudioDevice.h"
 #include "OutputSettings.h"
+#include "SampleFrame.h"
 
 namespace lmms
 {
@@ -49,10 +52,27 @@ public:
 
 	OutputSettings const & getOutputSettings() const { return m_outputSettings; }
 
+	//! Number of frames collected before they are handed to the encoder
+	static constexpr fpp_t BatchFrames = 8192;
+
 
 protected:
 	int writeData( const void* data, int len );
 
+	//! Encodes @p count frames of channels() interleaved samples each, at most BatchFrames
+	virtual void writeBatch( const sample_t* samples, fpp_t count ) = 0;
+
+	//! Hands the frames collected so far to writeBatch(). Subclasses have to call this before they finish the file.
+	void flushBatch();
+
+	//! Scratch space for converting a batch, large enough for BatchFrames frames of samples up to 32 bits
+	template<typename T>
+	T* conversionBuffer()
+	{
+		static_assert( sizeof( T ) <= 4 );
+		return reinterpret_cast<T*>( m_conversionBuffer.get() );
+	}
+
 	inline bool outputFileOpened() const
 	{
 		return m_outputFile.isOpen();
@@ -64,8 +84,14 @@ protected:
 	}
 
 private:
+	void writeBuffer( const SampleFrame* frames, fpp_t count ) override;
+
 	QFile m_outputFile;
 	OutputSettings m_outputSettings;
+
+	std::unique_ptr<sample_t[]> m_batch;
+	fpp_t m_batchFrames;
+	std::unique_ptr<std::byte[]> m_conversionBuffer;
 } ;
 
 using AudioFileDeviceInstantiaton
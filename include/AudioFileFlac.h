@@ -65,7 +65,7 @@ private:
 	SF_INFO  m_sfinfo;
 	SNDFILE* m_sf;
 
-	void writeBuffer(const SampleFrame* _ab, fpp_t const frames) override;
+	void writeBatch(const sample_t* samples, fpp_t const count) override;
 
 	bool startEncoding();
 	void finishEncoding();
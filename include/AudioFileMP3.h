@@ -30,6 +30,8 @@
 
 #ifdef LMMS_HAVE_MP3LAME
 
+#include <vector>
+
 #include "AudioFileDevice.h"
 
 #include "lame/lame.h"
@@ -58,7 +60,7 @@ public:
 	}
 
 protected:
-	void writeBuffer(const SampleFrame* /* _buf*/, const fpp_t /*_frames*/) override;
+	void writeBatch(const sample_t* samples, const fpp_t count) override;
 
 private:
 	void flushRemainingBuffers();
@@ -67,6 +69,7 @@ private:
 
 private:
 	lame_t m_lame;
+	std::vector<unsigned char> m_encodingBuffer;
 };
 
 } // namespace lmms
@@ -57,7 +57,7 @@ public:
 	}
 
 private:
-	void writeBuffer(const SampleFrame* _ab, const fpp_t _frames) override;
+	void writeBatch(const sample_t* samples, const fpp_t count) override;
 	vorbis_info m_vi;
 	vorbis_dsp_state m_vds;
 	vorbis_comment m_vc;
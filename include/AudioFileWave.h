@@ -56,7 +56,7 @@ public:
 
 
 private:
-	void writeBuffer(const SampleFrame* _ab, const fpp_t _frames) override;
+	void writeBatch(const sample_t* samples, const fpp_t count) override;
 
 	bool startEncoding();
 	void finishEncoding();
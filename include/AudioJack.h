@@ -70,6 +70,9 @@ public:
 	void removeMidiClient() { m_midiClient = nullptr; }
 	jack_client_t* jackClient() { return m_client; };
 
+	//! The process callback runs in JACK's realtime thread, which can render the periods itself
+	bool canRenderInCallback() const override { return true; }
+
 	inline static QString name()
 	{
 		return QT_TRANSLATE_NOOP("AudioDeviceSetupWidget", "JACK (JACK Audio Connection Kit)");
@@ -118,6 +121,7 @@ private:
 
 	static int staticProcessCallback(jack_nframes_t nframes, void* udata);
 	static void shutdownCallback(void* _udata);
+	static int xrunCallback(void* udata);
 
 	jack_client_t* m_client;
 
@@ -129,10 +133,6 @@ private:
 	std::vector<jack_port_t*> m_inputPorts;
 	jack_default_audio_sample_t** m_tempOutBufs;
 	std::vector<SampleFrame> m_inputFrameBuffer;
-	SampleFrame* m_outBuf;
-
-	f_cnt_t m_framesDoneInCurBuf;
-	f_cnt_t m_framesToDoInCurBuf;
 
 #ifdef AUDIO_BUS_HANDLE_SUPPORT
 	struct StereoPort
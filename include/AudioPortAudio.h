@@ -145,10 +145,6 @@ private:
 
 	bool m_wasPAInitError;
 
-	SampleFrame* m_outBuf;
-	std::size_t m_outBufPos;
-	fpp_t m_outBufSize;
-
 	bool m_stopped;
 
 } ;
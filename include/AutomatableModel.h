@@ -25,7 +25,10 @@
 #ifndef LMMS_AUTOMATABLE_MODEL_H
 #define LMMS_AUTOMATABLE_MODEL_H
 
+#include <atomic>
 #include <cmath>
+#include <mutex>
+#include <vector>
 #include <QMap>
 #include <QMutex>
 
@@ -173,6 +176,7 @@ public:
 
 	//! @brief Function that returns sample-exact data as a ValueBuffer
 	//! @return pointer to model's valueBuffer when s.ex.data exists, NULL otherwise
+	//! @note Lock-free once the model has been used for one period, see updateValueBuffers()
 	ValueBuffer * valueBuffer();
 
 	template<class T>
@@ -311,6 +315,11 @@ public:
 		s_periodCounter = 0;
 	}
 
+	//! Computes the value buffers of all models that have been asked for sample-exact data
+	//! before. Called by the audio engine once per period, before the instruments are rendered,
+	//! so that the audio threads only read them.
+	static void updateValueBuffers();
+
 	bool useControllerValue()
 	{
 		return m_useControllerValue;
@@ -405,14 +414,20 @@ private:
 	ControllerConnection* m_controllerConnection;
 
 
+	void updateValueBuffer();
+
 	ValueBuffer m_valueBuffer;
-	long m_lastUpdatedPeriod;
+	std::atomic<long> m_lastUpdatedPeriod;
 	static long s_periodCounter;
 
 	bool m_hasSampleExactData;
+	bool m_valueBufferRegistered;
 
-	// prevent several threads from attempting to write the same vb at the same time
-	QMutex m_valueBufferMutex;
+	//! Models whose value buffers are computed by updateValueBuffers()
+	static std::vector<AutomatableModel*> s_valueBufferModels;
+	//! Guards s_valueBufferModels. Recursive because computing a buffer may register
+	//! another model, e.g. an LFO controller asking for its amount model's buffer.
+	static std::recursive_mutex s_valueBufferModelsMutex;
 
 	bool m_useControllerValue;
 
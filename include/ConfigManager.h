@@ -207,6 +207,9 @@ public:
 		return m_workingDir + "recover.mmp";
 	}
 
+	//! FFTW wisdom about the FFT plans measured so far, stored next to the configuration file
+	QString fftwWisdomFile() const;
+
 	inline const QStringList & recentlyOpenedProjects() const
 	{
 		return m_recentlyOpenedProjects;
@@ -0,0 +1,119 @@
+/*
+ * Convolver.h
+ *
+ * Copyright (c) 2026 LMMS Developers
+ *
+ * This file is part of LMMS - https://lmms.io
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public
+ * License along with this program (see COPYING); if not, write to the
+ * Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA 02110-1301 USA.
+ *
+ */
+
+
+#ifndef LMMS_CONVOLVER_H
+#define LMMS_CONVOLVER_H
+
+#include <array>
+#include <atomic>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "LmmsSemaphore.h"
+#include "LmmsTypes.h"
+#include "SampleFrame.h"
+#include "lmms_export.h"
+
+namespace lmms
+{
+
+/**
+	@brief Stereo convolution with long impulse responses and no latency
+
+	The impulse response is split into partitions which are convolved with
+	the FFT. The head of the impulse response uses small partitions and is
+	computed in the audio thread, so the output is not delayed. The second
+	part uses the same small partitions, but is spread over the blocks of
+	the audio thread and only played one tail block later. Everything after
+	that uses large partitions, which are computed by a background thread while
+	the audio thread plays the earlier parts. The audio thread never waits for
+	the background thread: if it is late, a tail block is played without its
+	part. Only offline rendering waits for it.
+
+	The left channel of the input is convolved with the left channel of the
+	impulse response and the right channel with the right one.
+
+	The constructor is expensive and must not run in the audio thread. To
+	switch impulse responses, construct a new Convolver and swap it in.
+*/
+class LMMS_EXPORT Convolver
+{
+public:
+	//! @p headBlockSize and @p tailBlockSize are powers of two, the tail block being the larger one
+	Convolver(const SampleFrame* impulseResponse, f_cnt_t frames,
+		fpp_t headBlockSize = 128, fpp_t tailBlockSize = 4096);
+	~Convolver();
+
+	Convolver(const Convolver&) = delete;
+	Convolver& operator=(const Convolver&) = delete;
+
+	f_cnt_t impulseLength() const { return m_impulseLength; }
+
+	//! Writes the convolution of @p frames frames from @p in into @p out, which may be the same buffer
+	void process(const SampleFrame* in, SampleFrame* out, fpp_t frames);
+
+private:
+	class Partitions;
+
+	void processTail(fpp_t frames);
+	void tailThread();
+
+	using ChannelBuffers = std::array<std::vector<float>, DEFAULT_CHANNELS>;
+	using ChannelPartitions = std::array<std::unique_ptr<Partitions>, DEFAULT_CHANNELS>;
+
+	const f_cnt_t m_impulseLength;
+	const fpp_t m_headBlockSize;
+	const fpp_t m_tailBlockSize;
+
+	ChannelPartitions m_head; //!< first m_tailBlockSize frames of the impulse response, in the audio thread
+	ChannelPartitions m_tail0; //!< second tail block, in the audio thread but played a tail block later
+	ChannelPartitions m_tail; //!< everything after, in the background thread
+
+	ChannelBuffers m_input; //!< deinterleaved input of the current head block
+	ChannelBuffers m_output;
+
+	ChannelBuffers m_tailInput; //!< input of the current tail block
+	f_cnt_t m_tailInputFill = 0;
+	ChannelBuffers m_tail0Output;
+	ChannelBuffers m_tail0Precalculated;
+	ChannelBuffers m_tailOutput; //!< written by the background thread
+	ChannelBuffers m_tailPrecalculated;
+	ChannelBuffers m_backgroundInput; //!< read by the background thread
+
+	std::thread m_tailThread;
+	Semaphore m_tailStart;
+	Semaphore m_tailDone;
+	std::atomic<bool> m_exit = false;
+	//! input blocks the background thread has to skip, because they were dropped when it was late
+	std::atomic<int> m_skippedBlocks = 0;
+	bool m_tailBusy = false;
+	//! whether the running job of the background thread missed its deadline
+	bool m_tailLate = false;
+};
+
+} // namespace lmms
+
+#endif // LMMS_CONVOLVER_H
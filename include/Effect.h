@@ -101,6 +101,13 @@ public:
 		return m_enabledModel.value();
 	}
 
+	//! Number of frames the output of this effect lags behind its input,
+	//! used to compensate the delay on other signal paths
+	virtual f_cnt_t latency() const
+	{
+		return 0;
+	}
+
 	inline f_cnt_t timeout() const
 	{
 		const float samples = Engine::audioEngine()->outputSampleRate() * m_autoQuitModel.value() / 1000.0f;
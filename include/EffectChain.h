@@ -26,9 +26,13 @@
 #ifndef LMMS_EFFECT_CHAIN_H
 #define LMMS_EFFECT_CHAIN_H
 
+#include <array>
+#include <vector>
+
 #include "Model.h"
 #include "SerializingObject.h"
 #include "AutomatableModel.h"
+#include "lmms_constants.h"
 
 namespace lmms
 {
@@ -65,9 +69,22 @@ public:
 	void moveUp( Effect * _effect );
 	bool processAudioBuffer( SampleFrame* _buf, const fpp_t _frames, bool hasInputNoise );
 	void startRunning();
+	//! Whether any effect still needs to process, even without input
+	bool isRunning() const;
+
+	//! Sum of the latencies of all enabled effects
+	f_cnt_t latency() const;
 
 	void clear();
 
+	//! One period per channel, for effects that process deinterleaved audio
+	using PlanarBuffers = std::array<std::vector<sample_t>, DEFAULT_CHANNELS>;
+
+	//! Planar buffers that the effects of this chain share, since they are processed one after
+	//! another. The output buffers are for effects that can not process in place.
+	PlanarBuffers& planarInput() { return m_planarInput; }
+	PlanarBuffers& planarOutput() { return m_planarOutput; }
+
 
 private:
 	using EffectList = std::vector<Effect*>;
@@ -75,6 +92,9 @@ private:
 
 	BoolModel m_enabledModel;
 
+	PlanarBuffers m_planarInput;
+	PlanarBuffers m_planarOutput;
+
 
 	friend class gui::EffectRackView;
 
@@ -0,0 +1,183 @@
+/*
+ * FFTPlanCache.h
+ *
+ * Copyright (c) 2026 LMMS Developers
+ *
+ * This file is part of LMMS - https://lmms.io
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public
+ * License along with this program (see COPYING); if not, write to the
+ * Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA 02110-1301 USA.
+ *
+ */
+
+
+#ifndef LMMS_FFT_PLAN_CACHE_H
+#define LMMS_FFT_PLAN_CACHE_H
+
+#include <condition_variable>
+#include <cstring>
+#include <fftw3.h>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "lmms_export.h"
+
+namespace lmms
+{
+
+/**
+	Array allocated with fftwf_malloc
+
+	FFTW plans are made for SIMD aligned arrays. Plans from the FFTPlanCache
+	are executed on arbitrary arrays, so all of them must be allocated like this.
+*/
+template<class T>
+class FFTBuffer
+{
+public:
+	FFTBuffer() = default;
+
+	//! Allocates @p size elements, which are all zero
+	explicit FFTBuffer(std::size_t size) :
+		m_data(static_cast<T*>(fftwf_malloc(size * sizeof(T)))),
+		m_size(size)
+	{
+		if (m_data) { std::memset(static_cast<void*>(m_data), 0, size * sizeof(T)); }
+	}
+
+	FFTBuffer(FFTBuffer&& other) noexcept :
+		m_data(std::exchange(other.m_data, nullptr)),
+		m_size(std::exchange(other.m_size, 0))
+	{
+	}
+
+	FFTBuffer& operator=(FFTBuffer&& other) noexcept
+	{
+		std::swap(m_data, other.m_data);
+		std::swap(m_size, other.m_size);
+		return *this;
+	}
+
+	~FFTBuffer()
+	{
+		if (m_data) { fftwf_free(m_data); }
+	}
+
+	T* data() { return m_data; }
+	const T* data() const { return m_data; }
+	std::size_t size() const { return m_size; }
+
+	T& operator[](std::size_t index) { return m_data[index]; }
+	const T& operator[](std::size_t index) const { return m_data[index]; }
+
+	T* begin() { return m_data; }
+	T* end() { return m_data + m_size; }
+	const T* begin() const { return m_data; }
+	const T* end() const { return m_data + m_size; }
+
+private:
+	T* m_data = nullptr;
+	std::size_t m_size = 0;
+};
+
+
+
+
+//! Plan of a real FFT, shared by everyone using the same size and direction
+class LMMS_EXPORT FFTPlan
+{
+public:
+	FFTPlan() = default;
+
+	bool isValid() const { return m_entry != nullptr; }
+	//! Number of real values
+	int size() const;
+
+	friend bool operator==(const FFTPlan&, const FFTPlan&) = default;
+
+	//! Transforms size() real values at @p in into size() / 2 + 1 bins at @p out. This is realtime safe.
+	void forward(float* in, fftwf_complex* out) const;
+	//! Transforms size() / 2 + 1 bins at @p in, which are overwritten, into size() real values at @p out.
+	//! The result is not normalized, so it is size() times the original values. This is realtime safe.
+	void inverse(fftwf_complex* in, float* out) const;
+
+private:
+	friend class FFTPlanCache;
+	struct Entry;
+
+	explicit FFTPlan(const Entry* entry) : m_entry(entry) {}
+
+	const Entry* m_entry = nullptr;
+};
+
+
+
+
+/**
+	Creates and shares the FFTW plans of the whole application
+
+	Measuring the fastest plan for a size takes long, so plan() first returns a
+	plan from the stored wisdom or an estimated one, and a background thread
+	measures a better one. Plans switch to the measured version as soon as it is
+	ready, and the wisdom is saved so the next start can use it right away.
+	All plans are kept until the application exits.
+*/
+class LMMS_EXPORT FFTPlanCache
+{
+public:
+	enum class Direction
+	{
+		Forward, //!< real to complex
+		Inverse //!< complex to real
+	};
+
+	static FFTPlanCache& instance();
+
+	//! Returns the plan for a real FFT of @p size values. This is thread safe, but not realtime safe.
+	FFTPlan plan(int size, Direction direction);
+
+	//! Blocks until all plans have been measured, mostly for tests and benchmarks
+	void waitForMeasurements();
+
+private:
+	FFTPlanCache();
+	~FFTPlanCache();
+
+	//! Creates an FFTW plan for temporary arrays, the planner mutex must be held
+	static fftwf_plan createPlan(int size, Direction direction, unsigned flags);
+	void measureThread();
+
+	const std::string m_wisdomFile;
+
+	std::mutex m_plannerMutex; //!< FFTW's planner is not thread safe, executing plans is
+	std::mutex m_entriesMutex;
+	std::map<std::pair<int, Direction>, std::unique_ptr<FFTPlan::Entry>> m_entries;
+
+	std::condition_variable m_measureCondition;
+	std::condition_variable m_measuredCondition;
+	std::vector<FFTPlan::Entry*> m_toMeasure; //!< protected by m_entriesMutex
+	bool m_measuring = false;
+	bool m_exit = false;
+	std::thread m_measureThread;
+};
+
+} // namespace lmms
+
+#endif // LMMS_FFT_PLAN_CACHE_H
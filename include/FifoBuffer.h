@@ -81,6 +81,11 @@ public:
 		return m_readSem.available();
 	}
 
+	int size() const
+	{
+		return m_size;
+	}
+
 
 private:
 	QSemaphore m_readSem;
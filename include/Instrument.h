@@ -57,6 +57,7 @@ public:
 		IsSingleStreamed = 0x01,	/*! Instrument provides a single audio stream for all notes */
 		IsMidiBased = 0x02,			/*! Instrument is controlled by MIDI events rather than NotePlayHandles */
 		IsNotBendable = 0x04,		/*! Instrument can't react to pitch bend changes */
+		IsVoiceBatched = 0x08,		/*! All notes are rendered in one job by the instrument's InstrumentPlayHandle */
 	};
 
 	using Flags = lmms::Flags<Flag>;
@@ -76,6 +77,12 @@ public:
 	// if the plugin doesn't play each note, it can create an instrument-
 	// play-handle and re-implement this method, so that it mixes its
 	// output buffer only once per audio engine period
+	//
+	// plugins that are flagged as IsVoiceBatched also create an instrument-
+	// play-handle, but keep implementing playNote(). The play-handle then
+	// renders all notes one after another in a single job and mixes them
+	// into one buffer, instead of scheduling one job and mixing one buffer
+	// per note
 	virtual void play( SampleFrame* _working_buffer );
 
 	// to be implemented by actual plugin
@@ -95,6 +102,14 @@ public:
 	// the length of the longest envelope (if one active).
 	virtual f_cnt_t beatLen( NotePlayHandle * _n ) const;
 
+	// Number of sample-frames the output of this instrument lags behind
+	// the notes it receives. Only single-streamed instruments report it,
+	// the mixer delays other tracks by this amount.
+	virtual f_cnt_t latency() const
+	{
+		return 0;
+	}
+
 
 	// This method can be overridden by instruments that need a certain
 	// release time even if no envelope is active. It returns the time
@@ -126,6 +141,11 @@ public:
 		return m_flags.testFlag(Instrument::Flag::IsMidiBased);
 	}
 
+	bool isVoiceBatched() const
+	{
+		return m_flags.testFlag(Instrument::Flag::IsVoiceBatched);
+	}
+
 	bool isBendable() const
 	{
 		return !m_flags.testFlag(Instrument::Flag::IsNotBendable);
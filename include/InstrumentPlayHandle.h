@@ -39,7 +39,7 @@ class LMMS_EXPORT InstrumentPlayHandle : public PlayHandle
 public:
 	InstrumentPlayHandle(Instrument * instrument, InstrumentTrack* instrumentTrack);
 
-	~InstrumentPlayHandle() override = default;
+	~InstrumentPlayHandle() override;
 
 	void play(SampleFrame* working_buffer) override;
 
@@ -51,7 +51,13 @@ public:
 	bool isFromTrack(const Track* track) const override;
 
 private:
+	//! Renders all notes of a voice batched instrument into the working buffer
+	void playNotes(SampleFrame* working_buffer);
+
 	Instrument* m_instrument;
+
+	//! Buffer each note of a voice batched instrument is rendered into before it gets mixed
+	SampleFrame* m_noteBuffer;
 };
 
 } // namespace lmms
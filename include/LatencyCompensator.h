@@ -0,0 +1,75 @@
+/*
+ * LatencyCompensator.h - fixed capacity delay line for plugin delay compensation
+ *
+ * Copyright (c) 2026 LMMS Developers
+ *
+ * This file is part of LMMS - https://lmms.io
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public
+ * License along with this program (see COPYING); if not, write to the
+ * Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA 02110-1301 USA.
+ *
+ */
+
+#ifndef LMMS_LATENCY_COMPENSATOR_H
+#define LMMS_LATENCY_COMPENSATOR_H
+
+#include <memory>
+
+#include "LmmsTypes.h"
+#include "lmms_export.h"
+
+namespace lmms
+{
+
+class SampleFrame;
+
+/**
+	@brief Delay line which aligns a signal path with a path of higher latency
+
+	The storage for the maximum delay is allocated on construction, so the delay
+	can be changed from the audio thread without allocating.
+*/
+class LMMS_EXPORT LatencyCompensator
+{
+public:
+	//! Largest delay in frames which can be compensated
+	static constexpr f_cnt_t MaxDelay = 16384;
+
+	LatencyCompensator();
+
+	f_cnt_t delay() const { return m_delay; }
+	//! Whether audio from previous input is still in the delay line
+	bool hasTail() const { return m_tail > 0; }
+
+	//! Sets the delay, clamped to MaxDelay. Clears the delay line if the delay changes.
+	void setDelay(f_cnt_t delay);
+
+	//! Delays @p in by delay() frames and writes the result to @p out, which may be equal to @p in
+	//! @param hasInput false if @p in is known to be silent
+	//! @return false if @p out has not been written because the result would be silent
+	bool process(const SampleFrame* in, SampleFrame* out, fpp_t frames, bool hasInput);
+
+private:
+	std::unique_ptr<SampleFrame[]> m_buffer;
+	f_cnt_t m_delay = 0;
+	f_cnt_t m_position = 0;
+
+	//! Number of frames until the audio in the delay line has been fully played out
+	f_cnt_t m_tail = 0;
+};
+
+} // namespace lmms
+
+#endif // LMMS_LATENCY_COMPENSATOR_H
@@ -25,6 +25,7 @@
 #ifndef LMMS_LOCKLESS_RING_BUFFER_H
 #define LMMS_LOCKLESS_RING_BUFFER_H
 
+#include <climits>
 #include <QMutex>
 #include <QWaitCondition>
 
@@ -76,11 +77,12 @@ public:
 		m_notifier(&rb.m_notifier) {};
 
 	bool empty() const {return !this->read_space();}
-	void waitForData()
+	//! Wait until the writer notifies about new data or @p timeout milliseconds have passed
+	void waitForData(unsigned long timeout = ULONG_MAX)
 	{
 		QMutex useless_lock;
 		useless_lock.lock();
-		m_notifier->wait(&useless_lock);
+		m_notifier->wait(&useless_lock, timeout);
 		useless_lock.unlock();
 	}
 private:
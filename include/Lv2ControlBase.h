@@ -29,10 +29,12 @@
 
 #ifdef LMMS_HAVE_LV2
 
+#include <array>
 #include <lilv/lilv.h>
 #include <memory>
 
 #include "LinkedModelGroups.h"
+#include "lmms_constants.h"
 #include "lmms_export.h"
 #include "Plugin.h"
 
@@ -117,12 +119,12 @@ protected:
 	//! Bring values from all ports to the LMMS core
 	void copyModelsToLmms() const;
 
-	//! Copy buffer passed by LMMS into our ports
-	void copyBuffersFromLmms(const SampleFrame* buf, fpp_t frames);
-	//! Copy our ports into buffers passed by LMMS
-	void copyBuffersToLmms(SampleFrame* buf, fpp_t frames) const;
-	//! Run the Lv2 plugin instance for @param frames frames
-	void run(fpp_t frames);
+	//! Run the Lv2 plugin instances for @param frames frames, with their
+	//! audio ports connected directly to planar buffers of the calling thread
+	//! @param buf input passed by LMMS, nullptr if there is none (instruments)
+	//! @return the planar output of each LMMS channel, valid until the next
+	//!   call on the same thread
+	std::array<const float*, DEFAULT_CHANNELS> runPlanar(const SampleFrame* buf, fpp_t frames);
 
 	/*
 		load/save, must be called from virtuals
@@ -137,6 +139,7 @@ protected:
 	std::size_t controlCount() const;
 	QString nodeName() const { return "lv2controls"; }
 	bool hasNoteInput() const;
+	f_cnt_t latency() const;
 	void handleMidiInputEvent(const class MidiEvent &event,
 		const class TimePos &time, f_cnt_t offset);
 
@@ -41,9 +41,6 @@
 namespace lmms
 {
 
-class SampleFrame;
-
-struct ConnectPortVisitor;
 using LV2_Evbuf = struct LV2_Evbuf_Impl;
 
 namespace Lv2Ports {
@@ -168,7 +165,7 @@ struct Control : public VisitablePort<Control, ControlPortBase>
 	//! Data location which Lv2 plugins see
 	//! Model values are being copied here every run
 	//! Between runs, this data is not up-to-date
-	float m_val;
+	float m_val = 0.f;
 };
 
 struct Cv : public VisitablePort<Cv, ControlPortBase>
@@ -179,35 +176,22 @@ struct Cv : public VisitablePort<Cv, ControlPortBase>
 	std::vector<float> m_buffer;
 };
 
+//! Audio ports have no buffer of their own, they are connected to the
+//! planar buffers of the processing thread before each run
+//! (see `Lv2Proc::connectPlanarBuffers`)
 struct Audio : public VisitablePort<Audio, PortBase>
 {
-	Audio(std::size_t bufferSize, bool isSidechain);
-
-	//! Copy buffer passed by LMMS into our ports
-	//! @param channel channel index into each sample frame
-	void copyBuffersFromCore(const SampleFrame* lmmsBuf,
-		unsigned channel, fpp_t frames);
-	//! Add buffer passed by LMMS into our ports, and halve the result
-	//! @param channel channel index into each sample frame
-	void averageWithBuffersFromCore(const SampleFrame* lmmsBuf,
-		unsigned channel, fpp_t frames);
-	//! Copy our ports into buffers passed by LMMS
-	//! @param channel channel index into each sample frame
-	void copyBuffersToCore(SampleFrame* lmmsBuf,
-		unsigned channel, fpp_t frames) const;
+	explicit Audio(bool isSidechain);
 
 	bool isSideChain() const { return m_sidechain; }
 	bool isOptional() const { return m_optional; }
 	bool mustBeUsed() const { return !isSideChain() && !isOptional(); }
-	std::size_t bufferSize() const { return m_buffer.size(); }
+
+	//! Index of the port as passed to `connect_port`
+	uint32_t index() const;
 
 private:
-	//! the buffer where Lv2 reads/writes the data from/to
-	std::vector<float> m_buffer;
 	bool m_sidechain;
-
-	// the only case when data of m_buffer may be referenced:
-	friend struct lmms::ConnectPortVisitor;
 };
 
 struct AtomSeq : public VisitablePort<AtomSeq, PortBase>
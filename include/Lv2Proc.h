@@ -29,9 +29,11 @@
 
 #ifdef LMMS_HAVE_LV2
 
+#include <future>
 #include <lilv/lilv.h>
 #include <memory>
 #include <optional>
+#include <string>
 
 #include <ringbuffer/ringbuffer.h>
 
@@ -49,7 +51,6 @@ namespace lmms
 {
 
 class PluginIssue;
-class SampleFrame;
 
 // forward declare port structs/enums
 namespace Lv2Ports
@@ -121,31 +122,19 @@ public:
 	//! Bring values from all ports to the LMMS core
 	void copyModelsToCore();
 	/**
-	 * Copy buffer passed by the core into our ports
-	 * @param buf buffer of sample frames, each sample frame is something like
-	 *   a `float[<number-of-procs> * <channels per proc>]` array.
-	 * @param firstChan The offset for @p buf where we have to read our
-	 *   first channel.
-	 *   This marks the first sample in each sample frame where we read from.
+	 * Connect our audio ports to planar buffers for the next run
+	 * @param planar one buffer per core channel, containing the input. If
+	 *   the plugin can process in place, our outputs are written here, too.
+	 * @param scratch one buffer per core channel, receiving our outputs if
+	 *   the plugin can not process in place
+	 * @param firstChan The first core channel we process.
 	 *   If we are the 2nd of 2 mono procs, this can be greater than 0.
-	 * @param num Number of channels we must read from @param buf (starting at
-	 *   @p offset)
+	 * @param num Number of core channels we process (starting at
+	 *   @p firstChan)
+	 * @param result Receives the output buffer of each channel we process
 	 */
-	void copyBuffersFromCore(const SampleFrame* buf,
-								unsigned firstChan, unsigned num, fpp_t frames);
-	/**
-	 * Copy our ports into buffers passed by the core
-	 * @param buf buffer of sample frames, each sample frame is something like
-	 *   a `float[<number-of-procs> * <channels per proc>]` array.
-	 * @param firstChan The offset for @p buf where we have to write our
-	 *   first channel.
-	 *   This marks the first sample in each sample frame where we write to.
-	 *   If we are the 2nd of 2 mono procs, this can be greater than 0.
-	 * @param num Number of channels we must write to @param buf (starting at
-	 *   @p offset)
-	 */
-	void copyBuffersToCore(SampleFrame* buf, unsigned firstChan, unsigned num,
-								fpp_t frames) const;
+	void connectPlanarBuffers(float* const* planar, float* const* scratch,
+		unsigned firstChan, unsigned num, fpp_t frames, const float** result);
 	//! Run the Lv2 plugin instance for @param frames frames
 	void run(fpp_t frames);
 
@@ -158,19 +147,38 @@ public:
 	class AutomatableModel *modelAtPort(const QString &uri); // unused currently
 	std::size_t controlCount() const { return LinkedModelGroup::modelNum(); }
 	bool hasNoteInput() const;
+	//! Latency reported by the plugin in frames, 0 if it reports none
+	f_cnt_t latency() const;
+	//! Block until the instance is ready. During project load, plugins are
+	//! instantiated on worker threads, see initPlugin().
+	void waitForInstance();
 
 protected:
 	/*
 		load and save
 	*/
-	//! Create ports and instance, connect ports, activate plugin
+	//! Create features and instance, connect ports, activate plugin
+	//! @note While a project is loading, the instance is created on a worker thread
 	void initPlugin();
 	//! Deactivate instance
 	void shutdownPlugin();
 
 private:
+	//! Load the plugin library and look up the plugin's descriptor
+	//! @note Must run on the main thread, as it calls the LV2 discovery functions
+	const LV2_Descriptor* findDescriptor(const std::string& libraryPath);
+	//! Create the instance, connect ports and activate it
+	//! @note Can run on any thread, as it only calls functions of the new instance
+	void instantiate();
+
 	const LilvPlugin* m_plugin;
 	LilvInstance* m_instance = nullptr;
+	//! pending instantiation on a worker thread, if any
+	std::shared_future<void> m_instantiation;
+	//! looked up by initPlugin() for instantiate()
+	const LV2_Descriptor* m_descriptor = nullptr;
+	std::string m_bundlePath;
+	double m_sampleRate = 0.;
 	Lv2Features m_features;
 
 	// options
@@ -185,6 +193,9 @@ private:
 	// quick reference to specific, unique ports
 	StereoPortRef m_inPorts, m_outPorts;
 	Lv2Ports::AtomSeq *m_midiIn = nullptr, *m_midiOut = nullptr;
+	//! the plugin requires separate buffers for its inputs and outputs
+	bool m_inPlaceBroken = false;
+	const Lv2Ports::Control* m_latencyPort = nullptr;
 
 	// MIDI
 	// many things here may be moved into the `Instrument` class
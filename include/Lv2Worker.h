@@ -29,7 +29,9 @@
 
 #ifdef LMMS_HAVE_LV2
 
+#include <atomic>
 #include <lv2/worker/worker.h>
+#include <mutex>
 #include <thread>
 #include <vector>
 
@@ -41,6 +43,10 @@ namespace lmms
 
 /**
 	Worker container
+
+	Threaded workers do not own a thread, their requests are processed by
+	the shared Lv2WorkerPool. The pool never processes two requests of the
+	same worker at once, so requests are still processed in order.
 */
 class Lv2Worker
 {
@@ -64,8 +70,13 @@ public:
 	LV2_Worker_Status respond(uint32_t size, const void* data);
 
 private:
+	friend class Lv2WorkerPool;
+
 	// functions
-	void workerFunc();
+	//! Process all queued requests and release m_busy afterwards.
+	//! To be called only by Lv2WorkerPool, after claiming m_busy.
+	void processRequests();
+	bool hasRequests() { return m_requestsReader.read_space() >= sizeof(uint32_t); }
 	std::size_t bufferSize() const;  //!< size of internal buffers
 
 	// parameters
@@ -75,16 +86,50 @@ private:
 	LV2_Worker_Schedule m_scheduleFeature;
 
 	// threading/synchronization
-	std::thread m_thread;
-	std::vector<char> m_response;  //!< buffer where single requests from m_requests are unpacked
+	std::vector<char> m_request;  //!< buffer where single requests from m_requests are unpacked
+	std::vector<char> m_response;  //!< buffer where single requests from m_responses are unpacked
 	LocklessRingBuffer<char> m_requests, m_responses;  //!< ringbuffer to queue multiple requests
 	LocklessRingBufferReader<char> m_requestsReader, m_responsesReader;
-	std::atomic<bool> m_exit = false;  //!< Whether the worker function should keep looping
-	Semaphore m_sem;
+	std::atomic<bool> m_busy = false;  //!< Whether a pool thread is processing our requests
 	Semaphore* m_workLock;
 };
 
 
+
+
+/**
+	Small set of threads processing the requests of all threaded workers
+
+	Plugins like samplers only use their worker now and then, so sharing a
+	few threads scales better than one thread per plugin instance.
+*/
+class Lv2WorkerPool
+{
+public:
+	static Lv2WorkerPool& instance();
+
+	void addWorker(Lv2Worker* worker);
+	//! Blocks until no pool thread is processing requests of @p worker
+	void removeWorker(Lv2Worker* worker);
+	//! Wake up a thread to process new requests. This is realtime safe.
+	void notify() { m_sem.post(); }
+
+private:
+	Lv2WorkerPool(std::size_t numThreads);
+	~Lv2WorkerPool();
+	void threadFunc();
+	//! Returns a worker with pending requests after claiming it, or nullptr if there is none.
+	//! The scan starts at index @p next, which is advanced past the claimed worker, so busy workers take turns.
+	Lv2Worker* claimPendingWorker(std::size_t& next);
+
+	std::vector<std::thread> m_threads;
+	std::mutex m_workersMutex;  //!< protects m_workers
+	std::vector<Lv2Worker*> m_workers;
+	std::atomic<bool> m_exit = false;
+	Semaphore m_sem;
+};
+
+
 } // namespace lmms
 
 #endif // LMMS_HAVE_LV2
@@ -133,6 +133,9 @@ private:
 		private: int p[2];
 	} ;
 	QMap<MidiPort *, Ports> m_portIDs;
+	// input events refer to their source until they are processed by the audio thread,
+	// so the addresses are kept here rather than in the sequencer's event buffer
+	QMap<int, snd_seq_addr_t> m_sourceAddresses;
 #endif
 
 	int m_queueID;
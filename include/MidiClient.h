@@ -30,6 +30,7 @@
 
 
 #include "MidiEvent.h"
+#include "MidiInputQueue.h"
 
 class QObject;
 
@@ -63,6 +64,9 @@ public:
 	// re-implemented methods HAVE to call removePort() of base-class!!
 	virtual void removePort( MidiPort * _port );
 
+	//! Process the live input queued by all ports, called by the audio thread at the start of every period
+	void processQueuedInEvents(const MidiInputQueue::Period& period);
+
 
 	// returns whether client works with raw-MIDI, only needs to be
 	// re-implemented by MidiClientRaw for returning true
@@ -135,8 +139,10 @@ public:
 
 
 protected:
-	// generic raw-MIDI-parser which generates appropriate MIDI-events
-	void parseData( const unsigned char c );
+	// generic raw-MIDI-parser which generates appropriate MIDI-events,
+	// timestamped with the arrival time of their last byte
+	void parseData( const unsigned char c,
+		MidiInputQueue::Clock::time_point timestamp = MidiInputQueue::Clock::now() );
 
 	// to be implemented by actual client-implementation
 	virtual void sendByte( const unsigned char c ) = 0;
@@ -167,6 +173,7 @@ private:
 		uint32_t m_buffer[RAW_MIDI_PARSE_BUF_SIZE];
 					// buffer for incoming data
 		MidiEvent m_midiEvent;	// midi-event
+		MidiInputQueue::Clock::time_point m_timestamp;
 	} m_midiParseData;
 
 } ;
@@ -0,0 +1,90 @@
+/*
+ * MidiInputQueue.h
+ *
+ * Copyright (c) 2026 LMMS Developers
+ *
+ * This file is part of LMMS - https://lmms.io
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public
+ * License along with this program (see COPYING); if not, write to the
+ * Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA 02110-1301 USA.
+ *
+ */
+
+#ifndef LMMS_MIDI_INPUT_QUEUE_H
+#define LMMS_MIDI_INPUT_QUEUE_H
+
+#include <chrono>
+
+#include <ringbuffer/ringbuffer.h>
+
+#include "lmms_export.h"
+#include "LmmsTypes.h"
+#include "MidiEvent.h"
+#include "TimePos.h"
+
+namespace lmms
+{
+
+/**
+	@brief Lock-free queue passing live MIDI input from the MIDI thread to the audio thread
+
+	Events are timestamped on arrival and played in the following period at the offset
+	they arrived at relative to the start of the current one. This delays them by a constant
+	period instead of snapping them to the next period boundary.
+
+	There must be only one thread pushing events and one thread popping them.
+*/
+class LMMS_EXPORT MidiInputQueue
+{
+public:
+	using Clock = std::chrono::steady_clock;
+
+	struct Entry
+	{
+		MidiEvent event;
+		TimePos time;
+		Clock::time_point timestamp;
+	};
+
+	//! Timing of the period the events are played in
+	struct Period
+	{
+		//! When rendering of the previous period started, default constructed if there was none
+		Clock::time_point previousStart;
+		fpp_t frames;
+		sample_rate_t sampleRate;
+	};
+
+	static constexpr std::size_t DefaultCapacity = 512;
+
+	explicit MidiInputQueue(std::size_t capacity = DefaultCapacity);
+
+	//! Called from the MIDI thread. Returns false if the queue is full.
+	bool push(const MidiEvent& event, const TimePos& time, Clock::time_point timestamp = Clock::now());
+
+	//! Called from the audio thread. Returns false if the queue is empty.
+	bool pop(Entry& entry);
+
+	//! Offset into @p period at which an event with the given timestamp is played
+	static f_cnt_t frameOffset(Clock::time_point timestamp, const Period& period);
+
+private:
+	ringbuffer_t<Entry> m_buffer;
+	ringbuffer_reader_t<Entry> m_reader;
+};
+
+} // namespace lmms
+
+#endif // LMMS_MIDI_INPUT_QUEUE_H
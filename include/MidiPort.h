@@ -33,6 +33,7 @@
 #include "Midi.h"
 #include "TimePos.h"
 #include "AutomatableModel.h"
+#include "MidiInputQueue.h"
 
 namespace lmms
 {
@@ -111,9 +112,17 @@ public:
 		return outputChannel() ? outputChannel() - 1 : 0;
 	}
 
-	void processInEvent( const MidiEvent& event, const TimePos& time = TimePos() );
+	void processInEvent( const MidiEvent& event, const TimePos& time = TimePos(), f_cnt_t offset = 0 );
 	void processOutEvent( const MidiEvent& event, const TimePos& time = TimePos() );
 
+	//! Called by MIDI clients for live input. The event is processed by the audio thread
+	//! in the next period, at the offset given by its arrival time.
+	void queueInEvent(const MidiEvent& event, const TimePos& time = TimePos(),
+		MidiInputQueue::Clock::time_point timestamp = MidiInputQueue::Clock::now());
+
+	//! Called by the audio thread at the start of every period
+	void processQueuedInEvents(const MidiInputQueue::Period& period);
+
 
 	void saveSettings( QDomDocument& doc, QDomElement& thisElement ) override;
 	void loadSettings( const QDomElement& thisElement ) override;
@@ -173,6 +182,8 @@ private:
 	Map m_readablePorts;
 	Map m_writablePorts;
 
+	MidiInputQueue m_inputQueue;
+
 
 	friend class gui::ControllerConnectionDialog;
 	friend class gui::InstrumentMidiIOView;
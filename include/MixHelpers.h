@@ -32,6 +32,7 @@ namespace lmms
 
 class ValueBuffer;
 class SampleFrame;
+class MultiChannelBuffer;
 
 namespace MixHelpers
 {
@@ -65,6 +66,12 @@ void addMultipliedByBuffers( SampleFrame* dst, const SampleFrame* src, ValueBuff
 /*! \brief Same as addMultiplied, but sanitize output (strip out infs/nans) */
 void addSanitizedMultiplied( SampleFrame* dst, const SampleFrame* src, float coeffSrc, int frames );
 
+/*! \brief Overwrite dst with samples from src multiplied by coeffSrc */
+void copyMultiplied(SampleFrame* dst, const SampleFrame* src, float coeffSrc, int frames);
+
+/*! \brief Same as copyMultiplied, but sanitize output (strip out infs/nans) */
+void copySanitizedMultiplied(SampleFrame* dst, const SampleFrame* src, float coeffSrc, int frames);
+
 /*! \brief Add samples from src multiplied by coeffSrc and coeffSrcBuf to dst - sanitized version */
 void addSanitizedMultipliedByBuffer( SampleFrame* dst, const SampleFrame* src, float coeffSrc, ValueBuffer * coeffSrcBuf, int frames );
 
@@ -80,6 +87,15 @@ void multiplyAndAddMultiplied( SampleFrame* dst, const SampleFrame* src, float c
 /*! \brief Multiply dst by coeffDst and add samples from srcLeft/srcRight multiplied by coeffSrc */
 void multiplyAndAddMultipliedJoined( SampleFrame* dst, const sample_t* srcLeft, const sample_t* srcRight, float coeffDst, float coeffSrc, int frames );
 
+/*! \brief Add samples from src multiplied by coeff to channels first and first + 1 of dst
+ *
+ * The pair must fit into dst. A mono dst receives the average of both channels instead.
+ */
+void addToBus(MultiChannelBuffer& dst, ch_cnt_t first, const SampleFrame* src, float coeff, fpp_t frames);
+
+/*! \brief Multiply all samples of `dst` by `coeff` */
+void multiply(MultiChannelBuffer& dst, float coeff);
+
 } // namespace MixHelpers
 
 
@@ -28,17 +28,22 @@
 #include "Model.h"
 #include "EffectChain.h"
 #include "JournallingObject.h"
+#include "LatencyCompensator.h"
+#include "SampleFrame.h"
 #include "ThreadableJob.h"
 
 #include <atomic>
 #include <optional>
+#include <vector>
 #include <QColor>
 
 namespace lmms
 {
 
 
+class AudioBusHandle;
 class MixerRoute;
+class MultiChannelBuffer;
 using MixerRouteVector = std::vector<MixerRoute*>;
 
 class MixerChannel : public ThreadableJob
@@ -53,6 +58,9 @@ class MixerChannel : public ThreadableJob
 		bool m_hasInput;
 		// set to true if any effect in the channel is enabled and running
 		bool m_stillRunning;
+		// set to false if the buffer has been processed in this period,
+		// i.e. it may contain audio
+		bool m_silent = true;
 
 		float m_peakLeft;
 		float m_peakRight;
@@ -61,10 +69,15 @@ class MixerChannel : public ThreadableJob
 		BoolModel m_muteModel;
 		BoolModel m_soloModel;
 		FloatModel m_volumeModel;
+		//! 0 uses the sends. n > 0 sends post-fader to speaker pair n of the output layout (see speakerPairOffset()),
+		//! scaled by the master fader. The master channel's effects only process the front pair.
+		//! instead, so the channel does not reach the master channel. Without such a pair, the sends are used.
+		IntModel m_speakerPairModel;
 		QString m_name;
 		QMutex m_lock;
 		bool m_queued; // are we queued up for rendering yet?
 		bool m_muted; // are we muted? updated per period so we don't have to call m_muteModel.value() twice
+		ch_cnt_t m_speakerOffset = 0; // first bus channel we output to instead of the sends, 0 if none. updated per period
 
 		// pointers to other channels that this one sends to
 		MixerRouteVector m_sends;
@@ -88,11 +101,26 @@ class MixerChannel : public ThreadableJob
 		std::atomic_size_t m_dependenciesMet;
 		void incrementDeps();
 		void processed();
+
+		//! Latency of the slowest input into this channel, in frames
+		f_cnt_t inputLatency() const { return m_inputLatency; }
+		//! Latency of the output of this channel including its effects, in frames
+		f_cnt_t latency() const { return m_latency; }
 		
 	private:
 		void doProcessing() override;
+		f_cnt_t resolveLatency();
+
 		int m_channelIndex;
 		std::optional<QColor> m_color;
+
+		f_cnt_t m_inputLatency = 0;
+		f_cnt_t m_latency = 0;
+		bool m_latencyResolved = false;
+		// receives the delayed output of senders while mixing
+		std::vector<SampleFrame> m_compensationBuffer;
+
+		friend class Mixer;
 };
 
 class MixerRoute : public QObject
@@ -129,10 +157,18 @@ public:
 
 	void updateName();
 
+	//! Returns the output of the sender, delayed by the latency compensation
+	//! of this route, or nullptr if it is silent
+	//! @param scratch buffer for the delayed output
+	const SampleFrame* senderOutput(SampleFrame* scratch, fpp_t frames);
+
+	void setLatencyCompensation(f_cnt_t frames) { m_latencyCompensator.setDelay(frames); }
+
 	private:
 		MixerChannel * m_from;
 		MixerChannel * m_to;
 		FloatModel m_amount;
+		LatencyCompensator m_latencyCompensator;
 };
 
 
@@ -145,8 +181,13 @@ public:
 
 	void mixToChannel( const SampleFrame* _buf, mix_ch_t _ch );
 
-	void prepareMasterMix();
-	void masterMix( SampleFrame* _buf );
+	//! Process all channels and write the output of the master channel to `_buf`
+	//! Mixes the master output into @p _buf and, if given, all speakers of the output bus into @p bus
+	void masterMix( SampleFrame* _buf, MultiChannelBuffer* bus = nullptr );
+
+	// compute the latency of all channels and delay the inputs of each channel
+	// so that they line up with its slowest input
+	void compensateLatencies(const std::vector<AudioBusHandle*>& busHandles);
 
 	void saveSettings( QDomDocument & _doc, QDomElement & _parent ) override;
 	void loadSettings( const QDomElement & _this ) override;
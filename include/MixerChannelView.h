@@ -27,6 +27,8 @@
 
 #include <QWidget>
 
+#include "LmmsTypes.h"
+
 class QGraphicsView;
 class QLabel;
 class QLineEdit;
@@ -64,6 +66,8 @@ public:
 	void keyPressEvent(QKeyEvent* ke) override;
 
 	void reset();
+	//! Show the latency of the channel if it changed since the last call
+	void updateLatency();
 	int channelIndex() const { return m_channelIndex; }
 	void setChannelIndex(int index);
 
@@ -118,6 +122,8 @@ private:
 	AutomatableButton* m_muteButton;
 	AutomatableButton* m_soloButton;
 	PeakIndicator* m_peakIndicator = nullptr;
+	QLabel* m_latencyLabel;
+	f_cnt_t m_displayedLatency = 0;
 	Fader* m_fader;
 	EffectRackView* m_effectRackView;
 	MixerView* m_mixerView;
@@ -0,0 +1,145 @@
+/*
+ * MultiChannelBuffer.h
+ *
+ * Copyright (c) 2026 LMMS Developers
+ *
+ * This file is part of LMMS - https://lmms.io
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public
+ * License along with this program (see COPYING); if not, write to the
+ * Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA 02110-1301 USA.
+ *
+ */
+
+#ifndef LMMS_MULTI_CHANNEL_BUFFER_H
+#define LMMS_MULTI_CHANNEL_BUFFER_H
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <vector>
+
+#include "LmmsTypes.h"
+
+namespace lmms
+{
+
+//! Speaker layouts the audio engine can output, the value is the number of channels
+enum class ChannelLayout : ch_cnt_t
+{
+	Mono = 1,
+	Stereo = 2,
+	Quad = 4,
+	Surround51 = 6,
+	Surround71 = 8
+};
+
+constexpr ch_cnt_t channelCount(ChannelLayout layout)
+{
+	return static_cast<ch_cnt_t>(layout);
+}
+
+constexpr ch_cnt_t MaxOutputChannels = channelCount(ChannelLayout::Surround71);
+
+//! Number of speaker pairs of @p layout: front, then rear, then side. Center and LFE belong to no pair.
+constexpr int speakerPairCount(ChannelLayout layout)
+{
+	switch (layout)
+	{
+	case ChannelLayout::Quad:
+	case ChannelLayout::Surround51:
+		return 2;
+	case ChannelLayout::Surround71:
+		return 3;
+	default:
+		return 1;
+	}
+}
+
+constexpr int MaxSpeakerPairs = speakerPairCount(ChannelLayout::Surround71);
+
+//! First channel of speaker pair @p pair of @p layout in WAV channel order, 0 (the front pair) if there is no such pair
+constexpr ch_cnt_t speakerPairOffset(ChannelLayout layout, int pair)
+{
+	if (pair <= 0 || pair >= speakerPairCount(layout)) { return 0; }
+	// Quad is L R RL RR, the surround layouts are L R C LFE RL RR [SL SR]
+	return static_cast<ch_cnt_t>(layout == ChannelLayout::Quad ? 2 : 2 + 2 * pair);
+}
+
+
+//! A single frame with a channel count known at compile time, the multichannel counterpart of `SampleFrame`
+template<ch_cnt_t Channels>
+class MultiChannelFrame
+{
+public:
+	static constexpr ch_cnt_t channels() { return Channels; }
+
+	sample_t* data() { return m_samples.data(); }
+	const sample_t* data() const { return m_samples.data(); }
+
+	sample_t& operator[](ch_cnt_t channel) { return m_samples[channel]; }
+	const sample_t& operator[](ch_cnt_t channel) const { return m_samples[channel]; }
+
+private:
+	std::array<sample_t, Channels> m_samples = {};
+};
+
+static_assert(sizeof(MultiChannelFrame<6>) == 6 * sizeof(sample_t), "frames must be tightly packed");
+
+
+/**
+ * An interleaved buffer of a fixed number of frames with a channel count chosen at runtime.
+ * All memory is allocated on construction, so the buffer can be used from the audio thread.
+ */
+class MultiChannelBuffer
+{
+public:
+	MultiChannelBuffer(ch_cnt_t channels, fpp_t frames) :
+		m_channels(channels),
+		m_frames(frames),
+		m_samples(static_cast<std::size_t>(channels) * frames)
+	{
+		assert(channels > 0);
+	}
+
+	ch_cnt_t channels() const { return m_channels; }
+	fpp_t frames() const { return m_frames; }
+	f_cnt_t samples() const { return m_samples.size(); }
+
+	sample_t* data() { return m_samples.data(); }
+	const sample_t* data() const { return m_samples.data(); }
+
+	//! Returns the first sample of @p frame
+	sample_t* frame(fpp_t frame) { return m_samples.data() + frame * m_channels; }
+	const sample_t* frame(fpp_t frame) const { return m_samples.data() + frame * m_channels; }
+
+	//! Views the buffer as frames of @p Channels channels, which must match channels()
+	template<ch_cnt_t Channels>
+	MultiChannelFrame<Channels>* frames()
+	{
+		assert(Channels == m_channels);
+		return reinterpret_cast<MultiChannelFrame<Channels>*>(m_samples.data());
+	}
+
+	void clear() { std::fill(m_samples.begin(), m_samples.end(), 0.f); }
+
+private:
+	ch_cnt_t m_channels;
+	fpp_t m_frames;
+	std::vector<sample_t> m_samples;
+};
+
+} // namespace lmms
+
+#endif // LMMS_MULTI_CHANNEL_BUFFER_H
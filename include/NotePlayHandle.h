@@ -27,6 +27,7 @@
 #define LMMS_NOTE_PLAY_HANDLE_H
 
 #include <memory>
+#include <vector>
 
 #include "BasicFilters.h"
 #include "Note.h"
@@ -48,7 +49,8 @@ class LMMS_EXPORT NotePlayHandle : public PlayHandle, public Note
 {
 public:
 	void * m_pluginData;
-	std::unique_ptr<BasicFilters<>> m_filter;
+	//! Filter state for the sound shaping, owned by the NotePlayHandleManager
+	BasicFilters<>* m_filter;
 
 	// length of the declicking fade in
 	fpp_t m_fadeInLength;
@@ -118,6 +120,12 @@ public:
 		return m_released && framesLeft() <= 0;
 	}
 
+	/*! Notes of voice batched instruments are played by the InstrumentPlayHandle instead of their own job */
+	bool requiresProcessing() const override
+	{
+		return !m_voiceBatched && !isFinished();
+	}
+
 	/*! Returns number of frames left for playback */
 	f_cnt_t framesLeft() const;
 
@@ -330,6 +338,7 @@ private:
 	Origin m_origin;
 
 	bool m_frequencyNeedsUpdate;				// used to update pitch
+	bool m_voiceBatched;						// played by the instrument's InstrumentPlayHandle
 } ;
 
 
@@ -352,7 +361,14 @@ public:
 	static void free();
 
 private:
+	static BasicFilters<>* createFilter();
+
 	static NotePlayHandle ** s_available;
+	// one filter per NotePlayHandle slot, so that no filter has to be
+	// allocated while rendering
+	static BasicFilters<> ** s_availableFilters;
+	//! Owns all filters, including the ones of the NotePlayHandles in use
+	static std::vector<std::unique_ptr<BasicFilters<>>> s_filters;
 	static QReadWriteLock s_mutex;
 	static std::atomic_int s_availableIndex;
 	static int s_size;
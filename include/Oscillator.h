@@ -26,13 +26,14 @@
 #ifndef LMMS_OSCILLATOR_H
 #define LMMS_OSCILLATOR_H
 
+#include <array>
 #include <cassert>
-#include <fftw3.h>
 #include <memory>
 #include <cstdlib>
 #include <cmath>
 
 #include "Engine.h"
+#include "FFTPlanCache.h"
 #include "lmms_math.h"
 #include "AudioEngine.h"
 #include "OscillatorConstants.h"
@@ -110,6 +111,11 @@ public:
 
 	void update(SampleFrame* ab, const fpp_t frames, const ch_cnt_t chnl, bool modulator = false);
 
+	//! Renders \p left into the left and \p right into the right channel of \p ab in a single pass.
+	//! Both oscillators must use the same wave shape and modulation chain; they may differ in
+	//! detuning, phase offset and volume. Otherwise, both channels are rendered separately.
+	static void updateStereo(Oscillator* left, Oscillator* right, SampleFrame* ab, const fpp_t frames);
+
 	// now follow the wave-shape-routines...
 	static inline sample_t sinSample( const float _sample )
 	{
@@ -241,6 +247,8 @@ public:
 	}
 
 private:
+	friend class OscillatorBank;
+
 	const IntModel * m_waveShapeModel;
 	const IntModel * m_modulationAlgoModel;
 	const float & m_freq;
@@ -256,13 +264,16 @@ private:
 	// There are many update*() variants; the modulator flag is stored as a member variable to avoid
 	// adding more explicit parameters to all of them. Can be converted to a parameter if needed.
 	bool m_isModulator;
+	// Current frequency and wavetable band, updated once per update() call
+	float m_currentFreq;
+	int m_waveTableBand;
 
 	/* Multiband WaveTable */
 	static sample_t s_waveTables[NumWaveShapeTables][OscillatorConstants::WAVE_TABLES_PER_WAVEFORM_COUNT][OscillatorConstants::WAVETABLE_LENGTH];
-	static fftwf_plan s_fftPlan;
-	static fftwf_plan s_ifftPlan;
-	static fftwf_complex * s_specBuf;
-	static std::array<float, OscillatorConstants::WAVETABLE_LENGTH> s_sampleBuffer;
+	static FFTPlan s_fftPlan;
+	static FFTPlan s_ifftPlan;
+	static FFTBuffer<fftwf_complex> s_specBuf;
+	static FFTBuffer<float> s_sampleBuffer;
 
 	static void generateSawWaveTable(int bands, sample_t* table, int firstBand = 1);
 	static void generateTriangleWaveTable(int bands, sample_t* table, int firstBand = 1);
@@ -274,44 +285,92 @@ private:
 	/* End Multiband wavetable */
 
 
-	void updateNoSub( SampleFrame* _ab, const fpp_t _frames,
-							const ch_cnt_t _chnl );
-	void updatePM( SampleFrame* _ab, const fpp_t _frames,
-							const ch_cnt_t _chnl );
-	void updateAM( SampleFrame* _ab, const fpp_t _frames,
-							const ch_cnt_t _chnl );
-	void updateMix( SampleFrame* _ab, const fpp_t _frames,
-							const ch_cnt_t _chnl );
-	void updateSync( SampleFrame* _ab, const fpp_t _frames,
-							const ch_cnt_t _chnl );
-	void updateFM( SampleFrame* _ab, const fpp_t _frames,
-							const ch_cnt_t _chnl );
+	//! Number of frames the update routines compute at once. The phase ramp
+	//! and the wave shape lookups of a block are kept in small arrays so that
+	//! the compiler can vectorize them.
+	static constexpr fpp_t BlockSize = 8;
+	using Block = std::array<float, BlockSize>;
+
+	//! Oscillators rendered together, the n-th one writing to channel chnl + n
+	template<std::size_t CH>
+	using OscillatorGroup = std::array<Oscillator*, CH>;
+
+	bool isStereoCompatible(const Oscillator& other) const;
+	template<std::size_t CH>
+	static OscillatorGroup<CH> subOscillators(const OscillatorGroup<CH>& oscs);
+
+	template<std::size_t CH>
+	static void updateGroup(const OscillatorGroup<CH>& oscs, SampleFrame* ab, const fpp_t frames,
+		const ch_cnt_t chnl, bool modulator);
+
+	template<std::size_t CH>
+	static void updateNoSub(const OscillatorGroup<CH>& oscs, SampleFrame* ab, const fpp_t frames,
+		const ch_cnt_t chnl);
+	template<std::size_t CH>
+	static void updatePM(const OscillatorGroup<CH>& oscs, SampleFrame* ab, const fpp_t frames,
+		const ch_cnt_t chnl);
+	template<std::size_t CH>
+	static void updateAM(const OscillatorGroup<CH>& oscs, SampleFrame* ab, const fpp_t frames,
+		const ch_cnt_t chnl);
+	template<std::size_t CH>
+	static void updateMix(const OscillatorGroup<CH>& oscs, SampleFrame* ab, const fpp_t frames,
+		const ch_cnt_t chnl);
+	template<std::size_t CH>
+	static void updateSync(const OscillatorGroup<CH>& oscs, SampleFrame* ab, const fpp_t frames,
+		const ch_cnt_t chnl);
+	template<std::size_t CH>
+	static void updateFM(const OscillatorGroup<CH>& oscs, SampleFrame* ab, const fpp_t frames,
+		const ch_cnt_t chnl);
 
 	float syncInit( SampleFrame* _ab, const fpp_t _frames,
 							const ch_cnt_t _chnl );
 	inline bool syncOk( float _osc_coeff );
 
+	template<WaveShape W, std::size_t CH>
+	static void updateNoSub(const OscillatorGroup<CH>& oscs, SampleFrame* ab, const fpp_t frames,
+		const ch_cnt_t chnl);
+	template<WaveShape W, std::size_t CH>
+	static void updatePM(const OscillatorGroup<CH>& oscs, SampleFrame* ab, const fpp_t frames,
+		const ch_cnt_t chnl);
+	template<WaveShape W, std::size_t CH>
+	static void updateAM(const OscillatorGroup<CH>& oscs, SampleFrame* ab, const fpp_t frames,
+		const ch_cnt_t chnl);
+	template<WaveShape W, std::size_t CH>
+	static void updateMix(const OscillatorGroup<CH>& oscs, SampleFrame* ab, const fpp_t frames,
+		const ch_cnt_t chnl);
+	template<WaveShape W, std::size_t CH>
+	static void updateSync(const OscillatorGroup<CH>& oscs, SampleFrame* ab, const fpp_t frames,
+		const ch_cnt_t chnl);
+	template<WaveShape W, std::size_t CH>
+	static void updateFM(const OscillatorGroup<CH>& oscs, SampleFrame* ab, const fpp_t frames,
+		const ch_cnt_t chnl);
+
+	//! Fills \p out with the first \p n samples of the wave shape at \p phases
 	template<WaveShape W>
-	void updateNoSub( SampleFrame* _ab, const fpp_t _frames,
-							const ch_cnt_t _chnl );
-	template<WaveShape W>
-	void updatePM( SampleFrame* _ab, const fpp_t _frames,
-							const ch_cnt_t _chnl );
-	template<WaveShape W>
-	void updateAM( SampleFrame* _ab, const fpp_t _frames,
-							const ch_cnt_t _chnl );
-	template<WaveShape W>
-	void updateMix( SampleFrame* _ab, const fpp_t _frames,
-							const ch_cnt_t _chnl );
-	template<WaveShape W>
-	void updateSync( SampleFrame* _ab, const fpp_t _frames,
-							const ch_cnt_t _chnl );
-	template<WaveShape W>
-	void updateFM( SampleFrame* _ab, const fpp_t _frames,
-							const ch_cnt_t _chnl );
+	inline void getSamples(const Block& phases, Block& out, const fpp_t n);
 
-	template<WaveShape W>
-	inline sample_t getSample( const float _sample );
+	//! Band-limited lookup of \p n phases in a single wavetable
+	static inline void wtSamples(const sample_t* table, const Block& phases, Block& out, const fpp_t n)
+	{
+		for (fpp_t i = 0; i < n; ++i)
+		{
+			const float frame = absFraction(phases[i]) * OscillatorConstants::WAVETABLE_LENGTH;
+			const auto f1 = static_cast<f_cnt_t>(frame);
+			const auto f2 = f1 < OscillatorConstants::WAVETABLE_LENGTH - 1 ? f1 + 1 : 0;
+			// Plain linear interpolation instead of std::lerp, which does not vectorize
+			out[i] = table[f1] + fraction(frame) * (table[f2] - table[f1]);
+		}
+	}
+
+	//! Advances the phase by \p n frames and stores the phase of every frame in \p phases
+	inline void phaseRamp(Block& phases, const float oscCoeff, const fpp_t n)
+	{
+		for (fpp_t i = 0; i < n; ++i)
+		{
+			phases[i] = m_phase + i * oscCoeff;
+		}
+		m_phase += n * oscCoeff;
+	}
 
 	inline void recalcPhase();
 
@@ -0,0 +1,102 @@
+/*
+ * OscillatorBank.h - wave shape rendering of many voices at once
+ *
+ * Copyright (c) 2026 LMMS Developers
+ *
+ * This file is part of LMMS - https://lmms.io
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public
+ * License along with this program (see COPYING); if not, write to the
+ * Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA 02110-1301 USA.
+ *
+ */
+
+#ifndef LMMS_OSCILLATOR_BANK_H
+#define LMMS_OSCILLATOR_BANK_H
+
+#include <vector>
+
+#include "Oscillator.h"
+
+namespace lmms
+{
+
+
+//! Renders one wave shape for many voices, e.g. one oscillator of all notes of a polyphonic
+//! instrument. The state of the voices is stored as a structure of arrays, so every step of the
+//! rendering loops over contiguous phases, increments and gains of all voices, which the compiler
+//! can vectorize across voices. Unlike Oscillator, a bank has no sub-oscillators; all wave shapes
+//! but WaveShape::UserDefined are supported.
+class LMMS_EXPORT OscillatorBank
+{
+public:
+	using WaveShape = Oscillator::WaveShape;
+
+	OscillatorBank(WaveShape waveShape, bool useWaveTable);
+
+	//! Adds a voice with the given phase offset (in periods) and volume and returns its index.
+	//! The phase increment is 0 until it is set with setPhaseIncrement().
+	std::size_t addVoice(float phaseOffset, float volume);
+
+	//! Removes a voice. The last voice takes the index of the removed one.
+	void removeVoice(std::size_t voice);
+
+	//! Sets the frequency of a voice divided by the sample rate
+	void setPhaseIncrement(std::size_t voice, float increment)
+	{
+		m_increments[voice] = increment;
+	}
+
+	void setVolume(std::size_t voice, float volume)
+	{
+		m_volumes[voice] = volume;
+	}
+
+	std::size_t voices() const
+	{
+		return m_phases.size();
+	}
+
+	//! Writes \p frames samples of the n-th voice to channel \p chnl of \p buffers[n]
+	void update(SampleFrame* const* buffers, const fpp_t frames, const ch_cnt_t chnl);
+
+private:
+	static constexpr fpp_t BlockSize = Oscillator::BlockSize;
+
+	template<WaveShape W>
+	void update(SampleFrame* const* buffers, const fpp_t frames, const ch_cnt_t chnl);
+
+	//! Fills m_samples with the samples of all voices \p frame increments after m_phases
+	template<WaveShape W>
+	void getSamples(const fpp_t frame);
+
+	WaveShape m_waveShape;
+	bool m_useWaveTable;
+
+	std::vector<float> m_phases;
+	std::vector<float> m_increments;
+	std::vector<float> m_volumes;
+
+	// Updated once per update() call
+	std::vector<float> m_gains;
+	std::vector<int> m_waveTableBands;
+
+	//! Sample of every voice at the current frame
+	std::vector<float> m_samples;
+} ;
+
+
+} // namespace lmms
+
+#endif // LMMS_OSCILLATOR_BANK_H
@@ -0,0 +1,114 @@
+/*
+ * Oversampler.h
+ *
+ * Copyright (c) 2026 LMMS Developers
+ *
+ * This file is part of LMMS - https://lmms.io
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public
+ * License along with this program (see COPYING); if not, write to the
+ * Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA 02110-1301 USA.
+ *
+ */
+
+#ifndef LMMS_OVERSAMPLER_H
+#define LMMS_OVERSAMPLER_H
+
+#include <memory>
+#include <vector>
+
+#include "LmmsTypes.h"
+#include "SampleFrame.h"
+#include "lmms_export.h"
+
+namespace lmms
+{
+
+/**
+	@brief Stereo 2x, 4x or 8x oversampling for nonlinear processing
+
+	Every doubling of the rate is a polyphase halfband stage, so each stage only
+	computes the nonzero half of its filter. The linear phase stages are windowed
+	sinc FIR filters, the minimum phase stages are two paths of first order
+	allpass filters, which need fewer operations and have almost no latency but
+	shift the phase of high frequencies.
+
+	Effects call upsample(), process the returned buffer at factor() times the
+	engine rate and call downsample(), or use process() which does all three.
+	Nothing is allocated after construction, so the factor and the phase can be
+	changed from the audio thread.
+*/
+class LMMS_EXPORT Oversampler
+{
+public:
+	enum class Phase
+	{
+		Linear,
+		Minimum
+	};
+
+	static constexpr int MaxFactor = 8;
+
+	//! @p maxFrames is the largest number of frames that is going to be passed to upsample()
+	Oversampler(fpp_t maxFrames, int factor = 1, Phase phase = Phase::Linear);
+	~Oversampler();
+
+	int factor() const { return m_factor; }
+	Phase phase() const { return m_phase; }
+
+	//! Sets the factor, which is 1, 2, 4 or 8, and forgets all previous input if it changes
+	void setFactor(int factor);
+	//! Switches the filters and forgets all previous input if the phase changes
+	void setPhase(Phase phase);
+
+	//! Delay at the engine rate that upsampling and downsampling add, rounded to whole frames
+	f_cnt_t latency() const;
+
+	//! Upsamples @p frames frames from @p in and returns the buffer with the frames * factor() resulting frames
+	SampleFrame* upsample(const SampleFrame* in, fpp_t frames);
+
+	//! Downsamples the buffer returned by the last upsample() call into @p frames frames at @p out
+	void downsample(SampleFrame* out, fpp_t frames);
+
+	//! Runs @p func on the upsampled contents of @p buf, passing it the buffer and its number of frames
+	template<class Func>
+	void process(SampleFrame* buf, fpp_t frames, Func&& func)
+	{
+		if (m_factor == 1)
+		{
+			func(buf, frames);
+			return;
+		}
+		func(upsample(buf, frames), frames * m_factor);
+		downsample(buf, frames);
+	}
+
+	//! Forgets all previous input
+	void reset();
+
+private:
+	struct Stages;
+
+	int stageCount() const;
+
+	int m_factor;
+	Phase m_phase;
+	std::unique_ptr<Stages> m_stages;
+	//! Intermediate and final results of the stages, the last stage always writes into the first one
+	std::vector<SampleFrame> m_buffers[2];
+};
+
+} // namespace lmms
+
+#endif // LMMS_OVERSAMPLER_H
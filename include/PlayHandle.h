@@ -57,7 +57,9 @@ public:
 
 	constexpr static std::size_t MaxNumber = 1024;
 
-	PlayHandle( const Type type, f_cnt_t offset = 0 );
+	//! Handles which are always played into a buffer of someone else can pass
+	//! @p ownBuffer = false to not allocate one of their own
+	PlayHandle( const Type type, f_cnt_t offset = 0, bool ownBuffer = true );
 
 	PlayHandle & operator = ( PlayHandle & p )
 	{
@@ -148,6 +150,16 @@ public:
 	
 	SampleFrame* buffer();
 
+	//! To be called from play() if the handle knows whether its output is
+	//! silent, so that the buffer does not need to be scanned
+	void setBufferSilent(bool silent)
+	{
+		m_bufferSilence = silent ? Silence::Silent : Silence::Audible;
+	}
+
+	//! Whether the output of the last play() is silent
+	bool isBufferSilent();
+
 private:
 	Type m_type;
 	f_cnt_t m_offset;
@@ -156,6 +168,7 @@ private:
 	SampleFrame* m_playHandleBuffer;
 	bool m_bufferReleased;
 	bool m_usesBuffer;
+	enum class Silence { Unknown, Silent, Audible } m_bufferSilence = Silence::Unknown;
 	AudioBusHandle* m_audioBusHandle;
 } ;
 
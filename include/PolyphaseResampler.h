@@ -0,0 +1,82 @@
+/*
+ * PolyphaseResampler.h
+ *
+ * Copyright (c) 2026 LMMS Developers
+ *
+ * This file is part of LMMS - https://lmms.io
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public
+ * License along with this program (see COPYING); if not, write to the
+ * Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA 02110-1301 USA.
+ *
+ */
+
+
+#ifndef LMMS_POLYPHASE_RESAMPLER_H
+#define LMMS_POLYPHASE_RESAMPLER_H
+
+#include <vector>
+
+#include "LmmsTypes.h"
+#include "SampleFrame.h"
+#include "lmms_export.h"
+
+namespace lmms
+{
+
+/**
+	@brief Streaming stereo resampler for a fixed rational ratio
+
+	Converts from @p inRate to @p outRate using a windowed sinc lowpass which
+	is split into one short filter per output phase, so each output frame only
+	costs TapsPerPhase multiply-adds per channel. The coefficients are computed
+	on construction; process() does not allocate.
+*/
+class LMMS_EXPORT PolyphaseResampler
+{
+public:
+	//! Filter length per phase, in input frames
+	static constexpr int TapsPerPhase = 32;
+
+	PolyphaseResampler(sample_rate_t inRate, sample_rate_t outRate);
+
+	//! Upper bound of the number of frames process() writes for @p inFrames input frames
+	f_cnt_t maxOutputFrames(f_cnt_t inFrames) const { return inFrames * m_up / m_down + 1; }
+
+	//! Delay of the filter in output frames
+	f_cnt_t latency() const;
+
+	//! Resample @p inFrames frames from @p in into @p out, which must hold
+	//! at least maxOutputFrames(inFrames) frames
+	//! @return number of frames written to @p out
+	f_cnt_t process(const SampleFrame* in, f_cnt_t inFrames, SampleFrame* out);
+
+	//! Forget all previous input
+	void reset();
+
+private:
+	f_cnt_t m_up; //!< interpolation factor
+	f_cnt_t m_down; //!< decimation factor
+	//! TapsPerPhase coefficients per phase, ordered from the newest to the oldest input frame
+	std::vector<float> m_coeffs;
+	//! The last TapsPerPhase input frames, stored twice, so they can be read without wrapping
+	std::vector<SampleFrame> m_history;
+	int m_historyPos = 0;
+	//! Phase of the next output frame, in steps of 1 / m_up input frames
+	f_cnt_t m_phase = 0;
+};
+
+} // namespace lmms
+
+#endif // LMMS_POLYPHASE_RESAMPLER_H
@@ -0,0 +1,81 @@
+/*
+ * RealtimeContext.h - marks code running on the audio threads
+ *
+ * Copyright (c) 2026 LMMS Developers
+ *
+ * This file is part of LMMS - https://lmms.io
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public
+ * License along with this program (see COPYING); if not, write to the
+ * Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA 02110-1301 USA.
+ *
+ */
+
+#ifndef LMMS_REALTIME_CONTEXT_H
+#define LMMS_REALTIME_CONTEXT_H
+
+#include <cstddef>
+
+#include "lmms_export.h"
+#include "lmmsconfig.h"
+
+namespace lmms
+{
+
+/**
+	@brief Marks the current thread as realtime for the lifetime of the object
+
+	Used by the render thread and the @ref AudioEngineWorkerThread while they render a period.
+	In debug builds, heap allocations done inside a realtime context are counted and reported
+	on stderr when the outermost context of the thread ends. In release builds, this class
+	does nothing.
+
+	With WANT_DEBUG_REALTIME, deallocations, pthread mutex locks and futex waits (contended
+	QMutex locks) are reported as well, together with the call stacks of the first violations
+	of each period. The report is
+	written to the file named by the LMMS_REALTIME_REPORT environment variable, or to stderr.
+*/
+class LMMS_EXPORT RealtimeContext
+{
+public:
+#if defined(LMMS_DEBUG) || defined(LMMS_DEBUG_REALTIME)
+	RealtimeContext();
+	~RealtimeContext();
+#else
+	RealtimeContext() = default;
+#endif
+
+	RealtimeContext(const RealtimeContext&) = delete;
+	RealtimeContext& operator=(const RealtimeContext&) = delete;
+
+	//! Returns whether the current thread is inside a realtime context
+	static bool isActive();
+
+	//! Returns the number of violations reported so far by all threads
+	static std::size_t violations();
+
+	/**
+		Reports a lock taken on the current thread. Only needed for locks the checks cannot
+		intercept by themselves, like uncontended QMutex locks, which never leave user space.
+	*/
+#ifdef LMMS_DEBUG_REALTIME
+	static void reportLock(const char* function);
+#else
+	static void reportLock(const char*) {}
+#endif
+};
+
+} // namespace lmms
+
+#endif // LMMS_REALTIME_CONTEXT_H
@@ -102,6 +102,9 @@ public:
 
 	bool process( const SampleFrame* _in_buf, SampleFrame* _out_buf );
 
+	//! Latency added by process() in frames, one period if the plugin runs pipelined
+	f_cnt_t latency() const;
+
 	void processMidiEvent( const MidiEvent&, const f_cnt_t _offset );
 
 	void updateSampleRate( sample_rate_t _sr )
@@ -158,6 +161,8 @@ protected:
 	bool m_failed;
 private:
 	void resizeSharedProcessingMemory();
+	void writeInputs( const SampleFrame* _in_buf, fpp_t _frames );
+	void readOutputs( SampleFrame* _out_buf, fpp_t _frames );
 
 
 	QProcess m_process;
@@ -173,6 +178,12 @@ private:
 #endif
 	bool m_splitChannels;
 
+	//! If set, process() returns the result of the previous period and doesn't wait for the
+	//! plugin, so that all remote plugins can process concurrently
+	bool m_pipelined;
+	//! Whether IdStartProcessing has been sent without IdProcessingDone being received yet
+	bool m_processingPending;
+
 	SharedMemory<float[]> m_audioBuffer;
 	std::size_t m_audioBufferSize;
 
@@ -78,6 +78,11 @@
 #ifdef SYNC_WITH_SHM_FIFO
 #include "SharedMemory.h"
 #include "SystemSemaphore.h"
+#elif defined(LMMS_BUILD_LINUX)
+// the socket is only used until both sides have switched to rings in shared memory
+#define SYNC_WITH_SHM_RING
+#include "SharedMemory.h"
+#include "SharedMemoryRing.h"
 #endif
 
 namespace lmms
@@ -360,6 +365,8 @@ enum RemoteMessageIDs
 	IdLoadPresetFile,
 	IdDebugMessage,
 	IdIdle,
+	IdChangeTransport,
+	IdTransportChanged,
 	IdUserBase = 64
 } ;
 
@@ -524,6 +531,12 @@ public:
 #ifdef SYNC_WITH_SHM_FIFO
 		return m_in->messagesLeft();
 #else
+#ifdef SYNC_WITH_SHM_RING
+		if (m_useRingIn.load(std::memory_order_acquire))
+		{
+			return !isInvalid() && !m_ringIn.empty();
+		}
+#endif
 		struct pollfd pollin;
 		pollin.fd = m_socket;
 		pollin.events = POLLIN;
@@ -574,9 +587,39 @@ protected:
 		m_in->messageSent();
 #else
 		m_invalid = true;
+#endif
+#ifdef SYNC_WITH_SHM_RING
+		if (m_rings)
+		{
+			// wake up threads waiting for messages
+			m_ringIn.close();
+			m_ringOut.close();
+		}
 #endif
 	}
 
+#ifdef SYNC_WITH_SHM_RING
+	/*
+		Switching from the socket to the rings happens in three steps, so that no message
+		is lost or reordered in either direction:
+		1. The host offers the rings with IdChangeTransport.
+		2. The plugin attaches and answers with IdTransportChanged as its last message
+		   over the socket.
+		3. The host reads from the rings from then on and answers with IdTransportChanged
+		   as its last message over the socket, after which the plugin reads from the rings.
+		If the plugin cannot attach, it answers with 0 and both sides keep using the socket.
+	*/
+
+	//! Host side: creates the rings and offers them to the plugin
+	void offerRingTransport();
+	//! Plugin side: attaches to the offered rings and acknowledges that
+	void acceptRingTransport(const std::string& key);
+	//! Handles IdTransportChanged on both sides
+	void ringTransportChanged(const message& m);
+	//! Makes blocked ring reads and writes fail once the socket's other end hangs up
+	void watchPeerWithRings();
+#endif
+
 
 #ifndef SYNC_WITH_SHM_FIFO
 	int m_socket;
@@ -603,6 +646,17 @@ private:
 			memset( _buf, 0, _len );
 			return;
 		}
+#ifdef SYNC_WITH_SHM_RING
+		if (m_useRingIn.load(std::memory_order_acquire))
+		{
+			if (!m_ringIn.read(_buf, _len))
+			{
+				invalidate();
+				memset(_buf, 0, _len);
+			}
+			return;
+		}
+#endif
 		char * buf = (char *) _buf;
 		int remaining = _len;
 		while ( remaining )
@@ -629,6 +683,16 @@ private:
 		{
 			return;
 		}
+#ifdef SYNC_WITH_SHM_RING
+		if (m_useRingOut)
+		{
+			if (!m_ringOut.write(_buf, _len))
+			{
+				invalidate();
+			}
+			return;
+		}
+#endif
 		const char * buf = (const char *) _buf;
 		int remaining = _len;
 		while ( remaining )
@@ -649,12 +713,24 @@ private:
 	}
 
 
+	//! Writes @p m without locking m_sendMutex and returns the number of bytes written
+	int writeMessage(const message& m);
+
 	bool m_invalid;
 
 	pthread_mutex_t m_receiveMutex;
 	pthread_mutex_t m_sendMutex;
 #endif // SYNC_WITH_SHM_FIFO
 
+#ifdef SYNC_WITH_SHM_RING
+	//! [0] carries messages from host to plugin, [1] from plugin to host
+	SharedMemory<SharedMemoryRing::Data[]> m_rings;
+	SharedMemoryRing m_ringIn;
+	SharedMemoryRing m_ringOut;
+	std::atomic_bool m_useRingIn = false;
+	bool m_useRingOut = false; // guarded by m_sendMutex
+#endif
+
 } ;
 
 } // namespace lmms
@@ -308,6 +308,16 @@ bool RemotePluginClient::processMessage( const message & _m )
 		case IdInitDone:
 			break;
 
+#ifdef SYNC_WITH_SHM_RING
+		case IdChangeTransport:
+			acceptRingTransport(_m.getString(0));
+			break;
+
+		case IdTransportChanged:
+			ringTransportChanged(_m);
+			break;
+#endif
+
 		default:
 		{
 			char buf[64];
@@ -33,6 +33,7 @@ namespace lmms
 {
 
 class SampleBuffer;
+class SampleRecordWriter;
 
 namespace gui
 {
@@ -84,6 +85,16 @@ public:
 		return new SampleClip(*this);
 	}
 
+	//! The writer for the next take while the clip is armed for recording, nullptr otherwise.
+	//! After the take, it is kept in the stopped state until it has finalized its file.
+	SampleRecordWriter* recordWriter() const
+	{
+		return m_recordWriter.get();
+	}
+
+	//! Called by the writer once it has finalized its file
+	void finishRecording();
+
 public slots:
 	void setSampleFile(const QString& sf);
 	void updateLength();
@@ -91,12 +102,19 @@ public slots:
 	void playbackPositionChanged();
 	void updateTrackClips();
 
+private slots:
+	void updateRecordWriter();
+
 protected:
 	SampleClip( const SampleClip& orig );
 
 private:
+	//! Loads the file of a finished take into the clip
+	void loadRecording(SampleRecordWriter& writer);
+
 	Sample m_sample;
 	BoolModel m_recordModel;
+	std::unique_ptr<SampleRecordWriter> m_recordWriter;
 	bool m_isPlaying;
 
 	friend class gui::SampleClipView;
@@ -105,6 +123,8 @@ private:
 signals:
 	void sampleChanged();
 	void wasReversed();
+	//! Emitted before the recorded file is loaded, so views can use what the writer collected
+	void recordingFinished(lmms::SampleRecordWriter* writer);
 } ;
 
 
@@ -0,0 +1,111 @@
+/*
+ * SampleConversion.h - conversion of rendered audio into device sample formats
+ *
+ * Copyright (c) 2026 LMMS Developers
+ *
+ * This file is part of LMMS - https://lmms.io
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public
+ * License along with this program (see COPYING); if not, write to the
+ * Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA 02110-1301 USA.
+ *
+ */
+
+#ifndef LMMS_SAMPLE_CONVERSION_H
+#define LMMS_SAMPLE_CONVERSION_H
+
+#include <array>
+#include <cstdint>
+
+#include "LmmsTypes.h"
+#include "lmms_export.h"
+
+namespace lmms
+{
+
+class SampleFrame;
+
+/**
+ * Converts interleaved `SampleFrame` and multichannel buffers into the sample formats that audio devices and files accept.
+ *
+ * The kernels use SSE2 where available and round to the nearest integer. Integer conversions clip to the target range and optionally add TPDF dither, which decorrelates the quantization
+ * error from the signal at the cost of a noise floor of about one LSB.
+ */
+namespace SampleConversion
+{
+
+enum class Format
+{
+	S16, //!< 16 bit signed integer
+	S24, //!< 24 bit signed integer in the low bits of 32 bit words
+	S32, //!< 32 bit signed integer
+	Float //!< 32 bit float, not clipped
+};
+
+//! Size of a single sample of @p format in bytes
+constexpr int bytesPerSample(Format format)
+{
+	return format == Format::S16 ? 2 : 4;
+}
+
+//! Generates triangular probability density noise with an amplitude of +-1 LSB
+class TpdfDither
+{
+public:
+	//! Fills @p noise with @p count values in (-1, 1)
+	void generate(float* noise, f_cnt_t count);
+
+private:
+	static std::uint32_t next(std::uint32_t& state)
+	{
+		// xorshift32
+		state ^= state << 13;
+		state ^= state >> 17;
+		state ^= state << 5;
+		return state;
+	}
+
+	std::array<std::uint32_t, 4> m_state = {0x9e3779b9, 0x7f4a7c15, 0x85ebca6b, 0xc2b2ae35};
+};
+
+/**
+ * Converts @p frames frames from @p src into interleaved samples of @p format at @p dst.
+ * If @p dither is given, it is used for the integer formats. If @p swapEndian is set, integer samples are written in the
+ * opposite of the host byte order.
+ */
+LMMS_EXPORT void convert(const SampleFrame* src, void* dst, f_cnt_t frames, Format format,
+	TpdfDither* dither = nullptr, bool swapEndian = false);
+
+//! Same as convert(), but for @p samples interleaved samples of any channel count
+LMMS_EXPORT void convertSamples(const sample_t* src, void* dst, f_cnt_t samples, Format format,
+	TpdfDither* dither = nullptr, bool swapEndian = false);
+
+LMMS_EXPORT void toS16(const SampleFrame* src, std::int16_t* dst, f_cnt_t frames, TpdfDither* dither = nullptr);
+LMMS_EXPORT void toS24(const SampleFrame* src, std::int32_t* dst, f_cnt_t frames, TpdfDither* dither = nullptr);
+LMMS_EXPORT void toS32(const SampleFrame* src, std::int32_t* dst, f_cnt_t frames, TpdfDither* dither = nullptr);
+
+//! Splits @p src into one float buffer per channel without any copy in between
+LMMS_EXPORT void toPlanar(const SampleFrame* src, float* const* dst, f_cnt_t frames);
+
+//! Splits @p frames frames of @p channels interleaved channels from @p src into one float buffer per channel
+LMMS_EXPORT void deinterleave(const sample_t* src, ch_cnt_t channels, float* const* dst, f_cnt_t frames);
+
+LMMS_EXPORT void swapEndian(std::int16_t* samples, f_cnt_t count);
+LMMS_EXPORT void swapEndian(std::int32_t* samples, f_cnt_t count);
+
+} // namespace SampleConversion
+
+} // namespace lmms
+
+#endif // LMMS_SAMPLE_CONVERSION_H
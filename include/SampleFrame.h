@@ -119,6 +119,11 @@ public:
 		return *this;
 	}
 
+	SampleFrame operator-(const SampleFrame& other) const
+	{
+		return SampleFrame(left() - other.left(), right() - other.right());
+	}
+
 	SampleFrame operator*(float value) const
 	{
 		return SampleFrame(left() * value, right() * value);
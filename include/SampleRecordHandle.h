@@ -25,10 +25,6 @@
 #ifndef LMMS_SAMPLE_RECORD_HANDLE_H
 #define LMMS_SAMPLE_RECORD_HANDLE_H
 
-#include <QList>
-#include <QPair>
-#include <memory>
-
 #include "PlayHandle.h"
 #include "TimePos.h"
 
@@ -37,15 +33,21 @@ namespace lmms
 
 
 class PatternTrack;
-class SampleBuffer;
 class SampleClip;
+class SampleRecordWriter;
 class Track;
 
 
+/**
+ * Records the audio input into a sample clip.
+ *
+ * Only copies the input into the SampleRecordWriter the clip has created when it was armed. Destroying the handle
+ * ends the take, the writer finalizes the file and lets the clip load it.
+ */
 class SampleRecordHandle : public PlayHandle
 {
 public:
-	SampleRecordHandle( SampleClip* clip );
+	SampleRecordHandle( SampleClip* clip, SampleRecordWriter* writer );
 	~SampleRecordHandle() override;
 
 	void play( SampleFrame* _working_buffer ) override;
@@ -54,22 +56,16 @@ public:
 	bool isFromTrack( const Track * _track ) const override;
 
 	f_cnt_t framesRecorded() const;
-	std::shared_ptr<const SampleBuffer> createSampleBuffer();
 
 
 private:
-	virtual void writeBuffer( const SampleFrame* _ab,
-						const f_cnt_t _frames );
-
-	using bufferList = QList<QPair<SampleFrame*, f_cnt_t>>;
-	bufferList m_buffers;
 	f_cnt_t m_framesRecorded;
 	TimePos m_minLength;
 
 	Track * m_track;
 	PatternTrack* m_patternTrack;
 	SampleClip * m_clip;
-
+	SampleRecordWriter* m_writer;
 } ;
 
 
@@ -0,0 +1,112 @@
+/*
+ * SampleRecordWriter.h - writes a sample recording to disk
+ *
+ * Copyright (c) 2026 LMMS Developers
+ *
+ * This file is part of LMMS - https://lmms.io
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public
+ * License along with this program (see COPYING); if not, write to the
+ * Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA 02110-1301 USA.
+ *
+ */
+
+#ifndef LMMS_SAMPLE_RECORD_WRITER_H
+#define LMMS_SAMPLE_RECORD_WRITER_H
+
+#include <QFile>
+#include <atomic>
+#include <sndfile.h>
+#include <thread>
+#include <vector>
+
+#include "LocklessRingBuffer.h"
+#include "SampleThumbnail.h"
+
+namespace lmms
+{
+
+
+class SampleClip;
+
+
+/**
+ * Streams the audio input of one take into a WAV file in the user's sample directory.
+ *
+ * Created by the SampleClip when it is armed for recording, so the ring buffer and the disk thread exist before
+ * the audio thread needs them. The SampleRecordHandle only copies the input into the ring buffer and calls stop()
+ * when the take ends. The disk thread then finalizes the file and tells the clip, which loads the recording on its
+ * own thread.
+ */
+class SampleRecordWriter
+{
+public:
+	SampleRecordWriter(SampleClip* clip);
+	//! Stops the disk thread and waits for it
+	~SampleRecordWriter();
+
+	SampleRecordWriter(const SampleRecordWriter&) = delete;
+	SampleRecordWriter& operator=(const SampleRecordWriter&) = delete;
+
+	//! Queues @p frames for the disk thread. Realtime safe.
+	void write(const SampleFrame* frames, f_cnt_t count);
+	//! Ends the take. Realtime safe, the disk thread writes what is left and finalizes the file.
+	void stop();
+	//! Ends the take and waits until the disk thread has finalized the file
+	void finish();
+
+	//! Whether stop() has been called
+	bool isStopped() const { return m_stopRecording; }
+	//! Whether the file has been finalized. The following functions may only be used afterwards.
+	bool isFinished() const { return m_finished; }
+
+	//! The recorded file relative to the user's directories, or empty if nothing could be written
+	const QString& fileName() const { return m_fileName; }
+	//! The peaks of the most detailed thumbnail level, see SampleThumbnail::cachePeaks()
+	std::vector<SampleThumbnail::Peak>& peaks() { return m_peaks; }
+
+private:
+	//! How much input the ring buffer holds while the disk thread is busy
+	static constexpr auto RingBufferSeconds = 4;
+
+	void writeToDisk();
+	bool openFile();
+	void writeFrames(const SampleFrame* frames, f_cnt_t count);
+	void closeFile();
+
+	SampleClip* m_clip;
+
+	LocklessRingBuffer<SampleFrame> m_ringBuffer;
+	LocklessRingBufferReader<SampleFrame> m_ringBufferReader;
+	std::atomic<bool> m_stopRecording = false;
+	std::atomic<bool> m_finished = false;
+	std::atomic<f_cnt_t> m_framesDropped = 0;
+
+	// Only used by the disk thread until it has finished
+	QString m_fileName;
+	QFile m_file;
+	SNDFILE* m_sndFile = nullptr;
+	bool m_fileFailed = false;
+	std::vector<SampleFrame> m_writeBuffer;
+	std::vector<SampleThumbnail::Peak> m_peaks;
+	SampleThumbnail::Peak m_pendingPeak;
+	int m_pendingPeakFrames = 0;
+
+	std::thread m_diskThread;
+};
+
+
+} // namespace lmms
+
+#endif // LMMS_SAMPLE_RECORD_WRITER_H
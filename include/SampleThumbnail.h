@@ -29,6 +29,7 @@
 #include <QDateTime>
 #include <QRect>
 #include <memory>
+#include <mutex>
 
 #include "lmms_export.h"
 #include "SampleBuffer.h"
@@ -70,37 +71,48 @@ public:
 		bool reversed = false; //!< Determines if the waveform is drawn in reverse or not.
 	};
 
+	//! The minimum and maximum of a range of samples
+	struct Peak
+	{
+		Peak() = default;
+
+		Peak(float min, float max)
+			: min(min)
+			, max(max)
+		{
+		}
+
+		Peak(const SampleFrame& frame)
+			: min(std::min(frame.left(), frame.right()))
+			, max(std::max(frame.left(), frame.right()))
+		{
+		}
+
+		Peak operator+(const Peak& other) const { return Peak(std::min(min, other.min), std::max(max, other.max)); }
+		Peak operator+(const SampleFrame& frame) const { return *this + Peak{frame}; }
+
+		float min = std::numeric_limits<float>::infinity();
+		float max = -std::numeric_limits<float>::infinity();
+	};
+
+	//! The number of interleaved samples that make up one peak of the most detailed thumbnail
+	static constexpr auto AggregationPerZoomStep = 10;
+
 	SampleThumbnail() = default;
 	SampleThumbnail(const Sample& sample);
 	void visualize(VisualizeParameters parameters, QPainter& painter) const;
 
+	/**
+	   Caches the thumbnails for @p filePath, built from @p peaks that each span `AggregationPerZoomStep` samples.
+	   Lets recordings provide the peaks they collected while being written, so that loading the file afterwards
+	   does not scan the whole sample again. Can be called from any thread.
+	 */
+	static void cachePeaks(const QString& filePath, std::vector<Peak> peaks);
+
 private:
 	class Thumbnail
 	{
 	public:
-		struct Peak
-		{
-			Peak() = default;
-
-			Peak(float min, float max)
-				: min(min)
-				, max(max)
-			{
-			}
-
-			Peak(const SampleFrame& frame)
-				: min(std::min(frame.left(), frame.right()))
-				, max(std::max(frame.left(), frame.right()))
-			{
-			}
-
-			Peak operator+(const Peak& other) const { return Peak(std::min(min, other.min), std::max(max, other.max)); }
-			Peak operator+(const SampleFrame& frame) const { return *this + Peak{frame}; }
-
-			float min = std::numeric_limits<float>::infinity();
-			float max = -std::numeric_limits<float>::infinity();
-		};
-
 		Thumbnail() = default;
 		Thumbnail(std::vector<Peak> peaks, double samplesPerPeak);
 		Thumbnail(const float* buffer, size_t size, size_t width);
@@ -136,9 +148,14 @@ private:
 	};
 
 	using ThumbnailCache = std::vector<Thumbnail>;
+
+	static void addZoomedOutThumbnails(ThumbnailCache& thumbnailCache);
+	static void addToCacheMap(SampleThumbnailEntry entry, std::shared_ptr<ThumbnailCache> thumbnailCache);
+
 	std::shared_ptr<ThumbnailCache> m_thumbnailCache = std::make_shared<ThumbnailCache>();
 	std::shared_ptr<const SampleBuffer> m_buffer = SampleBuffer::emptyBuffer();
 	inline static std::unordered_map<SampleThumbnailEntry, std::shared_ptr<ThumbnailCache>, Hash> s_sampleThumbnailCacheMap;
+	inline static std::mutex s_sampleThumbnailCacheMutex;
 };
 
 } // namespace lmms
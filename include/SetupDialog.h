@@ -32,6 +32,7 @@
 #include "AudioDeviceSetupWidget.h"
 #include "MidiClient.h"
 #include "MidiSetupWidget.h"
+#include "ThreadScheduling.h"
 
 
 class QCheckBox;
@@ -98,6 +99,7 @@ private slots:
 	void vstEmbedMethodChanged();
 	void toggleVSTAlwaysOnTop(bool en);
 	void toggleDisableAutoQuit(bool enabled);
+	void togglePipelineRemotePlugins(bool enabled);
 
 	// Audio settings widget.
 	void audioInterfaceChanged(const QString & driver);
@@ -168,6 +170,7 @@ private:
 	QCheckBox * m_vstAlwaysOnTopCheckBox;
 	bool m_vstAlwaysOnTop;
 	bool m_disableAutoQuit;
+	bool m_pipelineRemotePlugins;
 
 	using AswMap = QMap<QString, AudioDeviceSetupWidget*>;
 	using MswMap = QMap<QString, MidiSetupWidget*>;
@@ -182,8 +185,11 @@ private:
 	QSlider * m_bufferSizeSlider;
 	QLabel * m_bufferSizeLbl;
 	QLabel * m_bufferSizeWarnLbl;
+	bool m_ditherOutput;
+	int m_outputChannels;
 	int m_sampleRate;
 	QSlider* m_sampleRateSlider;
+	ThreadScheduling::Settings m_schedulingSettings;
 
 	// MIDI settings widgets.
 	QComboBox * m_midiInterfaces;
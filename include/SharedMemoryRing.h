@@ -0,0 +1,97 @@
+/*
+ * SharedMemoryRing.h
+ *
+ * Copyright (c) 2026 LMMS Developers
+ *
+ * This file is part of LMMS - https://lmms.io
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public
+ * License along with this program (see COPYING); if not, write to the
+ * Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA 02110-1301 USA.
+ *
+ */
+
+#ifndef LMMS_SHARED_MEMORY_RING_H
+#define LMMS_SHARED_MEMORY_RING_H
+
+#include <cstddef>
+#include <cstdint>
+
+
+namespace lmms
+{
+
+/**
+	@brief Single-producer single-consumer byte ring for use in shared memory
+
+	The ring only works on a Data object provided by the user, usually one placed in a
+	SharedMemory segment, so both processes can hold a SharedMemoryRing for the same data.
+	Blocked readers and writers spin for a short time and then sleep on a futex, so a
+	round trip between two processes costs no system call while both sides are busy.
+
+	Only available on Linux.
+*/
+class SharedMemoryRing
+{
+public:
+	//! The part of the ring that lives in shared memory. Zero-initialized memory is an empty ring.
+	struct Data
+	{
+		static constexpr std::uint32_t Size = 512 * 1024;
+
+		alignas(64) std::uint32_t head; //!< bytes written in total, only modified by the writer
+		std::uint32_t readerWaiting;
+		alignas(64) std::uint32_t tail; //!< bytes read in total, only modified by the reader
+		std::uint32_t writerWaiting;
+		alignas(64) std::uint32_t closed;
+		char data[Size];
+	};
+
+	SharedMemoryRing() = default;
+	explicit SharedMemoryRing(Data* data) :
+		m_data{data}
+	{
+	}
+
+	//! Blocks until all of @p buffer has been written. Returns false if the ring was closed.
+	bool write(const void* buffer, std::size_t length);
+	//! Blocks until @p buffer has been filled. Returns false if the ring was closed.
+	bool read(void* buffer, std::size_t length);
+
+	bool empty() const;
+
+	//! Wakes up both sides and makes all further reads and writes fail
+	void close();
+	bool isClosed() const;
+
+	/**
+		Lets a blocked read or write notice that the other process is gone: whenever
+		the wait times out, the ring polls @p fd, usually a socket connected to the
+		other process, and closes itself once the other end has hung up.
+	*/
+	void watchPeer(int fd) { m_peerFd = fd; }
+
+private:
+	//! Waits until @p word no longer has the value @p value or the ring is closed
+	void wait(std::uint32_t& word, std::uint32_t value, std::uint32_t& waiting);
+	void wake(std::uint32_t& word, std::uint32_t& waiting) const;
+	bool peerHungUp() const;
+
+	Data* m_data = nullptr;
+	int m_peerFd = -1;
+};
+
+} // namespace lmms
+
+#endif // LMMS_SHARED_MEMORY_RING_H
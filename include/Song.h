@@ -26,7 +26,10 @@
 #define LMMS_SONG_H
 
 #include <array>
+#include <functional>
+#include <future>
 #include <memory>
+#include <vector>
 
 #include <QString>
 #include <QHash>  // IWYU pragma: keep
@@ -312,6 +315,11 @@ public:
 		return m_loadingProject;
 	}
 
+	//! Run @p task on a worker thread while a project is being loaded. The
+	//! project is only considered loaded once all of these tasks finished.
+	//! Exceptions thrown by @p task are reported as loading errors.
+	std::shared_future<void> addLoadingTask(std::function<void()> task);
+
 	void loadingCancelled()
 	{
 		m_isCancelled = true;
@@ -440,6 +448,9 @@ private:
 	void saveControllerStates( QDomDocument & doc, QDomElement & element );
 	void restoreControllerStates( const QDomElement & element );
 
+	//! Block until all tasks from addLoadingTask() have finished
+	void waitForLoadingTasks();
+
 	void removeAllControllers();
 
 	void saveScaleStates(QDomDocument &doc, QDomElement &element);
@@ -482,6 +493,7 @@ private:
 	bool m_savingProject;
 	bool m_loadingProject;
 	bool m_isCancelled;
+	std::vector<std::shared_future<void>> m_loadingTasks;
 
 	SaveOptions m_saveOptions;
 
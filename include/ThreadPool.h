@@ -54,13 +54,23 @@ public:
 		auto promise = std::make_shared<std::promise<ReturnType>>();
 		auto task = [promise, fn = std::forward<Fn>(fn), args = std::make_tuple(std::forward<Args>(args)...)] 
 		{
-			if constexpr (!std::is_same_v<ReturnType, void>)
+			try
 			{
-				promise->set_value(std::apply(fn, args));
-				return;
+				if constexpr (!std::is_same_v<ReturnType, void>)
+				{
+					promise->set_value(std::apply(fn, args));
+				}
+				else
+				{
+					std::apply(fn, args);
+					promise->set_value();
+				}
+			}
+			catch (...)
+			{
+				// rethrown by the future's get()
+				promise->set_exception(std::current_exception());
 			}
-			std::apply(fn, args);
-			promise->set_value();
 		};
 
 		{
@@ -0,0 +1,77 @@
+/*
+ * ThreadScheduling.h
+ *
+ * Copyright (c) 2026 LMMS Developers
+ *
+ * This file is part of LMMS - https://lmms.io
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public
+ * License along with this program (see COPYING); if not, write to the
+ * Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA 02110-1301 USA.
+ *
+ */
+
+#ifndef LMMS_THREAD_SCHEDULING_H
+#define LMMS_THREAD_SCHEDULING_H
+
+#include <vector>
+
+#include <QString>
+
+#include "lmms_export.h"
+
+namespace lmms::ThreadScheduling
+{
+
+enum class Policy
+{
+	Default, //!< Scheduling of the operating system, only the Qt thread priority is set
+	Fifo, //!< SCHED_FIFO
+	RoundRobin //!< SCHED_RR
+};
+
+//! Scheduling settings of the audio rendering threads, stored in the "audioengine" section of the configuration
+struct Settings
+{
+	Policy policy = Policy::Default;
+	int priority = 70;
+	//! CPUs the rendering threads are pinned to, empty to let them run on all of them
+	std::vector<int> cpus;
+	//! Number of threads rendering in parallel, including the audio thread. 0 picks one per CPU.
+	int renderThreads = 0;
+	//! Render in the callback thread of audio devices that support it instead of filling a fifo in between
+	bool renderInCallback = false;
+};
+
+LMMS_EXPORT Settings loadSettings();
+LMMS_EXPORT void saveSettings(const Settings& settings);
+
+LMMS_EXPORT QString policyName(Policy policy);
+
+//! Parses a CPU list like "2,3" or "2-5,8". Invalid ranges and CPUs that no affinity mask can hold are skipped.
+LMMS_EXPORT std::vector<int> parseCpuList(const QString& list);
+LMMS_EXPORT QString cpuListToString(const std::vector<int>& cpus);
+
+/*! \brief Applies the scheduling policy and the CPU affinity to the calling thread
+ *
+ * The priority is clamped to what RLIMIT_RTPRIO allows. If the policy can still not be set,
+ * the thread keeps the default scheduling and a warning is printed.
+ *
+ * \return The policy the thread effectively runs with
+ */
+LMMS_EXPORT Policy applyToCurrentThread(const Settings& settings);
+
+} // namespace lmms::ThreadScheduling
+
+#endif // LMMS_THREAD_SCHEDULING_H
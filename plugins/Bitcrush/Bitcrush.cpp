@@ -32,13 +32,6 @@ namespace lmms
 {
 
 
-const int OS_RATE = 5;
-const float OS_RATIO = 1.0f / OS_RATE;
-const float CUTOFF_RATIO = 0.353553391f;
-const int SILENCEFRAMES = 10;
-const auto OS_RESAMPLE = std::array{0.0001490062883964112f, 0.1645978376763992f, 0.6705063120704088f,
-		0.1645978376763992f, 0.0001490062883964112f };
-
 extern "C"
 {
 
@@ -61,10 +54,8 @@ BitcrushEffect::BitcrushEffect( Model * parent, const Descriptor::SubPluginFeatu
 	Effect( &bitcrush_plugin_descriptor, parent, key ),
 	m_controls( this ),
 	m_sampleRate( Engine::audioEngine()->outputSampleRate() ),
-	m_filter( m_sampleRate )
+	m_oversampler( Engine::audioEngine()->framesPerPeriod() )
 {
-	m_buffer = new SampleFrame[Engine::audioEngine()->framesPerPeriod() * OS_RATE];
-	m_filter.setLowpass( m_sampleRate * ( CUTOFF_RATIO * OS_RATIO ) );
 	m_needsUpdate = true;
 
 	m_bitCounterL = 0.0f;
@@ -72,21 +63,12 @@ BitcrushEffect::BitcrushEffect( Model * parent, const Descriptor::SubPluginFeatu
 
 	m_left = 0.0f;
 	m_right = 0.0f;
-
-	m_silenceCounter = 0;
-}
-
-BitcrushEffect::~BitcrushEffect()
-{
-	delete[] m_buffer;
 }
 
 
 void BitcrushEffect::sampleRateChanged()
 {
 	m_sampleRate = Engine::audioEngine()->outputSampleRate();
-	m_filter.setSampleRate( m_sampleRate );
-	m_filter.setLowpass( m_sampleRate * ( CUTOFF_RATIO * OS_RATIO ) );
 	m_needsUpdate = true;
 }
 
@@ -104,6 +86,15 @@ inline float BitcrushEffect::noise( float amt )
 Effect::ProcessStatus BitcrushEffect::processImpl(SampleFrame* buf, const fpp_t frames)
 {
 	// update values
+	const bool oversamplingChanged = m_controls.m_oversampling.isValueChanged();
+	if( m_needsUpdate || oversamplingChanged )
+	{
+		m_oversampler.setFactor( 1 << m_controls.m_oversampling.value() );
+	}
+	if( m_needsUpdate || m_controls.m_oversamplingPhase.isValueChanged() )
+	{
+		m_oversampler.setPhase( static_cast<Oversampler::Phase>( m_controls.m_oversamplingPhase.value() ) );
+	}
 	if( m_needsUpdate || m_controls.m_rateEnabled.isValueChanged() )
 	{
 		m_rateEnabled = m_controls.m_rateEnabled.value();
@@ -114,13 +105,15 @@ Effect::ProcessStatus BitcrushEffect::processImpl(SampleFrame* buf, const fpp_t
 	{
 		m_depthEnabled = m_controls.m_depthEnabled.value();
 	}
-	if( m_needsUpdate || m_controls.m_rate.isValueChanged() || m_controls.m_stereoDiff.isValueChanged() )
+	if( m_needsUpdate || oversamplingChanged
+		|| m_controls.m_rate.isValueChanged() || m_controls.m_stereoDiff.isValueChanged() )
 	{
 		const float rate = m_controls.m_rate.value();
 		const float diff = m_controls.m_stereoDiff.value() * 0.005 * rate;
+		const float oversampledRate = m_sampleRate * m_oversampler.factor();
 
-		m_rateCoeffL = ( m_sampleRate * OS_RATE ) / ( rate - diff );
-		m_rateCoeffR = ( m_sampleRate * OS_RATE ) / ( rate + diff );
+		m_rateCoeffL = oversampledRate / ( rate - diff );
+		m_rateCoeffR = oversampledRate / ( rate + diff );
 
 		m_bitCounterL = 0.0f;
 		m_bitCounterR = 0.0f;
@@ -146,92 +139,48 @@ Effect::ProcessStatus BitcrushEffect::processImpl(SampleFrame* buf, const fpp_t
 
 	const float noiseAmt = m_controls.m_inNoise.value() * 0.01f;
 
-	// read input buffer and write it to oversampled buffer
-	if( m_rateEnabled ) // rate crushing enabled so do that
+	const float d = dryLevel();
+	const float w = wetLevel();
+
+	// crush the upsampled input, so that the steps of the rate crusher and the
+	// clipping are filtered by the downsampling instead of aliasing
+	m_oversampler.process( buf, frames, [&]( SampleFrame* osBuf, fpp_t osFrames )
 	{
-		for (auto f = std::size_t{0}; f < frames; ++f)
+		for (auto f = std::size_t{0}; f < osFrames; ++f)
 		{
-			for( int o = 0; o < OS_RATE; ++o )
+			if( m_rateEnabled ) // rate crushing enabled so hold the crushed sample
 			{
-				m_buffer[f * OS_RATE + o][0] = m_left;
-				m_buffer[f * OS_RATE + o][1] = m_right;
 				m_bitCounterL += 1.0f;
 				m_bitCounterR += 1.0f;
 				if( m_bitCounterL > m_rateCoeffL )
 				{
 					m_bitCounterL -= m_rateCoeffL;
 					m_left = m_depthEnabled
-						? depthCrush( buf[f][0] * m_inGain + noise( buf[f][0] * noiseAmt ) )
-						: buf[f][0] * m_inGain + noise( buf[f][0] * noiseAmt );
+						? depthCrush( osBuf[f][0] * m_inGain + noise( osBuf[f][0] * noiseAmt ) )
+						: osBuf[f][0] * m_inGain + noise( osBuf[f][0] * noiseAmt );
 				}
 				if( m_bitCounterR > m_rateCoeffR )
 				{
 					m_bitCounterR -= m_rateCoeffR;
 					m_right = m_depthEnabled
-						? depthCrush( buf[f][1] * m_inGain + noise( buf[f][1] * noiseAmt ) )
-						: buf[f][1] * m_inGain + noise( buf[f][1] * noiseAmt );
+						? depthCrush( osBuf[f][1] * m_inGain + noise( osBuf[f][1] * noiseAmt ) )
+						: osBuf[f][1] * m_inGain + noise( osBuf[f][1] * noiseAmt );
 				}
 			}
-		}
-	}
-	else // rate crushing disabled: simply oversample with zero-order hold
-	{
-		for (auto f = std::size_t{0}; f < frames; ++f)
-		{
-			for( int o = 0; o < OS_RATE; ++o )
-			{
-				m_buffer[f * OS_RATE + o][0] = m_depthEnabled
-					? depthCrush( buf[f][0] * m_inGain + noise( buf[f][0] * noiseAmt ) )
-					: buf[f][0] * m_inGain + noise( buf[f][0] * noiseAmt );
-				m_buffer[f * OS_RATE + o][1] = m_depthEnabled
-					? depthCrush( buf[f][1] * m_inGain + noise( buf[f][1] * noiseAmt ) )
-					: buf[f][1] * m_inGain + noise( buf[f][1] * noiseAmt );
-			}
-		}
-	}
-
-	// the oversampled buffer is now written, so filter it to reduce aliasing
-
-	for (auto f = std::size_t{0}; f < frames * OS_RATE; ++f)
-	{
-		if( qMax( qAbs( m_buffer[f][0] ), qAbs( m_buffer[f][1] ) ) >= 1.0e-10f )
-		{
-			m_silenceCounter = 0;
-			m_buffer[f][0] = m_filter.update( m_buffer[f][0], 0 );
-			m_buffer[f][1] = m_filter.update( m_buffer[f][1], 1 );
-		}
-		else
-		{
-			if( m_silenceCounter > SILENCEFRAMES )
-			{
-				m_buffer[f][0] = m_buffer[f][1] = 0.0f;
-			}
 			else
 			{
-				++m_silenceCounter;
-				m_buffer[f][0] = m_filter.update( m_buffer[f][0], 0 );
-				m_buffer[f][1] = m_filter.update( m_buffer[f][1], 1 );
+				m_left = m_depthEnabled
+					? depthCrush( osBuf[f][0] * m_inGain + noise( osBuf[f][0] * noiseAmt ) )
+					: osBuf[f][0] * m_inGain + noise( osBuf[f][0] * noiseAmt );
+				m_right = m_depthEnabled
+					? depthCrush( osBuf[f][1] * m_inGain + noise( osBuf[f][1] * noiseAmt ) )
+					: osBuf[f][1] * m_inGain + noise( osBuf[f][1] * noiseAmt );
 			}
-		}
-	}
-
 
-	// now downsample and write it back to main buffer
-
-	const float d = dryLevel();
-	const float w = wetLevel();
-	for (auto f = std::size_t{0}; f < frames; ++f)
-	{
-		float lsum = 0.0f;
-		float rsum = 0.0f;
-		for( int o = 0; o < OS_RATE; ++o )
-		{
-			lsum += m_buffer[f * OS_RATE + o][0] * OS_RESAMPLE[o];
-			rsum += m_buffer[f * OS_RATE + o][1] * OS_RESAMPLE[o];
+			osBuf[f][0] = d * osBuf[f][0] + w * qBound( -m_outClip, m_left, m_outClip ) * m_outGain;
+			osBuf[f][1] = d * osBuf[f][1] + w * qBound( -m_outClip, m_right, m_outClip ) * m_outGain;
 		}
-		buf[f][0] = d * buf[f][0] + w * qBound( -m_outClip, lsum, m_outClip ) * m_outGain;
-		buf[f][1] = d * buf[f][1] + w * qBound( -m_outClip, rsum, m_outClip ) * m_outGain;
-	}
+	} );
 
 	return ProcessStatus::ContinueIfNotQuiet;
 }
@@ -29,7 +29,7 @@
 
 #include "Effect.h"
 #include "BitcrushControls.h"
-#include "BasicFilters.h"
+#include "Oversampler.h"
 
 
 namespace lmms
@@ -40,7 +40,7 @@ class BitcrushEffect : public Effect
 {
 public:
 	BitcrushEffect( Model* parent, const Descriptor::SubPluginFeatures::Key* key );
-	~BitcrushEffect() override;
+	~BitcrushEffect() override = default;
 
 	ProcessStatus processImpl(SampleFrame* buf, const fpp_t frames) override;
 
@@ -49,6 +49,11 @@ public:
 		return &m_controls;
 	}
 
+	f_cnt_t latency() const override
+	{
+		return m_oversampler.latency();
+	}
+
 private:
 	void sampleRateChanged();
 	float depthCrush( float in );
@@ -56,9 +61,8 @@ private:
 
 	BitcrushControls m_controls;
 	
-	SampleFrame* m_buffer;
 	float m_sampleRate;
-	StereoLinkwitzRiley m_filter;
+	Oversampler m_oversampler;
 	
 	float m_bitCounterL;
 	float m_rateCoeffL;
@@ -78,8 +82,6 @@ private:
 	float m_outClip;
 
 	bool m_needsUpdate;
-	
-	int m_silenceCounter;
 
 	friend class BitcrushControls;
 };
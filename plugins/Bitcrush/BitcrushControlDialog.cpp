@@ -29,6 +29,7 @@
 #include "embed.h"
 #include "BitcrushControlDialog.h"
 #include "BitcrushControls.h"
+#include "ComboBox.h"
 #include "FontHelper.h"
 #include "LedCheckBox.h"
 #include "Knob.h"
@@ -44,7 +45,7 @@ BitcrushControlDialog::BitcrushControlDialog( BitcrushControls * controls ) :
 	QPalette pal;
 	pal.setBrush( backgroundRole(),	PLUGIN_NAME::getIconPixmap( "artwork" ) );
 	setPalette( pal );
-	setFixedSize( 181, 128 );
+	setFixedSize( 181, 154 );
 	
 	// labels
 	const auto labelFont = adjustedToPixelSize(font(), DEFAULT_FONT_SIZE);
@@ -111,6 +112,18 @@ BitcrushControlDialog::BitcrushControlDialog( BitcrushControls * controls ) :
 	levels->move( 92, 32 );
 	levels->setModel( & controls->m_levels );
 	levels->setHintText( tr( "Levels:" ) , "" );
+
+
+	// oversampling
+	auto oversampling = new ComboBox( this );
+	oversampling->setGeometry( 10, 126, 60, ComboBox::DEFAULT_HEIGHT );
+	oversampling->setModel( & controls->m_oversampling );
+	oversampling->setToolTip( tr( "Oversampling factor, higher factors reduce aliasing" ) );
+
+	auto oversamplingPhase = new ComboBox( this );
+	oversamplingPhase->setGeometry( 76, 126, 95, ComboBox::DEFAULT_HEIGHT );
+	oversamplingPhase->setModel( & controls->m_oversamplingPhase );
+	oversamplingPhase->setToolTip( tr( "Linear phase filters keep the waveform intact, minimum phase filters add less latency" ) );
 }
 
 
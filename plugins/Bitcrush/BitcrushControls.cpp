@@ -44,8 +44,19 @@ BitcrushControls::BitcrushControls( BitcrushEffect * eff ) :
 	m_stereoDiff( 0.f, -50.f, 50.f, 0.1f, this, tr( "Stereo difference" ) ),
 	m_levels( 256.f, 1.f, 256.f, 0.01f, this, tr( "Levels" ) ),
 	m_rateEnabled( true, this, tr( "Rate enabled" ) ),
-	m_depthEnabled( true, this, tr( "Depth enabled" ) )
+	m_depthEnabled( true, this, tr( "Depth enabled" ) ),
+	m_oversampling( this, tr( "Oversampling" ) ),
+	m_oversamplingPhase( this, tr( "Oversampling filter" ) )
 {
+	m_oversampling.addItem( tr( "1x" ) );
+	m_oversampling.addItem( tr( "2x" ) );
+	m_oversampling.addItem( tr( "4x" ) );
+	m_oversampling.addItem( tr( "8x" ) );
+	m_oversampling.setInitValue( 2 );
+
+	m_oversamplingPhase.addItem( tr( "Linear phase" ) );
+	m_oversamplingPhase.addItem( tr( "Minimum phase" ) );
+
 	m_rate.setStrictStepSize( true );
 	m_levels.setStrictStepSize( true );
 	
@@ -64,6 +75,8 @@ void BitcrushControls::saveSettings( QDomDocument & doc, QDomElement & elem )
 	m_levels.saveSettings( doc, elem, "levels" );
 	m_rateEnabled.saveSettings( doc, elem, "rateon" );
 	m_depthEnabled.saveSettings( doc, elem, "depthon" );
+	m_oversampling.saveSettings( doc, elem, "oversampling" );
+	m_oversamplingPhase.saveSettings( doc, elem, "oversamplingphase" );
 }
 
 
@@ -78,6 +91,8 @@ void BitcrushControls::loadSettings( const QDomElement & elem )
 	m_levels.loadSettings(  elem, "levels" );
 	m_rateEnabled.loadSettings(  elem, "rateon" );
 	m_depthEnabled.loadSettings(  elem, "depthon" );
+	m_oversampling.loadSettings(  elem, "oversampling" );
+	m_oversamplingPhase.loadSettings(  elem, "oversamplingphase" );
 	
 	m_effect->m_needsUpdate = true;
 }
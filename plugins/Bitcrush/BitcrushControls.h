@@ -26,6 +26,7 @@
 #ifndef BITCRUSH_CONTROLS_H
 #define BITCRUSH_CONTROLS_H
 
+#include "ComboBoxModel.h"
 #include "EffectControls.h"
 #include "BitcrushControlDialog.h"
 
@@ -51,7 +52,7 @@ public:
 
 	int controlCount() override
 	{
-		return( 9 );
+		return( 11 );
 	}
 
 	gui::EffectControlDialog * createView() override
@@ -78,6 +79,9 @@ private:
 	
 	BoolModel m_rateEnabled;
 	BoolModel m_depthEnabled;
+
+	ComboBoxModel m_oversampling;
+	ComboBoxModel m_oversamplingPhase;
 	
 	friend class gui::BitcrushControlDialog;
 	friend class BitcrushEffect;
@@ -47,6 +47,12 @@ public:
 	ProcessStatus processImpl(SampleFrame* buf, const fpp_t frames) override;
 	void processBypassedImpl() override;
 
+	//! The input is delayed by the lookahead buffer if lookahead is enabled
+	f_cnt_t latency() const override
+	{
+		return m_compressorControls.m_lookaheadModel.value() ? m_lookBufLength : 0;
+	}
+
 	EffectControls* controls() override
 	{
 		return &m_compressorControls;
@@ -0,0 +1,160 @@
+/*
+ * ConvolutionReverb.cpp - convolution reverb effect
+ *
+ * Copyright (c) 2026 LMMS Developers
+ *
+ * This file is part of LMMS - https://lmms.io
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public
+ * License along with this program (see COPYING); if not, write to the
+ * Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA 02110-1301 USA.
+ *
+ */
+
+
+#include "ConvolutionReverb.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include "AudioEngine.h"
+#include "Engine.h"
+#include "PolyphaseResampler.h"
+#include "embed.h"
+#include "lmms_math.h"
+#include "plugin_export.h"
+
+namespace lmms
+{
+
+
+extern "C"
+{
+
+Plugin::Descriptor PLUGIN_EXPORT convolutionreverb_plugin_descriptor =
+{
+	LMMS_STRINGIFY(PLUGIN_NAME),
+	"Convolution Reverb",
+	QT_TRANSLATE_NOOP("PluginBrowser", "Reverb using recorded impulse responses"),
+	"LMMS Developers",
+	0x0100,
+	Plugin::Type::Effect,
+	new PluginPixmapLoader("logo"),
+	nullptr,
+	nullptr,
+};
+
+}
+
+
+ConvolutionReverbEffect::ConvolutionReverbEffect(Model* parent, const Descriptor::SubPluginFeatures::Key* key) :
+	Effect(&convolutionreverb_plugin_descriptor, parent, key),
+	m_controls(this),
+	m_wetBuffer(Engine::audioEngine()->framesPerPeriod())
+{
+}
+
+
+
+
+Effect::ProcessStatus ConvolutionReverbEffect::processImpl(SampleFrame* buf, const fpp_t frames)
+{
+	// without an impulse response, the input passes unchanged
+	if (!m_convolver) { return ProcessStatus::ContinueIfNotQuiet; }
+
+	m_convolver->process(buf, m_wetBuffer.data(), frames);
+
+	const float d = dryLevel();
+	const float w = wetLevel();
+	const ValueBuffer* gainBuffer = m_controls.m_gainModel.valueBuffer();
+	const float gain = dbfsToAmp(m_controls.m_gainModel.value());
+
+	for (fpp_t f = 0; f < frames; ++f)
+	{
+		const float wet = w * (gainBuffer ? dbfsToAmp(gainBuffer->values()[f]) : gain);
+		buf[f] = buf[f] * d + m_wetBuffer[f] * wet;
+	}
+
+	return ProcessStatus::ContinueIfNotQuiet;
+}
+
+
+
+
+void ConvolutionReverbEffect::setImpulseResponse(std::shared_ptr<const SampleBuffer> impulseResponse)
+{
+	m_impulseResponse = std::move(impulseResponse);
+	updateConvolver();
+}
+
+
+
+
+void ConvolutionReverbEffect::updateConvolver()
+{
+	auto impulse = std::vector<SampleFrame>(m_impulseResponse->begin(), m_impulseResponse->end());
+
+	const auto sampleRate = Engine::audioEngine()->outputSampleRate();
+	if (!impulse.empty() && m_impulseResponse->sampleRate() != sampleRate)
+	{
+		auto resampler = PolyphaseResampler{m_impulseResponse->sampleRate(), sampleRate};
+		// flush the filter with silence so the end of the impulse response is not cut off
+		const auto frames = impulse.size();
+		impulse.resize(frames + PolyphaseResampler::TapsPerPhase);
+		auto resampled = std::vector<SampleFrame>(resampler.maxOutputFrames(impulse.size()));
+		resampled.resize(resampler.process(impulse.data(), impulse.size(), resampled.data()));
+
+		const auto begin = std::min<f_cnt_t>(resampler.latency(), resampled.size());
+		const auto length = static_cast<f_cnt_t>(std::ceil(static_cast<double>(frames) * sampleRate
+			/ m_impulseResponse->sampleRate()));
+		impulse.assign(resampled.begin() + begin, resampled.begin() + std::min(begin + length, resampled.size()));
+	}
+
+	if (m_controls.m_normalizeModel.value())
+	{
+		// scale to unity gain for white noise, so impulse responses of different lengths are similarly loud
+		double energy = 0.;
+		for (const auto& frame : impulse) { energy += frame.sumOfSquaredAmplitudes(); }
+		if (energy > 0.)
+		{
+			const auto scale = static_cast<float>(1. / std::sqrt(energy / DEFAULT_CHANNELS));
+			for (auto& frame : impulse) { frame *= scale; }
+		}
+	}
+
+	auto convolver = std::unique_ptr<Convolver>{};
+	if (!impulse.empty()) { convolver = std::make_unique<Convolver>(impulse.data(), impulse.size()); }
+
+	Engine::audioEngine()->requestChangeInModel();
+	std::swap(m_convolver, convolver);
+	Engine::audioEngine()->doneChangeInModel();
+	// the previous convolver, which might wait for its background thread, is destroyed here
+}
+
+
+
+
+extern "C"
+{
+
+// necessary for getting instance out of shared lib
+PLUGIN_EXPORT Plugin* lmms_plugin_main(Model* parent, void* data)
+{
+	return new ConvolutionReverbEffect(parent, static_cast<const Plugin::Descriptor::SubPluginFeatures::Key*>(data));
+}
+
+}
+
+
+} // namespace lmms
@@ -0,0 +1,115 @@
+/*
+ * ConvolutionReverbControlDialog.cpp - control dialog for the convolution reverb
+ *
+ * Copyright (c) 2026 LMMS Developers
+ *
+ * This file is part of LMMS - https://lmms.io
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public
+ * License along with this program (see COPYING); if not, write to the
+ * Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA 02110-1301 USA.
+ *
+ */
+
+
+#include "ConvolutionReverbControlDialog.h"
+
+#include <QFileInfo>
+#include <QHBoxLayout>
+#include <QLabel>
+#include <QPushButton>
+#include <QVBoxLayout>
+
+#include "ConvolutionReverbControls.h"
+#include "Engine.h"
+#include "FontHelper.h"
+#include "Knob.h"
+#include "LedCheckBox.h"
+#include "SampleLoader.h"
+#include "Song.h"
+#include "embed.h"
+
+namespace lmms::gui
+{
+
+
+ConvolutionReverbControlDialog::ConvolutionReverbControlDialog(ConvolutionReverbControls* controls) :
+	EffectControlDialog(controls),
+	m_controls(controls)
+{
+	setAutoFillBackground(true);
+	QPalette pal;
+	pal.setBrush(backgroundRole(), PLUGIN_NAME::getIconPixmap("artwork"));
+	setPalette(pal);
+	setFixedSize(200, 90);
+
+	auto openButton = new QPushButton(this);
+	openButton->setIcon(embed::getIconPixmap("project_open"));
+	openButton->setToolTip(tr("Open impulse response"));
+	connect(openButton, &QPushButton::clicked, this, &ConvolutionReverbControlDialog::openImpulseResponse);
+
+	m_fileLabel = new QLabel(this);
+	m_fileLabel->setFont(adjustedToPixelSize(font(), DEFAULT_FONT_SIZE));
+
+	auto gainKnob = new Knob(KnobType::Bright26, tr("GAIN"), SMALL_FONT_SIZE, this);
+	gainKnob->setModel(&controls->m_gainModel);
+	gainKnob->setHintText(tr("Gain:"), " dBFS");
+
+	auto normalizeToggle = new LedCheckBox(tr("Normalize"), this, tr("Normalize"), LedCheckBox::LedColor::Green);
+	normalizeToggle->setModel(&controls->m_normalizeModel);
+	normalizeToggle->setToolTip(tr("Scale the impulse response so that it does not change the loudness"));
+
+	auto fileLayout = new QHBoxLayout();
+	fileLayout->addWidget(openButton);
+	fileLayout->addWidget(m_fileLabel, 1);
+
+	auto controlsLayout = new QHBoxLayout();
+	controlsLayout->addWidget(gainKnob);
+	controlsLayout->addWidget(normalizeToggle);
+	controlsLayout->addStretch();
+
+	auto mainLayout = new QVBoxLayout(this);
+	mainLayout->addLayout(fileLayout);
+	mainLayout->addLayout(controlsLayout);
+
+	connect(controls, &ConvolutionReverbControls::impulseResponseChanged,
+		this, &ConvolutionReverbControlDialog::updateFileLabel);
+	updateFileLabel();
+}
+
+
+
+
+void ConvolutionReverbControlDialog::openImpulseResponse()
+{
+	const auto file = SampleLoader::openAudioFile(m_controls->impulseResponseFile());
+	if (file.isEmpty()) { return; }
+
+	m_controls->setImpulseResponseFile(file);
+	Engine::getSong()->setModified();
+}
+
+
+
+
+void ConvolutionReverbControlDialog::updateFileLabel()
+{
+	const auto file = m_controls->impulseResponseFile();
+	const auto name = file.isEmpty() ? tr("No impulse response") : QFileInfo(file).fileName();
+	m_fileLabel->setText(m_fileLabel->fontMetrics().elidedText(name, Qt::ElideMiddle, 150));
+	m_fileLabel->setToolTip(file);
+}
+
+
+} // namespace lmms::gui
@@ -1,7 +1,7 @@
 /*
- * DataprocLauncher.h - QThread::create workaround for older Qt version
+ * ConvolutionReverbControlDialog.h - control dialog for the convolution reverb
  *
- * Copyright (c) 2019 Martin Pavelek <he29/dot/HS/at/gmail/dot/com>
+ * Copyright (c) 2026 LMMS Developers
  *
  * This file is part of LMMS - https://lmms.io
  *
@@ -22,38 +22,42 @@
  *
  */
 
-#ifndef DATAPROCLAUNCHER_H
-#define DATAPROCLAUNCHER_H
 
-#include <QThread>
+#ifndef LMMS_GUI_CONVOLUTION_REVERB_CONTROL_DIALOG_H
+#define LMMS_GUI_CONVOLUTION_REVERB_CONTROL_DIALOG_H
 
-#include "SaProcessor.h"
-#include "LocklessRingBuffer.h"
+#include "EffectControlDialog.h"
+
+class QLabel;
 
 namespace lmms
 {
 
+class ConvolutionReverbControls;
+
+
+namespace gui
+{
 
-class DataprocLauncher : public QThread
+class ConvolutionReverbControlDialog : public EffectControlDialog
 {
+	Q_OBJECT
 public:
-	explicit DataprocLauncher(SaProcessor &proc, LocklessRingBuffer<SampleFrame> &buffer)
-		: m_processor(&proc),
-		m_inputBuffer(&buffer)
-	{
-	}
+	ConvolutionReverbControlDialog(ConvolutionReverbControls* controls);
+	~ConvolutionReverbControlDialog() override = default;
 
-private:
-	void run() override
-	{
-		m_processor->analyze(*m_inputBuffer);
-	}
+private slots:
+	void openImpulseResponse();
+	void updateFileLabel();
 
-	SaProcessor *m_processor;
-	LocklessRingBuffer<SampleFrame> *m_inputBuffer;
+private:
+	ConvolutionReverbControls* m_controls;
+	QLabel* m_fileLabel;
 };
 
 
+} // namespace gui
+
 } // namespace lmms
 
-#endif // DATAPROCLAUNCHER_H
+#endif // LMMS_GUI_CONVOLUTION_REVERB_CONTROL_DIALOG_H
@@ -0,0 +1,105 @@
+/*
+ * ConvolutionReverbControls.cpp - controls for the convolution reverb
+ *
+ * Copyright (c) 2026 LMMS Developers
+ *
+ * This file is part of LMMS - https://lmms.io
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public
+ * License along with this program (see COPYING); if not, write to the
+ * Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA 02110-1301 USA.
+ *
+ */
+
+
+#include "ConvolutionReverbControls.h"
+
+#include <QDomElement>
+#include <QFileInfo>
+
+#include "AudioEngine.h"
+#include "ConvolutionReverb.h"
+#include "Engine.h"
+#include "PathUtil.h"
+#include "SampleLoader.h"
+#include "Song.h"
+
+namespace lmms
+{
+
+
+ConvolutionReverbControls::ConvolutionReverbControls(ConvolutionReverbEffect* effect) :
+	EffectControls(effect),
+	m_effect(effect),
+	m_gainModel(0.0f, -60.0f, 15.0f, 0.1f, this, tr("Gain")),
+	m_normalizeModel(true, this, tr("Normalize"))
+{
+	connect(&m_normalizeModel, &BoolModel::dataChanged, this, &ConvolutionReverbControls::updateConvolver);
+	connect(Engine::audioEngine(), &AudioEngine::sampleRateChanged, this, &ConvolutionReverbControls::updateConvolver);
+}
+
+
+
+
+QString ConvolutionReverbControls::impulseResponseFile() const
+{
+	return m_effect->impulseResponse()->audioFile();
+}
+
+
+
+
+void ConvolutionReverbControls::setImpulseResponseFile(const QString& file)
+{
+	m_effect->setImpulseResponse(gui::SampleLoader::createBufferFromFile(file));
+	emit impulseResponseChanged();
+}
+
+
+
+
+void ConvolutionReverbControls::loadSettings(const QDomElement& elem)
+{
+	m_gainModel.loadSettings(elem, "gain");
+	m_normalizeModel.loadSettings(elem, "normalize");
+
+	auto file = elem.attribute("src");
+	if (!file.isEmpty() && !QFileInfo(PathUtil::toAbsolute(file)).exists())
+	{
+		Engine::getSong()->collectError(QString("%1: %2").arg(tr("Impulse response not found"), file));
+		file.clear();
+	}
+	setImpulseResponseFile(file);
+}
+
+
+
+
+void ConvolutionReverbControls::saveSettings(QDomDocument& doc, QDomElement& elem)
+{
+	m_gainModel.saveSettings(doc, elem, "gain");
+	m_normalizeModel.saveSettings(doc, elem, "normalize");
+	elem.setAttribute("src", impulseResponseFile());
+}
+
+
+
+
+void ConvolutionReverbControls::updateConvolver()
+{
+	m_effect->updateConvolver();
+}
+
+
+} // namespace lmms
@@ -0,0 +1,84 @@
+/*
+ * ConvolutionReverbControls.h - controls for the convolution reverb
+ *
+ * Copyright (c) 2026 LMMS Developers
+ *
+ * This file is part of LMMS - https://lmms.io
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public
+ * License along with this program (see COPYING); if not, write to the
+ * Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA 02110-1301 USA.
+ *
+ */
+
+
+#ifndef LMMS_CONVOLUTION_REVERB_CONTROLS_H
+#define LMMS_CONVOLUTION_REVERB_CONTROLS_H
+
+#include "ConvolutionReverbControlDialog.h"
+#include "EffectControls.h"
+
+namespace lmms
+{
+
+
+class ConvolutionReverbEffect;
+
+class ConvolutionReverbControls : public EffectControls
+{
+	Q_OBJECT
+public:
+	ConvolutionReverbControls(ConvolutionReverbEffect* effect);
+	~ConvolutionReverbControls() override = default;
+
+	void saveSettings(QDomDocument& doc, QDomElement& elem) override;
+	void loadSettings(const QDomElement& elem) override;
+	inline QString nodeName() const override
+	{
+		return "convolutionreverbcontrols";
+	}
+
+	int controlCount() override
+	{
+		return 2;
+	}
+
+	gui::EffectControlDialog* createView() override
+	{
+		return new gui::ConvolutionReverbControlDialog(this);
+	}
+
+	QString impulseResponseFile() const;
+	//! Loads the impulse response from @p file, or clears it if @p file is empty
+	void setImpulseResponseFile(const QString& file);
+
+signals:
+	void impulseResponseChanged();
+
+private slots:
+	void updateConvolver();
+
+private:
+	ConvolutionReverbEffect* m_effect;
+	FloatModel m_gainModel;
+	BoolModel m_normalizeModel;
+
+	friend class gui::ConvolutionReverbControlDialog;
+	friend class ConvolutionReverbEffect;
+};
+
+
+} // namespace lmms
+
+#endif // LMMS_CONVOLUTION_REVERB_CONTROLS_H
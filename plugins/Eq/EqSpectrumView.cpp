@@ -22,6 +22,7 @@
 
 #include "EqSpectrumView.h"
 
+#include <algorithm>
 #include <cmath>
 #include <numbers>
 #include <QPainter>
@@ -38,6 +39,8 @@ namespace lmms
 
 
 EqAnalyser::EqAnalyser() :
+	m_specBuf(FFT_BUFFER_SIZE + 1),
+	m_buffer(FFT_BUFFER_SIZE * 2),
 	m_framesFilledUp ( 0 ),
 	m_energy ( 0 ),
 	m_sampleRate ( 1 ),
@@ -45,8 +48,7 @@ EqAnalyser::EqAnalyser() :
 {
 	using namespace std::numbers;
 	m_inProgress=false;
-	m_specBuf = ( fftwf_complex * ) fftwf_malloc( ( FFT_BUFFER_SIZE + 1 ) * sizeof( fftwf_complex ) );
-	m_fftPlan = fftwf_plan_dft_r2c_1d( FFT_BUFFER_SIZE*2, m_buffer, m_specBuf, FFTW_MEASURE );
+	m_fftPlan = FFTPlanCache::instance().plan(FFT_BUFFER_SIZE * 2, FFTPlanCache::Direction::Forward);
 
 	//initialize Blackman-Harris window, constants taken from
 	//https://en.wikipedia.org/wiki/Window_function#A_list_of_window_functions
@@ -67,15 +69,6 @@ EqAnalyser::EqAnalyser() :
 
 
 
-EqAnalyser::~EqAnalyser()
-{
-	fftwf_destroy_plan( m_fftPlan );
-	fftwf_free( m_specBuf );
-}
-
-
-
-
 void EqAnalyser::analyze( SampleFrame* buf, const fpp_t frames )
 {
 	//only analyse if the view is visible
@@ -113,14 +106,14 @@ void EqAnalyser::analyze( SampleFrame* buf, const fpp_t frames )
 			m_buffer[i] = m_buffer[i] * m_fftWindow[i];
 		}
 
-		fftwf_execute( m_fftPlan );
-		absspec( m_specBuf, m_absSpecBuf, FFT_BUFFER_SIZE+1 );
+		m_fftPlan.forward(m_buffer.data(), m_specBuf.data());
+		absspec( m_specBuf.data(), m_absSpecBuf, FFT_BUFFER_SIZE+1 );
 
 		compressbands( m_absSpecBuf, m_bands, FFT_BUFFER_SIZE+1,
 					   MAX_BANDS,
 					   ( int )( LOWEST_FREQ * ( FFT_BUFFER_SIZE + 1 ) / ( float )( m_sampleRate / 2 ) ),
 					   ( int )( HIGHEST_FREQ * ( FFT_BUFFER_SIZE +  1) / ( float )( m_sampleRate / 2 ) ) );
-		m_energy = maximum( m_bands, MAX_BANDS ) / maximum( m_buffer, FFT_BUFFER_SIZE );
+		m_energy = maximum( m_bands, MAX_BANDS ) / maximum( m_buffer.data(), FFT_BUFFER_SIZE );
 
 		m_framesFilledUp = 0;
 		m_inProgress = false;
@@ -175,7 +168,7 @@ void EqAnalyser::clear()
 {
 	m_framesFilledUp = 0;
 	m_energy = 0;
-	memset( m_buffer, 0, sizeof( m_buffer ) );
+	std::fill(m_buffer.begin(), m_buffer.end(), 0.f);
 	memset( m_bands, 0, sizeof( m_bands ) );
 }
 
@@ -26,6 +26,7 @@
 #include <QPainterPath>
 #include <QWidget>
 
+#include "FFTPlanCache.h"
 #include "fft_helpers.h"
 #include "LmmsTypes.h"
 
@@ -39,7 +40,7 @@ class EqAnalyser
 {
 public:
 	EqAnalyser();
-	virtual ~EqAnalyser();
+	virtual ~EqAnalyser() = default;
 
 	float m_bands[MAX_BANDS];
 	bool getInProgress();
@@ -54,10 +55,10 @@ public:
 	void setActive(bool active);
 
 private:
-	fftwf_plan m_fftPlan;
-	fftwf_complex * m_specBuf;
+	FFTPlan m_fftPlan;
+	FFTBuffer<fftwf_complex> m_specBuf;
 	float m_absSpecBuf[FFT_BUFFER_SIZE+1];
-	float m_buffer[FFT_BUFFER_SIZE*2];
+	FFTBuffer<float> m_buffer;
 	int m_framesFilledUp;
 	float m_energy;
 	int m_sampleRate;
@@ -24,12 +24,16 @@
  */
 
 
-#include <QVarLengthArray>
+#include <QDebug>
+#include <QElapsedTimer>
 #include <QMessageBox>
 
+#include <algorithm>
+
 #include "LadspaEffect.h"
 #include "DataFile.h"
 #include "AudioEngine.h"
+#include "EffectChain.h"
 #include "Ladspa2LMMS.h"
 #include "LadspaBase.h"
 #include "LadspaControl.h"
@@ -110,10 +114,13 @@ void LadspaEffect::changeSampleRate()
 	LadspaControls * controls = m_controls;
 	m_controls = nullptr;
 
-	m_pluginMutex.lock();
-	pluginDestruction();
-	pluginInstantiation();
-	m_pluginMutex.unlock();
+	{
+		// processImpl() does not lock, so keep the audio threads out while
+		// the plugin is replaced
+		const auto guard = Engine::audioEngine()->requestChangesGuard();
+		pluginDestruction();
+		pluginInstantiation();
+	}
 
 	controls->effectModelChanged( m_controls );
 	delete controls;
@@ -130,29 +137,35 @@ void LadspaEffect::changeSampleRate()
 
 Effect::ProcessStatus LadspaEffect::processImpl(SampleFrame* buf, const fpp_t frames)
 {
-	m_pluginMutex.lock();
 	if (!isOkay() || dontRun() || !isEnabled() || !isRunning())
 	{
-		m_pluginMutex.unlock();
 		return ProcessStatus::Sleep;
 	}
 
-	auto outFrames = frames;
-	SampleFrame* outBuf = nullptr;
-	QVarLengthArray<SampleFrame> sBuf(frames);
+	// run the plugin at the highest sample rate it supports
+	SampleFrame* pluginBuf = buf;
+	f_cnt_t pluginFrames = frames;
+	if (m_downsampler)
+	{
+		pluginBuf = m_resampleBuffer.data();
+		pluginFrames = m_downsampler->process(buf, frames, pluginBuf);
+	}
 
-	if( m_maxSampleRate < Engine::audioEngine()->outputSampleRate() )
+	// shared with the other effects of the chain, one buffer per channel
+	Q_ASSERT(effectChain() != nullptr);
+	EffectChain::PlanarBuffers& inputs = effectChain()->planarInput();
+	for (fpp_t frame = 0; frame < pluginFrames; ++frame)
 	{
-		outBuf = buf;
-		buf = sBuf.data();
-		sampleDown(outBuf, buf, m_maxSampleRate);
-		outFrames = frames * m_maxSampleRate /
-				Engine::audioEngine()->outputSampleRate();
+		inputs[0][frame] = pluginBuf[frame][0];
+		inputs[1][frame] = pluginBuf[frame][1];
 	}
 
-	// Copy the LMMS audio buffer to the LADSPA input buffer and initialize
-	// the control ports.
-	ch_cnt_t channel = 0;
+	// Connect the audio ports to the planar buffers and initialize the
+	// control ports. Unless forbidden, each output shares the buffer with
+	// the input of the same channel.
+	EffectChain::PlanarBuffers& outputs = m_inPlaceBroken ? effectChain()->planarOutput() : inputs;
+	ch_cnt_t inChannel = 0;
+	ch_cnt_t outChannel = 0;
 	for( ch_cnt_t proc = 0; proc < processorCount(); ++proc )
 	{
 		for( int port = 0; port < m_portCount; ++port )
@@ -161,18 +174,17 @@ Effect::ProcessStatus LadspaEffect::processImpl(SampleFrame* buf, const fpp_t fr
 			switch( pp->rate )
 			{
 				case BufferRate::ChannelIn:
-					for (fpp_t frame = 0; frame < outFrames; ++frame)
-					{
-						pp->buffer[frame] = buf[frame][channel];
-					}
-					++channel;
+					(m_descriptor->connect_port)(m_handles[proc], pp->port_id, inputs[inChannel++].data());
+					break;
+				case BufferRate::ChannelOut:
+					(m_descriptor->connect_port)(m_handles[proc], pp->port_id, outputs[outChannel++].data());
 					break;
 				case BufferRate::AudioRateInput:
 				{
 					ValueBuffer * vb = pp->control->valueBuffer();
 					if( vb )
 					{
-						memcpy(pp->buffer, vb->values(), outFrames * sizeof(float));
+						memcpy(pp->buffer, vb->values(), pluginFrames * sizeof(float));
 					}
 					else
 					{
@@ -181,7 +193,7 @@ Effect::ProcessStatus LadspaEffect::processImpl(SampleFrame* buf, const fpp_t fr
 						// This only supports control rate ports, so the audio rates are
 						// treated as though they were control rate by setting the
 						// port buffer to all the same value.
-						for (fpp_t frame = 0; frame < outFrames; ++frame)
+						for (fpp_t frame = 0; frame < pluginFrames; ++frame)
 						{
 							pp->buffer[frame] = pp->value;
 						}
@@ -198,7 +210,6 @@ Effect::ProcessStatus LadspaEffect::processImpl(SampleFrame* buf, const fpp_t fr
 					pp->buffer[0] =
 						pp->value;
 					break;
-				case BufferRate::ChannelOut:
 				case BufferRate::AudioRateOutput:
 				case BufferRate::ControlRateOutput:
 					break;
@@ -212,53 +223,46 @@ Effect::ProcessStatus LadspaEffect::processImpl(SampleFrame* buf, const fpp_t fr
 	// Process the buffers.
 	for( ch_cnt_t proc = 0; proc < processorCount(); ++proc )
 	{
-		(m_descriptor->run)(m_handles[proc], outFrames);
+		(m_descriptor->run)(m_handles[proc], pluginFrames);
 	}
 
-	// Copy the LADSPA output buffers to the LMMS buffer.
-	channel = 0;
+	// Mix the outputs into the LMMS buffer.
 	const float d = dryLevel();
 	const float w = wetLevel();
-	for( ch_cnt_t proc = 0; proc < processorCount(); ++proc )
+	for (ch_cnt_t channel = 0; channel < outChannel; ++channel)
 	{
-		for( int port = 0; port < m_portCount; ++port )
+		for (fpp_t frame = 0; frame < pluginFrames; ++frame)
 		{
-			port_desc_t * pp = m_ports.at( proc ).at( port );
-			switch( pp->rate )
-			{
-				case BufferRate::ChannelIn:
-				case BufferRate::AudioRateInput:
-				case BufferRate::ControlRateInput:
-					break;
-				case BufferRate::ChannelOut:
-					for (fpp_t frame = 0; frame < outFrames; ++frame)
-					{
-						buf[frame][channel] = d * buf[frame][channel] + w * pp->buffer[frame];
-					}
-					++channel;
-					break;
-				case BufferRate::AudioRateOutput:
-				case BufferRate::ControlRateOutput:
-					break;
-				default:
-					break;
-			}
+			pluginBuf[frame][channel] = d * pluginBuf[frame][channel] + w * outputs[channel][frame];
 		}
 	}
 
-	if (outBuf != nullptr)
+	if (m_upsampler)
 	{
-		sampleBack(buf, outBuf, m_maxSampleRate);
+		// the number of frames coming back varies a bit from period to
+		// period, the backlog from pluginInstantiation() evens this out
+		m_backlogFrames += m_upsampler->process(pluginBuf, pluginFrames, m_backlog.data() + m_backlogFrames);
+		const auto available = std::min<f_cnt_t>(frames, m_backlogFrames);
+		std::copy_n(m_backlog.begin(), available, buf);
+		std::fill(buf + available, buf + frames, SampleFrame{});
+		m_backlogFrames -= available;
+		std::copy_n(m_backlog.begin() + available, m_backlogFrames, m_backlog.begin());
 	}
 
-	m_pluginMutex.unlock();
-
 	return ProcessStatus::ContinueIfNotQuiet;
 }
 
 
 
 
+f_cnt_t LadspaEffect::latency() const
+{
+	return m_resamplingLatency;
+}
+
+
+
+
 void LadspaEffect::setControl( int _control, LADSPA_Data _value )
 {
 	if( !isOkay() )
@@ -275,6 +279,24 @@ void LadspaEffect::pluginInstantiation()
 {
 	m_maxSampleRate = maxSamplerate( displayName() );
 
+	const sample_rate_t engineRate = Engine::audioEngine()->outputSampleRate();
+	if (m_maxSampleRate < engineRate)
+	{
+		const fpp_t frames = Engine::audioEngine()->framesPerPeriod();
+		m_downsampler = std::make_unique<PolyphaseResampler>(engineRate, m_maxSampleRate);
+		m_upsampler = std::make_unique<PolyphaseResampler>(m_maxSampleRate, engineRate);
+		m_resampleBuffer.resize(m_downsampler->maxOutputFrames(frames));
+
+		// The resamplers can fall behind the input by a few frames within a
+		// period, and catch up in the next. Start with a small backlog, so
+		// there is always a full period to return.
+		const f_cnt_t backlog = engineRate / m_maxSampleRate + 2;
+		m_backlog.assign(2 * (backlog + m_upsampler->maxOutputFrames(m_resampleBuffer.size())), SampleFrame{});
+		m_backlogFrames = backlog;
+		m_resamplingLatency = backlog + m_upsampler->latency()
+			+ m_downsampler->latency() * engineRate / m_maxSampleRate;
+	}
+
 	Ladspa2LMMS * manager = Engine::getLADSPAManager();
 
 	// Calculate how many processing units are needed.
@@ -287,11 +309,6 @@ void LadspaEffect::pluginInstantiation()
 	// Categorize the ports, and create the buffers.
 	m_portCount = manager->getPortCount( m_key );
 
-	int inputch = 0;
-	int outputch = 0;
-	std::array<LADSPA_Data*, 2> inbuf;
-	inbuf[0] = nullptr;
-	inbuf[1] = nullptr;
 	for( ch_cnt_t proc = 0; proc < processorCount(); proc++ )
 	{
 		multi_proc_t ports;
@@ -308,28 +325,16 @@ void LadspaEffect::pluginInstantiation()
 			// Determine the port's category.
 			if( manager->isPortAudio( m_key, port ) )
 			{
+				// channel ports get connected to planar buffers before each run
 				if( p->name.toUpper().contains( "IN" ) &&
 					manager->isPortInput( m_key, port ) )
 				{
 					p->rate = BufferRate::ChannelIn;
-					p->buffer = new LADSPA_Data[Engine::audioEngine()->framesPerPeriod()];
-					inbuf[ inputch ] = p->buffer;
-					inputch++;
 				}
 				else if( p->name.toUpper().contains( "OUT" ) &&
 					manager->isPortOutput( m_key, port ) )
 				{
 					p->rate = BufferRate::ChannelOut;
-					if( ! m_inPlaceBroken && inbuf[ outputch ] )
-					{
-						p->buffer = inbuf[ outputch ];
-						outputch++;
-					}
-					else
-					{
-						p->buffer = new LADSPA_Data[Engine::audioEngine()->framesPerPeriod()];
-						m_inPlaceBroken = true;
-					}
 				}
 				else if( manager->isPortInput( m_key, port ) )
 				{
@@ -462,6 +467,8 @@ void LadspaEffect::pluginInstantiation()
 	}
 
 	// Instantiate the processing units.
+	QElapsedTimer timer;
+	timer.start();
 	m_descriptor = manager->getDescriptor( m_key );
 	if( m_descriptor == nullptr )
 	{
@@ -518,6 +525,7 @@ void LadspaEffect::pluginInstantiation()
 	{
 		manager->activate( m_key, m_handles[proc] );
 	}
+	qDebug() << "Instantiated" << m_key.second << "in" << timer.elapsed() << "ms";
 	m_controls = new LadspaControls( this );
 }
 
@@ -541,10 +549,7 @@ void LadspaEffect::pluginDestruction()
 		for( int port = 0; port < m_portCount; port++ )
 		{
 			port_desc_t * pp = m_ports.at( proc ).at( port );
-			if( m_inPlaceBroken || pp->rate != BufferRate::ChannelOut )
-			{
-				if( pp->buffer) delete[] pp->buffer;
-			}
+			delete[] pp->buffer;
 			delete pp;
 		}
 		m_ports[proc].clear();
@@ -552,6 +557,10 @@ void LadspaEffect::pluginDestruction()
 	m_ports.clear();
 	m_handles.clear();
 	m_portControls.clear();
+
+	m_downsampler.reset();
+	m_upsampler.reset();
+	m_resamplingLatency = 0;
 }
 
 
@@ -572,7 +581,7 @@ sample_rate_t LadspaEffect::maxSamplerate( const QString & _name )
 	}
 	if( __buggy_plugins.contains( _name ) )
 	{
-		return( __buggy_plugins[_name] );
+		return std::min(__buggy_plugins[_name], Engine::audioEngine()->outputSampleRate());
 	}
 	return( Engine::audioEngine()->outputSampleRate() );
 }
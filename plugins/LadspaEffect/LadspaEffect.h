@@ -26,12 +26,14 @@
 #ifndef _LADSPA_EFFECT_H
 #define _LADSPA_EFFECT_H
 
-#include <QMutex>
+#include <memory>
+#include <vector>
 
 #include "Effect.h"
 #include "ladspa.h"
 #include "LadspaControls.h"
 #include "LadspaManager.h"
+#include "PolyphaseResampler.h"
 
 namespace lmms
 {
@@ -48,6 +50,7 @@ public:
 	~LadspaEffect() override;
 
 	ProcessStatus processImpl(SampleFrame* buf, const fpp_t frames) override;
+	f_cnt_t latency() const override;
 
 	void setControl( int _control, LADSPA_Data _data );
 
@@ -77,7 +80,6 @@ private:
 	static sample_rate_t maxSamplerate( const QString & _name );
 
 
-	QMutex m_pluginMutex;
 	LadspaControls * m_controls;
 
 	sample_rate_t m_maxSampleRate;
@@ -92,6 +94,13 @@ private:
 	multi_proc_t m_portControls;
 
 	ch_cnt_t m_processors = 1;
+
+	// only used if the plugin can not run at the engine's sample rate
+	std::unique_ptr<PolyphaseResampler> m_downsampler, m_upsampler;
+	std::vector<SampleFrame> m_resampleBuffer; //!< the input at the plugin's sample rate
+	std::vector<SampleFrame> m_backlog; //!< output at the engine's rate, not yet returned
+	f_cnt_t m_backlogFrames = 0;
+	f_cnt_t m_resamplingLatency = 0;
 };
 
 
@@ -44,6 +44,8 @@ public:
 
 	ProcessStatus processImpl(SampleFrame* buf, const fpp_t frames) override;
 
+	f_cnt_t latency() const override { return m_controls.latency(); }
+
 	EffectControls* controls() override { return &m_controls; }
 
 	Lv2FxControls* lv2Controls() { return &m_controls; }
@@ -51,7 +53,6 @@ public:
 
 private:
 	Lv2FxControls m_controls;
-	std::vector<SampleFrame> m_tmpOutputSmps;
 };
 
 
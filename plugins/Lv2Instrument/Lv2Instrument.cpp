@@ -191,10 +191,14 @@ void Lv2Instrument::play(SampleFrame* buf)
 
 	fpp_t fpp = Engine::audioEngine()->framesPerPeriod();
 
-	run(fpp);
+	const auto out = runPlanar(nullptr, fpp);
 
 	copyModelsToLmms();
-	copyBuffersToLmms(buf, fpp);
+	for (fpp_t f = 0; f < fpp; ++f)
+	{
+		buf[f][0] = out[0][f];
+		buf[f][1] = out[1][f];
+	}
 }
 
 
@@ -74,6 +74,7 @@ public:
 		realtime funcs
 	*/
 	bool hasNoteInput() const override { return Lv2ControlBase::hasNoteInput(); }
+	f_cnt_t latency() const override { return Lv2ControlBase::latency(); }
 #ifdef LV2_INSTRUMENT_USE_MIDI
 	bool handleMidiEvent(const MidiEvent &event,
 		const TimePos &time = TimePos(), f_cnt_t offset = 0) override;
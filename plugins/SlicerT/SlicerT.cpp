@@ -26,9 +26,9 @@
 
 #include <QDomElement>
 #include <cmath>
-#include <fftw3.h>
 
 #include "Engine.h"
+#include "FFTPlanCache.h"
 #include "InstrumentTrack.h"
 #include "PathUtil.h"
 #include "SampleLoader.h"
@@ -192,10 +192,9 @@ void SlicerT::findSlices()
 	}
 
 	std::vector<float> prevMags(windowSize / 2, 0);
-	std::vector<float> fftIn(windowSize, 0);
-	std::array<fftwf_complex, windowSize> fftOut;
-
-	fftwf_plan fftPlan = fftwf_plan_dft_r2c_1d(windowSize, fftIn.data(), fftOut.data(), FFTW_MEASURE);
+	auto fftIn = FFTBuffer<float>(windowSize);
+	auto fftOut = FFTBuffer<fftwf_complex>(windowSize / 2 + 1);
+	const FFTPlan fftPlan = FFTPlanCache::instance().plan(windowSize, FFTPlanCache::Direction::Forward);
 
 	int lastPoint = -minDist - 1; // to always store 0 first
 	float spectralFlux = 0;
@@ -205,7 +204,7 @@ void SlicerT::findSlices()
 	{
 		// fft
 		std::copy_n(singleChannel.data() + i, windowSize, fftIn.data());
-		fftwf_execute(fftPlan);
+		fftPlan.forward(fftIn.data(), fftOut.data());
 
 		// calculate spectral flux in regard to last window
 		for (int j = 0; j < windowSize / 2; j++) // only use niquistic frequencies
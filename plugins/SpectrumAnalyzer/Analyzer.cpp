@@ -35,6 +35,7 @@
 #include "embed.h"
 #include "LmmsTypes.h"
 #include "plugin_export.h"
+#include "SaAnalysisPool.h"
 
 namespace lmms
 {
@@ -59,21 +60,16 @@ extern "C" {
 Analyzer::Analyzer(Model *parent, const Plugin::Descriptor::SubPluginFeatures::Key *key) :
 	Effect(&analyzer_plugin_descriptor, parent, key),
 	m_processor(&m_controls),
-	m_controls(this),
-	m_processorThread(m_processor, m_inputBuffer),
-	// Buffer is sized to cover 4* the current maximum LMMS audio buffer size,
-	// so that it has some reserve space in case data processor is busy.
-	m_inputBuffer(4 * m_maxBufferSize)
+	m_controls(this)
 {
-	m_processorThread.start();
+	SaAnalysisPool::instance().addProcessor(&m_processor);
 }
 
 
 Analyzer::~Analyzer()
 {
-	m_processor.terminate();
-	m_inputBuffer.wakeAll();
-	m_processorThread.wait();
+	// the processor uses the controls, so stop the analysis before they are gone
+	SaAnalysisPool::instance().removeProcessor(&m_processor);
 }
 
 // Take audio data and pass them to the spectrum processor.
@@ -95,8 +91,8 @@ Effect::ProcessStatus Analyzer::processImpl(SampleFrame* buf, const fpp_t frames
 	if (m_controls.isViewVisible())
 	{
 		// To avoid processing spikes on audio thread, data are stored in
-		// a lockless ringbuffer and processed in a separate thread.
-		m_inputBuffer.write(buf, frames, true);
+		// a lockless ringbuffer and processed by the shared analysis pool.
+		m_processor.write(buf, frames);
 	}
 	#ifdef SA_DEBUG
 		audio_time = std::chrono::high_resolution_clock::now().time_since_epoch().count() - audio_time;
@@ -28,9 +28,7 @@
 #define ANALYZER_H
 
 
-#include "DataprocLauncher.h"
 #include "Effect.h"
-#include "LocklessRingBuffer.h"
 #include "SaControls.h"
 #include "SaProcessor.h"
 
@@ -55,17 +53,6 @@ private:
 	SaProcessor m_processor;
 	SaControls m_controls;
 
-	// Maximum LMMS buffer size (hard coded, the actual constant is hard to get)
-	const unsigned int m_maxBufferSize = 4096;
-
-	// QThread::create() workaround
-	// Replace DataprocLauncher by QThread and replace initializer in constructor
-	// with the following commented line when LMMS CI starts using Qt > 5.9
-	//m_processorThread = QThread::create([=]{m_processor.analyze(m_inputBuffer);});
-	DataprocLauncher m_processorThread;
-
-	LocklessRingBuffer<SampleFrame> m_inputBuffer;
-
 	#ifdef SA_DEBUG
 		int m_last_dump_time;
 		int m_dump_count;
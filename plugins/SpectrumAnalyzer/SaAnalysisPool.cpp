@@ -0,0 +1,122 @@
+/*
+ * SaAnalysisPool.cpp - threads shared by all spectrum analyzers
+ *
+ * Copyright (c) 2026 LMMS Developers
+ *
+ * This file is part of LMMS - https://lmms.io
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public
+ * License along with this program (see COPYING); if not, write to the
+ * Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA 02110-1301 USA.
+ *
+ */
+
+#include "SaAnalysisPool.h"
+
+#include <algorithm>
+#include <QThread>
+
+#include "SaProcessor.h"
+
+namespace lmms
+{
+
+
+SaAnalysisPool& SaAnalysisPool::instance()
+{
+	// a single analysis rarely takes more than a few percent of one core
+	static auto s_pool = SaAnalysisPool{std::clamp(QThread::idealThreadCount() / 2, 1, 4)};
+	return s_pool;
+}
+
+
+SaAnalysisPool::SaAnalysisPool(std::size_t numThreads) :
+	m_sem(0)
+{
+	for (std::size_t i = 0; i < numThreads; ++i)
+	{
+		m_threads.emplace_back(QThread::create([this] { threadFunc(); }));
+		// the display may lag behind a bit, the audio and GUI threads must not. LowPriority does nothing
+		// under SCHED_OTHER on Linux, IdlePriority uses SCHED_IDLE there.
+		m_threads.back()->start(QThread::IdlePriority);
+	}
+}
+
+
+SaAnalysisPool::~SaAnalysisPool()
+{
+	m_exit = true;
+	for (std::size_t i = 0; i < m_threads.size(); ++i) { m_sem.post(); }
+	for (auto& thread : m_threads) { thread->wait(); }
+}
+
+
+void SaAnalysisPool::addProcessor(SaProcessor* processor)
+{
+	const auto lock = std::lock_guard{m_processorsMutex};
+	m_processors.push_back(processor);
+}
+
+
+void SaAnalysisPool::removeProcessor(SaProcessor* processor)
+{
+	{
+		const auto lock = std::lock_guard{m_processorsMutex};
+		m_processors.erase(std::find(m_processors.begin(), m_processors.end(), processor));
+	}
+	// wait for a pool thread that is still analyzing our data
+	while (processor->m_busy) { QThread::yieldCurrentThread(); }
+}
+
+
+SaProcessor* SaAnalysisPool::claimPendingProcessor(std::size_t& next)
+{
+	const auto lock = std::lock_guard{m_processorsMutex};
+	const std::size_t count = m_processors.size();
+	for (std::size_t i = 0; i < count; ++i)
+	{
+		const std::size_t index = (next + i) % count;
+		SaProcessor* processor = m_processors[index];
+		// only one thread may read the input of a processor
+		// claiming it under the lock makes removeProcessor() wait for us
+		if (processor->m_dataPending && !processor->m_busy.exchange(true))
+		{
+			next = index + 1;
+			return processor;
+		}
+	}
+	return nullptr;
+}
+
+
+void SaAnalysisPool::threadFunc()
+{
+	while (true)
+	{
+		m_sem.wait();
+		if (m_exit) { break; }
+
+		// Scan all processors again after each one, so none is skipped if removeProcessor() shifts the list.
+		// This also picks up data that arrived while a different thread found the processor busy.
+		std::size_t next = 0;
+		while (SaProcessor* processor = claimPendingProcessor(next))
+		{
+			processor->analyze();
+			processor->m_busy = false;
+		}
+	}
+}
+
+
+} // namespace lmms
@@ -0,0 +1,80 @@
+/*
+ * SaAnalysisPool.h - threads shared by all spectrum analyzers
+ *
+ * Copyright (c) 2026 LMMS Developers
+ *
+ * This file is part of LMMS - https://lmms.io
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public
+ * License along with this program (see COPYING); if not, write to the
+ * Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA 02110-1301 USA.
+ *
+ */
+
+#ifndef SAANALYSISPOOL_H
+#define SAANALYSISPOOL_H
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "LmmsSemaphore.h"
+
+class QThread;
+
+namespace lmms
+{
+
+class SaProcessor;
+
+
+/**
+	Small set of idle priority threads running the analysis of all spectrum analyzers
+
+	Analyzers only need CPU time while their window is open, so a few shared
+	threads scale better than one thread per analyzer. The audio thread
+	notifies the pool when it queued new data for a processor.
+*/
+class SaAnalysisPool
+{
+public:
+	static SaAnalysisPool& instance();
+
+	void addProcessor(SaProcessor* processor);
+	//! Blocks until no pool thread is analyzing data of @p processor
+	void removeProcessor(SaProcessor* processor);
+	//! Wake up a thread to analyze new data. This is realtime safe.
+	void notify() { m_sem.post(); }
+
+private:
+	explicit SaAnalysisPool(std::size_t numThreads);
+	~SaAnalysisPool();
+
+	void threadFunc();
+	//! Returns a processor with new data after claiming it, or nullptr if there is none.
+	//! The scan starts at index @p next, which is advanced past the claimed processor, so busy ones take turns.
+	SaProcessor* claimPendingProcessor(std::size_t& next);
+
+	std::vector<std::unique_ptr<QThread>> m_threads;
+	std::mutex m_processorsMutex;
+	std::vector<SaProcessor*> m_processors;
+	Semaphore m_sem;
+	std::atomic<bool> m_exit = false;
+};
+
+
+} // namespace lmms
+
+#endif // SAANALYSISPOOL_H
@@ -26,10 +26,10 @@
 #include "SaProcessor.h"
 
 #include <algorithm>
+#include <chrono>
 #include "lmms_math.h"
 #include <cmath>
 #ifdef SA_DEBUG
-	#include <chrono>
 	#include <iomanip>
 	#include <iostream>
 #endif
@@ -37,7 +37,7 @@
 
 #include "fft_helpers.h"
 #include "lmms_constants.h"
-#include "LocklessRingBuffer.h"
+#include "SaAnalysisPool.h"
 #include "SaControls.h"
 
 #include <cassert>
@@ -49,7 +49,10 @@ namespace lmms
 
 SaProcessor::SaProcessor(const SaControls *controls) :
 	m_controls(controls),
-	m_terminate(false),
+	// Buffer is sized to cover 4* the current maximum LMMS audio buffer size,
+	// so that it has some reserve space in case the analysis pool is busy.
+	m_inputBuffer(4 * MaxBufferSize),
+	m_inputReader(m_inputBuffer),
 	m_inBlockSize(FFT_BLOCK_SIZES[0]),
 	m_fftBlockSize(FFT_BLOCK_SIZES[0]),
 	m_sampleRate(Engine::audioEngine()->outputSampleRate()),
@@ -64,12 +67,11 @@ SaProcessor::SaProcessor(const SaControls *controls) :
 
 	m_bufferL.resize(m_inBlockSize, 0);
 	m_bufferR.resize(m_inBlockSize, 0);
-	m_filteredBufferL.resize(m_fftBlockSize, 0);
-	m_filteredBufferR.resize(m_fftBlockSize, 0);
-	m_spectrumL = (fftwf_complex *) fftwf_malloc(binCount() * sizeof (fftwf_complex));
-	m_spectrumR = (fftwf_complex *) fftwf_malloc(binCount() * sizeof (fftwf_complex));
-	m_fftPlanL = fftwf_plan_dft_r2c_1d(m_fftBlockSize, m_filteredBufferL.data(), m_spectrumL, FFTW_MEASURE);
-	m_fftPlanR = fftwf_plan_dft_r2c_1d(m_fftBlockSize, m_filteredBufferR.data(), m_spectrumR, FFTW_MEASURE);
+	m_filteredBufferL = FFTBuffer<float>(m_fftBlockSize);
+	m_filteredBufferR = FFTBuffer<float>(m_fftBlockSize);
+	m_spectrumL = FFTBuffer<fftwf_complex>(binCount());
+	m_spectrumR = FFTBuffer<fftwf_complex>(binCount());
+	m_fftPlan = FFTPlanCache::instance().plan(m_fftBlockSize, FFTPlanCache::Direction::Forward);
 
 	m_absSpectrumL.resize(binCount(), 0);
 	m_absSpectrumR.resize(binCount(), 0);
@@ -82,36 +84,31 @@ SaProcessor::SaProcessor(const SaControls *controls) :
 }
 
 
-SaProcessor::~SaProcessor()
+// Store data from the audio thread and let the analysis pool know about them.
+void SaProcessor::write(const SampleFrame *buf, fpp_t frames)
 {
-	if (m_fftPlanL != nullptr) {fftwf_destroy_plan(m_fftPlanL);}
-	if (m_fftPlanR != nullptr) {fftwf_destroy_plan(m_fftPlanR);}
-	if (m_spectrumL != nullptr) {fftwf_free(m_spectrumL);}
-	if (m_spectrumR != nullptr) {fftwf_free(m_spectrumR);}
-
-	m_fftPlanL = nullptr;
-	m_fftPlanR = nullptr;
-	m_spectrumL = nullptr;
-	m_spectrumR = nullptr;
+	m_inputBuffer.write(buf, frames);
+	// one notification is enough for all data queued until the analysis starts
+	if (!m_dataPending.exchange(true)) {SaAnalysisPool::instance().notify();}
 }
 
 
 // Load data from audio thread ringbuffer and run FFT analysis if buffer is full enough.
-void SaProcessor::analyze(LocklessRingBuffer<SampleFrame> &ring_buffer)
+void SaProcessor::analyze()
 {
-	LocklessRingBufferReader<SampleFrame> reader(ring_buffer);
+	// Data written from now on need a new notification.
+	m_dataPending = false;
 
-	// Processing thread loop
-	while (!m_terminate)
+	const auto start_time = std::chrono::steady_clock::now();
+	std::size_t total_frames = 0;
+	while (!m_inputReader.empty())
 	{
-		// If there is nothing to read, wait for notification from the writing side.
-		if (reader.empty()) {reader.waitForData();}
-
 		// skip waterfall render if processing can't keep up with input
-		bool overload = ring_buffer.free() < ring_buffer.capacity() / 2;
+		bool overload = m_inputBuffer.free() < m_inputBuffer.capacity() / 2;
 
-		auto in_buffer = reader.read_max(ring_buffer.capacity() / 4);
+		auto in_buffer = m_inputReader.read_max(m_inputBuffer.capacity() / 4);
 		std::size_t frame_count = in_buffer.size();
+		total_frames += frame_count;
 
 		// Process received data only if any view is visible and not paused.
 		// Also, to prevent a momentary GUI freeze under high load (due to lock
@@ -176,15 +173,15 @@ void SaProcessor::analyze(LocklessRingBuffer<SampleFrame> &ring_buffer)
 
 				// Run FFT on left channel, convert the result to absolute magnitude
 				// spectrum and normalize it.
-				fftwf_execute(m_fftPlanL);
-				absspec(m_spectrumL, m_absSpectrumL.data(), binCount());
+				m_fftPlan.forward(m_filteredBufferL.data(), m_spectrumL.data());
+				absspec(m_spectrumL.data(), m_absSpectrumL.data(), binCount());
 				normalize(m_absSpectrumL, m_normSpectrumL, m_inBlockSize);
 
 				// repeat analysis for right channel if stereo processing is enabled
 				if (stereo)
 				{
-					fftwf_execute(m_fftPlanR);
-					absspec(m_spectrumR, m_absSpectrumR.data(), binCount());
+					m_fftPlan.forward(m_filteredBufferR.data(), m_spectrumR.data());
+					absspec(m_spectrumR.data(), m_absSpectrumR.data(), binCount());
 					normalize(m_absSpectrumR, m_normSpectrumR, m_inBlockSize);
 				}
 
@@ -315,7 +312,18 @@ void SaProcessor::analyze(LocklessRingBuffer<SampleFrame> &ring_buffer)
 				#endif
 			}	// frame filler and processing
 		}	// process if active
-	}	// thread loop end
+	}	// input loop end
+
+	// Report the cost as a share of the time the analyzed input takes to play.
+	m_analysisTime += std::chrono::duration<float>(std::chrono::steady_clock::now() - start_time).count();
+	m_analyzedFrames += total_frames;
+	const auto sample_rate = Engine::audioEngine()->outputSampleRate();
+	if (m_analyzedFrames >= sample_rate / 2)
+	{
+		m_analysisLoad = 100.f * m_analysisTime * sample_rate / m_analyzedFrames;
+		m_analysisTime = 0.f;
+		m_analyzedFrames = 0;
+	}
 }
 
 
@@ -378,6 +386,10 @@ void SaProcessor::reallocateBuffers()
 
 	const unsigned int new_bins = new_fft_size / 2 + 1;
 
+	// Get the plan before locking anything: a size used for the first time
+	// is planned here, while the slow measuring happens in the background.
+	const auto new_plan = FFTPlanCache::instance().plan(new_fft_size, FFTPlanCache::Direction::Forward);
+
 	// Use m_reallocating to tell analyze() to avoid asking for the lock. This
 	// is needed because under heavy load the FFT thread requests data lock so
 	// often that this routine could end up waiting even for several seconds.
@@ -389,30 +401,16 @@ void SaProcessor::reallocateBuffers()
 	QMutexLocker reloc_lock(&m_reallocationAccess);
 	QMutexLocker data_lock(&m_dataAccess);
 
-	// destroy old FFT plan and free the result buffer
-	if (m_fftPlanL != nullptr) {fftwf_destroy_plan(m_fftPlanL);}
-	if (m_fftPlanR != nullptr) {fftwf_destroy_plan(m_fftPlanR);}
-	if (m_spectrumL != nullptr) {fftwf_free(m_spectrumL);}
-	if (m_spectrumR != nullptr) {fftwf_free(m_spectrumR);}
-
-	// allocate new space, create new plan and resize containers
+	// allocate new space, switch to the new plan and resize containers
 	m_fftWindow.resize(new_in_size, 1.0);
 	precomputeWindow(m_fftWindow.data(), new_in_size, (FFTWindow) m_controls->m_windowModel.value());
 	m_bufferL.resize(new_in_size, 0);
 	m_bufferR.resize(new_in_size, 0);
-	m_filteredBufferL.resize(new_fft_size, 0);
-	m_filteredBufferR.resize(new_fft_size, 0);
-	m_spectrumL = (fftwf_complex *) fftwf_malloc(new_bins * sizeof (fftwf_complex));
-	m_spectrumR = (fftwf_complex *) fftwf_malloc(new_bins * sizeof (fftwf_complex));
-	m_fftPlanL = fftwf_plan_dft_r2c_1d(new_fft_size, m_filteredBufferL.data(), m_spectrumL, FFTW_MEASURE);
-	m_fftPlanR = fftwf_plan_dft_r2c_1d(new_fft_size, m_filteredBufferR.data(), m_spectrumR, FFTW_MEASURE);
-
-	if (m_fftPlanL == nullptr || m_fftPlanR == nullptr)
-	{
-		#ifdef SA_DEBUG
-			std::cerr << "Analyzer: failed to create new FFT plan!" << std::endl;
-		#endif
-	}
+	m_filteredBufferL = FFTBuffer<float>(new_fft_size);
+	m_filteredBufferR = FFTBuffer<float>(new_fft_size);
+	m_spectrumL = FFTBuffer<fftwf_complex>(new_bins);
+	m_spectrumR = FFTBuffer<fftwf_complex>(new_bins);
+	m_fftPlan = new_plan;
 	m_absSpectrumL.resize(new_bins, 0);
 	m_absSpectrumR.resize(new_bins, 0);
 	m_normSpectrumL.resize(new_bins, 0);
@@ -28,21 +28,20 @@
 #define SAPROCESSOR_H
 
 #include <atomic>
-#include <fftw3.h>
 #include <QMutex>
 #include <QRgb>
 #include <vector>
 
+#include "FFTPlanCache.h"
+#include "LocklessRingBuffer.h"
+#include "SampleFrame.h"
+
 
 
 namespace lmms
 {
 
-template<class T>
-class LocklessRingBuffer;
-
 class SaControls;
-class SampleFrame;
 
 
 //! Receives audio data, runs FFT analysis and stores the result.
@@ -50,11 +49,10 @@ class SaProcessor
 {
 public:
 	explicit SaProcessor(const SaControls *controls);
-	virtual ~SaProcessor();
+	virtual ~SaProcessor() = default;
 
-	// analysis thread and a method to terminate it
-	void analyze(LocklessRingBuffer<SampleFrame> &ring_buffer);
-	void terminate() {m_terminate = true;}
+	// queue audio data for the SaAnalysisPool; realtime safe
+	void write(const SampleFrame *buf, fpp_t frames);
 
 	// inform processor if any processing is actually required
 	void setSpectrumActive(bool active);
@@ -76,6 +74,7 @@ public:
 	unsigned int inBlockSize() const {return m_inBlockSize;}
 	unsigned int binCount() const;			//!< size of output (frequency domain) data block
 	bool spectrumNotEmpty();				//!< check if result buffers contain any non-zero values
+	float analysisLoad() const {return m_analysisLoad;}	//!< share of one CPU core used by the analysis, in %
 
 	unsigned int waterfallWidth() const;	//!< binCount value capped at 3840 (for display)
 	unsigned int waterfallHeight() const {return m_waterfallHeight;}
@@ -112,10 +111,26 @@ public:
 
 
 private:
+	friend class SaAnalysisPool;
+
+	// analyze all queued input; called by a SaAnalysisPool thread
+	void analyze();
+
 	const SaControls *m_controls;
 
-	// thread communication and control
-	bool m_terminate;
+	// Maximum LMMS buffer size (hard coded, the actual constant is hard to get)
+	static constexpr unsigned int MaxBufferSize = 4096;
+
+	// input queue and communication with the SaAnalysisPool
+	LocklessRingBuffer<SampleFrame> m_inputBuffer;
+	LocklessRingBufferReader<SampleFrame> m_inputReader;
+	std::atomic<bool> m_dataPending = false;	//!< new input arrived since the last analysis started
+	std::atomic<bool> m_busy = false;			//!< a pool thread is analyzing the input
+
+	// cost of the analysis, measured over roughly half a second of input
+	float m_analysisTime = 0.f;				//!< seconds spent since the last report
+	std::size_t m_analyzedFrames = 0;		//!< input frames analyzed since the last report
+	std::atomic<float> m_analysisLoad = 0.f;
 
 	// currently valid configuration
 	unsigned int m_zeroPadFactor = 2;		//!< use n-steps bigger FFT for given block size
@@ -128,12 +143,11 @@ private:
 	std::vector<float> m_bufferL;			//!< time domain samples (left)
 	std::vector<float> m_bufferR;			//!< time domain samples (right)
 	std::vector<float> m_fftWindow;			//!< precomputed window function coefficients
-	std::vector<float> m_filteredBufferL;	//!< time domain samples with window function applied (left)
-	std::vector<float> m_filteredBufferR;	//!< time domain samples with window function applied (right)
-	fftwf_plan m_fftPlanL;
-	fftwf_plan m_fftPlanR;
-	fftwf_complex *m_spectrumL;				//!< frequency domain samples (complex) (left)
-	fftwf_complex *m_spectrumR;				//!< frequency domain samples (complex) (right)
+	FFTBuffer<float> m_filteredBufferL;		//!< time domain samples with window function applied (left)
+	FFTBuffer<float> m_filteredBufferR;		//!< time domain samples with window function applied (right)
+	FFTPlan m_fftPlan;						//!< shared plan for both channels
+	FFTBuffer<fftwf_complex> m_spectrumL;	//!< frequency domain samples (complex) (left)
+	FFTBuffer<fftwf_complex> m_spectrumR;	//!< frequency domain samples (complex) (right)
 	std::vector<float> m_absSpectrumL;		//!< frequency domain samples (absolute) (left)
 	std::vector<float> m_absSpectrumR;		//!< frequency domain samples (absolute) (right)
 	std::vector<float> m_normSpectrumL;		//!< frequency domain samples (normalized) (left)
@@ -148,10 +162,10 @@ private:
 	const unsigned int m_waterfallMaxWidth = 3840;
 
 	// book keeping
-	bool m_spectrumActive;
-	bool m_waterfallActive;
+	std::atomic<bool> m_spectrumActive;
+	std::atomic<bool> m_waterfallActive;
 	std::atomic<unsigned int> m_waterfallNotEmpty;	//!< number of lines remaining visible on display
-	bool m_reallocating;
+	std::atomic<bool> m_reallocating;
 
 	// merge L and R channels and apply gamma correction to make a spectrogram pixel
 	QRgb makePixel(float left, float right) const;
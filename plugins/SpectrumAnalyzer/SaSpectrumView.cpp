@@ -59,7 +59,8 @@ SaSpectrumView::SaSpectrumView(SaControls *controls, SaProcessor *processor, QWi
 	m_cachedLogX(true),
 	m_cachedDisplayWidth(0),
 	m_cachedBinCount(0),
-	m_cachedSampleRate(0)
+	m_cachedSampleRate(0),
+	m_shownAnalysisLoad(-1)
 {
 	setMinimumSize(360, 170);
 	setSizePolicy(QSizePolicy::Minimum, QSizePolicy::Minimum);
@@ -813,6 +814,13 @@ void SaSpectrumView::periodicUpdate()
 {
 	// check if the widget is visible; if it is not, processing can be paused
 	m_processor->setSpectrumActive(isVisible());
+	// report the cost of this analyzer; only update the tooltip if it changed
+	const int load = static_cast<int>(m_processor->analysisLoad() * 10.f + 0.5f);
+	if (load != m_shownAnalysisLoad)
+	{
+		m_shownAnalysisLoad = load;
+		setToolTip(tr("Analysis CPU load: %1 %").arg(load / 10.f, 0, 'f', 1));
+	}
 	// tell Qt it is time for repaint
 	update();
 }
@@ -137,6 +137,9 @@ private:
 	unsigned int m_cachedBinCount;
 	unsigned int m_cachedSampleRate;
 
+	// analysis cost shown in the tooltip, in tenths of a percent
+	int m_shownAnalysisLoad;
+
 	#ifdef SA_DEBUG
 		float m_execution_avg;
 		float m_refresh_avg;
@@ -30,6 +30,7 @@
 #include "AudioEngine.h"
 #include "AutomatableButton.h"
 #include "Engine.h"
+#include "InstrumentPlayHandle.h"
 #include "InstrumentTrack.h"
 #include "Knob.h"
 #include "NotePlayHandle.h"
@@ -213,7 +214,7 @@ void OscillatorObject::updateUseWaveTable()
 
 
 TripleOscillator::TripleOscillator( InstrumentTrack * _instrument_track ) :
-	Instrument( _instrument_track, &tripleoscillator_plugin_descriptor )
+	Instrument(_instrument_track, &tripleoscillator_plugin_descriptor, nullptr, Flag::IsVoiceBatched)
 {
 	for( int i = 0; i < NUM_OF_OSCILLATORS; ++i )
 	{
@@ -223,6 +224,20 @@ TripleOscillator::TripleOscillator( InstrumentTrack * _instrument_track ) :
 
 	connect( Engine::audioEngine(), SIGNAL( sampleRateChanged() ),
 			this, SLOT( updateAllDetuning() ) );
+
+	// all notes are rendered in the job of this play handle, see Instrument::Flag::IsVoiceBatched
+	auto iph = new InstrumentPlayHandle(this, _instrument_track);
+	Engine::audioEngine()->addPlayHandle( iph );
+}
+
+
+
+
+TripleOscillator::~TripleOscillator()
+{
+	Engine::audioEngine()->removePlayHandlesOfTypes( instrumentTrack(),
+				PlayHandle::Type::NotePlayHandle
+				| PlayHandle::Type::InstrumentPlayHandle );
 }
 
 
@@ -374,8 +389,11 @@ void TripleOscillator::playNote( NotePlayHandle * _n,
 	const fpp_t frames = _n->framesLeftForCurrentPeriod();
 	const f_cnt_t offset = _n->noteOffset();
 
-	osc_l->update( _working_buffer + offset, frames, 0 );
-	osc_r->update( _working_buffer + offset, frames, 1 );
+	// TODO: Render all notes with one OscillatorBank per oscillator and channel. This needs a hook that
+	// lets the InstrumentPlayHandle render every note before their sound shaping, and only pays off
+	// when the banks beat separate oscillators (see BenchmarkBank in OscillatorTest) for the wave shapes
+	// and modulation algorithms in use.
+	Oscillator::updateStereo(osc_l, osc_r, _working_buffer + offset, frames);
 
 	applyFadeIn(_working_buffer, _n);
 	applyRelease( _working_buffer, _n );
@@ -108,7 +108,7 @@ class TripleOscillator : public Instrument
 	Q_OBJECT
 public:
 	TripleOscillator( InstrumentTrack * _track );
-	~TripleOscillator() override = default;
+	~TripleOscillator() override;
 
 	void playNote( NotePlayHandle * _n,
 						SampleFrame* _working_buffer ) override;
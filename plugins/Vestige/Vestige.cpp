@@ -410,6 +410,7 @@ void VestigeInstrument::play( SampleFrame* _buf )
 	}
 
 	m_plugin->process( nullptr, _buf );
+	m_latency = m_plugin->latency();
 
 	m_pluginMutex.unlock();
 }
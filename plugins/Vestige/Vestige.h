@@ -62,6 +62,11 @@ public:
 
 	virtual void play( SampleFrame* _working_buffer );
 
+	virtual f_cnt_t latency() const
+	{
+		return m_latency;
+	}
+
 	virtual void saveSettings( QDomDocument & _doc, QDomElement & _parent );
 	virtual void loadSettings( const QDomElement & _this );
 
@@ -84,6 +89,8 @@ private:
 
 	VstPlugin * m_plugin;
 	QMutex m_pluginMutex;
+	// latency of m_plugin, updated while holding m_pluginMutex in play()
+	f_cnt_t m_latency = 0;
 
 	QString m_pluginDLL;
 	QMdiSubWindow * m_subWindow;
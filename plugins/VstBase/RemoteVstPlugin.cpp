@@ -2238,10 +2238,13 @@ void * RemoteVstPlugin::processingThread(void * _param)
 	while( ( m = _this->receiveMessage() ).id != IdQuit )
 	{
 		
+		// Transport changes must be handled before the next message is received
 		if( m.id == IdStartProcessing
 			|| m.id == IdMidiEvent
 			|| m.id == IdVstSetParameter
-			|| m.id == IdVstSetTempo)
+			|| m.id == IdVstSetTempo
+			|| m.id == IdChangeTransport
+			|| m.id == IdTransportChanged)
 		{
 			_this->processMessage( m );
 		}
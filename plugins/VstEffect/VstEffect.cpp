@@ -88,6 +88,7 @@ Effect::ProcessStatus VstEffect::processImpl(SampleFrame* buf, const fpp_t frame
 	if (m_pluginMutex.tryLock(Engine::getSong()->isExporting() ? -1 : 0))
 	{
 		m_plugin->process(tempBuf.data(), tempBuf.data());
+		m_latency = m_plugin->latency();
 		m_pluginMutex.unlock();
 	}
 
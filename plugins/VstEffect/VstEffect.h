@@ -47,6 +47,8 @@ public:
 
 	ProcessStatus processImpl(SampleFrame* buf, const fpp_t frames) override;
 
+	f_cnt_t latency() const override { return m_latency; }
+
 	EffectControls * controls() override
 	{
 		return &m_vstControls;
@@ -60,6 +62,8 @@ private:
 
 	QSharedPointer<VstPlugin> m_plugin;
 	QMutex m_pluginMutex;
+	//! Latency of m_plugin, updated while holding m_pluginMutex in processImpl()
+	f_cnt_t m_latency = 0;
 	EffectKey m_key;
 
 	VstEffectControls m_vstControls;
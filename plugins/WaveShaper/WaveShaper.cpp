@@ -27,6 +27,8 @@
 #include "WaveShaper.h"
 #include "lmms_math.h"
 #include "embed.h"
+#include "AudioEngine.h"
+#include "Engine.h"
 
 #include "plugin_export.h"
 
@@ -58,7 +60,8 @@ Plugin::Descriptor PLUGIN_EXPORT waveshaper_plugin_descriptor =
 WaveShaperEffect::WaveShaperEffect( Model * _parent,
 			const Descriptor::SubPluginFeatures::Key * _key ) :
 	Effect( &waveshaper_plugin_descriptor, _parent, _key ),
-	m_wsControls( this )
+	m_wsControls( this ),
+	m_oversampler( Engine::audioEngine()->framesPerPeriod() )
 {
 }
 
@@ -68,8 +71,6 @@ WaveShaperEffect::WaveShaperEffect( Model * _parent,
 Effect::ProcessStatus WaveShaperEffect::processImpl(SampleFrame* buf, const fpp_t frames)
 {
 // variables for effect
-	int i = 0;
-
 	const float d = dryLevel();
 	const float w = wetLevel();
 	float input = m_wsControls.m_inputModel.value();
@@ -80,60 +81,63 @@ Effect::ProcessStatus WaveShaperEffect::processImpl(SampleFrame* buf, const fpp_
 	ValueBuffer *inputBuffer = m_wsControls.m_inputModel.valueBuffer();
 	ValueBuffer *outputBufer = m_wsControls.m_outputModel.valueBuffer();
 
-	int inputInc = inputBuffer ? 1 : 0;
-	int outputInc = outputBufer ? 1 : 0;
-
-	const float *inputPtr = inputBuffer ? &( inputBuffer->values()[ 0 ] ) : &input;
-	const float *outputPtr = outputBufer ? &( outputBufer->values()[ 0 ] ) : &output;
+	m_oversampler.setFactor( 1 << m_wsControls.m_oversamplingModel.value() );
+	m_oversampler.setPhase( static_cast<Oversampler::Phase>( m_wsControls.m_oversamplingPhaseModel.value() ) );
+	const int factor = m_oversampler.factor();
 
-	for (fpp_t f = 0; f < frames; ++f)
+// run everything including the dry/wet mix at the oversampled rate so the dry signal stays aligned
+	m_oversampler.process( buf, frames, [&]( SampleFrame* osBuf, fpp_t osFrames )
 	{
-		auto s = std::array{buf[f][0], buf[f][1]};
+		for (fpp_t f = 0; f < osFrames; ++f)
+		{
+			// sample exact automation is held for the oversampled frames of each frame
+			const float inputGain = inputBuffer ? inputBuffer->values()[f / factor] : input;
+			const float outputGain = outputBufer ? outputBufer->values()[f / factor] : output;
+
+			auto s = std::array{osBuf[f][0], osBuf[f][1]};
 
 // apply input gain
-		s[0] *= *inputPtr;
-		s[1] *= *inputPtr;
+			s[0] *= inputGain;
+			s[1] *= inputGain;
 
 // clip if clip enabled
-		if( clip )
-		{
-			s[0] = qBound( -1.0f, s[0], 1.0f );
-			s[1] = qBound( -1.0f, s[1], 1.0f );
-		}
+			if( clip )
+			{
+				s[0] = qBound( -1.0f, s[0], 1.0f );
+				s[1] = qBound( -1.0f, s[1], 1.0f );
+			}
 
 // start effect
 
-		for( i=0; i <= 1; ++i )
-		{
-			const int lookup = static_cast<int>( qAbs( s[i] ) * 200.0f );
-			const float frac = fraction( qAbs( s[i] ) * 200.0f );
-			const float posneg = s[i] < 0 ? -1.0f : 1.0f;
-
-			if( lookup < 1 )
-			{
-				s[i] = frac * samples[0] * posneg;
-			}
-			else if( lookup < 200 )
-			{
-				s[i] = std::lerp(samples[lookup - 1], samples[lookup], frac) * posneg;
-			}
-			else
+			for( int i=0; i <= 1; ++i )
 			{
-				s[i] *= samples[199];
+				const int lookup = static_cast<int>( qAbs( s[i] ) * 200.0f );
+				const float frac = fraction( qAbs( s[i] ) * 200.0f );
+				const float posneg = s[i] < 0 ? -1.0f : 1.0f;
+
+				if( lookup < 1 )
+				{
+					s[i] = frac * samples[0] * posneg;
+				}
+				else if( lookup < 200 )
+				{
+					s[i] = std::lerp(samples[lookup - 1], samples[lookup], frac) * posneg;
+				}
+				else
+				{
+					s[i] *= samples[199];
+				}
 			}
-		}
 
 // apply output gain
-		s[0] *= *outputPtr;
-		s[1] *= *outputPtr;
+			s[0] *= outputGain;
+			s[1] *= outputGain;
 
 // mix wet/dry signals
-		buf[f][0] = d * buf[f][0] + w * s[0];
-		buf[f][1] = d * buf[f][1] + w * s[1];
-
-		outputPtr += outputInc;
-		inputPtr += inputInc;
-	}
+			osBuf[f][0] = d * osBuf[f][0] + w * s[0];
+			osBuf[f][1] = d * osBuf[f][1] + w * s[1];
+		}
+	} );
 
 	return ProcessStatus::ContinueIfNotQuiet;
 }
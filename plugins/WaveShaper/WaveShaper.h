@@ -28,6 +28,7 @@
 #define _WAVESHAPER_H
 
 #include "Effect.h"
+#include "Oversampler.h"
 #include "WaveShaperControls.h"
 
 namespace lmms
@@ -48,11 +49,18 @@ public:
 		return( &m_wsControls );
 	}
 
+	f_cnt_t latency() const override
+	{
+		return m_oversampler.latency();
+	}
+
 
 private:
 
 	WaveShaperControls m_wsControls;
 
+	Oversampler m_oversampler;
+
 	friend class WaveShaperControls;
 
 } ;
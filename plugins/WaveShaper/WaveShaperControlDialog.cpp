@@ -27,6 +27,7 @@
 
 #include "WaveShaperControlDialog.h"
 #include "WaveShaperControls.h"
+#include "ComboBox.h"
 #include "embed.h"
 #include "FontHelper.h"
 #include "Graph.h"
@@ -47,7 +48,7 @@ WaveShaperControlDialog::WaveShaperControlDialog(
 	pal.setBrush( backgroundRole(),
 				PLUGIN_NAME::getIconPixmap( "artwork" ) );
 	setPalette( pal );
-	setFixedSize( 224, 274 );
+	setFixedSize( 224, 300 );
 
 	auto waveGraph = new Graph(this, Graph::Style::LinearNonCyclic, 204, 205);
 	waveGraph -> move( 10, 6 );
@@ -107,6 +108,16 @@ WaveShaperControlDialog::WaveShaperControlDialog(
 	clipInputToggle -> setModel( &_controls -> m_clipModel );
 	clipInputToggle->setToolTip(tr("Clip input signal to 0 dB"));
 
+	auto oversamplingBox = new ComboBox( this );
+	oversamplingBox->setGeometry( 10, 274, 60, ComboBox::DEFAULT_HEIGHT );
+	oversamplingBox->setModel( &_controls->m_oversamplingModel );
+	oversamplingBox->setToolTip(tr("Oversampling factor, higher factors reduce aliasing"));
+
+	auto oversamplingPhaseBox = new ComboBox( this );
+	oversamplingPhaseBox->setGeometry( 76, 274, 138, ComboBox::DEFAULT_HEIGHT );
+	oversamplingPhaseBox->setModel( &_controls->m_oversamplingPhaseModel );
+	oversamplingPhaseBox->setToolTip(tr("Linear phase filters keep the waveform intact, minimum phase filters add less latency"));
+
 	connect( resetButton, SIGNAL (clicked () ),
 			_controls, SLOT ( resetClicked() ) );
 	connect( smoothButton, SIGNAL (clicked () ),
@@ -45,8 +45,18 @@ WaveShaperControls::WaveShaperControls( WaveShaperEffect * _eff ) :
 	m_inputModel( 1.0f, 0.0f, 5.0f, 0.01f, this, tr( "Input gain" ) ),
 	m_outputModel( 1.0f, 0.0f, 5.0f, 0.01f, this, tr( "Output gain" ) ),
 	m_wavegraphModel( 0.0f, 1.0f, 200, this ),
-	m_clipModel( false, this )
+	m_clipModel( false, this ),
+	m_oversamplingModel( this, tr( "Oversampling" ) ),
+	m_oversamplingPhaseModel( this, tr( "Oversampling filter" ) )
 {
+	m_oversamplingModel.addItem( tr( "1x" ) );
+	m_oversamplingModel.addItem( tr( "2x" ) );
+	m_oversamplingModel.addItem( tr( "4x" ) );
+	m_oversamplingModel.addItem( tr( "8x" ) );
+
+	m_oversamplingPhaseModel.addItem( tr( "Linear phase" ) );
+	m_oversamplingPhaseModel.addItem( tr( "Minimum phase" ) );
+
 	connect( &m_wavegraphModel, SIGNAL( samplesChanged( int, int ) ),
 			this, SLOT( samplesChanged( int, int ) ) );
 
@@ -72,6 +82,9 @@ void WaveShaperControls::loadSettings( const QDomElement & _this )
 
 	m_clipModel.loadSettings( _this, "clipInput" );
 
+	m_oversamplingModel.loadSettings( _this, "oversampling" );
+	m_oversamplingPhaseModel.loadSettings( _this, "oversamplingphase" );
+
 //load waveshape
 	int size = 0;
 	char * dst = 0;
@@ -94,6 +107,9 @@ void WaveShaperControls::saveSettings( QDomDocument & _doc,
 
 	m_clipModel.saveSettings( _doc, _this, "clipInput" );
 
+	m_oversamplingModel.saveSettings( _doc, _this, "oversampling" );
+	m_oversamplingPhaseModel.saveSettings( _doc, _this, "oversamplingphase" );
+
 //save waveshape
 	QString sampleString;
 	base64::encode( (const char *)m_wavegraphModel.samples(),
@@ -336,10 +336,12 @@ void ZynAddSubFxInstrument::play( SampleFrame* _buf )
 	if( m_remotePlugin )
 	{
 		m_remotePlugin->process( nullptr, _buf );
+		m_latency = m_remotePlugin->latency();
 	}
 	else
 	{
 		m_plugin->processAudio( _buf );
+		m_latency = 0;
 	}
 	m_pluginMutex.unlock();
 }
@@ -76,6 +76,11 @@ public:
 
 	void play( SampleFrame* _working_buffer ) override;
 
+	f_cnt_t latency() const override
+	{
+		return m_latency;
+	}
+
 	bool handleMidiEvent( const MidiEvent& event, const TimePos& time = TimePos(), f_cnt_t offset = 0 ) override;
 
 	void saveSettings( QDomDocument & _doc, QDomElement & _parent ) override;
@@ -111,6 +116,8 @@ private:
 	QMutex m_pluginMutex;
 	LocalZynAddSubFx * m_plugin;
 	ZynAddSubFxRemotePlugin * m_remotePlugin;
+	// latency of m_remotePlugin, updated while holding m_pluginMutex in play()
+	f_cnt_t m_latency = 0;
 
 	FloatModel m_portamentoModel;
 	FloatModel m_filterFreqModel;
@@ -24,6 +24,8 @@
 
 #include "RemotePluginBase.h"
 
+#include <stdexcept>
+
 #ifndef BUILD_REMOTE_PLUGIN_CLIENT
 #include <QCoreApplication>
 #include <QThread>
@@ -88,6 +90,19 @@ int RemotePluginBase::sendMessage(const message & _m)
 	m_out->messageSent();
 #else
 	pthread_mutex_lock(&m_sendMutex);
+	const int j = writeMessage(_m);
+	pthread_mutex_unlock(&m_sendMutex);
+#endif
+
+	return j;
+}
+
+
+
+
+#ifndef SYNC_WITH_SHM_FIFO
+int RemotePluginBase::writeMessage(const message & _m)
+{
 	writeInt(_m.id);
 	writeInt(_m.data.size());
 	int j = 8;
@@ -96,11 +111,9 @@ int RemotePluginBase::sendMessage(const message & _m)
 		writeString(str);
 		j += 4 + str.size();
 	}
-	pthread_mutex_unlock(&m_sendMutex);
-#endif
-
 	return j;
 }
+#endif
 
 
 
@@ -192,4 +205,91 @@ RemotePluginBase::message RemotePluginBase::waitForMessage(
 	return message();
 }
 
+
+
+
+#ifdef SYNC_WITH_SHM_RING
+void RemotePluginBase::offerRingTransport()
+{
+	try
+	{
+		m_rings.create(2);
+	}
+	catch (const std::runtime_error& error)
+	{
+		fprintf(stderr, "Failed to create shared memory for remote plugin messages, using socket: %s\n",
+			error.what());
+		return;
+	}
+	m_ringOut = SharedMemoryRing{&m_rings[0]};
+	m_ringIn = SharedMemoryRing{&m_rings[1]};
+	watchPeerWithRings();
+	sendMessage(message(IdChangeTransport).addString(m_rings.key()));
+}
+
+
+
+
+void RemotePluginBase::watchPeerWithRings()
+{
+	// The socket stays connected after the switch, so it still tells when the other
+	// process is gone. Without this, a plugin would wait for its dead host forever.
+	m_ringIn.watchPeer(m_socket);
+	m_ringOut.watchPeer(m_socket);
+}
+
+
+
+
+void RemotePluginBase::acceptRingTransport(const std::string& key)
+{
+	try
+	{
+		m_rings.attach(key);
+	}
+	catch (const std::runtime_error&)
+	{
+		sendMessage(message(IdTransportChanged).addInt(0));
+		return;
+	}
+	m_ringIn = SharedMemoryRing{&m_rings[0]};
+	m_ringOut = SharedMemoryRing{&m_rings[1]};
+	watchPeerWithRings();
+
+	pthread_mutex_lock(&m_sendMutex);
+	writeMessage(message(IdTransportChanged).addInt(1));
+	m_useRingOut = true;
+	pthread_mutex_unlock(&m_sendMutex);
+}
+
+
+
+
+void RemotePluginBase::ringTransportChanged(const message& m)
+{
+	if (m_rings.key().empty()) { return; }
+
+	if (m_useRingOut)
+	{
+		// plugin side: this was the host's last message over the socket
+		m_useRingIn.store(true, std::memory_order_release);
+		return;
+	}
+
+	if (m.getInt(0) == 0)
+	{
+		m_rings.detach();
+		return;
+	}
+
+	// host side: everything the plugin sends from now on arrives through the ring
+	m_useRingIn.store(true, std::memory_order_release);
+
+	pthread_mutex_lock(&m_sendMutex);
+	writeMessage(message(IdTransportChanged));
+	m_useRingOut = true;
+	pthread_mutex_unlock(&m_sendMutex);
+}
+#endif // SYNC_WITH_SHM_RING
+
 } // namespace lmms
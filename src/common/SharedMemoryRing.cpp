@@ -0,0 +1,216 @@
+/*
+ * SharedMemoryRing.cpp
+ *
+ * Copyright (c) 2026 LMMS Developers
+ *
+ * This file is part of LMMS - https://lmms.io
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public
+ * License along with this program (see COPYING); if not, write to the
+ * Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA 02110-1301 USA.
+ *
+ */
+
+#include "SharedMemoryRing.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <climits>
+#include <cstring>
+#include <thread>
+
+#include <linux/futex.h>
+#include <poll.h>
+#include <sys/syscall.h>
+#include <time.h>
+#include <unistd.h>
+
+namespace lmms
+{
+
+namespace
+{
+
+// Roughly the time a remote plugin needs for a small period, so that a busy
+// peer is answered without sleeping. Spinning only delays the peer on a single core.
+const int SpinCount = std::thread::hardware_concurrency() > 1 ? 4000 : 0;
+
+// Sleep in slices, so that a waiter notices if the other process died without
+// waking it, see watchPeer()
+constexpr timespec SleepTimeout = {0, 100'000'000};
+
+long futex(std::uint32_t* word, int op, std::uint32_t value, const timespec* timeout = nullptr)
+{
+	// Not FUTEX_PRIVATE_FLAG, since the word is shared between processes
+	return syscall(SYS_futex, word, op, value, timeout, nullptr, 0);
+}
+
+inline void cpuRelax()
+{
+#if defined(__i386__) || defined(__x86_64__)
+	__builtin_ia32_pause();
+#endif
+}
+
+} // namespace
+
+
+
+
+bool SharedMemoryRing::write(const void* buffer, std::size_t length)
+{
+	auto head = std::atomic_ref{m_data->head};
+	auto tail = std::atomic_ref{m_data->tail};
+	auto in = static_cast<const char*>(buffer);
+	std::uint32_t position = head.load(std::memory_order_relaxed);
+
+	while (length > 0)
+	{
+		if (isClosed()) { return false; }
+
+		const std::uint32_t readPosition = tail.load(std::memory_order_acquire);
+		const std::uint32_t space = Data::Size - (position - readPosition);
+		if (space == 0)
+		{
+			wait(m_data->tail, readPosition, m_data->writerWaiting);
+			continue;
+		}
+
+		const auto offset = position % Data::Size;
+		const auto chunk = std::min<std::size_t>({length, space, Data::Size - offset});
+		std::memcpy(m_data->data + offset, in, chunk);
+		in += chunk;
+		length -= chunk;
+		position += static_cast<std::uint32_t>(chunk);
+
+		head.store(position, std::memory_order_seq_cst);
+		wake(m_data->head, m_data->readerWaiting);
+	}
+
+	return true;
+}
+
+
+
+
+bool SharedMemoryRing::read(void* buffer, std::size_t length)
+{
+	auto head = std::atomic_ref{m_data->head};
+	auto tail = std::atomic_ref{m_data->tail};
+	auto out = static_cast<char*>(buffer);
+	std::uint32_t position = tail.load(std::memory_order_relaxed);
+
+	while (length > 0)
+	{
+		const std::uint32_t writePosition = head.load(std::memory_order_acquire);
+		const std::uint32_t available = writePosition - position;
+		if (available == 0)
+		{
+			if (isClosed()) { return false; }
+			wait(m_data->head, writePosition, m_data->readerWaiting);
+			continue;
+		}
+
+		const auto offset = position % Data::Size;
+		const auto chunk = std::min<std::size_t>({length, available, Data::Size - offset});
+		std::memcpy(out, m_data->data + offset, chunk);
+		out += chunk;
+		length -= chunk;
+		position += static_cast<std::uint32_t>(chunk);
+
+		tail.store(position, std::memory_order_seq_cst);
+		wake(m_data->tail, m_data->writerWaiting);
+	}
+
+	return true;
+}
+
+
+
+
+bool SharedMemoryRing::empty() const
+{
+	return std::atomic_ref{m_data->head}.load(std::memory_order_acquire)
+		== std::atomic_ref{m_data->tail}.load(std::memory_order_acquire);
+}
+
+
+
+
+void SharedMemoryRing::close()
+{
+	std::atomic_ref{m_data->closed}.store(1, std::memory_order_seq_cst);
+	futex(&m_data->head, FUTEX_WAKE, INT_MAX);
+	futex(&m_data->tail, FUTEX_WAKE, INT_MAX);
+}
+
+
+
+
+bool SharedMemoryRing::isClosed() const
+{
+	return std::atomic_ref{m_data->closed}.load(std::memory_order_acquire) != 0;
+}
+
+
+
+
+void SharedMemoryRing::wait(std::uint32_t& word, std::uint32_t value, std::uint32_t& waiting)
+{
+	auto atomicWord = std::atomic_ref{word};
+	for (int i = 0; i < SpinCount; ++i)
+	{
+		if (atomicWord.load(std::memory_order_acquire) != value || isClosed()) { return; }
+		cpuRelax();
+	}
+
+	// The other side checks the flag after publishing its position, so either it
+	// sees the flag and wakes us, or we see the new position and don't sleep at all
+	auto atomicWaiting = std::atomic_ref{waiting};
+	atomicWaiting.store(1, std::memory_order_seq_cst);
+	if (atomicWord.load(std::memory_order_seq_cst) == value && !isClosed()
+		&& futex(&word, FUTEX_WAIT, value, &SleepTimeout) == -1 && errno == ETIMEDOUT
+		&& peerHungUp())
+	{
+		close();
+	}
+	atomicWaiting.store(0, std::memory_order_relaxed);
+}
+
+
+
+
+bool SharedMemoryRing::peerHungUp() const
+{
+	if (m_peerFd < 0) { return false; }
+
+	// POLLHUP and POLLERR are reported without asking for them
+	auto peer = pollfd{m_peerFd, 0, 0};
+	return poll(&peer, 1, 0) == 1 && (peer.revents & (POLLHUP | POLLERR | POLLNVAL));
+}
+
+
+
+
+void SharedMemoryRing::wake(std::uint32_t& word, std::uint32_t& waiting) const
+{
+	if (std::atomic_ref{waiting}.load(std::memory_order_seq_cst) != 0)
+	{
+		futex(&word, FUTEX_WAKE, 1);
+	}
+}
+
+
+} // namespace lmms
@@ -25,6 +25,8 @@
 
 #include <QMutexLocker>
 
+#include <algorithm>
+
 #include "AudioBusHandle.h"
 #include "AudioDevice.h"
 #include "AudioEngine.h"
@@ -33,6 +35,7 @@
 #include "Engine.h"
 #include "MixHelpers.h"
 #include "BufferManager.h"
+#include "RealtimeContext.h"
 
 namespace lmms
 {
@@ -106,6 +109,12 @@ bool AudioBusHandle::processEffects()
 }
 
 
+f_cnt_t AudioBusHandle::latency() const
+{
+	return m_sourceLatency + (m_effects ? m_effects->latency() : 0);
+}
+
+
 void AudioBusHandle::doProcessing()
 {
 	if (m_mutedModel && m_mutedModel->value())
@@ -115,26 +124,45 @@ void AudioBusHandle::doProcessing()
 
 	const fpp_t fpp = Engine::audioEngine()->framesPerPeriod();
 
-	// clear the buffer
-	zeroSampleFrames(m_buffer, fpp);
-
 	//qDebug( "Playhandles: %d", m_playHandles.size() );
+	bool mixed = false;
 	for (PlayHandle* ph : m_playHandles) // now we mix all playhandle buffers into our internal buffer
 	{
 		if (ph->buffer())
 		{
 			if (ph->usesBuffer()
 				&& (ph->type() == PlayHandle::Type::NotePlayHandle
-					|| !MixHelpers::isSilent(ph->buffer(), fpp)))
+					|| !ph->isBufferSilent()))
 			{
 				m_bufferUsage = true;
-				MixHelpers::add(m_buffer, ph->buffer(), fpp);
+				// the first buffer is copied, so ours never needs to be cleared before
+				if (mixed) { MixHelpers::add(m_buffer, ph->buffer(), fpp); }
+				else { std::copy_n(ph->buffer(), fpp, m_buffer); }
+				mixed = true;
 			}
 			ph->releaseBuffer(); 	// gets rid of playhandle's buffer and sets
 									// pointer to null, so if it doesn't get re-acquired we know to skip it next time
 		}
 	}
 
+	if (!mixed)
+	{
+		// without input, only the tails of the effects and of the delay line can be left
+		if (!(m_effects && m_effects->isRunning()) && !m_latencyCompensator.hasTail())
+		{
+			// the buffer is still read by audio devices with per-track outputs, so leave it cleared
+			if (!m_bufferCleared)
+			{
+				zeroSampleFrames(m_buffer, fpp);
+				m_bufferCleared = true;
+			}
+			Engine::audioEngine()->profiler().countSkippedNode();
+			return;
+		}
+		zeroSampleFrames(m_buffer, fpp);
+	}
+	m_bufferCleared = false;
+
 	if (m_bufferUsage)
 	{
 		// handle volume and panning
@@ -225,7 +253,9 @@ void AudioBusHandle::doProcessing()
 
 	// handle effects
 	const bool anyOutputAfterEffects = processEffects();
-	if (anyOutputAfterEffects || m_bufferUsage)
+
+	// delay the output if other paths into our mixer channel have a higher latency
+	if (m_latencyCompensator.process(m_buffer, m_buffer, fpp, anyOutputAfterEffects || m_bufferUsage))
 	{
 		Engine::mixer()->mixToChannel(m_buffer, m_nextMixerChannel);	// send output to mixer
 																		// TODO: improve the flow here - convert to pull model
@@ -236,6 +266,7 @@ void AudioBusHandle::doProcessing()
 
 void AudioBusHandle::addPlayHandle(PlayHandle* handle)
 {
+	RealtimeContext::reportLock("AudioBusHandle::addPlayHandle");
 	QMutexLocker lockGuard(&m_playHandleLock);
 	m_playHandles.append(handle);
 }
@@ -243,6 +274,7 @@ void AudioBusHandle::addPlayHandle(PlayHandle* handle)
 
 void AudioBusHandle::removePlayHandle(PlayHandle* handle)
 {
+	RealtimeContext::reportLock("AudioBusHandle::removePlayHandle");
 	QMutexLocker lockGuard(&m_playHandleLock);
 	PlayHandleList::Iterator it = std::find(m_playHandles.begin(), m_playHandles.end(), handle);
 	if (it != m_playHandles.end())
@@ -24,6 +24,8 @@
 
 #include "AudioEngine.h"
 
+#include <algorithm>
+
 #include "MixHelpers.h"
 #include "denormals.h"
 
@@ -36,6 +38,7 @@
 #include "EnvelopeAndLfoParameters.h"
 #include "NotePlayHandle.h"
 #include "ConfigManager.h"
+#include "RealtimeContext.h"
 
 // platform-specific audio-interface-classes
 #include "AudioAlsa.h"
@@ -67,6 +70,17 @@ using LocklessListElement = LocklessList<PlayHandle*>::Element;
 
 static thread_local bool s_renderingThread = false;
 
+//! Reads the channel count of the output layout, falls back to stereo for anything unsupported
+static ch_cnt_t loadOutputChannels()
+{
+	const int channels = ConfigManager::inst()->value("audioengine", "outputchannels").toInt();
+	for (auto layout : {ChannelLayout::Mono, ChannelLayout::Quad, ChannelLayout::Surround51, ChannelLayout::Surround71})
+	{
+		if (channels == channelCount(layout)) { return channelCount(layout); }
+	}
+	return DEFAULT_CHANNELS;
+}
+
 
 
 
@@ -78,14 +92,21 @@ AudioEngine::AudioEngine( bool renderOnly ) :
 	m_inputBufferWrite( 1 ),
 	m_outputBufferRead(nullptr),
 	m_outputBufferWrite(nullptr),
+	m_outputChannels(loadOutputChannels()),
+	m_schedulingSettings(ThreadScheduling::loadSettings()),
 	m_workers(),
-	m_numWorkers( QThread::idealThreadCount()-1 ),
+	m_numWorkers(m_schedulingSettings.renderThreads > 0
+		? m_schedulingSettings.renderThreads - 1
+		: QThread::idealThreadCount() - 1),
 	m_newPlayHandles( PlayHandle::MaxNumber ),
 	m_qualitySettings(qualitySettings::Interpolation::Linear),
 	m_masterGain( 1.0f ),
 	m_audioDev( nullptr ),
 	m_oldAudioDev( nullptr ),
 	m_audioDevStartFailed( false ),
+	m_fifoWriter( nullptr ),
+	m_renderingDirectly( false ),
+	m_renderingInCallback( false ),
 	m_profiler(),
 	m_clearSignal(false)
 {
@@ -131,12 +152,29 @@ AudioEngine::AudioEngine( bool renderOnly ) :
 	// allocte the FIFO from the determined size
 	m_fifo = new Fifo( fifoSize );
 
+	// Besides the ones in the FIFO, the fifo writer renders into one buffer and the device processes another one
+	const int fifoBufferCount = fifoSize + 2;
+	const f_cnt_t busFrames = m_outputChannels == DEFAULT_CHANNELS
+		? 0
+		: (m_framesPerPeriod * m_outputChannels + DEFAULT_CHANNELS - 1) / DEFAULT_CHANNELS;
+	m_freeFifoBuffers = new Fifo( fifoBufferCount );
+	for( int i = 0; i < fifoBufferCount; ++i )
+	{
+		m_fifoBuffers.push_back( std::make_unique<SampleFrame[]>( m_framesPerPeriod + busFrames ) );
+		m_freeFifoBuffers->write( m_fifoBuffers.back().get() );
+	}
+
 	// now that framesPerPeriod is fixed initialize global BufferManager
 	BufferManager::init( m_framesPerPeriod );
 
 	m_outputBufferRead = std::make_unique<SampleFrame[]>(m_framesPerPeriod);
 	m_outputBufferWrite = std::make_unique<SampleFrame[]>(m_framesPerPeriod);
 
+	if (m_outputChannels != DEFAULT_CHANNELS)
+	{
+		m_busOutputRead = std::make_unique<MultiChannelBuffer>(m_outputChannels, m_framesPerPeriod);
+		m_busOutputWrite = std::make_unique<MultiChannelBuffer>(m_outputChannels, m_framesPerPeriod);
+	}
 
 	for( int i = 0; i < m_numWorkers+1; ++i )
 	{
@@ -166,15 +204,13 @@ AudioEngine::~AudioEngine()
 		m_workers[w]->wait( 500 );
 	}
 
-	while( m_fifo->available() )
-	{
-		delete[] m_fifo->read();
-	}
-	delete m_fifo;
-
 	delete m_midiClient;
 	delete m_audioDev;
 
+	// after the device, which may still hand back a buffer
+	delete m_fifo;
+	delete m_freeFifoBuffers;
+
 
 	for (const auto& input : m_inputBuffer)
 	{
@@ -206,14 +242,20 @@ void AudioEngine::initDevices()
 
 void AudioEngine::startProcessing(bool needsFifo)
 {
-	if (needsFifo)
+	// Rendering in the device's callback saves the latency of the fifo, but the device thread has to take the
+	// full rendering time and wait for changes in the model
+	if (needsFifo && !(m_schedulingSettings.renderInCallback && m_audioDev->canRenderInCallback()))
 	{
-		m_fifoWriter = new fifoWriter( this, m_fifo );
+		m_fifoWriter = new fifoWriter( this, m_fifo, m_freeFifoBuffers );
 		m_fifoWriter->start( QThread::HighPriority );
 	}
 	else
 	{
 		m_fifoWriter = nullptr;
+		const auto lock = std::lock_guard{m_changeMutex};
+		m_renderingDirectly = true;
+		// Without a fifo, the periods are pulled by an offline renderer, which must get every period
+		m_renderingInCallback = needsFifo;
 	}
 
 	m_audioDev->startProcessing();
@@ -234,6 +276,11 @@ void AudioEngine::stopProcessing()
 	}
 	else
 	{
+		{
+			// Wait for the period currently rendered in the device's thread, and don't render any more
+			const auto lock = std::lock_guard{m_changeMutex};
+			m_renderingDirectly = false;
+		}
 		m_audioDev->stopProcessing();
 	}
 }
@@ -312,13 +359,19 @@ void AudioEngine::renderStageNoteSetup()
 
 	swapBuffers();
 
-	// prepare master mix (clear internal buffers etc.)
 	Mixer * mixer = Engine::mixer();
-	mixer->prepareMasterMix();
+
+	// align the paths into each mixer channel using the latencies of the last period
+	mixer->compensateLatencies(m_audioBusHandles);
 
 	// create play-handles for new notes, samples etc.
 	Engine::getSong()->processNextBuffer();
 
+	// play the live MIDI input that arrived while rendering the last period at the same offset in this one
+	const auto periodStart = MidiInputQueue::Clock::now();
+	m_midiClient->processQueuedInEvents({m_lastPeriodStart, m_framesPerPeriod, outputSampleRate()});
+	m_lastPeriodStart = periodStart;
+
 	// add all play-handles that have to be added
 	for( LocklessListElement * e = m_newPlayHandles.popList(); e; )
 	{
@@ -327,6 +380,9 @@ void AudioEngine::renderStageNoteSetup()
 		m_newPlayHandles.free( e );
 		e = next;
 	}
+
+	// compute sample-exact values now, so the following stages can read them without locking
+	AutomatableModel::updateValueBuffers();
 }
 
 
@@ -383,9 +439,10 @@ void AudioEngine::renderStageMix()
 	AudioEngineProfiler::Probe profilerProbe(m_profiler, AudioEngineProfiler::DetailType::Mixing);
 
 	Mixer *mixer = Engine::mixer();
-	mixer->masterMix(m_outputBufferWrite.get());
+	mixer->masterMix(m_outputBufferWrite.get(), m_busOutputWrite.get());
 
 	MixHelpers::multiply(m_outputBufferWrite.get(), m_masterGain, m_framesPerPeriod);
+	if (m_busOutputWrite) { MixHelpers::multiply(*m_busOutputWrite, m_masterGain); }
 
 	emit nextAudioBuffer(m_outputBufferRead.get());
 
@@ -400,6 +457,7 @@ void AudioEngine::renderStageMix()
 const SampleFrame* AudioEngine::renderNextBuffer()
 {
 	const auto lock = std::lock_guard{m_changeMutex};
+	const auto realtime = RealtimeContext{};
 
 	m_profiler.startPeriod();
 	s_renderingThread = true;
@@ -418,14 +476,38 @@ const SampleFrame* AudioEngine::renderNextBuffer()
 
 
 
+const SampleFrame* AudioEngine::renderDirectly()
+{
+	// A realtime callback must not wait for changes in the model, an offline renderer has to
+	auto lock = std::unique_lock{m_changeMutex, std::defer_lock};
+	if (m_renderingInCallback) { lock.try_lock(); }
+	else { lock.lock(); }
+	if (!m_renderingDirectly) { return nullptr; }
+
+	if (!lock.owns_lock())
+	{
+		// Only this thread uses the read buffers while rendering directly, so output them as a period of silence
+		zeroSampleFrames(m_outputBufferRead.get(), m_framesPerPeriod);
+		if (m_busOutputRead) { m_busOutputRead->clear(); }
+		return m_outputBufferRead.get();
+	}
+
+	disable_denormals();
+	return renderNextBuffer();
+}
+
+
+
+
 void AudioEngine::swapBuffers()
 {
 	m_inputBufferWrite = (m_inputBufferWrite + 1) % 2;
 	m_inputBufferRead = (m_inputBufferRead + 1) % 2;
 	m_inputBufferFrames[m_inputBufferWrite] = 0;
 
+	// the output buffers are overwritten by the master mix, so they do not need to be cleared
 	std::swap(m_outputBufferRead, m_outputBufferWrite);
-	zeroSampleFrames(m_outputBufferWrite.get(), m_framesPerPeriod);
+	std::swap(m_busOutputRead, m_busOutputWrite);
 }
 
 void AudioEngine::clear()
@@ -1080,9 +1162,10 @@ MidiClient * AudioEngine::tryMidiClients()
 
 
 
-AudioEngine::fifoWriter::fifoWriter( AudioEngine* audioEngine, Fifo * fifo ) :
+AudioEngine::fifoWriter::fifoWriter( AudioEngine* audioEngine, Fifo * fifo, Fifo * freeBuffers ) :
 	m_audioEngine( audioEngine ),
 	m_fifo( fifo ),
+	m_freeBuffers( freeBuffers ),
 	m_writing( true )
 {
 	setObjectName("AudioEngine::fifoWriter");
@@ -1102,13 +1185,19 @@ void AudioEngine::fifoWriter::finish()
 void AudioEngine::fifoWriter::run()
 {
 	disable_denormals();
+	m_audioEngine->profiler().reportSchedulingPolicy(
+		ThreadScheduling::applyToCurrentThread(m_audioEngine->schedulingSettings()));
 
 	const fpp_t frames = m_audioEngine->framesPerPeriod();
 	while( m_writing )
 	{
-		auto buffer = new SampleFrame[frames];
+		SampleFrame* buffer = m_freeBuffers->read();
 		const SampleFrame* b = m_audioEngine->renderNextBuffer();
 		memcpy(buffer, b, frames * sizeof(SampleFrame));
+		if (const auto& bus = m_audioEngine->m_busOutputRead)
+		{
+			std::copy_n(bus->data(), bus->samples(), buffer[frames].data());
+		}
 		m_fifo->write(buffer);
 	}
 
@@ -59,19 +59,41 @@ void AudioEngineProfiler::finishPeriod( sample_rate_t sampleRate, fpp_t framesPe
 		m_detailLoad[i].store(newLoad * 0.05f + oldLoad * 0.95f, std::memory_order_relaxed);
 	}
 
+	m_skippedNodesLastPeriod.store(m_skippedNodes.exchange(0, std::memory_order_relaxed),
+		std::memory_order_relaxed);
+
 	if( m_outputFile.isOpen() )
 	{
+		if (const int policy = m_schedulingPolicy.load(std::memory_order_relaxed); policy != m_writtenSchedulingPolicy)
+		{
+			m_outputFile.write(QString("# scheduling: %1\n")
+				.arg(ThreadScheduling::policyName(schedulingPolicy())).toLatin1());
+			m_writtenSchedulingPolicy = policy;
+		}
 		m_outputFile.write( QString( "%1\n" ).arg( periodElapsed ).toLatin1() );
 	}
 }
 
 
 
+void AudioEngineProfiler::reportSchedulingPolicy(ThreadScheduling::Policy policy)
+{
+	int expected = -1;
+	const int reported = static_cast<int>(policy);
+	if (!m_schedulingPolicy.compare_exchange_strong(expected, reported) && expected != reported)
+	{
+		m_schedulingPolicy = static_cast<int>(ThreadScheduling::Policy::Default);
+	}
+}
+
+
+
 void AudioEngineProfiler::setOutputFile( const QString& outputFile )
 {
 	m_outputFile.close();
 	m_outputFile.setFileName( outputFile );
 	m_outputFile.open( QFile::WriteOnly | QFile::Truncate );
+	m_writtenSchedulingPolicy = -1;
 }
 
 } // namespace lmms
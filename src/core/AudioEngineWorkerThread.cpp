@@ -30,6 +30,7 @@
 
 #include "denormals.h"
 #include "AudioEngine.h"
+#include "RealtimeContext.h"
 #include "ThreadableJob.h"
 
 #if __SSE__
@@ -115,6 +116,7 @@ void AudioEngineWorkerThread::JobQueue::wait()
 
 AudioEngineWorkerThread::AudioEngineWorkerThread( AudioEngine* audioEngine ) :
 	QThread( audioEngine ),
+	m_audioEngine( audioEngine ),
 	m_quit( false )
 {
 	// initialize global static data
@@ -167,13 +169,18 @@ void AudioEngineWorkerThread::startAndWaitForJobs()
 void AudioEngineWorkerThread::run()
 {
 	disable_denormals();
+	m_audioEngine->profiler().reportSchedulingPolicy(
+		ThreadScheduling::applyToCurrentThread(m_audioEngine->schedulingSettings()));
 
 	QMutex m;
 	while( m_quit == false )
 	{
 		m.lock();
 		queueReadyWaitCond->wait( &m );
-		globalJobQueue.run();
+		{
+			const auto realtime = RealtimeContext{};
+			globalJobQueue.run();
+		}
 		m.unlock();
 	}
 }
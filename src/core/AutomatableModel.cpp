@@ -24,6 +24,7 @@
 
 #include "AutomatableModel.h"
 
+#include <algorithm>
 #include <QRegularExpression>
 
 #include "lmms_math.h"
@@ -39,6 +40,8 @@ namespace lmms
 {
 
 long AutomatableModel::s_periodCounter = 0;
+std::vector<AutomatableModel*> AutomatableModel::s_valueBufferModels;
+std::recursive_mutex AutomatableModel::s_valueBufferModelsMutex;
 
 
 
@@ -59,6 +62,7 @@ AutomatableModel::AutomatableModel(
 	m_valueBuffer( static_cast<int>( Engine::audioEngine()->framesPerPeriod() ) ),
 	m_lastUpdatedPeriod( -1 ),
 	m_hasSampleExactData(false),
+	m_valueBufferRegistered(false),
 	m_useControllerValue(true)
 
 {
@@ -82,6 +86,14 @@ AutomatableModel::~AutomatableModel()
 		delete m_controllerConnection;
 	}
 
+	{
+		const auto lock = std::lock_guard{s_valueBufferModelsMutex};
+		if (m_valueBufferRegistered)
+		{
+			s_valueBufferModels.erase(std::find(s_valueBufferModels.begin(), s_valueBufferModels.end(), this));
+		}
+	}
+
 	m_valueBuffer.clear();
 
 	emit destroyed( id() );
@@ -591,16 +603,50 @@ float AutomatableModel::controllerValue( int frameOffset ) const
 
 ValueBuffer * AutomatableModel::valueBuffer()
 {
-	QMutexLocker m( &m_valueBufferMutex );
-	// if we've already calculated the valuebuffer this period, return the cached buffer
-	if( m_lastUpdatedPeriod == s_periodCounter )
+	if (m_lastUpdatedPeriod.load(std::memory_order_acquire) != s_periodCounter)
+	{
+		// The model has not been used sample-exactly before: compute its buffer now and
+		// leave it to updateValueBuffers() from the next period on
+		{
+			const auto lock = std::lock_guard{s_valueBufferModelsMutex};
+			if (!m_valueBufferRegistered)
+			{
+				s_valueBufferModels.push_back(this);
+				m_valueBufferRegistered = true;
+			}
+		}
+		updateValueBuffer();
+	}
+
+	return m_hasSampleExactData
+		? &m_valueBuffer
+		: nullptr;
+}
+
+
+
+
+void AutomatableModel::updateValueBuffers()
+{
+	const auto lock = std::lock_guard{s_valueBufferModelsMutex};
+	// Computing a buffer may register further models (e.g. an LFO controller's amount),
+	// which appends to the list, so iterators must not be held across the calls
+	for (std::size_t i = 0; i < s_valueBufferModels.size(); ++i)
 	{
-		return m_hasSampleExactData
-			? &m_valueBuffer
-			: nullptr;
+		s_valueBufferModels[i]->updateValueBuffer();
 	}
+}
+
+
+
+
+void AutomatableModel::updateValueBuffer()
+{
+	// linked models may have been updated already
+	if (m_lastUpdatedPeriod.load(std::memory_order_relaxed) == s_periodCounter) { return; }
 
 	float val = m_value; // make sure our m_value doesn't change midway
+	m_hasSampleExactData = false;
 
 	if (m_controllerConnection && m_useControllerValue && m_controllerConnection->getController()->isSampleExact())
 	{
@@ -628,49 +674,39 @@ ValueBuffer * AutomatableModel::valueBuffer()
 					"lacks implementation for a scale type");
 				break;
 			}
-			m_lastUpdatedPeriod = s_periodCounter;
 			m_hasSampleExactData = true;
-			return &m_valueBuffer;
 		}
 	}
-
-	if (!m_controllerConnection)
+	else if (!m_controllerConnection && hasLinkedModels())
 	{
-		AutomatableModel* lm = nullptr;
-		if (hasLinkedModels())
-		{
-			lm = m_linkedModels.front();
-		}
-		if (lm && lm->controllerConnection() && lm->useControllerValue() &&
+		AutomatableModel* lm = m_linkedModels.front();
+		if (lm->controllerConnection() && lm->useControllerValue() &&
 				lm->controllerConnection()->getController()->isSampleExact())
 		{
-			auto vb = lm->valueBuffer();
-			float * values = vb->values();
-			float * nvalues = m_valueBuffer.values();
-			for (int i = 0; i < vb->length(); i++)
+			lm->updateValueBuffer();
+			if (lm->m_hasSampleExactData)
 			{
-				nvalues[i] = fittedValue(values[i]);
+				float * values = lm->m_valueBuffer.values();
+				float * nvalues = m_valueBuffer.values();
+				for (int i = 0; i < lm->m_valueBuffer.length(); i++)
+				{
+					nvalues[i] = fittedValue(values[i]);
+				}
+				m_hasSampleExactData = true;
 			}
-			m_lastUpdatedPeriod = s_periodCounter;
-			m_hasSampleExactData = true;
-			return &m_valueBuffer;
 		}
 	}
 
-	if( m_oldValue != val )
+	if (!m_hasSampleExactData && m_oldValue != val)
 	{
 		m_valueBuffer.interpolate( m_oldValue, val );
 		m_oldValue = val;
-		m_lastUpdatedPeriod = s_periodCounter;
 		m_hasSampleExactData = true;
-		return &m_valueBuffer;
 	}
 
-	// if we have no sample-exact source for a ValueBuffer, return NULL to signify that no data is available at the moment
-	// in which case the recipient knows to use the static value() instead
-	m_lastUpdatedPeriod = s_periodCounter;
-	m_hasSampleExactData = false;
-	return nullptr;
+	// if we have no sample-exact source for a ValueBuffer, m_hasSampleExactData stays false to signify that
+	// no data is available at the moment, in which case the recipient knows to use the static value() instead
+	m_lastUpdatedPeriod.store(s_periodCounter, std::memory_order_release);
 }
 
 
@@ -697,6 +697,11 @@ void ConfigManager::saveConfigFile()
 	outfile.close();
 }
 
+QString ConfigManager::fftwWisdomFile() const
+{
+	return QFileInfo(m_lmmsRcFile).absolutePath() + "/.lmms-fftw-wisdom";
+}
+
 void ConfigManager::initPortableWorkingDir()
 {
 	QString applicationPath = qApp->applicationDirPath();
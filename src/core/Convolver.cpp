@@ -0,0 +1,379 @@
+/*
+ * Convolver.cpp
+ *
+ * Copyright (c) 2026 LMMS Developers
+ *
+ * This file is part of LMMS - https://lmms.io
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public
+ * License along with this program (see COPYING); if not, write to the
+ * Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA 02110-1301 USA.
+ *
+ */
+
+
+#include "Convolver.h"
+
+#include <algorithm>
+#include <cassert>
+
+#include "AudioEngine.h"
+#include "Engine.h"
+#include "FFTPlanCache.h"
+#include "Song.h"
+#include "ThreadScheduling.h"
+
+namespace lmms
+{
+
+namespace
+{
+
+//! Rendering without a deadline, like an export, waits for the background thread instead of dropping its blocks
+bool rendersOffline()
+{
+	const auto audioEngine = Engine::audioEngine();
+	const auto song = Engine::getSong();
+	return !audioEngine || audioEngine->renderOnly() || (song && song->isExporting());
+}
+
+} // namespace
+
+/**
+	Mono convolution with equally sized partitions of the impulse response
+
+	Each partition is convolved by multiplying its spectrum with the spectrum of
+	the input block it applies to, and the results are added with overlap-add.
+	Blocks which are not complete yet are transformed with zeros in place of the
+	missing input, so process() can return any number of frames without delay.
+	The partitions that apply to earlier, complete input blocks do not change
+	during a block, so their sum is only computed once per block.
+*/
+class Convolver::Partitions
+{
+public:
+	Partitions(std::size_t blockSize, const float* impulseResponse, std::size_t length) :
+		m_blockSize(blockSize),
+		m_bins(blockSize + 1),
+		m_count((length + blockSize - 1) / blockSize),
+		m_fftBuffer(2 * blockSize),
+		m_spectrum(m_bins),
+		m_forward(FFTPlanCache::instance().plan(static_cast<int>(2 * blockSize), FFTPlanCache::Direction::Forward)),
+		m_inverse(FFTPlanCache::instance().plan(static_cast<int>(2 * blockSize), FFTPlanCache::Direction::Inverse)),
+		m_filterSpectra(m_count * m_bins * 2),
+		m_inputSpectra(m_count * m_bins * 2),
+		m_earlierBlocks(m_bins * 2),
+		m_inputBlock(blockSize),
+		m_overlap(blockSize)
+	{
+		// FFTW does not normalize, so the scale of the round trip goes into the filters
+		const float scale = 1.f / (2 * blockSize);
+		for (std::size_t p = 0; p < m_count; ++p)
+		{
+			const auto begin = p * blockSize;
+			const auto frames = std::min(blockSize, length - begin);
+			std::fill(m_fftBuffer.begin(), m_fftBuffer.end(), 0.f);
+			std::transform(impulseResponse + begin, impulseResponse + begin + frames, m_fftBuffer.begin(),
+				[scale](float s) { return s * scale; });
+			m_forward.forward(m_fftBuffer.data(), m_spectrum.data());
+			std::copy_n(&m_spectrum[0][0], m_bins * 2, m_filterSpectra.data() + p * m_bins * 2);
+		}
+	}
+
+	void process(const float* in, float* out, std::size_t frames)
+	{
+		if (m_count == 0)
+		{
+			std::fill_n(out, frames, 0.f);
+			return;
+		}
+
+		for (std::size_t done = 0; done < frames; )
+		{
+			const bool blockStarts = m_inputFill == 0;
+			const auto count = std::min(frames - done, m_blockSize - m_inputFill);
+			std::copy_n(in + done, count, m_inputBlock.data() + m_inputFill);
+
+			std::copy(m_inputBlock.begin(), m_inputBlock.end(), m_fftBuffer.begin());
+			std::fill_n(m_fftBuffer.begin() + m_blockSize, m_blockSize, 0.f);
+			m_forward.forward(m_fftBuffer.data(), m_spectrum.data());
+			float* current = m_inputSpectra.data() + m_current * m_bins * 2;
+			std::copy_n(&m_spectrum[0][0], m_bins * 2, current);
+
+			if (blockStarts)
+			{
+				std::fill(m_earlierBlocks.begin(), m_earlierBlocks.end(), 0.f);
+				for (std::size_t p = 1; p < m_count; ++p)
+				{
+					const auto block = (m_current + p) % m_count;
+					multiplyAdd(m_filterSpectra.data() + p * m_bins * 2,
+						m_inputSpectra.data() + block * m_bins * 2, m_earlierBlocks.data());
+				}
+			}
+
+			std::copy(m_earlierBlocks.begin(), m_earlierBlocks.end(), &m_spectrum[0][0]);
+			multiplyAdd(m_filterSpectra.data(), current, &m_spectrum[0][0]);
+			m_inverse.inverse(m_spectrum.data(), m_fftBuffer.data());
+
+			for (std::size_t f = 0; f < count; ++f)
+			{
+				out[done + f] = m_fftBuffer[m_inputFill + f] + m_overlap[m_inputFill + f];
+			}
+
+			m_inputFill += count;
+			if (m_inputFill == m_blockSize)
+			{
+				std::fill(m_inputBlock.begin(), m_inputBlock.end(), 0.f);
+				std::copy_n(m_fftBuffer.begin() + m_blockSize, m_blockSize, m_overlap.data());
+				m_current = m_current > 0 ? m_current - 1 : m_count - 1;
+				m_inputFill = 0;
+			}
+			done += count;
+		}
+	}
+
+	//! Continues as if a block of silence had been processed, without computing its output
+	void skipBlock()
+	{
+		if (m_count == 0) { return; }
+		assert(m_inputFill == 0);
+		std::fill_n(m_inputSpectra.data() + m_current * m_bins * 2, m_bins * 2, 0.f);
+		std::fill(m_overlap.begin(), m_overlap.end(), 0.f);
+		m_current = m_current > 0 ? m_current - 1 : m_count - 1;
+	}
+
+private:
+	//! Adds the product of the interleaved complex spectra @p a and @p b to @p sum
+	void multiplyAdd(const float* a, const float* b, float* sum) const
+	{
+		for (std::size_t i = 0; i < m_bins * 2; i += 2)
+		{
+			sum[i] += a[i] * b[i] - a[i + 1] * b[i + 1];
+			sum[i + 1] += a[i] * b[i + 1] + a[i + 1] * b[i];
+		}
+	}
+
+	const std::size_t m_blockSize;
+	const std::size_t m_bins;
+	const std::size_t m_count; //!< number of partitions
+
+	FFTBuffer<float> m_fftBuffer;
+	FFTBuffer<fftwf_complex> m_spectrum;
+	FFTPlan m_forward;
+	FFTPlan m_inverse;
+
+	std::vector<float> m_filterSpectra; //!< spectrum of each partition
+	std::vector<float> m_inputSpectra; //!< spectra of the last m_count input blocks, a ring starting at m_current
+	std::vector<float> m_earlierBlocks; //!< sum of all partitions but the first for the current block
+	std::size_t m_current = 0;
+
+	std::vector<float> m_inputBlock;
+	std::size_t m_inputFill = 0;
+	std::vector<float> m_overlap; //!< second half of the result of the last complete block
+};
+
+
+
+
+Convolver::Convolver(const SampleFrame* impulseResponse, f_cnt_t frames,
+		fpp_t headBlockSize, fpp_t tailBlockSize) :
+	m_impulseLength(frames),
+	m_headBlockSize(headBlockSize),
+	m_tailBlockSize(tailBlockSize),
+	m_tailStart(0),
+	m_tailDone(0)
+{
+	assert(tailBlockSize > headBlockSize && tailBlockSize % headBlockSize == 0);
+
+	const auto channel = std::vector<float>(frames);
+	auto impulseChannels = ChannelBuffers{channel, channel};
+	for (f_cnt_t f = 0; f < frames; ++f)
+	{
+		impulseChannels[0][f] = impulseResponse[f].left();
+		impulseChannels[1][f] = impulseResponse[f].right();
+	}
+
+	for (int ch = 0; ch < DEFAULT_CHANNELS; ++ch)
+	{
+		const float* ir = impulseChannels[ch].data();
+		m_input[ch].resize(headBlockSize);
+		m_output[ch].resize(headBlockSize);
+
+		m_head[ch] = std::make_unique<Partitions>(headBlockSize, ir, std::min<f_cnt_t>(frames, tailBlockSize));
+
+		if (frames > tailBlockSize)
+		{
+			m_tail0[ch] = std::make_unique<Partitions>(headBlockSize, ir + tailBlockSize,
+				std::min<f_cnt_t>(frames - tailBlockSize, tailBlockSize));
+			m_tailInput[ch].resize(tailBlockSize);
+			m_tail0Output[ch].resize(tailBlockSize);
+			m_tail0Precalculated[ch].resize(tailBlockSize);
+		}
+
+		if (frames > 2 * tailBlockSize)
+		{
+			m_tail[ch] = std::make_unique<Partitions>(tailBlockSize, ir + 2 * tailBlockSize,
+				frames - 2 * tailBlockSize);
+			m_tailOutput[ch].resize(tailBlockSize);
+			m_tailPrecalculated[ch].resize(tailBlockSize);
+			m_backgroundInput[ch].resize(tailBlockSize);
+		}
+	}
+
+	if (m_tail[0]) { m_tailThread = std::thread{&Convolver::tailThread, this}; }
+}
+
+
+
+
+Convolver::~Convolver()
+{
+	if (m_tailThread.joinable())
+	{
+		m_exit = true;
+		m_tailStart.post();
+		m_tailThread.join();
+	}
+}
+
+
+
+
+void Convolver::process(const SampleFrame* in, SampleFrame* out, fpp_t frames)
+{
+	for (fpp_t done = 0; done < frames; )
+	{
+		// stay within the head blocks, so the second tail part can run on complete ones
+		const auto count = std::min<fpp_t>(frames - done, m_headBlockSize - m_tailInputFill % m_headBlockSize);
+		for (fpp_t f = 0; f < count; ++f)
+		{
+			m_input[0][f] = in[done + f].left();
+			m_input[1][f] = in[done + f].right();
+		}
+
+		for (int ch = 0; ch < DEFAULT_CHANNELS; ++ch)
+		{
+			m_head[ch]->process(m_input[ch].data(), m_output[ch].data(), count);
+		}
+		if (m_tail0[0]) { processTail(count); }
+
+		for (fpp_t f = 0; f < count; ++f)
+		{
+			out[done + f] = SampleFrame(m_output[0][f], m_output[1][f]);
+		}
+		done += count;
+	}
+}
+
+
+
+
+void Convolver::processTail(fpp_t frames)
+{
+	for (int ch = 0; ch < DEFAULT_CHANNELS; ++ch)
+	{
+		float* output = m_output[ch].data();
+		const float* tail0 = m_tail0Precalculated[ch].data() + m_tailInputFill;
+		for (fpp_t f = 0; f < frames; ++f) { output[f] += tail0[f]; }
+		if (m_tail[ch])
+		{
+			const float* tail = m_tailPrecalculated[ch].data() + m_tailInputFill;
+			for (fpp_t f = 0; f < frames; ++f) { output[f] += tail[f]; }
+		}
+		std::copy_n(m_input[ch].data(), frames, m_tailInput[ch].data() + m_tailInputFill);
+	}
+	m_tailInputFill += frames;
+
+	if (m_tailInputFill % m_headBlockSize == 0)
+	{
+		const auto offset = m_tailInputFill - m_headBlockSize;
+		for (int ch = 0; ch < DEFAULT_CHANNELS; ++ch)
+		{
+			m_tail0[ch]->process(m_tailInput[ch].data() + offset, m_tail0Output[ch].data() + offset, m_headBlockSize);
+		}
+	}
+
+	if (m_tailInputFill < m_tailBlockSize) { return; }
+
+	std::swap(m_tail0Precalculated, m_tail0Output);
+	if (m_tail[0])
+	{
+		// the result of the previous block is played during the next one, which gives the
+		// background thread a whole tail block of time and matches the offset of its partitions
+		if (m_tailBusy && rendersOffline())
+		{
+			m_tailDone.wait();
+			m_tailBusy = false;
+		}
+		if (!m_tailBusy || m_tailDone.tryWait())
+		{
+			if (m_tailLate)
+			{
+				// the result is a block too late to be played, the block in between has been silent already
+				m_tailLate = false;
+			}
+			else
+			{
+				std::swap(m_tailPrecalculated, m_tailOutput);
+			}
+			for (int ch = 0; ch < DEFAULT_CHANNELS; ++ch)
+			{
+				std::copy(m_tailInput[ch].begin(), m_tailInput[ch].end(), m_backgroundInput[ch].begin());
+			}
+			m_tailStart.post();
+			m_tailBusy = true;
+		}
+		else
+		{
+			// The background thread missed its deadline. The audio thread must not wait for it, so the next tail
+			// block is played without this part, and its input is dropped. The background thread skips the
+			// dropped input to keep its partitions aligned.
+			for (auto& buffer : m_tailPrecalculated) { std::fill(buffer.begin(), buffer.end(), 0.f); }
+			++m_skippedBlocks;
+			m_tailLate = true;
+		}
+	}
+	m_tailInputFill = 0;
+}
+
+
+
+
+void Convolver::tailThread()
+{
+	// Just below the audio threads, so the tail is not delayed by normal threads, but never delays the audio
+	if (const auto audioEngine = Engine::audioEngine())
+	{
+		auto settings = audioEngine->schedulingSettings();
+		--settings.priority;
+		ThreadScheduling::applyToCurrentThread(settings);
+	}
+
+	while (true)
+	{
+		m_tailStart.wait();
+		if (m_exit) { return; }
+		for (int skipped = m_skippedBlocks.exchange(0); skipped > 0; --skipped)
+		{
+			for (auto& tail : m_tail) { tail->skipBlock(); }
+		}
+		for (int ch = 0; ch < DEFAULT_CHANNELS; ++ch)
+		{
+			m_tail[ch]->process(m_backgroundInput[ch].data(), m_tailOutput[ch].data(), m_tailBlockSize);
+		}
+		m_tailDone.post();
+	}
+}
+
+} // namespace lmms
@@ -41,6 +41,12 @@ EffectChain::EffectChain( Model * _parent ) :
 	SerializingObject(),
 	m_enabledModel( false, nullptr, tr( "Effects enabled" ) )
 {
+	const fpp_t frames = Engine::audioEngine()->framesPerPeriod();
+	for (ch_cnt_t ch = 0; ch < DEFAULT_CHANNELS; ++ch)
+	{
+		m_planarInput[ch].resize(frames);
+		m_planarOutput[ch].resize(frames);
+	}
 }
 
 
@@ -186,7 +192,8 @@ void EffectChain::moveUp( Effect * _effect )
 
 bool EffectChain::processAudioBuffer( SampleFrame* _buf, const fpp_t _frames, bool hasInputNoise )
 {
-	if( m_enabledModel.value() == false )
+	// without input and running effects, the buffer is silent
+	if (m_enabledModel.value() == false || (!hasInputNoise && !isRunning()))
 	{
 		return false;
 	}
@@ -225,6 +232,36 @@ void EffectChain::startRunning()
 
 
 
+bool EffectChain::isRunning() const
+{
+	return m_enabledModel.value()
+		&& std::any_of(m_effects.begin(), m_effects.end(), [](const Effect* e) { return e->isRunning(); });
+}
+
+
+
+
+f_cnt_t EffectChain::latency() const
+{
+	if( m_enabledModel.value() == false )
+	{
+		return 0;
+	}
+
+	f_cnt_t total = 0;
+	for (const auto& effect : m_effects)
+	{
+		if (effect->isOkay() && !effect->dontRun() && effect->isEnabled())
+		{
+			total += effect->latency();
+		}
+	}
+	return total;
+}
+
+
+
+
 void EffectChain::clear()
 {
 	emit aboutToClear();
@@ -0,0 +1,234 @@
+/*
+ * FFTPlanCache.cpp
+ *
+ * Copyright (c) 2026 LMMS Developers
+ *
+ * This file is part of LMMS - https://lmms.io
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public
+ * License along with this program (see COPYING); if not, write to the
+ * Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA 02110-1301 USA.
+ *
+ */
+
+
+#include "FFTPlanCache.h"
+
+#include <atomic>
+#include <cassert>
+
+#include "ConfigManager.h"
+
+namespace lmms
+{
+
+namespace
+{
+
+//! Upper bound in seconds for measuring a single plan
+constexpr double MeasureTimeLimit = 2.0;
+
+} // namespace
+
+
+struct FFTPlan::Entry
+{
+	Entry(int size, FFTPlanCache::Direction direction, fftwf_plan plan) :
+		size(size),
+		direction(direction),
+		plan(plan),
+		initialPlan(plan)
+	{
+	}
+
+	const int size;
+	const FFTPlanCache::Direction direction;
+	std::atomic<fftwf_plan> plan;
+	//! Executing threads might still use this plan after the measured one replaced it
+	const fftwf_plan initialPlan;
+};
+
+
+
+
+int FFTPlan::size() const
+{
+	return m_entry ? m_entry->size : 0;
+}
+
+
+
+
+void FFTPlan::forward(float* in, fftwf_complex* out) const
+{
+	assert(m_entry && m_entry->direction == FFTPlanCache::Direction::Forward);
+	fftwf_execute_dft_r2c(m_entry->plan.load(std::memory_order_acquire), in, out);
+}
+
+
+
+
+void FFTPlan::inverse(fftwf_complex* in, float* out) const
+{
+	assert(m_entry && m_entry->direction == FFTPlanCache::Direction::Inverse);
+	fftwf_execute_dft_c2r(m_entry->plan.load(std::memory_order_acquire), in, out);
+}
+
+
+
+
+FFTPlanCache& FFTPlanCache::instance()
+{
+	static FFTPlanCache cache;
+	return cache;
+}
+
+
+
+
+FFTPlanCache::FFTPlanCache() :
+	m_wisdomFile(ConfigManager::inst()->fftwWisdomFile().toLocal8Bit().toStdString())
+{
+	const auto lock = std::lock_guard{m_plannerMutex};
+	fftwf_import_wisdom_from_filename(m_wisdomFile.c_str());
+}
+
+
+
+
+FFTPlanCache::~FFTPlanCache()
+{
+	{
+		const auto lock = std::lock_guard{m_entriesMutex};
+		m_exit = true;
+	}
+	m_measureCondition.notify_all();
+	if (m_measureThread.joinable()) { m_measureThread.join(); }
+
+	for (auto& [key, entry] : m_entries)
+	{
+		const auto plan = entry->plan.load();
+		if (plan != entry->initialPlan) { fftwf_destroy_plan(plan); }
+		fftwf_destroy_plan(entry->initialPlan);
+	}
+}
+
+
+
+
+FFTPlan FFTPlanCache::plan(int size, Direction direction)
+{
+	assert(size > 0);
+
+	auto lock = std::unique_lock{m_entriesMutex};
+	const auto key = std::pair{size, direction};
+	if (const auto it = m_entries.find(key); it != m_entries.end()) { return FFTPlan{it->second.get()}; }
+
+	// Planning can take a while even from wisdom, so don't block other lookups meanwhile.
+	// Two threads asking for the same new size both plan it, the second one keeps the first plan.
+	lock.unlock();
+	bool measured = true;
+	fftwf_plan newPlan;
+	{
+		const auto plannerLock = std::lock_guard{m_plannerMutex};
+		newPlan = createPlan(size, direction, FFTW_MEASURE | FFTW_WISDOM_ONLY);
+		if (!newPlan)
+		{
+			newPlan = createPlan(size, direction, FFTW_ESTIMATE);
+			measured = false;
+		}
+	}
+	lock.lock();
+
+	auto& entry = m_entries[key];
+	if (entry)
+	{
+		const auto existing = FFTPlan{entry.get()};
+		lock.unlock();
+		const auto plannerLock = std::lock_guard{m_plannerMutex};
+		fftwf_destroy_plan(newPlan);
+		return existing;
+	}
+
+	entry = std::make_unique<FFTPlan::Entry>(size, direction, newPlan);
+	if (!measured)
+	{
+		m_toMeasure.push_back(entry.get());
+		if (!m_measureThread.joinable()) { m_measureThread = std::thread{&FFTPlanCache::measureThread, this}; }
+		m_measureCondition.notify_one();
+	}
+	return FFTPlan{entry.get()};
+}
+
+
+
+
+void FFTPlanCache::waitForMeasurements()
+{
+	auto lock = std::unique_lock{m_entriesMutex};
+	m_measuredCondition.wait(lock, [this] { return m_toMeasure.empty() && !m_measuring; });
+}
+
+
+
+
+fftwf_plan FFTPlanCache::createPlan(int size, Direction direction, unsigned flags)
+{
+	// Measuring overwrites the arrays, so plan on temporary ones with the same alignment
+	auto real = FFTBuffer<float>(size);
+	auto complex = FFTBuffer<fftwf_complex>(size / 2 + 1);
+	return direction == Direction::Forward
+		? fftwf_plan_dft_r2c_1d(size, real.data(), complex.data(), flags)
+		: fftwf_plan_dft_c2r_1d(size, complex.data(), real.data(), flags);
+}
+
+
+
+
+void FFTPlanCache::measureThread()
+{
+	auto lock = std::unique_lock{m_entriesMutex};
+	while (true)
+	{
+		m_measureCondition.wait(lock, [this] { return m_exit || !m_toMeasure.empty(); });
+		if (m_exit) { break; }
+
+		FFTPlan::Entry* entry = m_toMeasure.back();
+		m_toMeasure.pop_back();
+		m_measuring = true;
+		lock.unlock();
+
+		{
+			const auto plannerLock = std::lock_guard{m_plannerMutex};
+			fftwf_set_timelimit(MeasureTimeLimit);
+			const auto measuredPlan = createPlan(entry->size, entry->direction, FFTW_MEASURE);
+			fftwf_set_timelimit(FFTW_NO_TIMELIMIT);
+			if (measuredPlan) { entry->plan.store(measuredPlan, std::memory_order_release); }
+		}
+
+		lock.lock();
+		if (m_toMeasure.empty())
+		{
+			// Save the wisdom once a batch of new sizes is done, e.g. after loading a project
+			lock.unlock();
+			const auto plannerLock = std::lock_guard{m_plannerMutex};
+			fftwf_export_wisdom_to_filename(m_wisdomFile.c_str());
+			lock.lock();
+		}
+		m_measuring = false;
+		m_measuredCondition.notify_all();
+	}
+}
+
+} // namespace lmms
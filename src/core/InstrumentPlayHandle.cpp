@@ -28,6 +28,8 @@
 #include "InstrumentTrack.h"
 #include "Engine.h"
 #include "AudioEngine.h"
+#include "BufferManager.h"
+#include "MixHelpers.h"
 
 namespace lmms
 {
@@ -35,13 +37,31 @@ namespace lmms
 
 InstrumentPlayHandle::InstrumentPlayHandle(Instrument * instrument, InstrumentTrack* instrumentTrack) :
 	PlayHandle(Type::InstrumentPlayHandle),
-	m_instrument(instrument)
+	m_instrument(instrument),
+	m_noteBuffer(instrument->isVoiceBatched() ? BufferManager::acquire() : nullptr)
 {
 	setAudioBusHandle(instrumentTrack->audioBusHandle());
 }
 
+InstrumentPlayHandle::~InstrumentPlayHandle()
+{
+	if (m_noteBuffer)
+	{
+		BufferManager::release(m_noteBuffer);
+	}
+}
+
 void InstrumentPlayHandle::play(SampleFrame* working_buffer)
 {
+	// read by the mixer for delay compensation in the next period
+	audioBusHandle()->setSourceLatency(m_instrument->latency());
+
+	if (m_instrument->isVoiceBatched())
+	{
+		playNotes(working_buffer);
+		return;
+	}
+
 	InstrumentTrack * instrumentTrack = m_instrument->instrumentTrack();
 
 	// ensure that all our nph's have been processed first
@@ -66,7 +86,42 @@ void InstrumentPlayHandle::play(SampleFrame* working_buffer)
 
 	// Process the audio buffer that the instrument has just worked on...
 	const fpp_t frames = Engine::audioEngine()->framesPerPeriod();
-	instrumentTrack->processAudioBuffer(working_buffer, frames, nullptr);
+	if (!instrumentTrack->processAudioBuffer(working_buffer, frames, nullptr))
+	{
+		// the track has just checked this, the bus handle does not need to check again
+		setBufferSilent(true);
+	}
+}
+
+void InstrumentPlayHandle::playNotes(SampleFrame* working_buffer)
+{
+	const fpp_t frames = Engine::audioEngine()->framesPerPeriod();
+	bool anyNotes = false;
+
+	// The nph's of voice batched instruments are not queued as separate jobs (see
+	// NotePlayHandle::requiresProcessing), so all of them are played from here. Each one
+	// still runs through its own sound shaping, but they share a single buffer.
+	for (const auto& handle : NotePlayHandle::nphsOfInstrumentTrack(m_instrument->instrumentTrack(), true))
+	{
+		auto nph = const_cast<NotePlayHandle*>(handle);
+		if (nph->isFinished()) { continue; }
+
+		if (nph->usesBuffer())
+		{
+			zeroSampleFrames(m_noteBuffer, frames);
+			nph->play(m_noteBuffer);
+			MixHelpers::add(working_buffer, m_noteBuffer, frames);
+			anyNotes = true;
+		}
+		else
+		{
+			// e.g. the master note of a chord or an arpeggio
+			nph->play(nullptr);
+		}
+	}
+
+	// like separate note play handles, playing notes are assumed to be audible
+	setBufferSilent(!anyNotes);
 }
 
 bool InstrumentPlayHandle::isFromTrack(const Track* track) const
@@ -22,7 +22,7 @@
  *
  */
 
-#include <QVarLengthArray>
+#include <array>
 #include <QDomElement>
 
 #include "InstrumentSoundShaping.h"
@@ -41,6 +41,12 @@ const float CUT_FREQ_MULTIPLIER = 6000.0f;
 const float RES_MULTIPLIER = 2.0f;
 const float RES_PRECISION = 1000.0f;
 
+// Envelope/LFO levels of the period being processed. Every worker thread gets its
+// own set, so that processAudioBuffer() does not need to allocate them per call.
+static thread_local std::array<float, MAXIMUM_BUFFER_SIZE> s_cutBuffer;
+static thread_local std::array<float, MAXIMUM_BUFFER_SIZE> s_resBuffer;
+static thread_local std::array<float, MAXIMUM_BUFFER_SIZE> s_volBuffer;
+
 
 InstrumentSoundShaping::InstrumentSoundShaping(
 					InstrumentTrack * _instrument_track ) :
@@ -131,16 +137,12 @@ void InstrumentSoundShaping::processAudioBuffer( SampleFrame* buffer,
 
 	if( m_filterEnabledModel.value() )
 	{
-		QVarLengthArray<float> cutBuffer(frames);
-		QVarLengthArray<float> resBuffer(frames);
+		auto& cutBuffer = s_cutBuffer;
+		auto& resBuffer = s_resBuffer;
 
 		int old_filter_cut = 0;
 		int old_filter_res = 0;
 
-		if( n->m_filter == nullptr )
-		{
-			n->m_filter = std::make_unique<BasicFilters<>>( Engine::audioEngine()->outputSampleRate() );
-		}
 		n->m_filter->setFilterType( static_cast<BasicFilters<>::FilterType>(m_filterModel.value()) );
 
 		if (cutoffParameters.isUsed())
@@ -226,7 +228,7 @@ void InstrumentSoundShaping::processAudioBuffer( SampleFrame* buffer,
 
 	if (volumeParameters.isUsed())
 	{
-		QVarLengthArray<float> volBuffer(frames);
+		auto& volBuffer = s_volBuffer;
 		volumeParameters.fillLevel(volBuffer.data(), envTotalFrames, envReleaseBegin, frames);
 
 		for( fpp_t frame = 0; frame < frames; ++frame )
@@ -0,0 +1,92 @@
+/*
+ * LatencyCompensator.cpp - fixed capacity delay line for plugin delay compensation
+ *
+ * Copyright (c) 2026 LMMS Developers
+ *
+ * This file is part of LMMS - https://lmms.io
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public
+ * License along with this program (see COPYING); if not, write to the
+ * Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA 02110-1301 USA.
+ *
+ */
+
+#include "LatencyCompensator.h"
+
+#include <algorithm>
+
+#include "SampleFrame.h"
+
+namespace lmms
+{
+
+
+LatencyCompensator::LatencyCompensator() :
+	m_buffer(std::make_unique<SampleFrame[]>(MaxDelay))
+{
+}
+
+
+
+
+void LatencyCompensator::setDelay(f_cnt_t delay)
+{
+	delay = std::min(delay, MaxDelay);
+	if (delay != m_delay)
+	{
+		m_delay = delay;
+		m_position = 0;
+		m_tail = 0;
+		zeroSampleFrames(m_buffer.get(), m_delay);
+	}
+}
+
+
+
+
+bool LatencyCompensator::process(const SampleFrame* in, SampleFrame* out, fpp_t frames, bool hasInput)
+{
+	if (m_delay == 0)
+	{
+		if (hasInput && in != out) { std::copy(in, in + frames, out); }
+		return hasInput;
+	}
+
+	if (hasInput)
+	{
+		m_tail = m_delay;
+	}
+	else if (m_tail == 0)
+	{
+		// everything in the delay line is silent, no need to rotate it
+		return false;
+	}
+	else
+	{
+		m_tail = m_tail > frames ? m_tail - frames : 0;
+	}
+
+	// without input, the contents of the input buffer are undefined and silence is fed instead
+	for (fpp_t f = 0; f < frames; ++f)
+	{
+		const SampleFrame sample = hasInput ? in[f] : SampleFrame{};
+		out[f] = m_buffer[m_position];
+		m_buffer[m_position] = sample;
+		if (++m_position == m_delay) { m_position = 0; }
+	}
+	return true;
+}
+
+
+} // namespace lmms
@@ -30,6 +30,11 @@
 
 #include <cmath>
 
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+#include "MultiChannelBuffer.h"
 #include "ValueBuffer.h"
 #include "SampleFrame.h"
 
@@ -268,6 +273,51 @@ void addSanitizedMultiplied( SampleFrame* dst, const SampleFrame* src, float coe
 
 
 
+struct CopyMultipliedOp
+{
+	CopyMultipliedOp(float coeff) : m_coeff(coeff) { }
+
+	void operator()(SampleFrame& dst, const SampleFrame& src) const
+	{
+		dst = src * m_coeff;
+	}
+
+	const float m_coeff;
+};
+
+void copyMultiplied(SampleFrame* dst, const SampleFrame* src, float coeffSrc, int frames)
+{
+	run<>(dst, src, frames, CopyMultipliedOp(coeffSrc));
+}
+
+
+
+struct CopySanitizedMultipliedOp
+{
+	CopySanitizedMultipliedOp(float coeff) : m_coeff(coeff) { }
+
+	void operator()(SampleFrame& dst, const SampleFrame& src) const
+	{
+		dst[0] = (std::isinf(src[0]) || std::isnan(src[0])) ? 0.0f : src[0] * m_coeff;
+		dst[1] = (std::isinf(src[1]) || std::isnan(src[1])) ? 0.0f : src[1] * m_coeff;
+	}
+
+	const float m_coeff;
+};
+
+void copySanitizedMultiplied(SampleFrame* dst, const SampleFrame* src, float coeffSrc, int frames)
+{
+	if (!useNaNHandler())
+	{
+		copyMultiplied(dst, src, coeffSrc, frames);
+		return;
+	}
+
+	run<>(dst, src, frames, CopySanitizedMultipliedOp(coeffSrc));
+}
+
+
+
 struct AddMultipliedStereoOp
 {
 	AddMultipliedStereoOp( float coeffLeft, float coeffRight )
@@ -329,5 +379,72 @@ void multiplyAndAddMultipliedJoined( SampleFrame* dst,
 	run<>( dst, srcLeft, srcRight, frames, MultiplyAndAddMultipliedOp(coeffDst, coeffSrc) );
 }
 
+
+
+/*! \brief Adds a stereo pair to channels first and first + 1 of a bus with Stride channels per frame
+ *
+ * The stride is a compile time constant so that the compiler can unroll and vectorize each width on its own.
+ * A stereo bus is laid out like a SampleFrame buffer and is processed four samples at a time.
+ */
+template<int Stride>
+static void addToBusPair(sample_t* dst, const SampleFrame* src, float coeff, fpp_t frames)
+{
+	const sample_t* in = src->data();
+	fpp_t f = 0;
+#ifdef __SSE2__
+	if constexpr (Stride == DEFAULT_CHANNELS)
+	{
+		const auto coeffVec = _mm_set1_ps(coeff);
+		for (; f + 2 <= frames; f += 2)
+		{
+			const auto sum = _mm_add_ps(_mm_loadu_ps(dst + f * 2), _mm_mul_ps(_mm_loadu_ps(in + f * 2), coeffVec));
+			_mm_storeu_ps(dst + f * 2, sum);
+		}
+	}
+#endif
+	for (; f < frames; ++f)
+	{
+		dst[f * Stride] += in[f * 2] * coeff;
+		dst[f * Stride + 1] += in[f * 2 + 1] * coeff;
+	}
+}
+
+void addToBus(MultiChannelBuffer& dst, ch_cnt_t first, const SampleFrame* src, float coeff, fpp_t frames)
+{
+	sample_t* out = dst.data();
+	switch (dst.channels())
+	{
+	case 1:
+		// there is no room for a pair, so the source is folded down
+		for (fpp_t f = 0; f < frames; ++f)
+		{
+			out[f] += (src[f].left() + src[f].right()) * 0.5f * coeff;
+		}
+		return;
+	case 2: addToBusPair<2>(out + first, src, coeff, frames); return;
+	case 4: addToBusPair<4>(out + first, src, coeff, frames); return;
+	case 6: addToBusPair<6>(out + first, src, coeff, frames); return;
+	case 8: addToBusPair<8>(out + first, src, coeff, frames); return;
+	default:
+		for (fpp_t f = 0; f < frames; ++f)
+		{
+			sample_t* frame = dst.frame(f) + first;
+			frame[0] += src[f].left() * coeff;
+			frame[1] += src[f].right() * coeff;
+		}
+	}
+}
+
+
+
+void multiply(MultiChannelBuffer& dst, float coeff)
+{
+	sample_t* samples = dst.data();
+	for (f_cnt_t i = 0; i < dst.samples(); ++i)
+	{
+		samples[i] *= coeff;
+	}
+}
+
 } // namespace lmms::MixHelpers
 
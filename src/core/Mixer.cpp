@@ -24,10 +24,14 @@
 
 #include <QDomElement>
 
+#include <algorithm>
+
+#include "AudioBusHandle.h"
 #include "AudioEngine.h"
 #include "AudioEngineWorkerThread.h"
 #include "Mixer.h"
 #include "MixHelpers.h"
+#include "MultiChannelBuffer.h"
 #include "Song.h"
 
 #include "InstrumentTrack.h"
@@ -57,6 +61,17 @@ void MixerRoute::updateName()
 }
 
 
+const SampleFrame* MixerRoute::senderOutput(SampleFrame* scratch, fpp_t frames)
+{
+	const bool hasOutput = !m_from->m_silent;
+	if (m_latencyCompensator.delay() == 0)
+	{
+		return hasOutput ? m_from->m_buffer : nullptr;
+	}
+	return m_latencyCompensator.process(m_from->m_buffer, scratch, frames, hasOutput) ? scratch : nullptr;
+}
+
+
 MixerChannel::MixerChannel( int idx, Model * _parent ) :
 	m_fxChain( nullptr ),
 	m_hasInput( false ),
@@ -67,11 +82,13 @@ MixerChannel::MixerChannel( int idx, Model * _parent ) :
 	m_muteModel( false, _parent ),
 	m_soloModel( false, _parent ),
 	m_volumeModel(1.f, 0.f, 2.f, 0.001f, _parent),
+	m_speakerPairModel(0, 0, MaxSpeakerPairs - 1, _parent),
 	m_name(),
 	m_lock(),
 	m_queued( false ),
 	m_dependenciesMet(0),
-	m_channelIndex(idx)
+	m_channelIndex(idx),
+	m_compensationBuffer(Engine::audioEngine()->framesPerPeriod())
 {
 	zeroSampleFrames(m_buffer, Engine::audioEngine()->framesPerPeriod());
 }
@@ -170,23 +187,34 @@ void MixerChannel::doProcessing()
 		for( MixerRoute * senderRoute : m_receives )
 		{
 			MixerChannel * sender = senderRoute->sender();
+			// the sender outputs to its own speakers instead
+			if (sender->m_speakerOffset > 0) { continue; }
+
 			FloatModel * sendModel = senderRoute->amount();
 			if( ! sendModel ) qFatal( "Error: no send model found from %d to %d", senderRoute->senderIndex(), m_channelIndex );
 
-			if( sender->m_hasInput || sender->m_stillRunning )
+			// mix it's output with this one's output, delayed if
+			// other inputs of this channel have a higher latency
+			if (const SampleFrame* ch_buf = senderRoute->senderOutput(m_compensationBuffer.data(), fpp))
 			{
 				// figure out if we're getting sample-exact input
 				ValueBuffer * sendBuf = sendModel->valueBuffer();
 				ValueBuffer * volBuf = sender->m_volumeModel.valueBuffer();
 
-				// mix it's output with this one's output
-				SampleFrame* ch_buf = sender->m_buffer;
+				// the first input overwrites the buffer, so it does not need to be cleared before. Sample-exact
+				// sends are rare enough to simply clear the buffer for them.
+				if (!m_hasInput && (volBuf || sendBuf))
+				{
+					zeroSampleFrames(m_buffer, fpp);
+					m_hasInput = true;
+				}
 
 				// use sample-exact mixing if sample-exact values are available
 				if( ! volBuf && ! sendBuf ) // neither volume nor send has sample-exact data...
 				{
 					const float v = sender->m_volumeModel.value() * sendModel->value();
-					MixHelpers::addSanitizedMultiplied( m_buffer, ch_buf, v, fpp );
+					if (m_hasInput) { MixHelpers::addSanitizedMultiplied(m_buffer, ch_buf, v, fpp); }
+					else { MixHelpers::copySanitizedMultiplied(m_buffer, ch_buf, v, fpp); }
 				}
 				else if( volBuf && sendBuf ) // both volume and send have sample-exact data
 				{
@@ -215,11 +243,25 @@ void MixerChannel::doProcessing()
 			m_fxChain.startRunning();
 		}
 
-		m_stillRunning = m_fxChain.processAudioBuffer( m_buffer, fpp, m_hasInput );
+		// the buffer stays silent without input and effect tails, so
+		// there is nothing to process, meter or pass on
+		m_silent = !m_hasInput && !m_fxChain.isRunning();
+		if (m_silent)
+		{
+			m_stillRunning = false;
+			Engine::audioEngine()->profiler().countSkippedNode();
+		}
+		else
+		{
+			// nothing has been written this period, but the effect tails are added to the buffer
+			if (!m_hasInput) { zeroSampleFrames(m_buffer, fpp); }
+
+			m_stillRunning = m_fxChain.processAudioBuffer( m_buffer, fpp, m_hasInput );
 
-		SampleFrame peakSamples = getAbsPeakValues(m_buffer, fpp);
-		m_peakLeft = std::max(m_peakLeft, peakSamples[0] * v);
-		m_peakRight = std::max(m_peakRight, peakSamples[1] * v);
+			SampleFrame peakSamples = getAbsPeakValues(m_buffer, fpp);
+			m_peakLeft = std::max(m_peakLeft, peakSamples[0] * v);
+			m_peakRight = std::max(m_peakRight, peakSamples[1] * v);
+		}
 	}
 	else
 	{
@@ -232,6 +274,22 @@ void MixerChannel::doProcessing()
 
 
 
+f_cnt_t MixerChannel::resolveLatency()
+{
+	if (!m_latencyResolved)
+	{
+		for (const MixerRoute* senderRoute : m_receives)
+		{
+			m_inputLatency = std::max(m_inputLatency, senderRoute->sender()->resolveLatency());
+		}
+		m_latency = m_inputLatency + m_fxChain.latency();
+		m_latencyResolved = true;
+	}
+	return m_latency;
+}
+
+
+
 Mixer::Mixer() :
 	Model( nullptr ),
 	JournallingObject(),
@@ -647,7 +705,10 @@ void Mixer::mixToChannel( const SampleFrame* _buf, mix_ch_t _ch )
 	if( m_mixerChannels[_ch]->m_muteModel.value() == false )
 	{
 		m_mixerChannels[_ch]->m_lock.lock();
-		MixHelpers::add( m_mixerChannels[_ch]->m_buffer, _buf, Engine::audioEngine()->framesPerPeriod() );
+		// the first input overwrites the buffer, so it does not need to be cleared before
+		const fpp_t fpp = Engine::audioEngine()->framesPerPeriod();
+		if (m_mixerChannels[_ch]->m_hasInput) { MixHelpers::add(m_mixerChannels[_ch]->m_buffer, _buf, fpp); }
+		else { std::copy_n(_buf, fpp, m_mixerChannels[_ch]->m_buffer); }
 		m_mixerChannels[_ch]->m_hasInput = true;
 		m_mixerChannels[_ch]->m_lock.unlock();
 	}
@@ -656,14 +717,50 @@ void Mixer::mixToChannel( const SampleFrame* _buf, mix_ch_t _ch )
 
 
 
-void Mixer::prepareMasterMix()
+void Mixer::compensateLatencies(const std::vector<AudioBusHandle*>& busHandles)
 {
-	zeroSampleFrames(m_mixerChannels[0]->m_buffer, Engine::audioEngine()->framesPerPeriod());
+	auto channelOf = [this](const AudioBusHandle* busHandle) -> MixerChannel*
+	{
+		const mix_ch_t ch = busHandle->nextMixerChannel();
+		return ch < numChannels() ? m_mixerChannels[ch] : nullptr;
+	};
+
+	for (MixerChannel* ch : m_mixerChannels)
+	{
+		ch->m_inputLatency = 0;
+		ch->m_latencyResolved = false;
+	}
+
+	// tracks feed the channels directly, channels feed each other through routes
+	for (const AudioBusHandle* busHandle : busHandles)
+	{
+		if (MixerChannel* ch = channelOf(busHandle))
+		{
+			ch->m_inputLatency = std::max(ch->m_inputLatency, busHandle->latency());
+		}
+	}
+	for (MixerChannel* ch : m_mixerChannels)
+	{
+		ch->resolveLatency();
+	}
+
+	// delay every input by the difference to the slowest input of its channel
+	for (AudioBusHandle* busHandle : busHandles)
+	{
+		if (const MixerChannel* ch = channelOf(busHandle))
+		{
+			busHandle->setLatencyCompensation(ch->m_inputLatency - busHandle->latency());
+		}
+	}
+	for (MixerRoute* route : m_mixerRoutes)
+	{
+		route->setLatencyCompensation(route->receiver()->m_inputLatency - route->sender()->m_latency);
+	}
 }
 
 
 
-void Mixer::masterMix( SampleFrame* _buf )
+void Mixer::masterMix( SampleFrame* _buf, MultiChannelBuffer* bus )
 {
 	const int fpp = Engine::audioEngine()->framesPerPeriod();
 
@@ -675,9 +772,11 @@ void Mixer::masterMix( SampleFrame* _buf )
 	// about their senders, and can just increment the deps of their
 	// recipients right away.
 	AudioEngineWorkerThread::resetJobQueue( AudioEngineWorkerThread::JobQueue::OperationMode::Dynamic );
+	const auto layout = static_cast<ChannelLayout>(bus ? bus->channels() : DEFAULT_CHANNELS);
 	for( MixerChannel * ch : m_mixerChannels )
 	{
 		ch->m_muted = ch->m_muteModel.value();
+		ch->m_speakerOffset = speakerPairOffset(layout, ch->m_speakerPairModel.value());
 		if( ch->m_muted ) // instantly "process" muted channels
 		{
 			ch->processed();
@@ -710,27 +809,62 @@ void Mixer::masterMix( SampleFrame* _buf )
 	}
 
 	// handle sample-exact data in master volume fader
-	ValueBuffer * volBuf = m_mixerChannels[0]->m_volumeModel.valueBuffer();
+	const ValueBuffer* volBuf = m_mixerChannels[0]->m_volumeModel.valueBuffer();
+	const float masterVolume = m_mixerChannels[0]->m_volumeModel.value();
 
-	if( volBuf )
+	if (!m_mixerChannels[0]->m_silent)
 	{
-		for( int f = 0; f < fpp; f++ )
+		if( volBuf )
 		{
-			m_mixerChannels[0]->m_buffer[f][0] *= volBuf->values()[f];
-			m_mixerChannels[0]->m_buffer[f][1] *= volBuf->values()[f];
+			for( int f = 0; f < fpp; f++ )
+			{
+				m_mixerChannels[0]->m_buffer[f][0] *= volBuf->values()[f];
+				m_mixerChannels[0]->m_buffer[f][1] *= volBuf->values()[f];
+			}
 		}
+
+		const float v = volBuf
+			? 1.0f
+			: masterVolume;
+		MixHelpers::copySanitizedMultiplied(_buf, m_mixerChannels[0]->m_buffer, v, fpp);
 	}
+	else
+	{
+		zeroSampleFrames(_buf, fpp);
+	}
+
+	if (bus)
+	{
+		// The front speakers get the master output, other pairs the channels routed to them. These skip the
+		// master channel's effects, which only process the front pair, but go through the master fader and mute.
+		bus->clear();
+		MixHelpers::addToBus(*bus, 0, _buf, 1.f, fpp);
+		for (std::size_t i = 1; i < m_mixerChannels.size() && !m_mixerChannels[0]->m_muted; ++i)
+		{
+			MixerChannel* ch = m_mixerChannels[i];
+			if (ch->m_speakerOffset == 0 || ch->m_muted || ch->m_silent) { continue; }
 
-	const float v = volBuf
-		? 1.0f
-		: m_mixerChannels[0]->m_volumeModel.value();
-	MixHelpers::addSanitizedMultiplied( _buf, m_mixerChannels[0]->m_buffer, v, fpp );
+			const ValueBuffer* chVolBuf = ch->m_volumeModel.valueBuffer();
+			if (chVolBuf || volBuf)
+			{
+				// the channel's buffer is overwritten in the next period, so apply sample-exact volumes in place
+				for (int f = 0; f < fpp; ++f)
+				{
+					const float gain = (chVolBuf ? chVolBuf->value(f) : 1.f) * (volBuf ? volBuf->value(f) : 1.f);
+					ch->m_buffer[f][0] *= gain;
+					ch->m_buffer[f][1] *= gain;
+				}
+			}
+			const float v = (chVolBuf ? 1.f : ch->m_volumeModel.value()) * (volBuf ? 1.f : masterVolume);
+			MixHelpers::addToBus(*bus, ch->m_speakerOffset, ch->m_buffer, v, fpp);
+		}
+	}
 
-	// clear all channel buffers and
-	// reset channel process state
+	// reset channel process state, the buffers are overwritten by
+	// their first input of the next period and need no clearing
 	for( int i = 0; i < numChannels(); ++i)
 	{
-		zeroSampleFrames(m_mixerChannels[i]->m_buffer, Engine::audioEngine()->framesPerPeriod());
+		m_mixerChannels[i]->m_silent = true;
 		m_mixerChannels[i]->reset();
 		m_mixerChannels[i]->m_queued = false;
 		// also reset hasInput
@@ -761,10 +895,12 @@ void Mixer::clearChannel(mix_ch_t index)
 	ch->m_volumeModel.setValue( 1.0f );
 	ch->m_muteModel.setValue( false );
 	ch->m_soloModel.setValue( false );
+	ch->m_speakerPairModel.setValue(0);
 	ch->m_name = ( index == 0 ) ? tr( "Master" ) : tr( "Channel %1" ).arg( index );
 	ch->m_volumeModel.setDisplayName( ch->m_name + ">" + tr( "Volume" ) );
 	ch->m_muteModel.setDisplayName( ch->m_name + ">" + tr( "Mute" ) );
 	ch->m_soloModel.setDisplayName( ch->m_name + ">" + tr( "Solo" ) );
+	ch->m_speakerPairModel.setDisplayName(ch->m_name + ">" + tr("Speakers"));
 	ch->setColor(std::nullopt);
 
 	// send only to master
@@ -801,6 +937,7 @@ void Mixer::saveSettings( QDomDocument & _doc, QDomElement & _this )
 		ch->m_volumeModel.saveSettings( _doc, mixch, "volume" );
 		ch->m_muteModel.saveSettings( _doc, mixch, "muted" );
 		ch->m_soloModel.saveSettings( _doc, mixch, "soloed" );
+		ch->m_speakerPairModel.saveSettings(_doc, mixch, "speakers");
 		mixch.setAttribute("num", static_cast<qulonglong>(i));
 		mixch.setAttribute( "name", ch->m_name );
 		if (const auto& color = ch->color()) { mixch.setAttribute("color", color->name()); }
@@ -849,6 +986,7 @@ void Mixer::loadSettings( const QDomElement & _this )
 		m_mixerChannels[num]->m_volumeModel.loadSettings( mixch, "volume" );
 		m_mixerChannels[num]->m_muteModel.loadSettings( mixch, "muted" );
 		m_mixerChannels[num]->m_soloModel.loadSettings( mixch, "soloed" );
+		m_mixerChannels[num]->m_speakerPairModel.loadSettings(mixch, "speakers");
 		m_mixerChannels[num]->m_name = mixch.attribute( "name" );
 		if (mixch.hasAttribute("color"))
 		{
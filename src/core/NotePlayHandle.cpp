@@ -36,6 +36,20 @@
 namespace lmms
 {
 
+namespace
+{
+
+//! Notes of voice batched instruments are played into the buffer of the InstrumentPlayHandle
+bool isVoiceBatched(const InstrumentTrack* instrumentTrack)
+{
+	return instrumentTrack->instrument() && instrumentTrack->instrument()->isVoiceBatched();
+}
+
+} // namespace
+
+
+
+
 NotePlayHandle::BaseDetuning::BaseDetuning( DetuningHelper *detuning ) :
 	m_value( detuning ? detuning->automationClip()->valueAt( 0 ) : 0 )
 {
@@ -53,9 +67,10 @@ NotePlayHandle::NotePlayHandle( InstrumentTrack* instrumentTrack,
 								NotePlayHandle *parent,
 								int midiEventChannel,
 								Origin origin ) :
-	PlayHandle( PlayHandle::Type::NotePlayHandle, _offset ),
+	PlayHandle(PlayHandle::Type::NotePlayHandle, _offset, !isVoiceBatched(instrumentTrack)),
 	Note(n),
 	m_pluginData( nullptr ),
+	m_filter( nullptr ),
 	m_instrumentTrack( instrumentTrack ),
 	m_frames( 0 ),
 	m_totalFramesPlayed( 0 ),
@@ -79,7 +94,8 @@ NotePlayHandle::NotePlayHandle( InstrumentTrack* instrumentTrack,
 	m_songGlobalParentOffset( 0 ),
 	m_midiChannel( midiEventChannel >= 0 ? midiEventChannel : instrumentTrack->midiPort()->realOutputChannel() ),
 	m_origin( origin ),
-	m_frequencyNeedsUpdate( false )
+	m_frequencyNeedsUpdate( false ),
+	m_voiceBatched(isVoiceBatched(instrumentTrack))
 {
 	lock();
 	if( hasParent() == false )
@@ -603,6 +619,8 @@ void NotePlayHandle::resize( const bpm_t _new_tempo )
 
 
 NotePlayHandle ** NotePlayHandleManager::s_available;
+BasicFilters<> ** NotePlayHandleManager::s_availableFilters;
+std::vector<std::unique_ptr<BasicFilters<>>> NotePlayHandleManager::s_filters;
 QReadWriteLock NotePlayHandleManager::s_mutex;
 std::atomic_int NotePlayHandleManager::s_availableIndex;
 int NotePlayHandleManager::s_size;
@@ -611,12 +629,14 @@ int NotePlayHandleManager::s_size;
 void NotePlayHandleManager::init()
 {
 	s_available = new NotePlayHandle*[INITIAL_NPH_CACHE];
+	s_availableFilters = new BasicFilters<>*[INITIAL_NPH_CACHE];
 
 	auto n = static_cast<NotePlayHandle *>(std::malloc(sizeof(NotePlayHandle) * INITIAL_NPH_CACHE));
 
 	for( int i=0; i < INITIAL_NPH_CACHE; ++i )
 	{
 		s_available[ i ] = n;
+		s_availableFilters[i] = createFilter();
 		++n;
 	}
 	s_availableIndex = INITIAL_NPH_CACHE - 1;
@@ -635,19 +655,28 @@ NotePlayHandle * NotePlayHandleManager::acquire( InstrumentTrack* instrumentTrac
 	// TODO: use some lockless data structures
 	s_mutex.lockForWrite();
 	if (s_availableIndex < 0) { extend(NPH_CACHE_INCREMENT); }
+	BasicFilters<>* filter = s_availableFilters[s_availableIndex];
 	NotePlayHandle * nph = s_available[s_availableIndex--];
 	s_mutex.unlock();
 
 	new( (void*)nph ) NotePlayHandle( instrumentTrack, offset, frames, noteToPlay, parent, midiEventChannel, origin );
+
+	filter->setSampleRate(Engine::audioEngine()->outputSampleRate());
+	filter->clearHistory();
+	nph->m_filter = filter;
+
 	return nph;
 }
 
 
 void NotePlayHandleManager::release( NotePlayHandle * nph )
 {
+	BasicFilters<>* filter = nph->m_filter;
 	nph->NotePlayHandle::~NotePlayHandle();
 	s_mutex.lockForRead();
-	s_available[++s_availableIndex] = nph;
+	const int index = ++s_availableIndex;
+	s_available[index] = nph;
+	s_availableFilters[index] = filter;
 	s_mutex.unlock();
 }
 
@@ -658,19 +687,36 @@ void NotePlayHandleManager::extend( int c )
 	auto tmp = new NotePlayHandle*[s_size];
 	delete[] s_available;
 	s_available = tmp;
+	auto tmpFilters = new BasicFilters<>*[s_size];
+	delete[] s_availableFilters;
+	s_availableFilters = tmpFilters;
 
 	auto n = static_cast<NotePlayHandle *>(std::malloc(sizeof(NotePlayHandle) * c));
 
 	for( int i=0; i < c; ++i )
 	{
-		s_available[++s_availableIndex] = n;
+		++s_availableIndex;
+		s_available[s_availableIndex] = n;
+		s_availableFilters[s_availableIndex] = createFilter();
 		++n;
 	}
 }
 
 void NotePlayHandleManager::free()
 {
+	s_filters.clear();
 	delete[] s_available;
+	delete[] s_availableFilters;
+}
+
+
+BasicFilters<>* NotePlayHandleManager::createFilter()
+{
+	auto& filter = s_filters.emplace_back(std::make_unique<BasicFilters<>>(SUPPORTED_SAMPLERATES[0]));
+	// make the filter allocate its sub filter right away instead of on
+	// the first note that uses one of the double filter types
+	filter->setFilterType(BasicFilters<>::FilterType::DoubleLowPass);
+	return filter.get();
 }
 
 
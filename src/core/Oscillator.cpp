@@ -34,7 +34,6 @@
 #include "Engine.h"
 #include "AudioEngine.h"
 #include "AutomatableModel.h"
-#include "fftw3.h"
 #include "fft_helpers.h"
 
 
@@ -70,7 +69,9 @@ Oscillator::Oscillator(const IntModel *wave_shape_model,
 	m_phase(phase_offset),
 	m_userWave(nullptr),
 	m_useWaveTable(false),
-	m_isModulator(false)
+	m_isModulator(false),
+	m_currentFreq(0.f),
+	m_waveTableBand(1)
 {
 }
 
@@ -79,39 +80,82 @@ Oscillator::Oscillator(const IntModel *wave_shape_model,
 
 void Oscillator::update(SampleFrame* ab, const fpp_t frames, const ch_cnt_t chnl, bool modulator)
 {
-	if (m_freq >= Engine::audioEngine()->outputSampleRate() / 2)
+	updateGroup<1>({this}, ab, frames, chnl, modulator);
+}
+
+
+
+
+void Oscillator::updateStereo(Oscillator* left, Oscillator* right, SampleFrame* ab, const fpp_t frames)
+{
+	if (left->isStereoCompatible(*right))
+	{
+		updateGroup<2>({left, right}, ab, frames, 0, false);
+	}
+	else
+	{
+		left->update(ab, frames, 0);
+		right->update(ab, frames, 1);
+	}
+}
+
+
+
+
+bool Oscillator::isStereoCompatible(const Oscillator& other) const
+{
+	if (m_waveShapeModel->value() != other.m_waveShapeModel->value()) { return false; }
+	if (m_subOsc == nullptr || other.m_subOsc == nullptr) { return m_subOsc == other.m_subOsc; }
+	return m_modulationAlgoModel->value() == other.m_modulationAlgoModel->value()
+		&& m_subOsc->isStereoCompatible(*other.m_subOsc);
+}
+
+
+
+
+template<std::size_t CH>
+void Oscillator::updateGroup(const OscillatorGroup<CH>& oscs, SampleFrame* ab, const fpp_t frames,
+	const ch_cnt_t chnl, bool modulator)
+{
+	const float sampleRate = Engine::audioEngine()->outputSampleRate();
+	if (oscs[0]->m_freq >= sampleRate / 2)
 	{
 		zeroSampleFrames(ab, frames);
 		return;
 	}
-	// If this oscillator is used to PM or PF modulate another oscillator, take a note.
-	// The sampling functions will check this variable and avoid using band-limited
-	// wavetables, since they contain ringing that would lead to unexpected results.
-	m_isModulator = modulator;
-	if (m_subOsc != nullptr)
+	for (auto osc : oscs)
+	{
+		// If this oscillator is used to PM or PF modulate another oscillator, take a note.
+		// The sampling functions will check this variable and avoid using band-limited
+		// wavetables, since they contain ringing that would lead to unexpected results.
+		osc->m_isModulator = modulator;
+		osc->m_currentFreq = osc->m_freq * osc->m_detuning_div_samplerate * sampleRate;
+		osc->m_waveTableBand = waveTableBandFromFreq(osc->m_currentFreq);
+	}
+	if (oscs[0]->m_subOsc != nullptr)
 	{
-		switch (static_cast<ModulationAlgo>(m_modulationAlgoModel->value()))
+		switch (static_cast<ModulationAlgo>(oscs[0]->m_modulationAlgoModel->value()))
 		{
 			case ModulationAlgo::PhaseModulation:
-				updatePM(ab, frames, chnl);
+				updatePM(oscs, ab, frames, chnl);
 				break;
 			case ModulationAlgo::AmplitudeModulation:
-				updateAM(ab, frames, chnl);
+				updateAM(oscs, ab, frames, chnl);
 				break;
 			case ModulationAlgo::SignalMix:
 			default:
-				updateMix(ab, frames, chnl);
+				updateMix(oscs, ab, frames, chnl);
 				break;
 			case ModulationAlgo::SynchronizedBySubOsc:
-				updateSync(ab, frames, chnl);
+				updateSync(oscs, ab, frames, chnl);
 				break;
 			case ModulationAlgo::FrequencyModulation:
-				updateFM(ab, frames, chnl);
+				updateFM(oscs, ab, frames, chnl);
 		}
 	}
 	else
 	{
-		updateNoSub(ab, frames, chnl);
+		updateNoSub(oscs, ab, frames, chnl);
 	}
 }
 
@@ -183,7 +227,7 @@ void Oscillator::generateFromFFT(int bands, sample_t* table)
 		s_specBuf[i][1] = 0.0f;
 	}
 	//ifft
-	fftwf_execute(s_ifftPlan);
+	s_ifftPlan.inverse(s_specBuf.data(), s_sampleBuffer.data());
 	//normalize and copy to result buffer
 	normalize(s_sampleBuffer.data(), table, OscillatorConstants::WAVETABLE_LENGTH, 2*OscillatorConstants::WAVETABLE_LENGTH + 1);
 }
@@ -200,7 +244,7 @@ std::unique_ptr<OscillatorConstants::waveform_t> Oscillator::generateAntiAliasUs
 			s_sampleBuffer[j] = Oscillator::userWaveSample(
 				sampleBuffer, static_cast<float>(j) / OscillatorConstants::WAVETABLE_LENGTH);
 		}
-		fftwf_execute(s_fftPlan);
+		s_fftPlan.forward(s_sampleBuffer.data(), s_specBuf.data());
 		Oscillator::generateFromFFT(OscillatorConstants::MAX_FREQ / freqFromWaveTableBand(i), (*userAntiAliasWaveTable)[i].data());
 	}
 
@@ -213,31 +257,28 @@ sample_t Oscillator::s_waveTables
 	[Oscillator::NumWaveShapeTables]
 	[OscillatorConstants::WAVE_TABLES_PER_WAVEFORM_COUNT]
 	[OscillatorConstants::WAVETABLE_LENGTH];
-fftwf_plan Oscillator::s_fftPlan;
-fftwf_plan Oscillator::s_ifftPlan;
-fftwf_complex * Oscillator::s_specBuf;
-std::array<float, OscillatorConstants::WAVETABLE_LENGTH> Oscillator::s_sampleBuffer;
+FFTPlan Oscillator::s_fftPlan;
+FFTPlan Oscillator::s_ifftPlan;
+FFTBuffer<fftwf_complex> Oscillator::s_specBuf;
+FFTBuffer<float> Oscillator::s_sampleBuffer;
 
 
 
 void Oscillator::createFFTPlans()
 {
-	Oscillator::s_specBuf = ( fftwf_complex * ) fftwf_malloc( ( OscillatorConstants::WAVETABLE_LENGTH * 2 + 1 ) * sizeof( fftwf_complex ) );
-	Oscillator::s_fftPlan = fftwf_plan_dft_r2c_1d(OscillatorConstants::WAVETABLE_LENGTH, s_sampleBuffer.data(), s_specBuf, FFTW_MEASURE );
-	Oscillator::s_ifftPlan = fftwf_plan_dft_c2r_1d(OscillatorConstants::WAVETABLE_LENGTH, s_specBuf, s_sampleBuffer.data(), FFTW_MEASURE);
-	// initialize s_specBuf content to zero, since the values are used in a condition inside generateFromFFT()
-	for (int i = 0; i < OscillatorConstants::WAVETABLE_LENGTH * 2 + 1; i++)
-	{
-		s_specBuf[i][0] = 0.0f;
-		s_specBuf[i][1] = 0.0f;
-	}
+	// s_specBuf starts zeroed, since the values are used in a condition inside generateFromFFT()
+	Oscillator::s_specBuf = FFTBuffer<fftwf_complex>(OscillatorConstants::WAVETABLE_LENGTH * 2 + 1);
+	Oscillator::s_sampleBuffer = FFTBuffer<float>(OscillatorConstants::WAVETABLE_LENGTH);
+	// The plans are shared with everyone else using this size, and get measured in the background
+	Oscillator::s_fftPlan = FFTPlanCache::instance().plan(OscillatorConstants::WAVETABLE_LENGTH, FFTPlanCache::Direction::Forward);
+	Oscillator::s_ifftPlan = FFTPlanCache::instance().plan(OscillatorConstants::WAVETABLE_LENGTH, FFTPlanCache::Direction::Inverse);
 }
 
 void Oscillator::destroyFFTPlans()
 {
-	fftwf_destroy_plan(s_fftPlan);
-	fftwf_destroy_plan(s_ifftPlan);
-	fftwf_free(s_specBuf);
+	// The plans themselves belong to the FFTPlanCache
+	s_specBuf = {};
+	s_sampleBuffer = {};
 }
 
 void Oscillator::generateWaveTables()
@@ -283,7 +324,7 @@ void Oscillator::generateWaveTables()
 			{
 				Oscillator::s_sampleBuffer[i] = moogSawSample((float)i / (float)OscillatorConstants::WAVETABLE_LENGTH);
 			}
-			fftwf_execute(s_fftPlan);
+			s_fftPlan.forward(s_sampleBuffer.data(), s_specBuf.data());
 			generateFromFFT(OscillatorConstants::MAX_FREQ / freqFromWaveTableBand(i), s_waveTables[static_cast<std::size_t>(WaveShape::MoogSaw) - FirstWaveShapeTable][i]);
 		}
 
@@ -294,7 +335,7 @@ void Oscillator::generateWaveTables()
 			{
 				s_sampleBuffer[i] = expSample((float)i / (float)OscillatorConstants::WAVETABLE_LENGTH);
 			}
-			fftwf_execute(s_fftPlan);
+			s_fftPlan.forward(s_sampleBuffer.data(), s_specBuf.data());
 			generateFromFFT(OscillatorConstants::MAX_FREQ / freqFromWaveTableBand(i), s_waveTables[static_cast<std::size_t>(WaveShape::Exponential) - FirstWaveShapeTable][i]);
 		}
 	};
@@ -322,35 +363,36 @@ void Oscillator::generateWaveTables()
 
 
 
-void Oscillator::updateNoSub( SampleFrame* _ab, const fpp_t _frames,
-							const ch_cnt_t _chnl )
+template<std::size_t CH>
+void Oscillator::updateNoSub(const OscillatorGroup<CH>& oscs, SampleFrame* ab, const fpp_t frames,
+	const ch_cnt_t chnl)
 {
-	switch( static_cast<WaveShape>(m_waveShapeModel->value()) )
+	switch (static_cast<WaveShape>(oscs[0]->m_waveShapeModel->value()))
 	{
 		case WaveShape::Sine:
 		default:
-			updateNoSub<WaveShape::Sine>( _ab, _frames, _chnl );
+			updateNoSub<WaveShape::Sine>(oscs, ab, frames, chnl);
 			break;
 		case WaveShape::Triangle:
-			updateNoSub<WaveShape::Triangle>( _ab, _frames, _chnl );
+			updateNoSub<WaveShape::Triangle>(oscs, ab, frames, chnl);
 			break;
 		case WaveShape::Saw:
-			updateNoSub<WaveShape::Saw>( _ab, _frames, _chnl );
+			updateNoSub<WaveShape::Saw>(oscs, ab, frames, chnl);
 			break;
 		case WaveShape::Square:
-			updateNoSub<WaveShape::Square>( _ab, _frames, _chnl );
+			updateNoSub<WaveShape::Square>(oscs, ab, frames, chnl);
 			break;
 		case WaveShape::MoogSaw:
-			updateNoSub<WaveShape::MoogSaw>( _ab, _frames, _chnl );
+			updateNoSub<WaveShape::MoogSaw>(oscs, ab, frames, chnl);
 			break;
 		case WaveShape::Exponential:
-			updateNoSub<WaveShape::Exponential>( _ab, _frames, _chnl );
+			updateNoSub<WaveShape::Exponential>(oscs, ab, frames, chnl);
 			break;
 		case WaveShape::WhiteNoise:
-			updateNoSub<WaveShape::WhiteNoise>( _ab, _frames, _chnl );
+			updateNoSub<WaveShape::WhiteNoise>(oscs, ab, frames, chnl);
 			break;
 		case WaveShape::UserDefined:
-			updateNoSub<WaveShape::UserDefined>( _ab, _frames, _chnl );
+			updateNoSub<WaveShape::UserDefined>(oscs, ab, frames, chnl);
 			break;
 	}
 }
@@ -358,35 +400,36 @@ void Oscillator::updateNoSub( SampleFrame* _ab, const fpp_t _frames,
 
 
 
-void Oscillator::updatePM( SampleFrame* _ab, const fpp_t _frames,
-							const ch_cnt_t _chnl )
+template<std::size_t CH>
+void Oscillator::updatePM(const OscillatorGroup<CH>& oscs, SampleFrame* ab, const fpp_t frames,
+	const ch_cnt_t chnl)
 {
-	switch( static_cast<WaveShape>(m_waveShapeModel->value()) )
+	switch (static_cast<WaveShape>(oscs[0]->m_waveShapeModel->value()))
 	{
 		case WaveShape::Sine:
 		default:
-			updatePM<WaveShape::Sine>( _ab, _frames, _chnl );
+			updatePM<WaveShape::Sine>(oscs, ab, frames, chnl);
 			break;
 		case WaveShape::Triangle:
-			updatePM<WaveShape::Triangle>( _ab, _frames, _chnl );
+			updatePM<WaveShape::Triangle>(oscs, ab, frames, chnl);
 			break;
 		case WaveShape::Saw:
-			updatePM<WaveShape::Saw>( _ab, _frames, _chnl );
+			updatePM<WaveShape::Saw>(oscs, ab, frames, chnl);
 			break;
 		case WaveShape::Square:
-			updatePM<WaveShape::Square>( _ab, _frames, _chnl );
+			updatePM<WaveShape::Square>(oscs, ab, frames, chnl);
 			break;
 		case WaveShape::MoogSaw:
-			updatePM<WaveShape::MoogSaw>( _ab, _frames, _chnl );
+			updatePM<WaveShape::MoogSaw>(oscs, ab, frames, chnl);
 			break;
 		case WaveShape::Exponential:
-			updatePM<WaveShape::Exponential>( _ab, _frames, _chnl );
+			updatePM<WaveShape::Exponential>(oscs, ab, frames, chnl);
 			break;
 		case WaveShape::WhiteNoise:
-			updatePM<WaveShape::WhiteNoise>( _ab, _frames, _chnl );
+			updatePM<WaveShape::WhiteNoise>(oscs, ab, frames, chnl);
 			break;
 		case WaveShape::UserDefined:
-			updatePM<WaveShape::UserDefined>( _ab, _frames, _chnl );
+			updatePM<WaveShape::UserDefined>(oscs, ab, frames, chnl);
 			break;
 	}
 }
@@ -394,35 +437,36 @@ void Oscillator::updatePM( SampleFrame* _ab, const fpp_t _frames,
 
 
 
-void Oscillator::updateAM( SampleFrame* _ab, const fpp_t _frames,
-							const ch_cnt_t _chnl )
+template<std::size_t CH>
+void Oscillator::updateAM(const OscillatorGroup<CH>& oscs, SampleFrame* ab, const fpp_t frames,
+	const ch_cnt_t chnl)
 {
-	switch( static_cast<WaveShape>(m_waveShapeModel->value()) )
+	switch (static_cast<WaveShape>(oscs[0]->m_waveShapeModel->value()))
 	{
 		case WaveShape::Sine:
 		default:
-			updateAM<WaveShape::Sine>( _ab, _frames, _chnl );
+			updateAM<WaveShape::Sine>(oscs, ab, frames, chnl);
 			break;
 		case WaveShape::Triangle:
-			updateAM<WaveShape::Triangle>( _ab, _frames, _chnl );
+			updateAM<WaveShape::Triangle>(oscs, ab, frames, chnl);
 			break;
 		case WaveShape::Saw:
-			updateAM<WaveShape::Saw>( _ab, _frames, _chnl );
+			updateAM<WaveShape::Saw>(oscs, ab, frames, chnl);
 			break;
 		case WaveShape::Square:
-			updateAM<WaveShape::Square>( _ab, _frames, _chnl );
+			updateAM<WaveShape::Square>(oscs, ab, frames, chnl);
 			break;
 		case WaveShape::MoogSaw:
-			updateAM<WaveShape::MoogSaw>( _ab, _frames, _chnl );
+			updateAM<WaveShape::MoogSaw>(oscs, ab, frames, chnl);
 			break;
 		case WaveShape::Exponential:
-			updateAM<WaveShape::Exponential>( _ab, _frames, _chnl );
+			updateAM<WaveShape::Exponential>(oscs, ab, frames, chnl);
 			break;
 		case WaveShape::WhiteNoise:
-			updateAM<WaveShape::WhiteNoise>( _ab, _frames, _chnl );
+			updateAM<WaveShape::WhiteNoise>(oscs, ab, frames, chnl);
 			break;
 		case WaveShape::UserDefined:
-			updateAM<WaveShape::UserDefined>( _ab, _frames, _chnl );
+			updateAM<WaveShape::UserDefined>(oscs, ab, frames, chnl);
 			break;
 	}
 }
@@ -430,35 +474,36 @@ void Oscillator::updateAM( SampleFrame* _ab, const fpp_t _frames,
 
 
 
-void Oscillator::updateMix( SampleFrame* _ab, const fpp_t _frames,
-							const ch_cnt_t _chnl )
+template<std::size_t CH>
+void Oscillator::updateMix(const OscillatorGroup<CH>& oscs, SampleFrame* ab, const fpp_t frames,
+	const ch_cnt_t chnl)
 {
-	switch( static_cast<WaveShape>(m_waveShapeModel->value()) )
+	switch (static_cast<WaveShape>(oscs[0]->m_waveShapeModel->value()))
 	{
 		case WaveShape::Sine:
 		default:
-			updateMix<WaveShape::Sine>( _ab, _frames, _chnl );
+			updateMix<WaveShape::Sine>(oscs, ab, frames, chnl);
 			break;
 		case WaveShape::Triangle:
-			updateMix<WaveShape::Triangle>( _ab, _frames, _chnl );
+			updateMix<WaveShape::Triangle>(oscs, ab, frames, chnl);
 			break;
 		case WaveShape::Saw:
-			updateMix<WaveShape::Saw>( _ab, _frames, _chnl );
+			updateMix<WaveShape::Saw>(oscs, ab, frames, chnl);
 			break;
 		case WaveShape::Square:
-			updateMix<WaveShape::Square>( _ab, _frames, _chnl );
+			updateMix<WaveShape::Square>(oscs, ab, frames, chnl);
 			break;
 		case WaveShape::MoogSaw:
-			updateMix<WaveShape::MoogSaw>( _ab, _frames, _chnl );
+			updateMix<WaveShape::MoogSaw>(oscs, ab, frames, chnl);
 			break;
 		case WaveShape::Exponential:
-			updateMix<WaveShape::Exponential>( _ab, _frames, _chnl );
+			updateMix<WaveShape::Exponential>(oscs, ab, frames, chnl);
 			break;
 		case WaveShape::WhiteNoise:
-			updateMix<WaveShape::WhiteNoise>( _ab, _frames, _chnl );
+			updateMix<WaveShape::WhiteNoise>(oscs, ab, frames, chnl);
 			break;
 		case WaveShape::UserDefined:
-			updateMix<WaveShape::UserDefined>( _ab, _frames, _chnl );
+			updateMix<WaveShape::UserDefined>(oscs, ab, frames, chnl);
 			break;
 	}
 }
@@ -466,35 +511,36 @@ void Oscillator::updateMix( SampleFrame* _ab, const fpp_t _frames,
 
 
 
-void Oscillator::updateSync( SampleFrame* _ab, const fpp_t _frames,
-							const ch_cnt_t _chnl )
+template<std::size_t CH>
+void Oscillator::updateSync(const OscillatorGroup<CH>& oscs, SampleFrame* ab, const fpp_t frames,
+	const ch_cnt_t chnl)
 {
-	switch( static_cast<WaveShape>(m_waveShapeModel->value()) )
+	switch (static_cast<WaveShape>(oscs[0]->m_waveShapeModel->value()))
 	{
 		case WaveShape::Sine:
 		default:
-			updateSync<WaveShape::Sine>( _ab, _frames, _chnl );
+			updateSync<WaveShape::Sine>(oscs, ab, frames, chnl);
 			break;
 		case WaveShape::Triangle:
-			updateSync<WaveShape::Triangle>( _ab, _frames, _chnl );
+			updateSync<WaveShape::Triangle>(oscs, ab, frames, chnl);
 			break;
 		case WaveShape::Saw:
-			updateSync<WaveShape::Saw>( _ab, _frames, _chnl );
+			updateSync<WaveShape::Saw>(oscs, ab, frames, chnl);
 			break;
 		case WaveShape::Square:
-			updateSync<WaveShape::Square>( _ab, _frames, _chnl );
+			updateSync<WaveShape::Square>(oscs, ab, frames, chnl);
 			break;
 		case WaveShape::MoogSaw:
-			updateSync<WaveShape::MoogSaw>( _ab, _frames, _chnl );
+			updateSync<WaveShape::MoogSaw>(oscs, ab, frames, chnl);
 			break;
 		case WaveShape::Exponential:
-			updateSync<WaveShape::Exponential>( _ab, _frames, _chnl );
+			updateSync<WaveShape::Exponential>(oscs, ab, frames, chnl);
 			break;
 		case WaveShape::WhiteNoise:
-			updateSync<WaveShape::WhiteNoise>( _ab, _frames, _chnl );
+			updateSync<WaveShape::WhiteNoise>(oscs, ab, frames, chnl);
 			break;
 		case WaveShape::UserDefined:
-			updateSync<WaveShape::UserDefined>( _ab, _frames, _chnl );
+			updateSync<WaveShape::UserDefined>(oscs, ab, frames, chnl);
 			break;
 	}
 }
@@ -502,35 +548,36 @@ void Oscillator::updateSync( SampleFrame* _ab, const fpp_t _frames,
 
 
 
-void Oscillator::updateFM( SampleFrame* _ab, const fpp_t _frames,
-							const ch_cnt_t _chnl )
+template<std::size_t CH>
+void Oscillator::updateFM(const OscillatorGroup<CH>& oscs, SampleFrame* ab, const fpp_t frames,
+	const ch_cnt_t chnl)
 {
-	switch( static_cast<WaveShape>(m_waveShapeModel->value()) )
+	switch (static_cast<WaveShape>(oscs[0]->m_waveShapeModel->value()))
 	{
 		case WaveShape::Sine:
 		default:
-			updateFM<WaveShape::Sine>( _ab, _frames, _chnl );
+			updateFM<WaveShape::Sine>(oscs, ab, frames, chnl);
 			break;
 		case WaveShape::Triangle:
-			updateFM<WaveShape::Triangle>( _ab, _frames, _chnl );
+			updateFM<WaveShape::Triangle>(oscs, ab, frames, chnl);
 			break;
 		case WaveShape::Saw:
-			updateFM<WaveShape::Saw>( _ab, _frames, _chnl );
+			updateFM<WaveShape::Saw>(oscs, ab, frames, chnl);
 			break;
 		case WaveShape::Square:
-			updateFM<WaveShape::Square>( _ab, _frames, _chnl );
+			updateFM<WaveShape::Square>(oscs, ab, frames, chnl);
 			break;
 		case WaveShape::MoogSaw:
-			updateFM<WaveShape::MoogSaw>( _ab, _frames, _chnl );
+			updateFM<WaveShape::MoogSaw>(oscs, ab, frames, chnl);
 			break;
 		case WaveShape::Exponential:
-			updateFM<WaveShape::Exponential>( _ab, _frames, _chnl );
+			updateFM<WaveShape::Exponential>(oscs, ab, frames, chnl);
 			break;
 		case WaveShape::WhiteNoise:
-			updateFM<WaveShape::WhiteNoise>( _ab, _frames, _chnl );
+			updateFM<WaveShape::WhiteNoise>(oscs, ab, frames, chnl);
 			break;
 		case WaveShape::UserDefined:
-			updateFM<WaveShape::UserDefined>( _ab, _frames, _chnl );
+			updateFM<WaveShape::UserDefined>(oscs, ab, frames, chnl);
 			break;
 	}
 }
@@ -578,18 +625,46 @@ float Oscillator::syncInit( SampleFrame* _ab, const fpp_t _frames,
 
 
 
+template<std::size_t CH>
+auto Oscillator::subOscillators(const OscillatorGroup<CH>& oscs) -> OscillatorGroup<CH>
+{
+	auto subOscs = OscillatorGroup<CH>{};
+	for (std::size_t c = 0; c < CH; ++c)
+	{
+		subOscs[c] = oscs[c]->m_subOsc;
+	}
+	return subOscs;
+}
+
+
+
+
 // if we have no sub-osc, we can't do any modulation... just get our samples
-template<Oscillator::WaveShape W>
-void Oscillator::updateNoSub( SampleFrame* _ab, const fpp_t _frames,
-							const ch_cnt_t _chnl )
+template<Oscillator::WaveShape W, std::size_t CH>
+void Oscillator::updateNoSub(const OscillatorGroup<CH>& oscs, SampleFrame* ab, const fpp_t frames,
+	const ch_cnt_t chnl)
 {
-	recalcPhase();
-	const float osc_coeff = m_freq * m_detuning_div_samplerate;
+	auto oscCoeffs = std::array<float, CH>{};
+	for (std::size_t c = 0; c < CH; ++c)
+	{
+		oscs[c]->recalcPhase();
+		oscCoeffs[c] = oscs[c]->m_freq * oscs[c]->m_detuning_div_samplerate;
+	}
 
-	for( fpp_t frame = 0; frame < _frames; ++frame )
+	Block phases, samples;
+	for (fpp_t frame = 0; frame < frames; frame += BlockSize)
 	{
-		_ab[frame][_chnl] = getSample<W>( m_phase ) * m_volume;
-		m_phase += osc_coeff;
+		const fpp_t n = std::min(BlockSize, frames - frame);
+		for (std::size_t c = 0; c < CH; ++c)
+		{
+			Oscillator* osc = oscs[c];
+			osc->phaseRamp(phases, oscCoeffs[c], n);
+			osc->getSamples<W>(phases, samples, n);
+			for (fpp_t i = 0; i < n; ++i)
+			{
+				ab[frame + i][chnl + c] = samples[i] * osc->m_volume;
+			}
+		}
 	}
 }
 
@@ -597,20 +672,36 @@ void Oscillator::updateNoSub( SampleFrame* _ab, const fpp_t _frames,
 
 
 // do pm by using sub-osc as modulator
-template<Oscillator::WaveShape W>
-void Oscillator::updatePM( SampleFrame* _ab, const fpp_t _frames,
-							const ch_cnt_t _chnl )
+template<Oscillator::WaveShape W, std::size_t CH>
+void Oscillator::updatePM(const OscillatorGroup<CH>& oscs, SampleFrame* ab, const fpp_t frames,
+	const ch_cnt_t chnl)
 {
-	m_subOsc->update( _ab, _frames, _chnl, true );
-	recalcPhase();
-	const float osc_coeff = m_freq * m_detuning_div_samplerate;
+	updateGroup(subOscillators(oscs), ab, frames, chnl, true);
+	auto oscCoeffs = std::array<float, CH>{};
+	for (std::size_t c = 0; c < CH; ++c)
+	{
+		oscs[c]->recalcPhase();
+		oscCoeffs[c] = oscs[c]->m_freq * oscs[c]->m_detuning_div_samplerate;
+	}
 
-	for( fpp_t frame = 0; frame < _frames; ++frame )
+	Block phases, samples;
+	for (fpp_t frame = 0; frame < frames; frame += BlockSize)
 	{
-		_ab[frame][_chnl] = getSample<W>( m_phase +
-					_ab[frame][_chnl] )
-							* m_volume;
-		m_phase += osc_coeff;
+		const fpp_t n = std::min(BlockSize, frames - frame);
+		for (std::size_t c = 0; c < CH; ++c)
+		{
+			Oscillator* osc = oscs[c];
+			osc->phaseRamp(phases, oscCoeffs[c], n);
+			for (fpp_t i = 0; i < n; ++i)
+			{
+				phases[i] += ab[frame + i][chnl + c];
+			}
+			osc->getSamples<W>(phases, samples, n);
+			for (fpp_t i = 0; i < n; ++i)
+			{
+				ab[frame + i][chnl + c] = samples[i] * osc->m_volume;
+			}
+		}
 	}
 }
 
@@ -618,18 +709,32 @@ void Oscillator::updatePM( SampleFrame* _ab, const fpp_t _frames,
 
 
 // do am by using sub-osc as modulator
-template<Oscillator::WaveShape W>
-void Oscillator::updateAM( SampleFrame* _ab, const fpp_t _frames,
-							const ch_cnt_t _chnl )
+template<Oscillator::WaveShape W, std::size_t CH>
+void Oscillator::updateAM(const OscillatorGroup<CH>& oscs, SampleFrame* ab, const fpp_t frames,
+	const ch_cnt_t chnl)
 {
-	m_subOsc->update( _ab, _frames, _chnl, false );
-	recalcPhase();
-	const float osc_coeff = m_freq * m_detuning_div_samplerate;
+	updateGroup(subOscillators(oscs), ab, frames, chnl, false);
+	auto oscCoeffs = std::array<float, CH>{};
+	for (std::size_t c = 0; c < CH; ++c)
+	{
+		oscs[c]->recalcPhase();
+		oscCoeffs[c] = oscs[c]->m_freq * oscs[c]->m_detuning_div_samplerate;
+	}
 
-	for( fpp_t frame = 0; frame < _frames; ++frame )
+	Block phases, samples;
+	for (fpp_t frame = 0; frame < frames; frame += BlockSize)
 	{
-		_ab[frame][_chnl] *= getSample<W>( m_phase ) * m_volume;
-		m_phase += osc_coeff;
+		const fpp_t n = std::min(BlockSize, frames - frame);
+		for (std::size_t c = 0; c < CH; ++c)
+		{
+			Oscillator* osc = oscs[c];
+			osc->phaseRamp(phases, oscCoeffs[c], n);
+			osc->getSamples<W>(phases, samples, n);
+			for (fpp_t i = 0; i < n; ++i)
+			{
+				ab[frame + i][chnl + c] *= samples[i] * osc->m_volume;
+			}
+		}
 	}
 }
 
@@ -637,18 +742,32 @@ void Oscillator::updateAM( SampleFrame* _ab, const fpp_t _frames,
 
 
 // do mix by using sub-osc as mix-sample
-template<Oscillator::WaveShape W>
-void Oscillator::updateMix( SampleFrame* _ab, const fpp_t _frames,
-							const ch_cnt_t _chnl )
+template<Oscillator::WaveShape W, std::size_t CH>
+void Oscillator::updateMix(const OscillatorGroup<CH>& oscs, SampleFrame* ab, const fpp_t frames,
+	const ch_cnt_t chnl)
 {
-	m_subOsc->update( _ab, _frames, _chnl, false );
-	recalcPhase();
-	const float osc_coeff = m_freq * m_detuning_div_samplerate;
+	updateGroup(subOscillators(oscs), ab, frames, chnl, false);
+	auto oscCoeffs = std::array<float, CH>{};
+	for (std::size_t c = 0; c < CH; ++c)
+	{
+		oscs[c]->recalcPhase();
+		oscCoeffs[c] = oscs[c]->m_freq * oscs[c]->m_detuning_div_samplerate;
+	}
 
-	for( fpp_t frame = 0; frame < _frames; ++frame )
+	Block phases, samples;
+	for (fpp_t frame = 0; frame < frames; frame += BlockSize)
 	{
-		_ab[frame][_chnl] += getSample<W>( m_phase ) * m_volume;
-		m_phase += osc_coeff;
+		const fpp_t n = std::min(BlockSize, frames - frame);
+		for (std::size_t c = 0; c < CH; ++c)
+		{
+			Oscillator* osc = oscs[c];
+			osc->phaseRamp(phases, oscCoeffs[c], n);
+			osc->getSamples<W>(phases, samples, n);
+			for (fpp_t i = 0; i < n; ++i)
+			{
+				ab[frame + i][chnl + c] += samples[i] * osc->m_volume;
+			}
+		}
 	}
 }
 
@@ -657,22 +776,42 @@ void Oscillator::updateMix( SampleFrame* _ab, const fpp_t _frames,
 
 // sync with sub-osc (every time sub-osc starts new period, we also start new
 // period)
-template<Oscillator::WaveShape W>
-void Oscillator::updateSync( SampleFrame* _ab, const fpp_t _frames,
-							const ch_cnt_t _chnl )
+template<Oscillator::WaveShape W, std::size_t CH>
+void Oscillator::updateSync(const OscillatorGroup<CH>& oscs, SampleFrame* ab, const fpp_t frames,
+	const ch_cnt_t chnl)
 {
-	const float sub_osc_coeff = m_subOsc->syncInit( _ab, _frames, _chnl );
-	recalcPhase();
-	const float osc_coeff = m_freq * m_detuning_div_samplerate;
+	auto subOscCoeffs = std::array<float, CH>{};
+	auto oscCoeffs = std::array<float, CH>{};
+	for (std::size_t c = 0; c < CH; ++c)
+	{
+		subOscCoeffs[c] = oscs[c]->m_subOsc->syncInit(ab, frames, chnl + c);
+		oscs[c]->recalcPhase();
+		oscCoeffs[c] = oscs[c]->m_freq * oscs[c]->m_detuning_div_samplerate;
+	}
 
-	for( fpp_t frame = 0; frame < _frames ; ++frame )
+	Block phases, samples;
+	for (fpp_t frame = 0; frame < frames; frame += BlockSize)
 	{
-		if( m_subOsc->syncOk( sub_osc_coeff ) )
+		const fpp_t n = std::min(BlockSize, frames - frame);
+		for (std::size_t c = 0; c < CH; ++c)
 		{
-			m_phase = m_phaseOffset;
+			Oscillator* osc = oscs[c];
+			// resetting the phase is a sequential operation, only the sampling is done block-wise
+			for (fpp_t i = 0; i < n; ++i)
+			{
+				if (osc->m_subOsc->syncOk(subOscCoeffs[c]))
+				{
+					osc->m_phase = osc->m_phaseOffset;
+				}
+				phases[i] = osc->m_phase;
+				osc->m_phase += oscCoeffs[c];
+			}
+			osc->getSamples<W>(phases, samples, n);
+			for (fpp_t i = 0; i < n; ++i)
+			{
+				ab[frame + i][chnl + c] = samples[i] * osc->m_volume;
+			}
 		}
-		_ab[frame][_chnl] = getSample<W>( m_phase ) * m_volume;
-		m_phase += osc_coeff;
 	}
 }
 
@@ -680,20 +819,39 @@ void Oscillator::updateSync( SampleFrame* _ab, const fpp_t _frames,
 
 
 // do fm by using sub-osc as modulator
-template<Oscillator::WaveShape W>
-void Oscillator::updateFM( SampleFrame* _ab, const fpp_t _frames,
-							const ch_cnt_t _chnl )
+template<Oscillator::WaveShape W, std::size_t CH>
+void Oscillator::updateFM(const OscillatorGroup<CH>& oscs, SampleFrame* ab, const fpp_t frames,
+	const ch_cnt_t chnl)
 {
-	m_subOsc->update( _ab, _frames, _chnl, true );
-	recalcPhase();
-	const float osc_coeff = m_freq * m_detuning_div_samplerate;
+	updateGroup(subOscillators(oscs), ab, frames, chnl, true);
+	auto oscCoeffs = std::array<float, CH>{};
+	for (std::size_t c = 0; c < CH; ++c)
+	{
+		oscs[c]->recalcPhase();
+		oscCoeffs[c] = oscs[c]->m_freq * oscs[c]->m_detuning_div_samplerate;
+	}
 	const float sampleRateCorrection = 44100.0f / Engine::audioEngine()->outputSampleRate();
 
-	for( fpp_t frame = 0; frame < _frames; ++frame )
+	Block phases, samples;
+	for (fpp_t frame = 0; frame < frames; frame += BlockSize)
 	{
-		m_phase += _ab[frame][_chnl] * sampleRateCorrection;
-		_ab[frame][_chnl] = getSample<W>( m_phase ) * m_volume;
-		m_phase += osc_coeff;
+		const fpp_t n = std::min(BlockSize, frames - frame);
+		for (std::size_t c = 0; c < CH; ++c)
+		{
+			Oscillator* osc = oscs[c];
+			// the phase accumulates the modulator, so it has to be computed sequentially
+			for (fpp_t i = 0; i < n; ++i)
+			{
+				osc->m_phase += ab[frame + i][chnl + c] * sampleRateCorrection;
+				phases[i] = osc->m_phase;
+				osc->m_phase += oscCoeffs[c];
+			}
+			osc->getSamples<W>(phases, samples, n);
+			for (fpp_t i = 0; i < n; ++i)
+			{
+				ab[frame + i][chnl + c] = samples[i] * osc->m_volume;
+			}
+		}
 	}
 }
 
@@ -701,17 +859,18 @@ void Oscillator::updateFM( SampleFrame* _ab, const fpp_t _frames,
 
 
 template<>
-inline sample_t Oscillator::getSample<Oscillator::WaveShape::Sine>(const float sample)
+inline void Oscillator::getSamples<Oscillator::WaveShape::Sine>(const Block& phases, Block& out, const fpp_t n)
 {
-	const float current_freq = m_freq * m_detuning_div_samplerate * Engine::audioEngine()->outputSampleRate();
-
-	if (!m_useWaveTable || current_freq < OscillatorConstants::MAX_FREQ)
+	if (!m_useWaveTable || m_currentFreq < OscillatorConstants::MAX_FREQ)
 	{
-		return sinSample(sample);
+		for (fpp_t i = 0; i < n; ++i)
+		{
+			out[i] = sinSample(phases[i]);
+		}
 	}
 	else
 	{
-		return 0;
+		std::fill_n(out.begin(), n, 0.f);
 	}
 }
 
@@ -719,16 +878,19 @@ inline sample_t Oscillator::getSample<Oscillator::WaveShape::Sine>(const float s
 
 
 template<>
-inline sample_t Oscillator::getSample<Oscillator::WaveShape::Triangle>(
-		const float _sample )
+inline void Oscillator::getSamples<Oscillator::WaveShape::Triangle>(const Block& phases, Block& out, const fpp_t n)
 {
 	if (m_useWaveTable && !m_isModulator)
 	{
-		return wtSample(s_waveTables[static_cast<std::size_t>(WaveShape::Triangle) - FirstWaveShapeTable],_sample);
+		wtSamples(s_waveTables[static_cast<std::size_t>(WaveShape::Triangle) - FirstWaveShapeTable][m_waveTableBand],
+			phases, out, n);
 	}
 	else
 	{
-		return triangleSample(_sample);
+		for (fpp_t i = 0; i < n; ++i)
+		{
+			out[i] = triangleSample(phases[i]);
+		}
 	}
 }
 
@@ -736,16 +898,19 @@ inline sample_t Oscillator::getSample<Oscillator::WaveShape::Triangle>(
 
 
 template<>
-inline sample_t Oscillator::getSample<Oscillator::WaveShape::Saw>(
-		const float _sample )
+inline void Oscillator::getSamples<Oscillator::WaveShape::Saw>(const Block& phases, Block& out, const fpp_t n)
 {
 	if (m_useWaveTable && !m_isModulator)
 	{
-		return wtSample(s_waveTables[static_cast<std::size_t>(WaveShape::Saw) - FirstWaveShapeTable], _sample);
+		wtSamples(s_waveTables[static_cast<std::size_t>(WaveShape::Saw) - FirstWaveShapeTable][m_waveTableBand],
+			phases, out, n);
 	}
 	else
 	{
-		return sawSample(_sample);
+		for (fpp_t i = 0; i < n; ++i)
+		{
+			out[i] = sawSample(phases[i]);
+		}
 	}
 }
 
@@ -753,16 +918,19 @@ inline sample_t Oscillator::getSample<Oscillator::WaveShape::Saw>(
 
 
 template<>
-inline sample_t Oscillator::getSample<Oscillator::WaveShape::Square>(
-		const float _sample )
+inline void Oscillator::getSamples<Oscillator::WaveShape::Square>(const Block& phases, Block& out, const fpp_t n)
 {
 	if (m_useWaveTable && !m_isModulator)
 	{
-		return wtSample(s_waveTables[static_cast<std::size_t>(WaveShape::Square) - FirstWaveShapeTable], _sample);
+		wtSamples(s_waveTables[static_cast<std::size_t>(WaveShape::Square) - FirstWaveShapeTable][m_waveTableBand],
+			phases, out, n);
 	}
 	else
 	{
-		return squareSample(_sample);
+		for (fpp_t i = 0; i < n; ++i)
+		{
+			out[i] = squareSample(phases[i]);
+		}
 	}
 }
 
@@ -770,16 +938,19 @@ inline sample_t Oscillator::getSample<Oscillator::WaveShape::Square>(
 
 
 template<>
-inline sample_t Oscillator::getSample<Oscillator::WaveShape::MoogSaw>(
-							const float _sample )
+inline void Oscillator::getSamples<Oscillator::WaveShape::MoogSaw>(const Block& phases, Block& out, const fpp_t n)
 {
 	if (m_useWaveTable && !m_isModulator)
 	{
-		return wtSample(s_waveTables[static_cast<std::size_t>(WaveShape::MoogSaw) - FirstWaveShapeTable], _sample);
+		wtSamples(s_waveTables[static_cast<std::size_t>(WaveShape::MoogSaw) - FirstWaveShapeTable][m_waveTableBand],
+			phases, out, n);
 	}
 	else
 	{
-		return moogSawSample(_sample);
+		for (fpp_t i = 0; i < n; ++i)
+		{
+			out[i] = moogSawSample(phases[i]);
+		}
 	}
 }
 
@@ -787,16 +958,19 @@ inline sample_t Oscillator::getSample<Oscillator::WaveShape::MoogSaw>(
 
 
 template<>
-inline sample_t Oscillator::getSample<Oscillator::WaveShape::Exponential>(
-							const float _sample )
+inline void Oscillator::getSamples<Oscillator::WaveShape::Exponential>(const Block& phases, Block& out, const fpp_t n)
 {
 	if (m_useWaveTable && !m_isModulator)
 	{
-		return wtSample(s_waveTables[static_cast<std::size_t>(WaveShape::Exponential) - FirstWaveShapeTable], _sample);
+		wtSamples(s_waveTables[static_cast<std::size_t>(WaveShape::Exponential) - FirstWaveShapeTable][m_waveTableBand],
+			phases, out, n);
 	}
 	else
 	{
-		return expSample(_sample);
+		for (fpp_t i = 0; i < n; ++i)
+		{
+			out[i] = expSample(phases[i]);
+		}
 	}
 }
 
@@ -804,26 +978,30 @@ inline sample_t Oscillator::getSample<Oscillator::WaveShape::Exponential>(
 
 
 template<>
-inline sample_t Oscillator::getSample<Oscillator::WaveShape::WhiteNoise>(
-							const float _sample )
+inline void Oscillator::getSamples<Oscillator::WaveShape::WhiteNoise>(const Block& phases, Block& out, const fpp_t n)
 {
-	return( noiseSample( _sample ) );
+	for (fpp_t i = 0; i < n; ++i)
+	{
+		out[i] = noiseSample(phases[i]);
+	}
 }
 
 
 
 
 template<>
-inline sample_t Oscillator::getSample<Oscillator::WaveShape::UserDefined>(
-							const float _sample )
+inline void Oscillator::getSamples<Oscillator::WaveShape::UserDefined>(const Block& phases, Block& out, const fpp_t n)
 {
 	if (m_useWaveTable && m_userAntiAliasWaveTable && !m_isModulator)
 	{
-		return wtSample(m_userAntiAliasWaveTable.get(), _sample);
+		wtSamples((*m_userAntiAliasWaveTable)[m_waveTableBand].data(), phases, out, n);
 	}
 	else
 	{
-		return userWaveSample(m_userWave.get(), _sample);
+		for (fpp_t i = 0; i < n; ++i)
+		{
+			out[i] = userWaveSample(m_userWave.get(), phases[i]);
+		}
 	}
 }
 
@@ -0,0 +1,198 @@
+/*
+ * OscillatorBank.cpp - wave shape rendering of many voices at once
+ *
+ * Copyright (c) 2026 LMMS Developers
+ *
+ * This file is part of LMMS - https://lmms.io
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public
+ * License along with this program (see COPYING); if not, write to the
+ * Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA 02110-1301 USA.
+ *
+ */
+
+#include "OscillatorBank.h"
+
+#include <algorithm>
+
+
+namespace lmms
+{
+
+
+namespace
+{
+
+template<Oscillator::WaveShape W>
+inline sample_t shapeSample(const float phase)
+{
+	using WaveShape = Oscillator::WaveShape;
+	if constexpr (W == WaveShape::Sine) { return Oscillator::sinSample(phase); }
+	else if constexpr (W == WaveShape::Triangle) { return Oscillator::triangleSample(phase); }
+	else if constexpr (W == WaveShape::Saw) { return Oscillator::sawSample(phase); }
+	else if constexpr (W == WaveShape::Square) { return Oscillator::squareSample(phase); }
+	else if constexpr (W == WaveShape::MoogSaw) { return Oscillator::moogSawSample(phase); }
+	else if constexpr (W == WaveShape::Exponential) { return Oscillator::expSample(phase); }
+	else { return Oscillator::noiseSample(phase); }
+}
+
+} // namespace
+
+
+
+
+OscillatorBank::OscillatorBank(WaveShape waveShape, bool useWaveTable) :
+	m_waveShape(waveShape),
+	m_useWaveTable(useWaveTable)
+{
+	assert(waveShape != WaveShape::UserDefined);
+}
+
+
+
+
+std::size_t OscillatorBank::addVoice(float phaseOffset, float volume)
+{
+	m_phases.push_back(phaseOffset);
+	m_increments.push_back(0.f);
+	m_volumes.push_back(volume);
+	m_gains.push_back(0.f);
+	m_waveTableBands.push_back(1);
+	m_samples.push_back(0.f);
+	return voices() - 1;
+}
+
+
+
+
+void OscillatorBank::removeVoice(std::size_t voice)
+{
+	assert(voice < voices());
+	const auto removeFrom = [voice](auto& values)
+	{
+		values[voice] = values.back();
+		values.pop_back();
+	};
+	removeFrom(m_phases);
+	removeFrom(m_increments);
+	removeFrom(m_volumes);
+	removeFrom(m_gains);
+	removeFrom(m_waveTableBands);
+	removeFrom(m_samples);
+}
+
+
+
+
+void OscillatorBank::update(SampleFrame* const* buffers, const fpp_t frames, const ch_cnt_t chnl)
+{
+	const float sampleRate = Engine::audioEngine()->outputSampleRate();
+	for (std::size_t v = 0; v < voices(); ++v)
+	{
+		const float freq = m_increments[v] * sampleRate;
+		// voices at or above the Nyquist frequency are muted like in Oscillator
+		const bool audible = m_increments[v] < 0.5f
+			&& !(m_waveShape == WaveShape::Sine && m_useWaveTable && freq >= OscillatorConstants::MAX_FREQ);
+		m_gains[v] = audible ? m_volumes[v] : 0.f;
+		m_waveTableBands[v] = Oscillator::waveTableBandFromFreq(freq);
+		m_phases[v] = absFraction(m_phases[v]);
+	}
+
+	switch (m_waveShape)
+	{
+		case WaveShape::Sine:
+		default:
+			update<WaveShape::Sine>(buffers, frames, chnl);
+			break;
+		case WaveShape::Triangle:
+			update<WaveShape::Triangle>(buffers, frames, chnl);
+			break;
+		case WaveShape::Saw:
+			update<WaveShape::Saw>(buffers, frames, chnl);
+			break;
+		case WaveShape::Square:
+			update<WaveShape::Square>(buffers, frames, chnl);
+			break;
+		case WaveShape::MoogSaw:
+			update<WaveShape::MoogSaw>(buffers, frames, chnl);
+			break;
+		case WaveShape::Exponential:
+			update<WaveShape::Exponential>(buffers, frames, chnl);
+			break;
+		case WaveShape::WhiteNoise:
+			update<WaveShape::WhiteNoise>(buffers, frames, chnl);
+			break;
+	}
+}
+
+
+
+
+template<OscillatorBank::WaveShape W>
+void OscillatorBank::update(SampleFrame* const* buffers, const fpp_t frames, const ch_cnt_t chnl)
+{
+	const std::size_t count = voices();
+	// The phases advance once per block and every frame is computed from the start of its block,
+	// the same way Oscillator::phaseRamp() does, so that both produce the same samples
+	for (fpp_t frame = 0; frame < frames; frame += BlockSize)
+	{
+		const fpp_t n = std::min(BlockSize, frames - frame);
+		for (fpp_t i = 0; i < n; ++i)
+		{
+			getSamples<W>(i);
+			for (std::size_t v = 0; v < count; ++v)
+			{
+				buffers[v][frame + i][chnl] = m_samples[v] * m_gains[v];
+			}
+		}
+		for (std::size_t v = 0; v < count; ++v)
+		{
+			m_phases[v] += n * m_increments[v];
+		}
+	}
+}
+
+
+
+
+template<OscillatorBank::WaveShape W>
+void OscillatorBank::getSamples(const fpp_t frame)
+{
+	const std::size_t count = voices();
+	if constexpr (W != WaveShape::Sine && W != WaveShape::WhiteNoise)
+	{
+		if (m_useWaveTable)
+		{
+			const auto& tables = Oscillator::s_waveTables[static_cast<std::size_t>(W) - Oscillator::FirstWaveShapeTable];
+			for (std::size_t v = 0; v < count; ++v)
+			{
+				const sample_t* table = tables[m_waveTableBands[v]];
+				const float pos = absFraction(m_phases[v] + frame * m_increments[v])
+					* OscillatorConstants::WAVETABLE_LENGTH;
+				const auto f1 = static_cast<f_cnt_t>(pos);
+				const auto f2 = f1 < OscillatorConstants::WAVETABLE_LENGTH - 1 ? f1 + 1 : 0;
+				m_samples[v] = table[f1] + fraction(pos) * (table[f2] - table[f1]);
+			}
+			return;
+		}
+	}
+
+	for (std::size_t v = 0; v < count; ++v)
+	{
+		m_samples[v] = shapeSample<W>(m_phases[v] + frame * m_increments[v]);
+	}
+}
+
+
+} // namespace lmms
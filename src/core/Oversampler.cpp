@@ -0,0 +1,408 @@
+/*
+ * Oversampler.cpp
+ *
+ * Copyright (c) 2026 LMMS Developers
+ *
+ * This file is part of LMMS - https://lmms.io
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public
+ * License along with this program (see COPYING); if not, write to the
+ * Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA 02110-1301 USA.
+ *
+ */
+
+#include "Oversampler.h"
+
+#include <array>
+#include <cassert>
+#include <cmath>
+#include <numbers>
+
+namespace lmms
+{
+
+namespace
+{
+
+constexpr int MaxStages = 3;
+
+//! Zeroth order modified Bessel function of the first kind, for the Kaiser window
+double besselI0(double x)
+{
+	double sum = 1.0, term = 1.0;
+	for (int k = 1; k < 32; ++k)
+	{
+		term *= (x / (2 * k)) * (x / (2 * k));
+		sum += term;
+	}
+	return sum;
+}
+
+
+/**
+	Linear phase halfband FIR with 2 * Order + 1 taps. Order is odd, so all taps
+	at an odd distance from the center are zero except the center tap itself.
+	For each pair of output frames, one is a plain delay of the input and the
+	other is the only filter that needs to be computed.
+*/
+template<int Order>
+class FirStage
+{
+	static_assert(Order % 2 == 1);
+	static constexpr int Taps = Order + 1; //!< nonzero taps at an even distance from the center
+	static constexpr int Delay = (Order - 1) / 2; //!< delay of the center tap path in input frames
+
+public:
+	FirStage()
+	{
+		// 80 dB stopband attenuation
+		const double beta = 0.1102 * (80.0 - 8.7);
+		for (int k = 0; k < Taps; ++k)
+		{
+			const int n = 2 * k;
+			const double x = n - Order; // always odd
+			const double sinc = std::sin(std::numbers::pi * x / 2) / (std::numbers::pi * x);
+			const double ratio = x / (Order + 1);
+			// doubled for the gain of the upsampler, halved again when downsampling
+			m_coeffs[k] = static_cast<float>(2.0 * sinc * besselI0(beta * std::sqrt(1.0 - ratio * ratio)) / besselI0(beta));
+		}
+	}
+
+	//! Group delay of upsampling and downsampling together, in frames of the higher rate
+	static constexpr double latency() { return 2.0 * Order; }
+
+	void upsample(const SampleFrame* in, fpp_t frames, SampleFrame* out)
+	{
+		for (fpp_t f = 0; f < frames; ++f)
+		{
+			const SampleFrame* x = m_up.push(in[f]);
+			out[2 * f] = filter(x);
+			out[2 * f + 1] = x[Delay];
+		}
+	}
+
+	void downsample(const SampleFrame* in, fpp_t frames, SampleFrame* out)
+	{
+		for (fpp_t f = 0; f < frames; ++f)
+		{
+			const SampleFrame* even = m_downEven.push(in[2 * f]);
+			// the odd input frame takes part in the next output frame
+			const SampleFrame* odd = m_downOdd.data();
+			out[f] = (filter(even) + odd[Delay]) * 0.5f;
+			m_downOdd.push(in[2 * f + 1]);
+		}
+	}
+
+	void reset()
+	{
+		m_up = {};
+		m_downEven = {};
+		m_downOdd = {};
+	}
+
+private:
+	//! The last Size frames stored twice, so they can be read from the newest to the oldest without wrapping
+	template<int Size>
+	struct History
+	{
+		const SampleFrame* push(const SampleFrame& frame)
+		{
+			pos = (pos == 0 ? Size : pos) - 1;
+			frames[pos] = frames[pos + Size] = frame;
+			return data();
+		}
+
+		const SampleFrame* data() const { return frames.data() + pos; }
+
+		std::array<SampleFrame, 2 * Size> frames = {};
+		int pos = 0;
+	};
+
+	SampleFrame filter(const SampleFrame* x) const
+	{
+		auto sum = SampleFrame{};
+		for (int k = 0; k < Taps; ++k)
+		{
+			sum += x[k] * m_coeffs[k];
+		}
+		return sum;
+	}
+
+	std::array<float, Taps> m_coeffs;
+	History<Taps> m_up;
+	History<Taps> m_downEven;
+	History<Delay + 1> m_downOdd;
+};
+
+
+/**
+	Minimum phase halfband filter made of two parallel chains of first order
+	allpass filters at the lower rate, after "Digital signal processing schemes
+	for efficient interpolation and decimation" by Valenzuela and Constantinides.
+*/
+template<int Coeffs>
+class AllpassStage
+{
+public:
+	//! @p transition is the width of the transition band relative to the higher rate
+	explicit AllpassStage(double transition)
+	{
+		using std::numbers::pi;
+
+		// elliptic filter parameters for the transition band
+		double k = std::tan((1.0 - transition * 2.0) * pi / 4.0);
+		k *= k;
+		const double kksqrt = std::pow(1.0 - k * k, 0.25);
+		const double e = 0.5 * (1.0 - kksqrt) / (1.0 + kksqrt);
+		const double e4 = e * e * e * e;
+		const double q = e * (1.0 + e4 * (2.0 + e4 * (15.0 + 150.0 * e4)));
+
+		const int order = Coeffs * 2 + 1;
+		for (int index = 0; index < Coeffs; ++index)
+		{
+			const int c = index + 1;
+			double num = 0.0, den = 0.0;
+			for (int i = 0; i < 16; ++i)
+			{
+				num += (i % 2 ? -1.0 : 1.0) * std::pow(q, i * (i + 1)) * std::sin((i * 2 + 1) * c * pi / order);
+			}
+			for (int i = 1; i < 16; ++i)
+			{
+				den += (i % 2 ? -1.0 : 1.0) * std::pow(q, i * i) * std::cos(i * 2 * c * pi / order);
+			}
+			const double ww = num * std::pow(q, 0.25) / (den + 0.5);
+			const double wwsq = ww * ww;
+			const double x = std::sqrt((1.0 - wwsq * k) * (1.0 - wwsq / k)) / (1.0 + wwsq);
+			m_coeffs[index] = static_cast<float>((1.0 - x) / (1.0 + x));
+		}
+	}
+
+	//! Group delay at low frequencies of upsampling and downsampling together, in frames of the higher rate
+	double latency() const
+	{
+		// Each section delays its path by (1 - c) / (1 + c) frames of the lower rate, the filter by the average of
+		// both paths plus half a frame. Downsampling takes the input one frame earlier, which leaves the sum.
+		double delay = 0.0;
+		for (float coeff : m_coeffs)
+		{
+			delay += 2.0 * (1.0 - coeff) / (1.0 + coeff);
+		}
+		return delay;
+	}
+
+	void upsample(const SampleFrame* in, fpp_t frames, SampleFrame* out)
+	{
+		for (fpp_t f = 0; f < frames; ++f)
+		{
+			SampleFrame even = in[f];
+			SampleFrame odd = in[f];
+			m_up.process(m_coeffs, even, odd);
+			out[2 * f] = even;
+			out[2 * f + 1] = odd;
+		}
+	}
+
+	void downsample(const SampleFrame* in, fpp_t frames, SampleFrame* out)
+	{
+		for (fpp_t f = 0; f < frames; ++f)
+		{
+			SampleFrame first = in[2 * f + 1];
+			SampleFrame second = in[2 * f];
+			m_down.process(m_coeffs, first, second);
+			out[f] = (first + second) * 0.5f;
+		}
+	}
+
+	void reset()
+	{
+		m_up = {};
+		m_down = {};
+	}
+
+private:
+	struct Chains
+	{
+		//! Runs @p a through the sections with even and @p b through the ones with odd coefficient indices
+		void process(const std::array<float, Coeffs>& coeffs, SampleFrame& a, SampleFrame& b)
+		{
+			for (int i = 0; i < Coeffs; i += 2)
+			{
+				const SampleFrame outA = (a - y[i]) * coeffs[i] + x[i];
+				x[i] = a;
+				y[i] = outA;
+				a = outA;
+				if (i + 1 < Coeffs)
+				{
+					const SampleFrame outB = (b - y[i + 1]) * coeffs[i + 1] + x[i + 1];
+					x[i + 1] = b;
+					y[i + 1] = outB;
+					b = outB;
+				}
+			}
+		}
+
+		std::array<SampleFrame, Coeffs> x = {};
+		std::array<SampleFrame, Coeffs> y = {};
+	};
+
+	std::array<float, Coeffs> m_coeffs;
+	Chains m_up;
+	Chains m_down;
+};
+
+} // namespace
+
+
+
+
+//! The first stage has to keep the whole audible band, the following ones only need to remove what is above it
+struct Oversampler::Stages
+{
+	FirStage<31> fir0;
+	FirStage<11> fir1;
+	FirStage<11> fir2;
+	AllpassStage<8> allpass0{0.04};
+	AllpassStage<4> allpass1{0.25};
+	AllpassStage<4> allpass2{0.25};
+
+	template<class Func>
+	void visit(int stage, Phase phase, Func&& func)
+	{
+		if (phase == Phase::Linear)
+		{
+			switch (stage)
+			{
+			case 0: func(fir0); break;
+			case 1: func(fir1); break;
+			default: func(fir2); break;
+			}
+		}
+		else
+		{
+			switch (stage)
+			{
+			case 0: func(allpass0); break;
+			case 1: func(allpass1); break;
+			default: func(allpass2); break;
+			}
+		}
+	}
+};
+
+
+
+
+Oversampler::Oversampler(fpp_t maxFrames, int factor, Phase phase) :
+	m_factor(1),
+	m_phase(phase),
+	m_stages(std::make_unique<Stages>()),
+	m_buffers{std::vector<SampleFrame>(maxFrames * MaxFactor), std::vector<SampleFrame>(maxFrames * MaxFactor / 2)}
+{
+	setFactor(factor);
+}
+
+
+
+
+Oversampler::~Oversampler() = default;
+
+
+
+
+void Oversampler::setFactor(int factor)
+{
+	assert(factor == 1 || factor == 2 || factor == 4 || factor == 8);
+	if (factor == m_factor) { return; }
+	m_factor = factor;
+	reset();
+}
+
+
+
+
+void Oversampler::setPhase(Phase phase)
+{
+	if (phase == m_phase) { return; }
+	m_phase = phase;
+	reset();
+}
+
+
+
+
+f_cnt_t Oversampler::latency() const
+{
+	double frames = 0.0;
+	for (int stage = 0; stage < stageCount(); ++stage)
+	{
+		// stage s runs at 2^(s + 1) times the engine rate
+		m_stages->visit(stage, m_phase, [&](auto& s) { frames += s.latency() / (2 << stage); });
+	}
+	return static_cast<f_cnt_t>(std::lround(frames));
+}
+
+
+
+
+SampleFrame* Oversampler::upsample(const SampleFrame* in, fpp_t frames)
+{
+	const int stages = stageCount();
+	for (int stage = 0; stage < stages; ++stage)
+	{
+		// alternate between both buffers so that the last stage writes into the first one
+		const SampleFrame* src = stage == 0 ? in : m_buffers[(stages - stage) % 2].data();
+		SampleFrame* dst = m_buffers[(stages - 1 - stage) % 2].data();
+		m_stages->visit(stage, m_phase, [&](auto& s) { s.upsample(src, frames << stage, dst); });
+	}
+	return m_buffers[0].data();
+}
+
+
+
+
+void Oversampler::downsample(SampleFrame* out, fpp_t frames)
+{
+	const int stages = stageCount();
+	for (int stage = stages - 1; stage >= 0; --stage)
+	{
+		const SampleFrame* src = m_buffers[(stages - 1 - stage) % 2].data();
+		SampleFrame* dst = stage == 0 ? out : m_buffers[(stages - stage) % 2].data();
+		m_stages->visit(stage, m_phase, [&](auto& s) { s.downsample(src, frames << stage, dst); });
+	}
+}
+
+
+
+
+void Oversampler::reset()
+{
+	for (int stage = 0; stage < MaxStages; ++stage)
+	{
+		for (auto phase : {Phase::Linear, Phase::Minimum})
+		{
+			m_stages->visit(stage, phase, [](auto& s) { s.reset(); });
+		}
+	}
+}
+
+
+
+
+int Oversampler::stageCount() const
+{
+	return m_factor == 8 ? 3 : m_factor / 2;
+}
+
+
+} // namespace lmms
@@ -26,18 +26,20 @@
 #include "AudioEngine.h"
 #include "BufferManager.h"
 #include "Engine.h"
+#include "MixHelpers.h"
 
+#include <cassert>
 #include <QThread>
 
 
 namespace lmms
 {
 
-PlayHandle::PlayHandle(const Type type, f_cnt_t offset) :
+PlayHandle::PlayHandle(const Type type, f_cnt_t offset, bool ownBuffer) :
 		m_type(type),
 		m_offset(offset),
 		m_affinity(QThread::currentThread()),
-		m_playHandleBuffer(BufferManager::acquire()),
+		m_playHandleBuffer(ownBuffer ? BufferManager::acquire() : nullptr),
 		m_bufferReleased(true),
 		m_usesBuffer(true)
 {
@@ -46,7 +48,7 @@ PlayHandle::PlayHandle(const Type type, f_cnt_t offset) :
 
 PlayHandle::~PlayHandle()
 {
-	BufferManager::release(m_playHandleBuffer);
+	if (m_playHandleBuffer) { BufferManager::release(m_playHandleBuffer); }
 }
 
 
@@ -54,7 +56,9 @@ void PlayHandle::doProcessing()
 {
 	if( m_usesBuffer )
 	{
+		assert(m_playHandleBuffer);
 		m_bufferReleased = false;
+		m_bufferSilence = Silence::Unknown;
 		zeroSampleFrames(m_playHandleBuffer, Engine::audioEngine()->framesPerPeriod());
 		play( buffer() );
 	}
@@ -75,4 +79,14 @@ SampleFrame* PlayHandle::buffer()
 	return m_bufferReleased ? nullptr : m_playHandleBuffer;
 };
 
+bool PlayHandle::isBufferSilent()
+{
+	if (m_bufferSilence == Silence::Unknown)
+	{
+		const bool silent = MixHelpers::isSilent(m_playHandleBuffer, Engine::audioEngine()->framesPerPeriod());
+		m_bufferSilence = silent ? Silence::Silent : Silence::Audible;
+	}
+	return m_bufferSilence == Silence::Silent;
+}
+
 } // namespace lmms
\ No newline at end of file
@@ -0,0 +1,140 @@
+/*
+ * PolyphaseResampler.cpp
+ *
+ * Copyright (c) 2026 LMMS Developers
+ *
+ * This file is part of LMMS - https://lmms.io
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public
+ * License along with this program (see COPYING); if not, write to the
+ * Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA 02110-1301 USA.
+ *
+ */
+
+
+#include "PolyphaseResampler.h"
+
+#include <algorithm>
+#include <cmath>
+#include <numbers>
+#include <numeric>
+
+namespace lmms
+{
+
+namespace
+{
+
+//! Zeroth order modified Bessel function of the first kind, for the Kaiser window
+double besselI0(double x)
+{
+	double sum = 1.0, term = 1.0;
+	for (int k = 1; k < 32; ++k)
+	{
+		term *= (x / (2 * k)) * (x / (2 * k));
+		sum += term;
+	}
+	return sum;
+}
+
+} // namespace
+
+
+
+
+PolyphaseResampler::PolyphaseResampler(sample_rate_t inRate, sample_rate_t outRate) :
+	m_history(2 * TapsPerPhase)
+{
+	const auto divisor = std::gcd(inRate, outRate);
+	m_up = outRate / divisor;
+	m_down = inRate / divisor;
+
+	// lowpass at the lower of both Nyquist frequencies, relative to the
+	// interpolated rate, with some room for the transition band
+	const auto taps = m_up * TapsPerPhase;
+	const double cutoff = 0.45 / std::max(m_up, m_down);
+	const double beta = 8.0;
+	const double center = (taps - 1) / 2.0;
+	auto prototype = std::vector<double>(taps);
+	for (f_cnt_t n = 0; n < taps; ++n)
+	{
+		const double x = n - center;
+		const double sinc = x == 0.0 ? 1.0 : std::sin(2 * std::numbers::pi * cutoff * x) / (2 * std::numbers::pi * cutoff * x);
+		const double ratio = x / (center + 1);
+		prototype[n] = sinc * besselI0(beta * std::sqrt(1.0 - ratio * ratio)) / besselI0(beta);
+	}
+
+	// split into phases, normalized so that each has unity gain at DC
+	m_coeffs.resize(taps);
+	for (f_cnt_t phase = 0; phase < m_up; ++phase)
+	{
+		double sum = 0.0;
+		for (int k = 0; k < TapsPerPhase; ++k) { sum += prototype[phase + k * m_up]; }
+		for (int k = 0; k < TapsPerPhase; ++k)
+		{
+			m_coeffs[phase * TapsPerPhase + k] = static_cast<float>(prototype[phase + k * m_up] / sum);
+		}
+	}
+}
+
+
+
+
+f_cnt_t PolyphaseResampler::latency() const
+{
+	const auto taps = m_up * TapsPerPhase;
+	return static_cast<f_cnt_t>(std::lround((taps - 1) / (2.0 * m_down)));
+}
+
+
+
+
+f_cnt_t PolyphaseResampler::process(const SampleFrame* in, f_cnt_t inFrames, SampleFrame* out)
+{
+	f_cnt_t written = 0;
+	for (f_cnt_t f = 0; f < inFrames; ++f)
+	{
+		m_history[m_historyPos] = m_history[m_historyPos + TapsPerPhase] = in[f];
+		// the newest frame is at newest[0], older ones at lower addresses
+		const SampleFrame* newest = &m_history[m_historyPos + TapsPerPhase];
+
+		// produce all output frames which lie between this and the next input frame
+		for (; m_phase < m_up; m_phase += m_down)
+		{
+			const float* coeffs = &m_coeffs[m_phase * TapsPerPhase];
+			float left = 0.f, right = 0.f;
+			for (int k = 0; k < TapsPerPhase; ++k)
+			{
+				left += coeffs[k] * newest[-k][0];
+				right += coeffs[k] * newest[-k][1];
+			}
+			out[written++] = SampleFrame(left, right);
+		}
+		m_phase -= m_up;
+		m_historyPos = (m_historyPos + 1) % TapsPerPhase;
+	}
+	return written;
+}
+
+
+
+
+void PolyphaseResampler::reset()
+{
+	std::fill(m_history.begin(), m_history.end(), SampleFrame{});
+	m_historyPos = 0;
+	m_phase = 0;
+}
+
+} // namespace lmms
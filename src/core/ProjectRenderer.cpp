@@ -94,8 +94,12 @@ ProjectRenderer::ProjectRenderer( const AudioEngine::qualitySettings & qualitySe
 	{
 		bool successful = false;
 
+		// WAV and FLAC files carry all speakers of the output layout, the lossy formats stay stereo
+		const bool multichannel = exportFileFormat == ExportFileFormat::Wave || exportFileFormat == ExportFileFormat::Flac;
+		const ch_cnt_t channels = multichannel ? Engine::audioEngine()->outputChannels() : DEFAULT_CHANNELS;
+
 		m_fileDev = audioEncoderFactory(
-					outputFilename, outputSettings, DEFAULT_CHANNELS,
+					outputFilename, outputSettings, channels,
 					Engine::audioEngine(), successful );
 		if( !successful )
 		{
@@ -162,14 +166,15 @@ void ProjectRenderer::run()
 	PerfLogTimer perfLog("Project Render");
 
 	Engine::getSong()->startExport();
-	// Skip first empty buffer.
-	Engine::audioEngine()->nextBuffer();
 
 	m_progress = 0;
 
 	// Now start processing
 	Engine::audioEngine()->startProcessing(false);
 
+	// Skip first empty buffer.
+	Engine::audioEngine()->nextBuffer();
+
 	// Continually track and emit progress percentage to listeners.
 	while (!Engine::getSong()->isExportDone() && !m_abort)
 	{
@@ -0,0 +1,343 @@
+/*
+ * RealtimeContext.cpp - marks code running on the audio threads
+ *
+ * Copyright (c) 2026 LMMS Developers
+ *
+ * This file is part of LMMS - https://lmms.io
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public
+ * License along with this program (see COPYING); if not, write to the
+ * Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA 02110-1301 USA.
+ *
+ */
+
+#include "RealtimeContext.h"
+
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+
+#ifdef LMMS_DEBUG_REALTIME
+#include <cerrno>
+#include <cstdarg>
+#include <dlfcn.h>
+#include <execinfo.h>
+#include <fcntl.h>
+#include <linux/futex.h>
+#include <pthread.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+#if defined(LMMS_DEBUG) || defined(LMMS_DEBUG_REALTIME)
+#define LMMS_REALTIME_CHECKS
+#endif
+
+namespace lmms
+{
+
+namespace
+{
+
+// Only trivial thread locals are used here, since they are accessed from within malloc().
+// Initial-exec TLS never allocates on access.
+#if defined(__GNUC__) && !defined(_WIN32)
+#define LMMS_TLS_INITIAL_EXEC __attribute__((tls_model("initial-exec")))
+#else
+#define LMMS_TLS_INITIAL_EXEC
+#endif
+
+thread_local int s_depth LMMS_TLS_INITIAL_EXEC = 0;
+thread_local unsigned s_allocations LMMS_TLS_INITIAL_EXEC = 0;
+
+// Avoid flooding stderr if the render path allocates every period
+constexpr int MaxReports = 100;
+std::atomic_int s_reports = 0;
+std::atomic<std::size_t> s_violations = 0;
+
+#ifdef LMMS_DEBUG_REALTIME
+
+//! Call stack of a single violation
+struct Stack
+{
+	static constexpr int MaxDepth = 32;
+
+	const char* function;
+	int depth;
+	void* frames[MaxDepth];
+};
+
+// Only the first few violations of each period keep their call stack
+constexpr int MaxStacks = 4;
+
+thread_local unsigned s_deallocations LMMS_TLS_INITIAL_EXEC = 0;
+thread_local unsigned s_locks LMMS_TLS_INITIAL_EXEC = 0;
+thread_local bool s_inHook LMMS_TLS_INITIAL_EXEC = false;
+thread_local int s_stackCount LMMS_TLS_INITIAL_EXEC = 0;
+thread_local Stack s_stacks[MaxStacks] LMMS_TLS_INITIAL_EXEC;
+
+int s_reportFd = STDERR_FILENO;
+
+using MutexLockFunc = int (*)(pthread_mutex_t*);
+std::atomic<MutexLockFunc> s_mutexLock = nullptr;
+
+MutexLockFunc realMutexLock()
+{
+	auto func = s_mutexLock.load(std::memory_order_relaxed);
+	if (!func)
+	{
+		func = reinterpret_cast<MutexLockFunc>(dlsym(RTLD_NEXT, "pthread_mutex_lock"));
+		s_mutexLock.store(func, std::memory_order_relaxed);
+	}
+	return func;
+}
+
+using SyscallFunc = long (*)(long, ...);
+std::atomic<SyscallFunc> s_syscall = nullptr;
+
+SyscallFunc realSyscall()
+{
+	auto func = s_syscall.load(std::memory_order_relaxed);
+	if (!func)
+	{
+		func = reinterpret_cast<SyscallFunc>(dlsym(RTLD_NEXT, "syscall"));
+		s_syscall.store(func, std::memory_order_relaxed);
+	}
+	return func;
+}
+
+void printSummary()
+{
+	dprintf(s_reportFd, "RealtimeContext: %zu violation(s) in total\n", s_violations.load());
+}
+
+//! Opens the report and resolves everything the hooks need before any audio thread runs
+struct ReportInit
+{
+	ReportInit()
+	{
+		if (const char* path = std::getenv("LMMS_REALTIME_REPORT"))
+		{
+			const int fd = open(path, O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+			if (fd >= 0) { s_reportFd = fd; }
+		}
+
+		// The first backtrace() call loads libgcc, which allocates
+		void* frame;
+		backtrace(&frame, 1);
+		realMutexLock();
+		realSyscall();
+
+		std::atexit(printSummary);
+	}
+} s_reportInit;
+
+#endif // LMMS_DEBUG_REALTIME
+
+} // namespace
+
+
+#ifdef LMMS_REALTIME_CHECKS
+
+//! Called by the hooks below for every function that must not be used on an audio thread
+inline void recordViolation([[maybe_unused]] const char* function, unsigned& counter)
+{
+#ifdef LMMS_DEBUG_REALTIME
+	if (s_depth == 0 || s_inHook) { return; }
+	++counter;
+
+	if (s_stackCount < MaxStacks)
+	{
+		s_inHook = true;
+		auto& stack = s_stacks[s_stackCount++];
+		stack.function = function;
+		stack.depth = backtrace(stack.frames, Stack::MaxDepth);
+		s_inHook = false;
+	}
+#else
+	if (s_depth > 0) { ++counter; }
+#endif
+}
+
+#endif // LMMS_REALTIME_CHECKS
+
+
+bool RealtimeContext::isActive()
+{
+	return s_depth > 0;
+}
+
+
+std::size_t RealtimeContext::violations()
+{
+	return s_violations.load(std::memory_order_relaxed);
+}
+
+
+#ifdef LMMS_DEBUG_REALTIME
+
+void RealtimeContext::reportLock(const char* function)
+{
+	recordViolation(function, s_locks);
+}
+
+#endif
+
+
+#ifdef LMMS_REALTIME_CHECKS
+
+RealtimeContext::RealtimeContext()
+{
+	if (s_depth++ > 0) { return; }
+
+	s_allocations = 0;
+#ifdef LMMS_DEBUG_REALTIME
+	s_deallocations = 0;
+	s_locks = 0;
+	s_stackCount = 0;
+#endif
+}
+
+
+RealtimeContext::~RealtimeContext()
+{
+	if (--s_depth > 0) { return; }
+
+#ifdef LMMS_DEBUG_REALTIME
+	const unsigned total = s_allocations + s_deallocations + s_locks;
+	if (total == 0) { return; }
+	s_violations += total;
+
+	// Reports written to a file are never suppressed, since they are evaluated afterwards
+	const int report = ++s_reports;
+	if (s_reportFd == STDERR_FILENO && report > MaxReports) { return; }
+
+	dprintf(s_reportFd, "RealtimeContext: %u allocation(s), %u deallocation(s), %u lock(s) on an audio thread\n",
+		s_allocations, s_deallocations, s_locks);
+	for (int i = 0; i < s_stackCount; ++i)
+	{
+		dprintf(s_reportFd, "  %s() called from:\n", s_stacks[i].function);
+		backtrace_symbols_fd(s_stacks[i].frames, s_stacks[i].depth, s_reportFd);
+	}
+	if (s_reportFd == STDERR_FILENO && report == MaxReports)
+	{
+		dprintf(s_reportFd, "RealtimeContext: too many violations on audio threads, further reports suppressed\n");
+	}
+#else
+	if (s_allocations == 0) { return; }
+	s_violations += s_allocations;
+
+	const int report = ++s_reports;
+	if (report < MaxReports)
+	{
+		std::fprintf(stderr, "RealtimeContext: %u heap allocation(s) on an audio thread\n", s_allocations);
+	}
+	else if (report == MaxReports)
+	{
+		std::fprintf(stderr, "RealtimeContext: too many allocations on audio threads, further reports suppressed\n");
+	}
+#endif
+}
+
+#endif // LMMS_REALTIME_CHECKS
+
+} // namespace lmms
+
+
+#if defined(LMMS_REALTIME_CHECKS) && defined(__GLIBC__)
+
+// Interpose the allocation functions of the C library. operator new and
+// all containers end up here as well.
+extern "C"
+{
+
+void* __libc_malloc(std::size_t size);
+void* __libc_calloc(std::size_t count, std::size_t size);
+void* __libc_realloc(void* ptr, std::size_t size);
+
+void* malloc(std::size_t size)
+{
+	lmms::recordViolation("malloc", lmms::s_allocations);
+	return __libc_malloc(size);
+}
+
+void* calloc(std::size_t count, std::size_t size)
+{
+	lmms::recordViolation("calloc", lmms::s_allocations);
+	return __libc_calloc(count, size);
+}
+
+void* realloc(void* ptr, std::size_t size)
+{
+	lmms::recordViolation("realloc", lmms::s_allocations);
+	return __libc_realloc(ptr, size);
+}
+
+#ifdef LMMS_DEBUG_REALTIME
+
+void* __libc_memalign(std::size_t alignment, std::size_t size);
+void __libc_free(void* ptr);
+
+void* aligned_alloc(std::size_t alignment, std::size_t size)
+{
+	lmms::recordViolation("aligned_alloc", lmms::s_allocations);
+	return __libc_memalign(alignment, size);
+}
+
+int posix_memalign(void** ptr, std::size_t alignment, std::size_t size)
+{
+	lmms::recordViolation("posix_memalign", lmms::s_allocations);
+	void* result = __libc_memalign(alignment, size);
+	if (!result) { return ENOMEM; }
+	*ptr = result;
+	return 0;
+}
+
+void free(void* ptr)
+{
+	if (ptr) { lmms::recordViolation("free", lmms::s_deallocations); }
+	__libc_free(ptr);
+}
+
+// QMutex does not use pthread mutexes on Linux, so only std::mutex and
+// plain pthread mutexes are caught here
+int pthread_mutex_lock(pthread_mutex_t* mutex)
+{
+	lmms::recordViolation("pthread_mutex_lock", lmms::s_locks);
+	return lmms::realMutexLock()(mutex);
+}
+
+// QMutex calls the futex syscall directly once it is contended, so waiting for
+// one is caught here. Uncontended QMutex locks never leave user space and have
+// to be reported with RealtimeContext::reportLock() at the lock site.
+long syscall(long number, ...)
+{
+	va_list args;
+	va_start(args, number);
+	long arg[6];
+	for (auto& a : arg) { a = va_arg(args, long); }
+	va_end(args);
+
+	if (number == SYS_futex && (arg[1] & FUTEX_CMD_MASK) == FUTEX_WAIT)
+	{
+		lmms::recordViolation("futex", lmms::s_locks);
+	}
+	return lmms::realSyscall()(number, arg[0], arg[1], arg[2], arg[3], arg[4], arg[5]);
+}
+
+#endif // LMMS_DEBUG_REALTIME
+
+} // extern "C"
+
+#endif // defined(LMMS_REALTIME_CHECKS) && defined(__GLIBC__)
@@ -34,6 +34,7 @@
 #endif
 
 #include "AudioEngine.h"
+#include "ConfigManager.h"
 #include "Engine.h"
 #include "MidiEvent.h"
 #include "Song.h"
@@ -143,6 +144,8 @@ RemotePlugin::RemotePlugin() :
 	m_commMutex(QMutex::Recursive),
 #endif
 	m_splitChannels( false ),
+	m_pipelined( ConfigManager::inst()->value( "audioengine", "pipelineremoteplugins", "0" ).toInt() ),
+	m_processingPending( false ),
 	m_audioBufferSize( 0 ),
 	m_inputCount( DEFAULT_CHANNELS ),
 	m_outputCount( DEFAULT_CHANNELS )
@@ -234,6 +237,7 @@ bool RemotePlugin::init(const QString &pluginExecutable,
 #endif
 		m_failed = false;
 	}
+	m_processingPending = false;
 	QString exec = QFileInfo(QDir("plugins:"), pluginExecutable).absoluteFilePath();
 
 	// We may have received a directory via a environment variable
@@ -315,6 +319,10 @@ bool RemotePlugin::init(const QString &pluginExecutable,
 	}
 #endif
 
+#ifdef SYNC_WITH_SHM_RING
+	offerRingTransport();
+#endif
+
 	sendMessage(message(IdSyncKey).addString(Engine::getSong()->syncKey()));
 	resizeSharedProcessingMemory();
 
@@ -362,8 +370,63 @@ bool RemotePlugin::process( const SampleFrame* _in_buf, SampleFrame* _out_buf )
 		return false;
 	}
 
+	if( m_pipelined )
+	{
+		lock();
+		// the plugin has had a whole period for this, so usually there's no waiting here
+		while( m_processingPending && !m_failed && !isInvalid() )
+		{
+			fetchAndProcessNextMessage();
+		}
+
+		if( _out_buf != nullptr )
+		{
+			if( m_outputCount > 0 && !m_failed ) { readOutputs( _out_buf, frames ); }
+			else { zeroSampleFrames( _out_buf, frames ); }
+		}
+
+		memset( m_audioBuffer.get(), 0, m_audioBufferSize );
+		writeInputs( _in_buf, frames );
+		sendMessage( IdStartProcessing );
+		m_processingPending = true;
+		unlock();
+
+		return _out_buf != nullptr && m_outputCount > 0;
+	}
+
 	memset( m_audioBuffer.get(), 0, m_audioBufferSize );
+	writeInputs( _in_buf, frames );
+
+	lock();
+	sendMessage( IdStartProcessing );
+
+	if( m_failed || _out_buf == nullptr || m_outputCount == 0 )
+	{
+		unlock();
+		return false;
+	}
+
+	waitForMessage( IdProcessingDone );
+	unlock();
+
+	readOutputs( _out_buf, frames );
+
+	return true;
+}
+
+
+
+
+f_cnt_t RemotePlugin::latency() const
+{
+	return m_pipelined ? Engine::audioEngine()->framesPerPeriod() : 0;
+}
+
 
+
+
+void RemotePlugin::writeInputs( const SampleFrame* _in_buf, const fpp_t frames )
+{
 	ch_cnt_t inputs = std::min<ch_cnt_t>(m_inputCount, DEFAULT_CHANNELS);
 
 	if( _in_buf != nullptr && inputs > 0 )
@@ -396,19 +459,13 @@ bool RemotePlugin::process( const SampleFrame* _in_buf, SampleFrame* _out_buf )
 			}
 		}
 	}
+}
 
-	lock();
-	sendMessage( IdStartProcessing );
 
-	if( m_failed || _out_buf == nullptr || m_outputCount == 0 )
-	{
-		unlock();
-		return false;
-	}
 
-	waitForMessage( IdProcessingDone );
-	unlock();
 
+void RemotePlugin::readOutputs( SampleFrame* _out_buf, const fpp_t frames )
+{
 	const ch_cnt_t outputs = std::min<ch_cnt_t>(m_outputCount,
 							DEFAULT_CHANNELS);
 	if( m_splitChannels )
@@ -442,8 +499,6 @@ bool RemotePlugin::process( const SampleFrame* _in_buf, SampleFrame* _out_buf )
 			}
 		}
 	}
-
-	return true;
 }
 
 
@@ -570,7 +625,16 @@ bool RemotePlugin::processMessage( const message & _m )
 						_m.getString( 0 ).c_str() );
 			break;
 
+#ifdef SYNC_WITH_SHM_RING
+		case IdTransportChanged:
+			ringTransportChanged( _m );
+			break;
+#endif
+
 		case IdProcessingDone:
+			m_processingPending = false;
+			break;
+
 		case IdQuit:
 		default:
 			break;
@@ -27,9 +27,12 @@
 #include <QDomElement>
 #include <QFileInfo>
 
+#include <utility>
+
 #include "PathUtil.h"
 #include "SampleClipView.h"
 #include "SampleLoader.h"
+#include "SampleRecordWriter.h"
 #include "SampleTrack.h"
 #include "Song.h"
 
@@ -65,6 +68,8 @@ SampleClip::SampleClip(Track* _track, Sample sample, bool isPlaying)
 			this, SLOT(playbackPositionChanged()), Qt::DirectConnection );
 	//care about Clip position
 	connect( this, SIGNAL(positionChanged()), this, SLOT(updateTrackClips()));
+	//prepare recording while armed
+	connect(&m_recordModel, SIGNAL(dataChanged()), this, SLOT(updateRecordWriter()));
 
 	updateTrackClips();
 }
@@ -103,6 +108,8 @@ SampleClip::SampleClip(const SampleClip& orig) :
 			this, SLOT(playbackPositionChanged()), Qt::DirectConnection );
 	//care about Clip position
 	connect( this, SIGNAL(positionChanged()), this, SLOT(updateTrackClips()));
+	//prepare recording while armed
+	connect(&m_recordModel, SIGNAL(dataChanged()), this, SLOT(updateRecordWriter()));
 
 	updateTrackClips();
 }
@@ -185,6 +192,68 @@ void SampleClip::toggleRecord()
 
 
 
+void SampleClip::updateRecordWriter()
+{
+	const bool armed = m_recordWriter && !m_recordWriter->isStopped();
+	if (isRecord() == armed) { return; }
+
+	if (isRecord())
+	{
+		// Set up here, so the audio thread does not have to allocate the buffer or start the disk thread
+		auto writer = std::make_unique<SampleRecordWriter>(this);
+		std::unique_ptr<SampleRecordWriter> previous;
+		{
+			const auto guard = Engine::audioEngine()->requestChangesGuard();
+			previous = std::exchange(m_recordWriter, std::move(writer));
+		}
+		// The previous take may still be on its way to disk, and its finishRecording() would see the new writer
+		if (previous)
+		{
+			previous->finish();
+			loadRecording(*previous);
+		}
+	}
+	else
+	{
+		// No record handle may use the writer anymore
+		Engine::audioEngine()->removePlayHandlesOfTypes(getTrack(), PlayHandle::Type::SamplePlayHandle);
+		// Keep the writer until its disk thread has finalized the file, so finishRecording() loads the take
+		m_recordWriter->stop();
+	}
+}
+
+
+
+
+void SampleClip::finishRecording()
+{
+	// The clip may have been armed for another take in the meantime
+	if (!m_recordWriter || !m_recordWriter->isFinished()) { return; }
+
+	std::unique_ptr<SampleRecordWriter> writer;
+	{
+		const auto guard = Engine::audioEngine()->requestChangesGuard();
+		writer = std::move(m_recordWriter);
+	}
+
+	loadRecording(*writer);
+	setRecord(false);
+}
+
+
+
+
+void SampleClip::loadRecording(SampleRecordWriter& writer)
+{
+	if (writer.fileName().isEmpty()) { return; }
+
+	emit recordingFinished(&writer);
+	setSampleFile(writer.fileName());
+}
+
+
+
+
 void SampleClip::playbackPositionChanged()
 {
 	Engine::audioEngine()->removePlayHandlesOfTypes( getTrack(), PlayHandle::Type::SamplePlayHandle );
@@ -24,24 +24,26 @@
 
 
 #include "SampleRecordHandle.h"
+
 #include "AudioEngine.h"
 #include "Engine.h"
 #include "PatternTrack.h"
-#include "SampleBuffer.h"
 #include "SampleClip.h"
+#include "SampleRecordWriter.h"
 
 
 namespace lmms
 {
 
 
-SampleRecordHandle::SampleRecordHandle( SampleClip* clip ) :
+SampleRecordHandle::SampleRecordHandle( SampleClip* clip, SampleRecordWriter* writer ) :
 	PlayHandle( Type::SamplePlayHandle ),
 	m_framesRecorded( 0 ),
 	m_minLength( clip->length() ),
 	m_track( clip->getTrack() ),
 	m_patternTrack( nullptr ),
-	m_clip( clip )
+	m_clip( clip ),
+	m_writer( writer )
 {
 }
 
@@ -50,14 +52,8 @@ SampleRecordHandle::SampleRecordHandle( SampleClip* clip ) :
 
 SampleRecordHandle::~SampleRecordHandle()
 {
-	if (!m_buffers.empty()) { m_clip->setSampleBuffer(createSampleBuffer()); }
-
-	while( !m_buffers.empty() )
-	{
-		delete[] m_buffers.front().first;
-		m_buffers.erase( m_buffers.begin() );
-	}
-	m_clip->setRecord( false );
+	// May run on the audio thread, so leave closing the file and loading it to the writer
+	m_writer->stop();
 }
 
 
@@ -67,7 +63,7 @@ void SampleRecordHandle::play( SampleFrame* /*_working_buffer*/ )
 {
 	const SampleFrame* recbuf = Engine::audioEngine()->inputBuffer();
 	const f_cnt_t frames = Engine::audioEngine()->inputBufferFrames();
-	writeBuffer( recbuf, frames );
+	m_writer->write( recbuf, frames );
 	m_framesRecorded += frames;
 
 	TimePos len = (tick_t)( m_framesRecorded / Engine::framesPerTick() );
@@ -103,41 +99,4 @@ f_cnt_t SampleRecordHandle::framesRecorded() const
 }
 
 
-
-
-std::shared_ptr<const SampleBuffer> SampleRecordHandle::createSampleBuffer()
-{
-	const f_cnt_t frames = framesRecorded();
-	// create buffer to store all recorded buffers in
-	auto bigBuffer = std::vector<SampleFrame>(frames);
-
-	// now copy all buffers into big buffer
-	auto framesCopied = 0;
-	for (const auto& [buf, numFrames] : m_buffers)
-	{
-		std::copy_n(buf, numFrames, bigBuffer.begin() + framesCopied);
-		framesCopied += numFrames;
-	}
-
-	// create according sample-buffer out of big buffer
-	return std::make_shared<const SampleBuffer>(std::move(bigBuffer), Engine::audioEngine()->inputSampleRate());
-}
-
-
-
-
-void SampleRecordHandle::writeBuffer( const SampleFrame* _ab, const f_cnt_t _frames )
-{
-	auto buf = new SampleFrame[_frames];
-	for( f_cnt_t frame = 0; frame < _frames; ++frame )
-	{
-		for( ch_cnt_t chnl = 0; chnl < DEFAULT_CHANNELS; ++chnl )
-		{
-			buf[frame][chnl] = _ab[frame][chnl];
-		}
-	}
-	m_buffers.push_back( qMakePair( buf, _frames ) );
-}
-
-
 } // namespace lmms
@@ -0,0 +1,218 @@
+/*
+ * SampleRecordWriter.cpp - writes a sample recording to disk
+ *
+ * Copyright (c) 2026 LMMS Developers
+ *
+ * This file is part of LMMS - https://lmms.io
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public
+ * License along with this program (see COPYING); if not, write to the
+ * Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA 02110-1301 USA.
+ *
+ */
+
+#include "SampleRecordWriter.h"
+
+#include <QDateTime>
+#include <QDir>
+#include <QMetaObject>
+#include <QtGlobal>
+
+#include "AudioEngine.h"
+#include "ConfigManager.h"
+#include "Engine.h"
+#include "PathUtil.h"
+#include "SampleClip.h"
+
+
+namespace lmms
+{
+
+
+SampleRecordWriter::SampleRecordWriter(SampleClip* clip) :
+	m_clip(clip),
+	m_ringBuffer(Engine::audioEngine()->inputSampleRate() * RingBufferSeconds),
+	m_ringBufferReader(m_ringBuffer),
+	m_diskThread(&SampleRecordWriter::writeToDisk, this)
+{
+}
+
+
+
+
+SampleRecordWriter::~SampleRecordWriter()
+{
+	finish();
+}
+
+
+
+
+void SampleRecordWriter::write(const SampleFrame* frames, f_cnt_t count)
+{
+	const auto written = m_ringBuffer.write(frames, count, true);
+	m_framesDropped += count - written;
+}
+
+
+
+
+void SampleRecordWriter::stop()
+{
+	m_stopRecording = true;
+	m_ringBuffer.wakeAll();
+}
+
+
+
+
+void SampleRecordWriter::finish()
+{
+	stop();
+	if (m_diskThread.joinable()) { m_diskThread.join(); }
+}
+
+
+
+
+void SampleRecordWriter::writeToDisk()
+{
+	m_writeBuffer.resize(m_ringBuffer.capacity() / 4);
+
+	while (true)
+	{
+		// Check before draining, so that everything written before the stop request ends up in the file
+		const bool stopping = m_stopRecording;
+
+		while (!m_ringBufferReader.empty())
+		{
+			auto frames = m_ringBufferReader.read_max(m_writeBuffer.size());
+			const f_cnt_t count = frames.size();
+			for (f_cnt_t frame = 0; frame < count; ++frame)
+			{
+				m_writeBuffer[frame] = frames[frame];
+			}
+			writeFrames(m_writeBuffer.data(), count);
+		}
+
+		if (stopping) { break; }
+
+		// The timeout covers a stop request that arrives right before we start waiting
+		m_ringBufferReader.waitForData(100);
+	}
+
+	closeFile();
+
+	if (m_framesDropped > 0)
+	{
+		qWarning("SampleRecordWriter: dropped %zu frames because the disk could not keep up",
+			static_cast<std::size_t>(m_framesDropped));
+	}
+
+	m_finished = true;
+	// Dropped by Qt if the clip is destroyed first. Its destructor waits for us, so the clip stays valid until then.
+	QMetaObject::invokeMethod(m_clip, [clip = m_clip] { clip->finishRecording(); }, Qt::QueuedConnection);
+}
+
+
+
+
+bool SampleRecordWriter::openFile()
+{
+	static auto s_recordingCount = std::atomic<int>{0};
+
+	const auto dir = ConfigManager::inst()->userSamplesDir() + "recordings/";
+	QDir().mkpath(dir);
+	const auto fileName = dir + QString("recording-%1-%2.wav")
+		.arg(QDateTime::currentDateTime().toString("yyyyMMdd-hhmmss"))
+		.arg(++s_recordingCount);
+
+	m_file.setFileName(fileName);
+	if (!m_file.open(QFile::WriteOnly | QFile::Truncate))
+	{
+		qWarning("SampleRecordWriter: could not open %s for writing", qPrintable(fileName));
+		return false;
+	}
+
+	SF_INFO info = {};
+	info.samplerate = Engine::audioEngine()->inputSampleRate();
+	info.channels = DEFAULT_CHANNELS;
+	info.format = SF_FORMAT_WAV | SF_FORMAT_FLOAT;
+
+	// Use file handle to handle unicode file name on Windows
+	m_sndFile = sf_open_fd(m_file.handle(), SFM_WRITE, &info, false);
+	if (!m_sndFile)
+	{
+		qWarning("SampleRecordWriter: %s", sf_strerror(nullptr));
+		m_file.remove();
+		return false;
+	}
+
+	m_fileName = PathUtil::toShortestRelative(fileName);
+	return true;
+}
+
+
+
+
+void SampleRecordWriter::writeFrames(const SampleFrame* frames, f_cnt_t count)
+{
+	// Opened on the first input, so arming a clip without recording anything leaves no file behind
+	if (!m_sndFile)
+	{
+		if (m_fileFailed) { return; }
+		if (!openFile())
+		{
+			m_fileFailed = true;
+			return;
+		}
+	}
+
+	sf_writef_float(m_sndFile, frames->data(), count);
+
+	// Collect the peaks of the most detailed thumbnail level, so it does not need to scan the file later on
+	constexpr auto framesPerPeak = SampleThumbnail::AggregationPerZoomStep / DEFAULT_CHANNELS;
+	for (f_cnt_t frame = 0; frame < count; ++frame)
+	{
+		m_pendingPeak = m_pendingPeak + frames[frame];
+		if (++m_pendingPeakFrames == framesPerPeak)
+		{
+			m_peaks.push_back(m_pendingPeak);
+			m_pendingPeak = {};
+			m_pendingPeakFrames = 0;
+		}
+	}
+}
+
+
+
+
+void SampleRecordWriter::closeFile()
+{
+	if (!m_sndFile) { return; }
+
+	// Like the thumbnails computed from a sample buffer, the last peak also covers the remaining frames
+	if (m_pendingPeakFrames > 0)
+	{
+		if (m_peaks.empty()) { m_peaks.push_back(m_pendingPeak); }
+		else { m_peaks.back() = m_peaks.back() + m_pendingPeak; }
+	}
+
+	sf_close(m_sndFile);
+	m_sndFile = nullptr;
+	m_file.close();
+}
+
+
+} // namespace lmms
@@ -54,6 +54,7 @@
 #include "ProjectNotes.h"
 #include "Scale.h"
 #include "SongEditor.h"
+#include "ThreadPool.h"
 #include "PeakController.h"
 
 
@@ -990,6 +991,7 @@ void Song::createNewProject()
 
 	QCoreApplication::instance()->processEvents();
 
+	waitForLoadingTasks();
 	m_loadingProject = false;
 	updateLength();
 	Engine::patternStore()->updateAfterTrackAdd();
@@ -1194,6 +1196,8 @@ void Song::loadProject( const QString & fileName )
 	// resolve all IDs so that autoModels are automated
 	AutomationClip::resolveAllIDs();
 
+	// plugins may still be instantiating on worker threads
+	waitForLoadingTasks();
 
 	Engine::audioEngine()->doneChangeInModel();
 
@@ -1479,6 +1483,32 @@ void Song::removeController( Controller * controller )
 
 
 
+std::shared_future<void> Song::addLoadingTask(std::function<void()> task)
+{
+	Q_ASSERT(m_loadingProject);
+	auto result = ThreadPool::instance().enqueue(std::move(task)).share();
+	m_loadingTasks.push_back(result);
+	return result;
+}
+
+
+
+
+void Song::waitForLoadingTasks()
+{
+	if (m_loadingTasks.empty()) { return; }
+
+	for (const auto& task : m_loadingTasks)
+	{
+		try { task.get(); }
+		catch (const std::exception& e) { collectError(QString::fromUtf8(e.what())); }
+	}
+	m_loadingTasks.clear();
+}
+
+
+
+
 void Song::clearErrors()
 {
 	m_errors.clear();
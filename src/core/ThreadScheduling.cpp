@@ -0,0 +1,228 @@
+/*
+ * ThreadScheduling.cpp
+ *
+ * Copyright (c) 2026 LMMS Developers
+ *
+ * This file is part of LMMS - https://lmms.io
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public
+ * License along with this program (see COPYING); if not, write to the
+ * Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA 02110-1301 USA.
+ *
+ */
+
+#include "ThreadScheduling.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <cstring>
+#include <iterator>
+
+#include <QDebug>
+#include <QStringList>
+
+#include "ConfigManager.h"
+#include "lmmsconfig.h"
+
+#ifdef LMMS_HAVE_PTHREAD_H
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+#ifdef LMMS_BUILD_LINUX
+#include <sys/resource.h>
+#endif
+
+namespace lmms::ThreadScheduling
+{
+
+namespace
+{
+
+std::atomic_bool s_warned = false;
+
+//! CPUs beyond this cannot be set in an affinity mask, which also bounds the ranges of a CPU list
+#ifdef CPU_SETSIZE
+constexpr int MaxCpus = CPU_SETSIZE;
+#else
+constexpr int MaxCpus = 1024;
+#endif
+
+//! Print a warning for the first thread only, all rendering threads are set up the same way
+void warnOnce(const QString& message)
+{
+	if (!s_warned.exchange(true))
+	{
+		qWarning().noquote() << message;
+	}
+}
+
+} // namespace
+
+
+
+Settings loadSettings()
+{
+	const auto config = ConfigManager::inst();
+	auto settings = Settings{};
+
+	const QString policy = config->value("audioengine", "schedulingpolicy");
+	if (policy == "fifo") { settings.policy = Policy::Fifo; }
+	else if (policy == "rr") { settings.policy = Policy::RoundRobin; }
+
+	settings.priority = config->value("audioengine", "schedulingpriority",
+		QString::number(settings.priority)).toInt();
+	settings.cpus = parseCpuList(config->value("audioengine", "cpuaffinity"));
+	settings.renderThreads = std::max(config->value("audioengine", "renderthreads").toInt(), 0);
+	settings.renderInCallback = config->value("audioengine", "renderincallback").toInt() != 0;
+	return settings;
+}
+
+
+
+void saveSettings(const Settings& settings)
+{
+	const auto config = ConfigManager::inst();
+	const char* policy = settings.policy == Policy::Fifo ? "fifo"
+		: settings.policy == Policy::RoundRobin ? "rr"
+		: "default";
+	config->setValue("audioengine", "schedulingpolicy", policy);
+	config->setValue("audioengine", "schedulingpriority", QString::number(settings.priority));
+	config->setValue("audioengine", "cpuaffinity", cpuListToString(settings.cpus));
+	config->setValue("audioengine", "renderthreads", QString::number(settings.renderThreads));
+	config->setValue("audioengine", "renderincallback", QString::number(settings.renderInCallback));
+}
+
+
+
+QString policyName(Policy policy)
+{
+	switch (policy)
+	{
+		case Policy::Fifo: return "SCHED_FIFO";
+		case Policy::RoundRobin: return "SCHED_RR";
+		default: return "default";
+	}
+}
+
+
+
+std::vector<int> parseCpuList(const QString& list)
+{
+	auto cpus = std::vector<int>{};
+	for (const QString& part : list.split(','))
+	{
+		if (part.trimmed().isEmpty()) { continue; }
+
+		const QStringList range = part.trimmed().split('-');
+		bool firstOk = false, lastOk = false;
+		const int first = range.front().toInt(&firstOk);
+		const int last = range.size() == 2 ? range.back().toInt(&lastOk) : first;
+		if (!firstOk || range.size() > 2 || (range.size() == 2 && !lastOk) || first < 0 || last < first)
+		{
+			qWarning() << "Ignoring invalid CPU range" << part;
+			continue;
+		}
+		if (last >= MaxCpus)
+		{
+			qWarning() << "Ignoring CPUs from" << std::max(first, MaxCpus) << "in" << part;
+		}
+		for (int cpu = first; cpu <= std::min(last, MaxCpus - 1); ++cpu)
+		{
+			cpus.push_back(cpu);
+		}
+	}
+
+	std::sort(cpus.begin(), cpus.end());
+	cpus.erase(std::unique(cpus.begin(), cpus.end()), cpus.end());
+	return cpus;
+}
+
+
+
+QString cpuListToString(const std::vector<int>& cpus)
+{
+	QStringList parts;
+	for (auto it = cpus.begin(); it != cpus.end();)
+	{
+		// merge consecutive CPUs into ranges
+		auto last = it;
+		while (std::next(last) != cpus.end() && *std::next(last) == *last + 1) { ++last; }
+		parts << (last == it ? QString::number(*it) : QString("%1-%2").arg(*it).arg(*last));
+		it = std::next(last);
+	}
+	return parts.join(',');
+}
+
+
+
+Policy applyToCurrentThread(const Settings& settings)
+{
+#ifdef LMMS_BUILD_LINUX
+	if (!settings.cpus.empty())
+	{
+		cpu_set_t set;
+		CPU_ZERO(&set);
+		for (int cpu : settings.cpus)
+		{
+			if (cpu < CPU_SETSIZE) { CPU_SET(cpu, &set); }
+		}
+		if (const int error = pthread_setaffinity_np(pthread_self(), sizeof(set), &set))
+		{
+			warnOnce(QString("Could not pin the audio threads to CPUs %1: %2")
+				.arg(cpuListToString(settings.cpus), std::strerror(error)));
+		}
+	}
+#endif
+
+#ifdef LMMS_HAVE_PTHREAD_H
+	if (settings.policy == Policy::Default) { return Policy::Default; }
+
+	const int policy = settings.policy == Policy::Fifo ? SCHED_FIFO : SCHED_RR;
+	auto param = sched_param{};
+	param.sched_priority = std::clamp(settings.priority,
+		sched_get_priority_min(policy), sched_get_priority_max(policy));
+
+	int error = pthread_setschedparam(pthread_self(), policy, &param);
+#ifdef LMMS_BUILD_LINUX
+	// unprivileged users may only use priorities up to RLIMIT_RTPRIO, so retry with the highest allowed one
+	auto limit = rlimit{};
+	if (error == EPERM && getrlimit(RLIMIT_RTPRIO, &limit) == 0
+		&& limit.rlim_cur != RLIM_INFINITY
+		&& static_cast<int>(limit.rlim_cur) >= sched_get_priority_min(policy)
+		&& static_cast<int>(limit.rlim_cur) < param.sched_priority)
+	{
+		param.sched_priority = static_cast<int>(limit.rlim_cur);
+		error = pthread_setschedparam(pthread_self(), policy, &param);
+		if (!error)
+		{
+			warnOnce(QString("Audio threads run with priority %1 instead of %2 due to RLIMIT_RTPRIO")
+				.arg(param.sched_priority).arg(settings.priority));
+		}
+	}
+#endif
+	if (error)
+	{
+		warnOnce(QString("Could not use %1 scheduling for the audio threads, falling back to the default: %2")
+			.arg(policyName(settings.policy), std::strerror(error)));
+		return Policy::Default;
+	}
+	return settings.policy;
+#else
+	return Policy::Default;
+#endif
+}
+
+} // namespace lmms::ThreadScheduling
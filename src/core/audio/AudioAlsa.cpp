@@ -27,6 +27,10 @@
 
 #ifdef LMMS_HAVE_ALSA
 
+#include <algorithm>
+#include <cstring>
+#include <vector>
+
 #include "endian_handling.h"
 #include "AudioEngine.h"
 #include "ConfigManager.h"
@@ -42,6 +46,7 @@ AudioAlsa::AudioAlsa( bool & _success_ful, AudioEngine*  _audioEngine ) :
 	m_handle( nullptr ),
 	m_hwParams( nullptr ),
 	m_swParams( nullptr ),
+	m_format( SampleConversion::Format::S16 ),
 	m_convertEndian( false )
 {
 	_success_ful = false;
@@ -192,6 +197,7 @@ int AudioAlsa::handleError( int _err )
 	if( _err == -EPIPE )
 	{
 		// under-run
+		audioEngine()->profiler().countXrun();
 		_err = snd_pcm_prepare( m_handle );
 		if( _err < 0 )
 			printf( "Can't recover from underrun, prepare "
@@ -241,47 +247,29 @@ void AudioAlsa::stopProcessing()
 
 void AudioAlsa::run()
 {
-	auto temp = new SampleFrame[audioEngine()->framesPerPeriod()];
-	auto outbuf = new int_sample_t[audioEngine()->framesPerPeriod() * channels()];
-	auto pcmbuf = new int_sample_t[m_periodSize * channels()];
+	if( !audioEngine()->hasFifoWriter() )
+	{
+		// this thread renders the periods itself
+		audioEngine()->profiler().reportSchedulingPolicy(
+			ThreadScheduling::applyToCurrentThread( audioEngine()->schedulingSettings() ) );
+	}
 
-	int outbuf_size = audioEngine()->framesPerPeriod() * channels();
-	int outbuf_pos = 0;
-	int pcmbuf_size = m_periodSize * channels();
+	const auto bytesPerFrame = SampleConversion::bytesPerSample( m_format ) * channels();
+	auto pcmbuf = std::vector<char>( m_periodSize * bytesPerFrame );
 
 	bool quit = false;
 	while( quit == false )
 	{
-		int_sample_t * ptr = pcmbuf;
-		int len = pcmbuf_size;
-		while( len )
+		// convert straight from the engine's buffers into the period, in whatever format the device took
+		const fpp_t done = readInterleaved( pcmbuf.data(), m_periodSize, m_format, m_convertEndian );
+		if( done < m_periodSize )
 		{
-			if( outbuf_pos == 0 )
-			{
-				// frames depend on the sample rate
-				const fpp_t frames = getNextBuffer( temp );
-				if( !frames )
-				{
-					quit = true;
-					memset( ptr, 0, len
-						* sizeof( int_sample_t ) );
-					break;
-				}
-				outbuf_size = frames * channels();
-
-				convertToS16(temp, frames, outbuf, m_convertEndian);
-			}
-			int min_len = std::min(len, outbuf_size - outbuf_pos);
-			memcpy( ptr, outbuf + outbuf_pos,
-					min_len * sizeof( int_sample_t ) );
-			ptr += min_len;
-			len -= min_len;
-			outbuf_pos += min_len;
-			outbuf_pos %= outbuf_size;
+			quit = true;
+			memset( pcmbuf.data() + done * bytesPerFrame, 0, ( m_periodSize - done ) * bytesPerFrame );
 		}
 
 		f_cnt_t frames = m_periodSize;
-		ptr = pcmbuf;
+		char * ptr = pcmbuf.data();
 
 		while( frames )
 		{
@@ -301,14 +289,10 @@ void AudioAlsa::run()
 				}
 				break;	// skip this buffer
 			}
-			ptr += err * channels();
+			ptr += err * bytesPerFrame;
 			frames -= err;
 		}
 	}
-
-	delete[] temp;
-	delete[] outbuf;
-	delete[] pcmbuf;
 }
 
 
@@ -332,21 +316,37 @@ int AudioAlsa::setHWParams( const ch_cnt_t _channels, snd_pcm_access_t _access )
 		return err;
 	}
 
-	// set the sample format
-	if (int err = snd_pcm_hw_params_set_format(m_handle, m_hwParams, SND_PCM_FORMAT_S16_LE); err < 0)
+	// set the sample format, preferring the highest resolution the device accepts
+	struct FormatCandidate
 	{
-		if (int err = snd_pcm_hw_params_set_format(m_handle, m_hwParams, SND_PCM_FORMAT_S16_BE); err < 0)
-		{
-			printf( "Neither little- nor big-endian available for "
-					"playback: %s\n", snd_strerror( err ) );
-			return err;
-		}
-		m_convertEndian = isLittleEndian();
+		snd_pcm_format_t alsaFormat;
+		SampleConversion::Format format;
+		bool convertEndian;
+	};
+	const FormatCandidate candidates[] = {
+		{ SND_PCM_FORMAT_S32, SampleConversion::Format::S32, false },
+		{ SND_PCM_FORMAT_S24, SampleConversion::Format::S24, false },
+		{ SND_PCM_FORMAT_FLOAT, SampleConversion::Format::Float, false },
+		{ SND_PCM_FORMAT_S16, SampleConversion::Format::S16, false },
+		{ isLittleEndian() ? SND_PCM_FORMAT_S16_BE : SND_PCM_FORMAT_S16_LE, SampleConversion::Format::S16, true }
+	};
+	const auto candidate = std::find_if( std::begin( candidates ), std::end( candidates ),
+		[this]( const FormatCandidate& c ) {
+			return snd_pcm_hw_params_test_format( m_handle, m_hwParams, c.alsaFormat ) == 0;
+		} );
+	if( candidate == std::end( candidates ) )
+	{
+		printf( "No supported sample format available for playback\n" );
+		return -EINVAL;
 	}
-	else
+	if (int err = snd_pcm_hw_params_set_format(m_handle, m_hwParams, candidate->alsaFormat); err < 0)
 	{
-		m_convertEndian = !isLittleEndian();
+		printf( "Sample format %s not available for playback: %s\n",
+				snd_pcm_format_name( candidate->alsaFormat ), snd_strerror( err ) );
+		return err;
 	}
+	m_format = candidate->format;
+	m_convertEndian = candidate->convertEndian;
 
 	// set the count of channels
 	if (int err = snd_pcm_hw_params_set_channels(m_handle, m_hwParams, _channels); err < 0)
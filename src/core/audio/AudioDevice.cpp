@@ -22,10 +22,12 @@
  *
  */
 
+#include <algorithm>
 #include <cstring>
 
 #include "AudioDevice.h"
 #include "AudioEngine.h"
+#include "ConfigManager.h"
 
 namespace lmms
 {
@@ -35,7 +37,14 @@ AudioDevice::AudioDevice( const ch_cnt_t _channels, AudioEngine*  _audioEngine )
 	m_sampleRate( _audioEngine->outputSampleRate() ),
 	m_channels( _channels ),
 	m_audioEngine( _audioEngine ),
-	m_buffer(new SampleFrame[audioEngine()->framesPerPeriod()])
+	m_buffer(new SampleFrame[audioEngine()->framesPerPeriod()]),
+	m_busBuffer(usesBus() ? audioEngine()->framesPerPeriod() * _channels : 0),
+	m_pendingBuffer(nullptr),
+	m_pendingBus(nullptr),
+	m_pendingBufferPooled(false),
+	m_pendingFrames(0),
+	m_pendingPos(0),
+	m_ditherEnabled(ConfigManager::inst()->value("audioengine", "dither", "0").toInt())
 {
 }
 
@@ -44,6 +53,7 @@ AudioDevice::AudioDevice( const ch_cnt_t _channels, AudioEngine*  _audioEngine )
 
 AudioDevice::~AudioDevice()
 {
+	releasePendingBuffer();
 	delete[] m_buffer;
 	m_devMutex.tryLock();
 	unlock();
@@ -70,14 +80,105 @@ fpp_t AudioDevice::getNextBuffer(SampleFrame* _ab)
 	if (!b) { return 0; }
 
 	memcpy(_ab, b, frames * sizeof(SampleFrame));
+	if (usesBus()) { std::copy_n(audioEngine()->busOutput(b), m_busBuffer.size(), m_busBuffer.begin()); }
 
-	if (audioEngine()->hasFifoWriter()) { delete[] b; }
+	if (audioEngine()->hasFifoWriter()) { audioEngine()->releaseBuffer(b); }
 	return frames;
 }
 
 
 
 
+bool AudioDevice::usesBus() const
+{
+	return m_channels != DEFAULT_CHANNELS && m_channels == m_audioEngine->outputChannels();
+}
+
+
+
+
+template<class Write>
+fpp_t AudioDevice::read(fpp_t frames, Write write)
+{
+	fpp_t done = 0;
+	while (done < frames)
+	{
+		if (m_pendingPos == m_pendingFrames)
+		{
+			releasePendingBuffer();
+			m_pendingBuffer = audioEngine()->nextBuffer();
+			if (!m_pendingBuffer)
+			{
+				m_inProcess = false;
+				break;
+			}
+			m_pendingBus = usesBus() ? audioEngine()->busOutput(m_pendingBuffer) : nullptr;
+			m_pendingBufferPooled = audioEngine()->hasFifoWriter();
+			m_pendingFrames = audioEngine()->framesPerPeriod();
+		}
+
+		const auto count = std::min(frames - done, m_pendingFrames - m_pendingPos);
+		const sample_t* bus = m_pendingBus ? m_pendingBus + m_pendingPos * channels() : nullptr;
+		write(m_pendingBuffer + m_pendingPos, bus, done, count);
+		done += count;
+		m_pendingPos += count;
+	}
+	return done;
+}
+
+
+
+
+void AudioDevice::releasePendingBuffer()
+{
+	// Buffers from the fifo go back to its pool, the others stay with the engine
+	if (m_pendingBufferPooled) { audioEngine()->releaseBuffer(m_pendingBuffer); }
+	m_pendingBuffer = nullptr;
+	m_pendingBus = nullptr;
+	m_pendingBufferPooled = false;
+	m_pendingFrames = 0;
+	m_pendingPos = 0;
+}
+
+
+
+
+fpp_t AudioDevice::readPlanar(float* const* out, fpp_t frames)
+{
+	return read(frames, [this, out](const SampleFrame* src, const sample_t* bus, fpp_t offset, fpp_t count)
+	{
+		float* dst[MaxOutputChannels];
+		for (ch_cnt_t channel = 0; channel < channels(); ++channel) { dst[channel] = out[channel] + offset; }
+
+		if (bus) { SampleConversion::deinterleave(bus, channels(), dst, count); }
+		else
+		{
+			SampleConversion::toPlanar(src, dst, count);
+			for (ch_cnt_t channel = DEFAULT_CHANNELS; channel < channels(); ++channel)
+			{
+				std::fill_n(dst[channel], count, 0.f);
+			}
+		}
+	});
+}
+
+
+
+
+fpp_t AudioDevice::readInterleaved(void* out, fpp_t frames, SampleConversion::Format format, bool swapEndian)
+{
+	const auto bytesPerFrame = SampleConversion::bytesPerSample(format) * channels();
+	return read(frames, [&](const SampleFrame* src, const sample_t* bus, fpp_t offset, fpp_t count)
+	{
+		void* dst = static_cast<char*>(out) + offset * bytesPerFrame;
+		if (bus) { SampleConversion::convertSamples(bus, dst, count * channels(), format, dither(), swapEndian); }
+		else { SampleConversion::convert(src, dst, count, format, dither(), swapEndian); }
+	});
+}
+
+
+
+
 void AudioDevice::stopProcessing()
 {
 	if( audioEngine()->hasFifoWriter() )
@@ -130,32 +231,7 @@ int AudioDevice::convertToS16(const SampleFrame* _ab,
 								int_sample_t * _output_buffer,
 								const bool _convert_endian )
 {
-	if( _convert_endian )
-	{
-		for( fpp_t frame = 0; frame < _frames; ++frame )
-		{
-			for( ch_cnt_t chnl = 0; chnl < channels(); ++chnl )
-			{
-				auto temp = static_cast<int_sample_t>(AudioEngine::clip(_ab[frame][chnl]) * OUTPUT_SAMPLE_MULTIPLIER);
-
-				( _output_buffer + frame * channels() )[chnl] =
-						( temp & 0x00ff ) << 8 |
-						( temp & 0xff00 ) >> 8;
-			}
-		}
-	}
-	else
-	{
-		for( fpp_t frame = 0; frame < _frames; ++frame )
-		{
-			for( ch_cnt_t chnl = 0; chnl < channels(); ++chnl )
-			{
-				(_output_buffer + frame * channels())[chnl]
-					= static_cast<int_sample_t>(AudioEngine::clip(_ab[frame][chnl]) * OUTPUT_SAMPLE_MULTIPLIER);
-			}
-		}
-	}
-
+	SampleConversion::convert(_ab, _output_buffer, _frames, SampleConversion::Format::S16, dither(), _convert_endian);
 	return _frames * channels() * BYTES_PER_INT_SAMPLE;
 }
 
@@ -24,6 +24,7 @@
  */
 
 #include <QMessageBox>
+#include <algorithm>
 
 #include "AudioFileDevice.h"
 #include "ExportProjectDialog.h"
@@ -38,7 +39,10 @@ AudioFileDevice::AudioFileDevice( OutputSettings const & outputSettings,
 					AudioEngine*  _audioEngine ) :
 	AudioDevice( _channels, _audioEngine ),
 	m_outputFile( _file ),
-	m_outputSettings(outputSettings)
+	m_outputSettings(outputSettings),
+	m_batch( std::make_unique<sample_t[]>( BatchFrames * _channels ) ),
+	m_batchFrames( 0 ),
+	m_conversionBuffer( std::make_unique<std::byte[]>( BatchFrames * _channels * 4 ) )
 {
 	using gui::ExportProjectDialog;
 
@@ -91,4 +95,56 @@ int AudioFileDevice::writeData( const void* data, int len )
 	return -1;
 }
 
+
+
+
+void AudioFileDevice::writeBuffer( const SampleFrame* frames, fpp_t count )
+{
+	const ch_cnt_t ch = channels();
+	// the output bus carries all channels already, stereo frames are mapped to the first channels of the file
+	const sample_t* bus = usesBus() ? busBuffer() : nullptr;
+	while( count > 0 )
+	{
+		const auto chunk = std::min( count, BatchFrames - m_batchFrames );
+		sample_t* dst = m_batch.get() + m_batchFrames * ch;
+		if( bus )
+		{
+			std::copy_n( bus, chunk * ch, dst );
+			bus += chunk * ch;
+		}
+		else if( ch == DEFAULT_CHANNELS )
+		{
+			std::copy_n( frames->data(), chunk * ch, dst );
+		}
+		else
+		{
+			std::fill_n( dst, chunk * ch, 0.f );
+			for( fpp_t f = 0; f < chunk; ++f )
+			{
+				std::copy_n( frames[f].data(), std::min<ch_cnt_t>( ch, DEFAULT_CHANNELS ), dst + f * ch );
+			}
+		}
+		m_batchFrames += chunk;
+		frames += chunk;
+		count -= chunk;
+
+		if( m_batchFrames == BatchFrames )
+		{
+			flushBatch();
+		}
+	}
+}
+
+
+
+
+void AudioFileDevice::flushBatch()
+{
+	if( m_batchFrames > 0 )
+	{
+		writeBatch( m_batch.get(), m_batchFrames );
+		m_batchFrames = 0;
+	}
+}
+
 } // namespace lmms
@@ -23,6 +23,7 @@
  */
 
 
+#include <algorithm>
 #include <cmath>
 
 #include "AudioFileFlac.h"
@@ -41,6 +42,7 @@ AudioFileFlac::AudioFileFlac(OutputSettings const& outputSettings, ch_cnt_t cons
 
 AudioFileFlac::~AudioFileFlac()
 {
+	flushBatch();
 	finishEncoding();
 }
 
@@ -87,31 +89,27 @@ bool AudioFileFlac::startEncoding()
 	return true;
 }
 
-void AudioFileFlac::writeBuffer(const SampleFrame* _ab, fpp_t const frames)
+void AudioFileFlac::writeBatch(const sample_t* samples, fpp_t const count)
 {
 	OutputSettings::BitDepth depth = getOutputSettings().getBitDepth();
 	float clipvalue = std::nextafterf( -1.0f, 0.0f );
 
 	if (depth == OutputSettings::BitDepth::Depth24Bit || depth == OutputSettings::BitDepth::Depth32Bit) // Float encoding
 	{
-		auto buf = std::vector<sample_t>(frames * channels());
-		for(fpp_t frame = 0; frame < frames; ++frame)
-		{
-			for(ch_cnt_t channel=0; channel<channels(); ++channel)
-			{
-				// Clip the negative side to just above -1.0 in order to prevent it from changing sign
-				// Upstream issue: https://github.com/erikd/libsndfile/issues/309
-				// When this commit is reverted libsndfile-1.0.29 must be made a requirement for FLAC
-				buf[frame*channels() + channel] = std::max(clipvalue, _ab[frame][channel]);
-			}
-		}
-		sf_writef_float(m_sf, static_cast<float*>(buf.data()), frames);
+		const auto buf = conversionBuffer<float>();
+		// Clip the negative side to just above -1.0 in order to prevent it from changing sign
+		// Upstream issue: https://github.com/erikd/libsndfile/issues/309
+		// When this commit is reverted libsndfile-1.0.29 must be made a requirement for FLAC
+		std::transform(samples, samples + count * channels(), buf,
+			[clipvalue](float sample) { return std::max(clipvalue, sample); });
+		sf_writef_float(m_sf, buf, count);
 	}
 	else // integer PCM encoding
 	{
-		auto buf = std::vector<int_sample_t>(frames * channels());
-		convertToS16(_ab, frames, buf.data(), !isLittleEndian());
-		sf_writef_short(m_sf, static_cast<short*>(buf.data()), frames);
+		const auto buf = conversionBuffer<int_sample_t>();
+		SampleConversion::convertSamples(samples, buf, count * channels(), SampleConversion::Format::S16,
+			dither(), !isLittleEndian());
+		sf_writef_short(m_sf, buf, count);
 	}
 
 }
@@ -40,7 +40,9 @@ AudioFileMP3::AudioFileMP3(	OutputSettings const & outputSettings,
 				bool & successful,
 				const QString & file,
 				AudioEngine* audioEngine ) :
-	AudioFileDevice( outputSettings, channels, file, audioEngine )
+	AudioFileDevice( outputSettings, channels, file, audioEngine ),
+	// Worst case size of the encoded data according to the LAME documentation
+	m_encodingBuffer(static_cast<std::size_t>(1.25 * BatchFrames + 7200))
 {
 	successful = true;
 	// For now only accept stereo sources
@@ -51,31 +53,24 @@ AudioFileMP3::AudioFileMP3(	OutputSettings const & outputSettings,
 
 AudioFileMP3::~AudioFileMP3()
 {
+	flushBatch();
 	flushRemainingBuffers();
 	tearDownEncoder();
 }
 
-void AudioFileMP3::writeBuffer(const SampleFrame* _buf, const fpp_t _frames)
+void AudioFileMP3::writeBatch(const sample_t* samples, const fpp_t count)
 {
-	if (_frames < 1)
+	if (count < 1)
 	{
 		return;
 	}
 
-	std::vector<float> interleavedDataBuffer(_frames * 2);
-	for (fpp_t i = 0; i < _frames; ++i)
-	{
-		interleavedDataBuffer[2*i] = _buf[i][0];
-		interleavedDataBuffer[2*i + 1] = _buf[i][1];
-	}
-
-	size_t minimumBufferSize = 1.25 * _frames + 7200;
-	std::vector<unsigned char> encodingBuffer(minimumBufferSize);
-
-	int bytesWritten = lame_encode_buffer_interleaved_ieee_float(m_lame, &interleavedDataBuffer[0], _frames, &encodingBuffer[0], static_cast<int>(encodingBuffer.size()));
+	// The samples are interleaved stereo floats already
+	int bytesWritten = lame_encode_buffer_interleaved_ieee_float(m_lame, samples, count,
+		m_encodingBuffer.data(), static_cast<int>(m_encodingBuffer.size()));
 	assert (bytesWritten >= 0);
 
-	writeData(&encodingBuffer[0], bytesWritten);
+	writeData(m_encodingBuffer.data(), bytesWritten);
 }
 
 void AudioFileMP3::flushRemainingBuffers()
@@ -79,6 +79,7 @@ AudioFileOgg::AudioFileOgg(OutputSettings const& outputSettings, const ch_cnt_t
 
 AudioFileOgg::~AudioFileOgg()
 {
+	flushBatch();
 	vorbis_analysis_wrote(&m_vds, 0);
 	ogg_stream_clear(&m_oss);
 	vorbis_block_clear(&m_vb);
@@ -87,23 +88,12 @@ AudioFileOgg::~AudioFileOgg()
 	vorbis_info_clear(&m_vi);
 }
 
-void AudioFileOgg::writeBuffer(const SampleFrame* _ab, const fpp_t _frames)
+void AudioFileOgg::writeBatch(const sample_t* samples, const fpp_t count)
 {
-	const auto vab = vorbis_analysis_buffer(&m_vds, _frames);
+	const auto vab = vorbis_analysis_buffer(&m_vds, count);
+	SampleConversion::deinterleave(samples, channels(), vab, count);
 
-	for (auto c = 0; c < channels(); ++c)
-	{
-		if (c < DEFAULT_CHANNELS)
-		{
-			for (auto i = std::size_t{0}; i < _frames; ++i)
-			{
-				vab[c][i] = _ab[i][c];
-			}
-		}
-		else { std::fill_n(vab[c], _frames, 0.0f); }
-	}
-
-	vorbis_analysis_wrote(&m_vds, _frames);
+	vorbis_analysis_wrote(&m_vds, count);
 
 	while (vorbis_analysis_blockout(&m_vds, &m_vb) == 1)
 	{
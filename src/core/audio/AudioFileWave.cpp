@@ -26,6 +26,7 @@
 #include "AudioFileWave.h"
 #include "endian_handling.h"
 #include "AudioEngine.h"
+#include "MultiChannelBuffer.h"
 
 
 namespace lmms
@@ -46,6 +47,7 @@ AudioFileWave::AudioFileWave( OutputSettings const & outputSettings,
 
 AudioFileWave::~AudioFileWave()
 {
+	flushBatch();
 	finishEncoding();
 }
 
@@ -60,7 +62,8 @@ bool AudioFileWave::startEncoding()
 	m_si.sections = 1;
 	m_si.seekable = 0;
 
-	m_si.format = SF_FORMAT_WAV;
+	// WAVE_FORMAT_EXTENSIBLE stores which speaker each channel belongs to
+	m_si.format = channels() > DEFAULT_CHANNELS ? SF_FORMAT_WAVEX : SF_FORMAT_WAV;
 
 	switch( getOutputSettings().getBitDepth() )
 	{
@@ -85,6 +88,18 @@ bool AudioFileWave::startEncoding()
 		return false;
 	}
 
+	if (channels() > DEFAULT_CHANNELS)
+	{
+		// The speaker pairs of the output bus follow the WAV channel order
+		static constexpr int channelMap[] = {SF_CHANNEL_MAP_LEFT, SF_CHANNEL_MAP_RIGHT, SF_CHANNEL_MAP_CENTER,
+			SF_CHANNEL_MAP_LFE, SF_CHANNEL_MAP_REAR_LEFT, SF_CHANNEL_MAP_REAR_RIGHT, SF_CHANNEL_MAP_SIDE_LEFT,
+			SF_CHANNEL_MAP_SIDE_RIGHT};
+		static constexpr int quadMap[] = {SF_CHANNEL_MAP_LEFT, SF_CHANNEL_MAP_RIGHT, SF_CHANNEL_MAP_REAR_LEFT,
+			SF_CHANNEL_MAP_REAR_RIGHT};
+		const int* map = channels() == channelCount(ChannelLayout::Quad) ? quadMap : channelMap;
+		sf_command(m_sf, SFC_SET_CHANNEL_MAP_INFO, const_cast<int*>(map), channels() * sizeof(int));
+	}
+
 	// Prevent fold overs when encountering clipped data
 	sf_command(m_sf, SFC_SET_CLIPPING, nullptr, SF_TRUE);
 
@@ -93,30 +108,22 @@ bool AudioFileWave::startEncoding()
 	return true;
 }
 
-void AudioFileWave::writeBuffer(const SampleFrame* _ab, const fpp_t _frames)
+void AudioFileWave::writeBatch(const sample_t* samples, const fpp_t count)
 {
 	OutputSettings::BitDepth bitDepth = getOutputSettings().getBitDepth();
 
 	if( bitDepth == OutputSettings::BitDepth::Depth32Bit || bitDepth == OutputSettings::BitDepth::Depth24Bit )
 	{
-		auto buf = new float[_frames * channels()];
-		for( fpp_t frame = 0; frame < _frames; ++frame )
-		{
-			for( ch_cnt_t chnl = 0; chnl < channels(); ++chnl )
-			{
-				buf[frame * channels() + chnl] = _ab[frame][chnl];
-			}
-		}
-		sf_writef_float( m_sf, buf, _frames );
-		delete[] buf;
+		// The samples are interleaved floats already, libsndfile reduces them to 24 bits if needed
+		sf_writef_float( m_sf, samples, count );
 	}
 	else
 	{
-		auto buf = new int_sample_t[_frames * channels()];
-		convertToS16(_ab, _frames, buf, !isLittleEndian());
+		const auto buf = conversionBuffer<int_sample_t>();
+		SampleConversion::convertSamples(samples, buf, count * channels(), SampleConversion::Format::S16,
+			dither(), !isLittleEndian());
 
-		sf_writef_short( m_sf, buf, _frames );
-		delete[] buf;
+		sf_writef_short( m_sf, buf, count );
 	}
 }
 
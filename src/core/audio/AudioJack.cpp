@@ -36,6 +36,7 @@
 
 #include "AudioEngine.h"
 #include "ConfigManager.h"
+#include "Engine.h"
 #include "GuiApplication.h"
 #include "MainWindow.h"
 #include "MidiJack.h"
@@ -96,15 +97,12 @@ static QString buildInputName(ch_cnt_t ch)
 
 AudioJack::AudioJack(bool& successful, AudioEngine* audioEngineParam)
 	: AudioDevice(
-		DEFAULT_CHANNELS,
+		audioEngineParam->outputChannels(),
 		audioEngineParam)
 	, m_client(nullptr)
 	, m_active(false)
 	, m_midiClient(nullptr)
 	, m_tempOutBufs(new jack_default_audio_sample_t*[channels()])
-	, m_outBuf(new SampleFrame[audioEngine()->framesPerPeriod()])
-	, m_framesDoneInCurBuf(0)
-	, m_framesToDoInCurBuf(0)
 {
 	m_stopped = true;
 
@@ -136,8 +134,6 @@ AudioJack::~AudioJack()
 	}
 
 	delete[] m_tempOutBufs;
-
-	delete[] m_outBuf;
 }
 
 
@@ -217,18 +213,30 @@ bool AudioJack::initJackClient()
 	// set shutdown-callback
 	jack_on_shutdown(m_client, shutdownCallback, this);
 
+	jack_set_xrun_callback(m_client, xrunCallback, this);
+
 	if (jack_get_sample_rate(m_client) != sampleRate()) { setSampleRate(jack_get_sample_rate(m_client)); }
 
+	// there is one output port per speaker of the output layout, the input stays stereo
 	for (ch_cnt_t ch = 0; ch < channels(); ++ch)
 	{
 		const QString name = buildOutputName(ch);
 		m_outputPorts.push_back(
 			jack_port_register(m_client, name.toLatin1().constData(), JACK_DEFAULT_AUDIO_TYPE, JackPortIsOutput, 0));
 
+		if (m_outputPorts.back() == nullptr)
+		{
+			std::fprintf(stderr, "no more JACK-ports available!\n");
+			return false;
+		}
+	}
+
+	for (ch_cnt_t ch = 0; ch < DEFAULT_CHANNELS; ++ch)
+	{
 		const QString input_name = buildInputName(ch);
 		m_inputPorts.push_back(jack_port_register(m_client, input_name.toLatin1().constData(), JACK_DEFAULT_AUDIO_TYPE, JackPortIsInput, 0));
 
-		if (m_outputPorts.back() == nullptr)
+		if (m_inputPorts.back() == nullptr)
 		{
 			std::fprintf(stderr, "no more JACK-ports available!\n");
 			return false;
@@ -313,13 +321,12 @@ void AudioJack::startProcessing()
 
 	const auto cm = ConfigManager::inst();
 
-	const auto numberOfChannels = channels();
-	for (size_t i = 0; i < numberOfChannels; ++i)
+	for (size_t i = 0; i < m_outputPorts.size(); ++i)
 	{
 		attemptToReconnectOutput(i, cm->value(audioJackClass, getOutputKeyByChannel(i)));
 	}
 
-	for (size_t i = 0; i < numberOfChannels; ++i)
+	for (size_t i = 0; i < m_inputPorts.size(); ++i)
 	{
 		attemptToReconnectInput(i, cm->value(audioJackClass, getInputKeyByChannel(i)));
 	}
@@ -413,7 +420,7 @@ int AudioJack::processCallback(jack_nframes_t nframes)
 	const int frames = std::min<int>(nframes, audioEngine()->framesPerPeriod());
 	for (JackPortMap::iterator it = m_portMap.begin(); it != m_portMap.end(); ++it)
 	{
-		for (ch_cnt_t ch = 0; ch < channels(); ++ch)
+		for (ch_cnt_t ch = 0; ch < DEFAULT_CHANNELS; ++ch)
 		{
 			if (it.value().ports[ch] == nullptr) { continue; }
 			jack_default_audio_sample_t* buf
@@ -426,34 +433,12 @@ int AudioJack::processCallback(jack_nframes_t nframes)
 	}
 #endif
 
-	jack_nframes_t done = 0;
-	while (done < nframes && !m_stopped)
-	{
-		jack_nframes_t todo = std::min<jack_nframes_t>(nframes - done, m_framesToDoInCurBuf - m_framesDoneInCurBuf);
-		for (int c = 0; c < channels(); ++c)
-		{
-			jack_default_audio_sample_t* o = m_tempOutBufs[c];
-			for (jack_nframes_t frame = 0; frame < todo; ++frame)
-			{
-				o[done + frame] = m_outBuf[m_framesDoneInCurBuf + frame][c];
-			}
-		}
-		done += todo;
-		m_framesDoneInCurBuf += todo;
-		if (m_framesDoneInCurBuf == m_framesToDoInCurBuf)
-		{
-			m_framesToDoInCurBuf = getNextBuffer(m_outBuf);
-			m_framesDoneInCurBuf = 0;
-			if (!m_framesToDoInCurBuf)
-			{
-				m_stopped = true;
-				break;
-			}
-		}
-	}
-
-	if (nframes != done)
+	// Deinterleave straight from the engine's buffers into the JACK ports
+	const jack_nframes_t done = m_stopped ? 0 : readPlanar(m_tempOutBufs, nframes);
+	if (done < nframes)
 	{
+		// The engine does not deliver any more periods
+		m_stopped = true;
 		for (int c = 0; c < channels(); ++c)
 		{
 			jack_default_audio_sample_t* b = m_tempOutBufs[c] + done;
@@ -461,7 +446,7 @@ int AudioJack::processCallback(jack_nframes_t nframes)
 		}
 	}
 
-	for (int c = 0; c < channels(); ++c)
+	for (int c = 0; c < DEFAULT_CHANNELS; ++c)
 	{
 		jack_default_audio_sample_t* jack_input_buffer = (jack_default_audio_sample_t*) jack_port_get_buffer(m_inputPorts[c], nframes);
 
@@ -495,6 +480,15 @@ void AudioJack::shutdownCallback(void* udata)
 
 
 
+int AudioJack::xrunCallback(void* udata)
+{
+	static_cast<AudioJack*>(udata)->audioEngine()->profiler().countXrun();
+	return 0;
+}
+
+
+
+
 AudioJack::setupWidget::setupWidget(QWidget* parent)
 	: AudioDeviceSetupWidget(AudioJack::name(), parent)
 {
@@ -535,7 +529,8 @@ AudioJack::setupWidget::setupWidget(QWidget* parent)
 	// Outputs
 	const auto audioOutputNames = getAudioOutputNames();
 
-	constexpr size_t numberOfOutputChannels = 2;
+	// the output layout can only change on restart, so the running engine has the current one
+	const size_t numberOfOutputChannels = Engine::audioEngine()->outputChannels();
 	for (size_t i = 0; i < numberOfOutputChannels; ++i)
 	{
 		const auto outputKey = getOutputKeyByChannel(i);
@@ -51,12 +51,12 @@ AudioPulseAudio::AudioPulseAudio( bool & _success_ful, AudioEngine*  _audioEngin
 		DEFAULT_CHANNELS,
 		DEFAULT_CHANNELS), _audioEngine),
 	m_s( nullptr ),
-	m_quit( false ),
-	m_convertEndian( false )
+	m_quit( false )
 {
 	_success_ful = false;
 
-	m_sampleSpec.format = PA_SAMPLE_S16LE;
+	// Hand over float samples, PulseAudio converts them to the format of the sink itself
+	m_sampleSpec.format = PA_SAMPLE_FLOAT32NE;
 	m_sampleSpec.rate = sampleRate();
 	m_sampleSpec.channels = channels();
 
@@ -248,30 +248,36 @@ void AudioPulseAudio::run()
 
 void AudioPulseAudio::streamWriteCallback( pa_stream *s, size_t length )
 {
-	const fpp_t fpp = audioEngine()->framesPerPeriod();
-	auto temp = new SampleFrame[fpp];
-	auto pcmbuf = (int_sample_t*)pa_xmalloc(fpp * channels() * sizeof(int_sample_t));
+	const size_t bytesPerFrame = pa_frame_size( &m_sampleSpec );
 
-	size_t fd = 0;
-	while( fd < length/4 && m_quit == false )
+	size_t written = 0;
+	while( written < length && m_quit == false )
 	{
-		const fpp_t frames = getNextBuffer( temp );
-		if( !frames )
+		// Let PulseAudio provide the memory, so the samples are written into the stream without a copy
+		void* data = nullptr;
+		size_t bytes = length - written;
+		if( pa_stream_begin_write( s, &data, &bytes ) < 0 || data == nullptr )
 		{
-			m_quit = true;
 			break;
 		}
-		int bytes = convertToS16(temp, frames, pcmbuf, m_convertEndian);
-		if( bytes > 0 )
+
+		const fpp_t frames = bytes / bytesPerFrame;
+		const fpp_t done = readInterleaved( data, frames, SampleConversion::Format::Float );
+		if( done < frames )
 		{
-			pa_stream_write( m_s, pcmbuf, bytes, nullptr, 0,
-							PA_SEEK_RELATIVE );
+			m_quit = true;
 		}
-		fd += frames;
-	}
 
-	pa_xfree( pcmbuf );
-	delete[] temp;
+		if( done > 0 )
+		{
+			pa_stream_write( s, data, done * bytesPerFrame, nullptr, 0, PA_SEEK_RELATIVE );
+		}
+		else
+		{
+			pa_stream_cancel_write( s );
+		}
+		written += done * bytesPerFrame;
+	}
 }
 
 
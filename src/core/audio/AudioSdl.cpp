@@ -42,14 +42,10 @@ constexpr auto PlaybackDeviceSDL = "device";
 constexpr auto InputDeviceSDL = "inputdevice";
 
 AudioSdl::AudioSdl( bool & _success_ful, AudioEngine*  _audioEngine ) :
-	AudioDevice( DEFAULT_CHANNELS, _audioEngine ),
-	m_outBuf(new SampleFrame[audioEngine()->framesPerPeriod()])
+	AudioDevice( DEFAULT_CHANNELS, _audioEngine )
 {
 	_success_ful = false;
 
-	m_currentBufferFramesCount = 0;
-	m_currentBufferFramePos = 0;
-
 	if( SDL_Init( SDL_INIT_AUDIO | SDL_INIT_NOPARACHUTE ) < 0 )
 	{
 		qCritical( "Couldn't initialize SDL: %s\n", SDL_GetError() );
@@ -129,8 +125,6 @@ AudioSdl::~AudioSdl()
 		SDL_CloseAudioDevice(m_outputDevice);
 
 	SDL_Quit();
-
-	delete[] m_outBuf;
 }
 
 
@@ -183,30 +177,11 @@ void AudioSdl::sdlAudioCallback( Uint8 * _buf, int _len )
 	}
 
 	// SDL2: process float samples
-	while( _len )
+	const auto frames = static_cast<fpp_t>(_len / sizeof(SampleFrame));
+	const fpp_t done = readInterleaved(_buf, frames, SampleConversion::Format::Float);
+	if (done < frames)
 	{
-		if( m_currentBufferFramePos == 0 )
-		{
-			// frames depend on the sample rate
-			const fpp_t frames = getNextBuffer( m_outBuf );
-			if( !frames )
-			{
-				memset( _buf, 0, _len );
-				return;
-			}
-			m_currentBufferFramesCount = frames;
-
-		}
-		const uint min_frames_count = std::min(_len/sizeof(SampleFrame),
-										  m_currentBufferFramesCount
-										- m_currentBufferFramePos);
-
-		memcpy( _buf, m_outBuf + m_currentBufferFramePos, min_frames_count*sizeof(SampleFrame) );
-		_buf += min_frames_count*sizeof(SampleFrame);
-		_len -= min_frames_count*sizeof(SampleFrame);
-		m_currentBufferFramePos += min_frames_count;
-
-		m_currentBufferFramePos %= m_currentBufferFramesCount;
+		memset(_buf + done * sizeof(SampleFrame), 0, (frames - done) * sizeof(SampleFrame));
 	}
 }
 
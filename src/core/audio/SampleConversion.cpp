@@ -0,0 +1,271 @@
+/*
+ * SampleConversion.cpp
+ *
+ * Copyright (c) 2026 LMMS Developers
+ *
+ * This file is part of LMMS - https://lmms.io
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public
+ * License along with this program (see COPYING); if not, write to the
+ * Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA 02110-1301 USA.
+ *
+ */
+
+#include "SampleConversion.h"
+
+#include <algorithm>
+#include <cmath>
+
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+#include "SampleFrame.h"
+
+namespace lmms::SampleConversion
+{
+
+namespace
+{
+
+//! Number of samples converted per block, so that the dither noise fits on the stack
+constexpr f_cnt_t BlockSize = 256;
+
+/**
+ * Scales @p count samples from @p in by @p scale, adds @p noise if given, clips them to [@p low, @p high] and
+ * rounds them to the nearest integer. The SSE2 version handles eight samples per iteration and saturates to
+ * 16 bits when packing, the scalar version handles the remainder and other architectures.
+ */
+template<class Int>
+void quantize(const float* in, Int* out, f_cnt_t count, float scale, float low, float high, const float* noise)
+{
+	f_cnt_t i = 0;
+#ifdef __SSE2__
+	const auto scaleVec = _mm_set1_ps(scale);
+	const auto lowVec = _mm_set1_ps(low);
+	const auto highVec = _mm_set1_ps(high);
+	for (; i + 8 <= count; i += 8)
+	{
+		auto a = _mm_mul_ps(_mm_loadu_ps(in + i), scaleVec);
+		auto b = _mm_mul_ps(_mm_loadu_ps(in + i + 4), scaleVec);
+		if (noise)
+		{
+			a = _mm_add_ps(a, _mm_loadu_ps(noise + i));
+			b = _mm_add_ps(b, _mm_loadu_ps(noise + i + 4));
+		}
+		const auto intA = _mm_cvtps_epi32(_mm_min_ps(_mm_max_ps(a, lowVec), highVec));
+		const auto intB = _mm_cvtps_epi32(_mm_min_ps(_mm_max_ps(b, lowVec), highVec));
+		if constexpr (sizeof(Int) == 2)
+		{
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(out + i), _mm_packs_epi32(intA, intB));
+		}
+		else
+		{
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(out + i), intA);
+			_mm_storeu_si128(reinterpret_cast<__m128i*>(out + i + 4), intB);
+		}
+	}
+#endif
+	for (; i < count; ++i)
+	{
+		const auto value = in[i] * scale + (noise ? noise[i] : 0.f);
+		// like _mm_cvtps_epi32, lrint rounds halfway cases to even
+		out[i] = static_cast<Int>(std::lrint(std::clamp(value, low, high)));
+	}
+}
+
+template<class Int>
+void toInt(const sample_t* in, Int* dst, f_cnt_t samples, float scale, float low, float high, TpdfDither* dither)
+{
+	if (!dither)
+	{
+		quantize(in, dst, samples, scale, low, high, nullptr);
+		return;
+	}
+
+	float noise[BlockSize];
+	for (f_cnt_t start = 0; start < samples; start += BlockSize)
+	{
+		const auto count = std::min(BlockSize, samples - start);
+		dither->generate(noise, count);
+		quantize(in + start, dst + start, count, scale, low, high, noise);
+	}
+}
+
+} // namespace
+
+
+
+
+void TpdfDither::generate(float* noise, f_cnt_t count)
+{
+	// The difference of two uniform variables in [0, 1) has a triangular distribution in (-1, 1).
+	// Each of the four lanes runs its own xorshift32 generator, so that they can be computed in parallel.
+	constexpr auto toUnit = 1.f / (1 << 24);
+	f_cnt_t i = 0;
+#ifdef __SSE2__
+	auto lanes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(m_state.data()));
+	const auto nextLanes = [&lanes]
+	{
+		lanes = _mm_xor_si128(lanes, _mm_slli_epi32(lanes, 13));
+		lanes = _mm_xor_si128(lanes, _mm_srli_epi32(lanes, 17));
+		lanes = _mm_xor_si128(lanes, _mm_slli_epi32(lanes, 5));
+		return _mm_mul_ps(_mm_cvtepi32_ps(_mm_srli_epi32(lanes, 8)), _mm_set1_ps(toUnit));
+	};
+	for (; i + 4 <= count; i += 4)
+	{
+		const auto a = nextLanes();
+		const auto b = nextLanes();
+		_mm_storeu_ps(noise + i, _mm_sub_ps(a, b));
+	}
+	_mm_storeu_si128(reinterpret_cast<__m128i*>(m_state.data()), lanes);
+#endif
+	for (; i < count; ++i)
+	{
+		auto& state = m_state[i % m_state.size()];
+		const auto a = static_cast<float>(next(state) >> 8) * toUnit;
+		const auto b = static_cast<float>(next(state) >> 8) * toUnit;
+		noise[i] = a - b;
+	}
+}
+
+
+
+
+void convert(const SampleFrame* src, void* dst, f_cnt_t frames, Format format, TpdfDither* dither, bool swap)
+{
+	convertSamples(src->data(), dst, frames * DEFAULT_CHANNELS, format, dither, swap);
+}
+
+
+
+
+void convertSamples(const sample_t* src, void* dst, f_cnt_t samples, Format format, TpdfDither* dither, bool swap)
+{
+	switch (format)
+	{
+	case Format::S16:
+	{
+		const auto out = static_cast<std::int16_t*>(dst);
+		toInt(src, out, samples, 32767.f, -32768.f, 32767.f, dither);
+		if (swap) { swapEndian(out, samples); }
+		break;
+	}
+	case Format::S24:
+	{
+		const auto out = static_cast<std::int32_t*>(dst);
+		toInt(src, out, samples, 8388607.f, -8388608.f, 8388607.f, dither);
+		if (swap) { swapEndian(out, samples); }
+		break;
+	}
+	case Format::S32:
+	{
+		const auto out = static_cast<std::int32_t*>(dst);
+		// 2147483520 is the largest float below 2^31. Float samples carry 24 bits of precision only anyway.
+		toInt(src, out, samples, 2147483647.f, -2147483648.f, 2147483520.f, dither);
+		if (swap) { swapEndian(out, samples); }
+		break;
+	}
+	case Format::Float:
+		std::copy_n(src, samples, static_cast<float*>(dst));
+		break;
+	}
+}
+
+
+
+
+void toS16(const SampleFrame* src, std::int16_t* dst, f_cnt_t frames, TpdfDither* dither)
+{
+	convertSamples(src->data(), dst, frames * DEFAULT_CHANNELS, Format::S16, dither);
+}
+
+
+
+
+void toS24(const SampleFrame* src, std::int32_t* dst, f_cnt_t frames, TpdfDither* dither)
+{
+	convertSamples(src->data(), dst, frames * DEFAULT_CHANNELS, Format::S24, dither);
+}
+
+
+
+
+void toS32(const SampleFrame* src, std::int32_t* dst, f_cnt_t frames, TpdfDither* dither)
+{
+	convertSamples(src->data(), dst, frames * DEFAULT_CHANNELS, Format::S32, dither);
+}
+
+
+
+
+void toPlanar(const SampleFrame* src, float* const* dst, f_cnt_t frames)
+{
+	deinterleave(src->data(), DEFAULT_CHANNELS, dst, frames);
+}
+
+
+
+
+void deinterleave(const sample_t* src, ch_cnt_t channels, float* const* dst, f_cnt_t frames)
+{
+	if (channels == DEFAULT_CHANNELS)
+	{
+		// the common case with a compile time stride
+		float* left = dst[0];
+		float* right = dst[1];
+		for (f_cnt_t frame = 0; frame < frames; ++frame)
+		{
+			left[frame] = src[frame * 2];
+			right[frame] = src[frame * 2 + 1];
+		}
+		return;
+	}
+	for (ch_cnt_t channel = 0; channel < channels; ++channel)
+	{
+		float* out = dst[channel];
+		for (f_cnt_t frame = 0; frame < frames; ++frame)
+		{
+			out[frame] = src[frame * channels + channel];
+		}
+	}
+}
+
+
+
+
+void swapEndian(std::int16_t* samples, f_cnt_t count)
+{
+	for (f_cnt_t i = 0; i < count; ++i)
+	{
+		const auto value = static_cast<std::uint16_t>(samples[i]);
+		samples[i] = static_cast<std::int16_t>((value << 8) | (value >> 8));
+	}
+}
+
+
+
+
+void swapEndian(std::int32_t* samples, f_cnt_t count)
+{
+	for (f_cnt_t i = 0; i < count; ++i)
+	{
+		const auto value = static_cast<std::uint32_t>(samples[i]);
+		samples[i] = static_cast<std::int32_t>((value << 24) | ((value << 8) & 0x00ff0000)
+			| ((value >> 8) & 0x0000ff00) | (value >> 24));
+	}
+}
+
+
+} // namespace lmms::SampleConversion
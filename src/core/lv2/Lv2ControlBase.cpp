@@ -27,13 +27,16 @@
 #ifdef LMMS_HAVE_LV2
 
 #include <algorithm>
+#include <array>
 #include <QDebug>
 #include <QtGlobal>
 
+#include "AudioEngine.h"
 #include "Engine.h"
 #include "lmms_constants.h"
 #include "Lv2Manager.h"
 #include "Lv2Proc.h"
+#include "SampleFrame.h"
 
 
 namespace lmms
@@ -138,31 +141,45 @@ void Lv2ControlBase::copyModelsToLmms() const
 
 
 
-void Lv2ControlBase::copyBuffersFromLmms(const SampleFrame* buf, fpp_t frames) {
-	unsigned firstChan = 0; // tell the procs which channels they shall read from
-	for (const auto& c : m_procs) 
+std::array<const float*, DEFAULT_CHANNELS> Lv2ControlBase::runPlanar(const SampleFrame* buf, fpp_t frames)
+{
+	// shared by all Lv2 plugins running on this thread, one buffer per channel
+	using PlanarBuffers = std::array<std::array<float, MAXIMUM_BUFFER_SIZE>, DEFAULT_CHANNELS>;
+	static thread_local PlanarBuffers s_planar, s_scratch;
+
+	auto planar = std::array<float*, DEFAULT_CHANNELS>{};
+	auto scratch = std::array<float*, DEFAULT_CHANNELS>{};
+	for (ch_cnt_t ch = 0; ch < DEFAULT_CHANNELS; ++ch)
 	{
-		c->copyBuffersFromCore(buf, firstChan, m_channelsPerProc, frames);
-		firstChan += m_channelsPerProc;
+		planar[ch] = s_planar[ch].data();
+		scratch[ch] = s_scratch[ch].data();
 	}
-}
-
-
 
+	if (buf)
+	{
+		// deinterleave once for all procs
+		for (fpp_t f = 0; f < frames; ++f)
+		{
+			planar[0][f] = buf[f][0];
+			planar[1][f] = buf[f][1];
+		}
+	}
+	else
+	{
+		// inputs of instruments, if any, get silence
+		for (auto& channel : s_planar) { std::fill_n(channel.begin(), frames, 0.f); }
+	}
 
-void Lv2ControlBase::copyBuffersToLmms(SampleFrame* buf, fpp_t frames) const {
-	unsigned firstChan = 0; // tell the procs which channels they shall write to
-	for (const auto& c : m_procs) {
-		c->copyBuffersToCore(buf, firstChan, m_channelsPerProc, frames);
+	auto result = std::array<const float*, DEFAULT_CHANNELS>{};
+	unsigned firstChan = 0; // tell the procs which channels they shall process
+	for (const auto& c : m_procs)
+	{
+		c->connectPlanarBuffers(planar.data(), scratch.data(), firstChan, m_channelsPerProc, frames, result.data());
 		firstChan += m_channelsPerProc;
 	}
-}
-
 
-
-
-void Lv2ControlBase::run(fpp_t frames) {
 	for (const auto& c : m_procs) { c->run(frames); }
+	return result;
 }
 
 
@@ -214,6 +231,16 @@ bool Lv2ControlBase::hasNoteInput() const
 
 
 
+f_cnt_t Lv2ControlBase::latency() const
+{
+	f_cnt_t result = 0;
+	for (const auto& c : m_procs) { result = std::max(result, c->latency()); }
+	return result;
+}
+
+
+
+
 void Lv2ControlBase::handleMidiInputEvent(const MidiEvent &event,
 	const TimePos &time, f_cnt_t offset)
 {
@@ -34,7 +34,6 @@
 #include "Lv2Basics.h"
 #include "Lv2Manager.h"
 #include "Lv2Evbuf.h"
-#include "SampleFrame.h"
 
 
 namespace lmms::Lv2Ports
@@ -304,45 +303,17 @@ QString PortBase::uri() const
 
 
 
-Audio::Audio(std::size_t bufferSize, bool isSidechain)
-	: m_buffer(bufferSize), m_sidechain(isSidechain)
+Audio::Audio(bool isSidechain)
+	: m_sidechain(isSidechain)
 {
 }
 
 
 
 
-void Audio::copyBuffersFromCore(const SampleFrame* lmmsBuf,
-	unsigned channel, fpp_t frames)
+uint32_t Audio::index() const
 {
-	for (std::size_t f = 0; f < static_cast<unsigned>(frames); ++f)
-	{
-		m_buffer[f] = lmmsBuf[f][channel];
-	}
-}
-
-
-
-
-void Audio::averageWithBuffersFromCore(const SampleFrame* lmmsBuf,
-	unsigned channel, fpp_t frames)
-{
-	for (std::size_t f = 0; f < static_cast<unsigned>(frames); ++f)
-	{
-		m_buffer[f] = (m_buffer[f] + lmmsBuf[f][channel]) / 2.0f;
-	}
-}
-
-
-
-
-void Audio::copyBuffersToCore(SampleFrame* lmmsBuf,
-	unsigned channel, fpp_t frames) const
-{
-	for (std::size_t f = 0; f < static_cast<unsigned>(frames); ++f)
-	{
-		lmmsBuf[f][channel] = m_buffer[f];
-	}
+	return lilv_port_get_index(m_plugin, m_port);
 }
 
 
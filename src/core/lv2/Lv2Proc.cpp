@@ -27,11 +27,14 @@
 #ifdef LMMS_HAVE_LV2
 
 #include <cmath>
+#include <cstring>
 #include <lv2/midi/midi.h>
 #include <lv2/atom/atom.h>
 #include <lv2/resize-port/resize-port.h>
 #include <lv2/worker/worker.h>
 #include <QDebug>
+#include <QElapsedTimer>
+#include <QLibrary>
 #include <QtGlobal>
 
 #include "AudioEngine.h"
@@ -46,6 +49,7 @@
 #include "MidiEvent.h"
 #include "MidiEventToByteSeq.h"
 #include "NoCopyNoMove.h"
+#include "Song.h"
 
 
 namespace lmms
@@ -174,8 +178,9 @@ class Lv2ProcSuspender : NoCopyNoMove
 public:
 	Lv2ProcSuspender(Lv2Proc* proc)
 		: m_proc(proc)
-		, m_wasActive(proc->m_instance)
 	{
+		m_proc->waitForInstance();
+		m_wasActive = m_proc->m_instance;
 		if (m_wasActive) { m_proc->shutdownPlugin(); }
 	}
 	~Lv2ProcSuspender()
@@ -184,7 +189,7 @@ public:
 	}
 private:
 	Lv2Proc* const m_proc;
-	const bool m_wasActive;
+	bool m_wasActive;
 };
 
 
@@ -324,44 +329,51 @@ void Lv2Proc::copyModelsToCore()
 
 
 
-void Lv2Proc::copyBuffersFromCore(const SampleFrame* buf,
-									unsigned firstChan, unsigned num,
-									fpp_t frames)
+void Lv2Proc::connectPlanarBuffers(float* const* planar, float* const* scratch,
+	unsigned firstChan, unsigned num, fpp_t frames, const float** result)
 {
-	inPorts().m_left->copyBuffersFromCore(buf, firstChan, frames);
-	if (num > 1)
+	// connect_port is realtime safe, so the ports can be pointed directly at
+	// the buffers the core uses for this run instead of copying
+	auto connect = [this](const Lv2Ports::Audio* port, float* location)
 	{
-		// if the caller requests to take input from two channels, but we only
-		// have one input channel... take medium of left and right for
-		// mono input
-		// (this happens if we have two outputs and only one input)
-		if (inPorts().m_right)
-		{
-			inPorts().m_right->copyBuffersFromCore(buf, firstChan + 1, frames);
-		}
-		else
+		if (m_instance) { lilv_instance_connect_port(m_instance, port->index(), location); }
+	};
+
+	if (inPorts().m_left)
+	{
+		if (num > 1 && !inPorts().m_right)
 		{
-			inPorts().m_left->averageWithBuffersFromCore(buf, firstChan + 1, frames);
+			// if the caller requests to take input from two channels, but we only
+			// have one input channel... take medium of left and right for
+			// mono input
+			// (this happens if we have two outputs and only one input)
+			float* left = planar[firstChan];
+			const float* right = planar[firstChan + 1];
+			for (fpp_t f = 0; f < frames; ++f) { left[f] = (left[f] + right[f]) / 2.0f; }
 		}
+		connect(inPorts().m_left, planar[firstChan]);
+		if (num > 1 && inPorts().m_right) { connect(inPorts().m_right, planar[firstChan + 1]); }
 	}
-}
-
-
 
-
-void Lv2Proc::copyBuffersToCore(SampleFrame* buf,
-								unsigned firstChan, unsigned num,
-								fpp_t frames) const
-{
-	outPorts().m_left->copyBuffersToCore(buf, firstChan + 0, frames);
+	// each output shares the buffer with the input of the same channel, unless forbidden
+	// (without an instance, the input is just passed through)
+	float* const* out = (m_inPlaceBroken && m_instance) ? scratch : planar;
+	connect(outPorts().m_left, out[firstChan]);
+	result[firstChan] = out[firstChan];
 	if (num > 1)
 	{
 		// if the caller requests to copy into two channels, but we only have
 		// one output channel, duplicate our output
 		// (this happens if we have two inputs and only one output)
-		Lv2Ports::Audio* ap = outPorts().m_right
-			? outPorts().m_right : outPorts().m_left;
-		ap->copyBuffersToCore(buf, firstChan + 1, frames);
+		if (outPorts().m_right)
+		{
+			connect(outPorts().m_right, out[firstChan + 1]);
+			result[firstChan + 1] = out[firstChan + 1];
+		}
+		else
+		{
+			result[firstChan + 1] = out[firstChan];
+		}
 	}
 }
 
@@ -370,6 +382,9 @@ void Lv2Proc::copyBuffersToCore(SampleFrame* buf,
 
 void Lv2Proc::run(fpp_t frames)
 {
+	// instantiation has failed
+	if (!m_instance) { return; }
+
 	if (m_worker)
 	{
 		// Process any worker replies
@@ -438,34 +453,124 @@ void Lv2Proc::initPlugin()
 	initPluginSpecificFeatures();
 	m_features.createFeatureVectors();
 
-	m_instance = lilv_plugin_instantiate(m_plugin,
-		Engine::audioEngine()->outputSampleRate(),
-		m_features.featurePointers());
+	m_inPlaceBroken = lilv_plugin_has_feature(m_plugin, uri(LV2_CORE__inPlaceBroken).get());
 
-	if (m_instance)
+	// Everything that is not bound to the instance is resolved here, on the main thread:
+	// the lilv world is not thread safe, and the LV2 discovery functions (descriptor
+	// lookup, extension_data) must never be called concurrently
+	const auto filePath = [](const LilvNode* fileUri)
 	{
-		const auto iface = static_cast<const LV2_Worker_Interface*>(
-			lilv_instance_get_extension_data(m_instance, LV2_WORKER__interface));
-		if (iface)
+		char* path = lilv_file_uri_parse(lilv_node_as_uri(fileUri), nullptr);
+		auto result = std::string{path ? path : ""};
+		lilv_free(path);
+		return result;
+	};
+	m_bundlePath = filePath(lilv_plugin_get_bundle_uri(m_plugin));
+	m_sampleRate = Engine::audioEngine()->outputSampleRate();
+	m_descriptor = findDescriptor(filePath(lilv_plugin_get_library_uri(m_plugin)));
+
+	if (m_worker && m_descriptor->extension_data)
+	{
+		if (const auto iface = static_cast<const LV2_Worker_Interface*>(
+			m_descriptor->extension_data(LV2_WORKER__interface)))
 		{
-			m_worker->setHandle(lilv_instance_get_handle(m_instance));
 			m_worker->setInterface(iface);
 		}
-		for (std::size_t portNum = 0; portNum < m_ports.size(); ++portNum)
+	}
+
+	Song* song = Engine::getSong();
+	if (song && song->isLoadingProject())
+	{
+		// the song waits for us before it starts playing
+		m_instantiation = song->addLoadingTask([this] { instantiate(); });
+	}
+	else
+	{
+		instantiate();
+	}
+}
+
+
+
+
+const LV2_Descriptor* Lv2Proc::findDescriptor(const std::string& libraryPath)
+{
+	const char* pluginUri = lilv_node_as_uri(lilv_plugin_get_uri(m_plugin));
+
+	// This does what lilv_plugin_instantiate does, but without registering
+	// the library in the lilv world, so the instance can be created on
+	// another thread. The library stays loaded until LMMS quits.
+	QLibrary lib(QString::fromStdString(libraryPath));
+	lib.setLoadHints(QLibrary::ResolveAllSymbolsHint);
+	const LV2_Descriptor* descriptor = nullptr;
+	if (auto getDescriptor = reinterpret_cast<LV2_Descriptor_Function>(lib.resolve("lv2_descriptor")))
+	{
+		for (uint32_t i = 0; !descriptor; ++i)
 		{
-			connectPort(portNum);
+			const LV2_Descriptor* cur = getDescriptor(i);
+			if (!cur) { break; }
+			if (!std::strcmp(cur->URI, pluginUri)) { descriptor = cur; }
 		}
-		lilv_instance_activate(m_instance);
 	}
-	else
+	else if (auto getLib = reinterpret_cast<LV2_Lib_Descriptor_Function>(lib.resolve("lv2_lib_descriptor")))
 	{
-		qCritical() << "Failed to create an instance of"
-			<< qStringFromPluginNode(m_plugin, lilv_plugin_get_name)
-			<< "(URI:"
-			<< lilv_node_as_uri(lilv_plugin_get_uri(m_plugin))
-			<< ")";
-		throw std::runtime_error("Failed to create Lv2 processor");
+		if (const LV2_Lib_Descriptor* libDescriptor = getLib(m_bundlePath.c_str(), m_features.featurePointers()))
+		{
+			for (uint32_t i = 0; !descriptor; ++i)
+			{
+				const LV2_Descriptor* cur = libDescriptor->get_plugin(libDescriptor->handle, i);
+				if (!cur) { break; }
+				if (!std::strcmp(cur->URI, pluginUri)) { descriptor = cur; }
+			}
+		}
+	}
+
+	if (!descriptor)
+	{
+		qCritical() << "Failed to find the descriptor of" << pluginUri
+			<< "in" << lib.fileName() << lib.errorString();
+		throw std::runtime_error(std::string{"Failed to create Lv2 processor for "} + pluginUri);
 	}
+	return descriptor;
+}
+
+
+
+
+void Lv2Proc::instantiate()
+{
+	QElapsedTimer timer;
+	timer.start();
+	LV2_Handle handle = m_descriptor->instantiate(m_descriptor, m_sampleRate,
+		m_bundlePath.c_str(), m_features.featurePointers());
+	if (!handle)
+	{
+		const char* pluginUri = m_descriptor->URI;
+		qCritical() << "Failed to create an instance of" << pluginUri;
+		throw std::runtime_error(std::string{"Failed to create Lv2 processor for "} + pluginUri);
+	}
+
+	m_instance = new LilvInstance{m_descriptor, handle, nullptr};
+	if (m_worker) { m_worker->setHandle(handle); }
+	for (std::size_t portNum = 0; portNum < m_ports.size(); ++portNum)
+	{
+		connectPort(portNum);
+	}
+	lilv_instance_activate(m_instance);
+	qDebug() << "Instantiated" << m_descriptor->URI << "in" << timer.elapsed() << "ms";
+}
+
+
+
+
+void Lv2Proc::waitForInstance()
+{
+	if (!m_instantiation.valid()) { return; }
+
+	// a failure has already been reported by the song
+	try { m_instantiation.get(); }
+	catch (const std::exception&) {}
+	m_instantiation = {};
 }
 
 
@@ -473,9 +578,16 @@ void Lv2Proc::initPlugin()
 
 void Lv2Proc::shutdownPlugin()
 {
-	lilv_instance_deactivate(m_instance);
-	lilv_instance_free(m_instance);
-	m_instance = nullptr;
+	waitForInstance();
+	if (m_instance)
+	{
+		lilv_instance_deactivate(m_instance);
+		// we did not get the instance from lilv, see instantiate()
+		const LV2_Descriptor* descriptor = lilv_instance_get_descriptor(m_instance);
+		if (descriptor->cleanup) { descriptor->cleanup(lilv_instance_get_handle(m_instance)); }
+		delete m_instance;
+		m_instance = nullptr;
+	}
 
 	m_features.clear();
 	m_options.clear();
@@ -484,6 +596,17 @@ void Lv2Proc::shutdownPlugin()
 
 
 
+f_cnt_t Lv2Proc::latency() const
+{
+	// the plugin writes the port on each run
+	return (m_latencyPort && m_latencyPort->m_flow == Lv2Ports::Flow::Output)
+		? static_cast<f_cnt_t>(std::max(m_latencyPort->m_val, 0.f))
+		: 0;
+}
+
+
+
+
 bool Lv2Proc::hasNoteInput() const
 {
 	return m_midiIn;
@@ -537,7 +660,7 @@ void Lv2Proc::initPluginSpecificFeatures()
 		bool threaded = !Engine::audioEngine()->renderOnly();
 		m_worker.emplace(&m_workLock, threaded);
 		m_features[LV2_WORKER__schedule] = m_worker->feature();
-		// note: the worker interface can not be instantiated yet - it requires m_instance. see initPlugin()
+		// note: the worker interface and handle are not known yet, see initPlugin() and instantiate()
 	}
 }
 
@@ -655,8 +778,7 @@ void Lv2Proc::createPort(std::size_t portNum)
 		}
 		case Lv2Ports::Type::Audio:
 		{
-			auto audio = new Lv2Ports::Audio(static_cast<std::size_t>(Engine::audioEngine()->framesPerPeriod()),
-				portIsSideChain(m_plugin, lilvPort));
+			auto audio = new Lv2Ports::Audio(portIsSideChain(m_plugin, lilvPort));
 			port = audio;
 			break;
 		}
@@ -801,6 +923,11 @@ void Lv2Proc::createPorts()
 		m_ports[portNum]->accept(registerPort);
 	}
 
+	// lilv resolves both lv2:reportsLatency and the lv2:latency designation
+	m_latencyPort = lilv_plugin_has_latency(m_plugin)
+		? Lv2Ports::dcast<Lv2Ports::Control>(m_ports[lilv_plugin_get_latency_port_index(m_plugin)].get())
+		: nullptr;
+
 	// initially assign model values to port values
 	copyModelsFromCore();
 
@@ -825,10 +952,8 @@ struct ConnectPortVisitor : public Lv2Ports::Visitor
 		connectPort(lv2_evbuf_get_buffer(atomSeq.m_buf.get()));
 	}
 	void visit(Lv2Ports::Control& ctrl) override { connectPort(&ctrl.m_val); }
-	void visit(Lv2Ports::Audio& audio) override
-	{
-		connectPort((audio.mustBeUsed()) ? audio.m_buffer.data() : nullptr);
-	}
+	// used audio ports get connected before each run, see connectPlanarBuffers
+	void visit(Lv2Ports::Audio&) override { connectPort(nullptr); }
 	void visit(Lv2Ports::Unknown&) override { connectPort(nullptr); }
 	~ConnectPortVisitor() override = default;
 };
@@ -863,7 +988,6 @@ void Lv2Proc::dumpPort(std::size_t num)
 		{
 			qDebug() << (audio.isSideChain()	? "  audio port (sidechain)"
 												: "  audio port");
-			qDebug() << "    buffer size:" << audio.bufferSize();
 		}
 	};
 
@@ -24,10 +24,13 @@
 
 #include "Lv2Worker.h"
 
+#include <algorithm>
 #include <cassert>
 
 #ifdef LMMS_HAVE_LV2
 
+#include "AudioEngine.h"
+#include "Engine.h"
 
 
 namespace lmms
@@ -58,14 +61,22 @@ std::size_t Lv2Worker::bufferSize() const
 
 
 
+static void changeQueueDepth(AudioEngineProfiler::QueueType type, int delta)
+{
+	Engine::audioEngine()->profiler().changeQueueDepth(type, delta);
+}
+
+
+
+
 Lv2Worker::Lv2Worker(Semaphore* commonWorkLock, bool threaded) :
 	m_threaded(threaded),
+	m_request(bufferSize()),
 	m_response(bufferSize()),
 	m_requests(bufferSize()),
 	m_responses(bufferSize()),
 	m_requestsReader(m_requests),
 	m_responsesReader(m_responses),
-	m_sem(0),
 	m_workLock(commonWorkLock)
 {
 	m_scheduleFeature.handle = static_cast<LV2_Worker_Schedule_Handle>(this);
@@ -76,10 +87,10 @@ Lv2Worker::Lv2Worker(Semaphore* commonWorkLock, bool threaded) :
 			return worker->scheduleWork(size, data);
 		};
 
-	if (threaded) { m_thread = std::thread(&Lv2Worker::workerFunc, this); }
-
 	m_requests.mlock();
 	m_responses.mlock();
+
+	if (threaded) { Lv2WorkerPool::instance().addWorker(this); }
 }
 
 
@@ -105,10 +116,24 @@ void Lv2Worker::setInterface(const LV2_Worker_Interface* newInterface)
 
 Lv2Worker::~Lv2Worker()
 {
-	m_exit = true;
-	if(m_threaded) {
-		m_sem.post();
-		m_thread.join();
+	if (m_threaded)
+	{
+		Lv2WorkerPool::instance().removeWorker(this);
+
+		// drop what has not been processed yet
+		uint32_t size;
+		while (hasRequests())
+		{
+			m_requestsReader.read(sizeof(size)).copy((char*)&size, sizeof(size));
+			if (size) { m_requestsReader.read(size); }
+			changeQueueDepth(AudioEngineProfiler::QueueType::Lv2WorkRequests, -1);
+		}
+		while (m_responsesReader.read_space() >= sizeof(size))
+		{
+			m_responsesReader.read(sizeof(size)).copy((char*)&size, sizeof(size));
+			if (size) { m_responsesReader.read(size); }
+			changeQueueDepth(AudioEngineProfiler::QueueType::Lv2WorkResponses, -1);
+		}
 	}
 }
 
@@ -128,6 +153,7 @@ LV2_Worker_Status Lv2Worker::respond(uint32_t size, const void* data)
 		{
 			m_responses.write((const char*)&size, sizeof(size));
 			if(size && data) { m_responses.write((const char*)data, size); }
+			changeQueueDepth(AudioEngineProfiler::QueueType::Lv2WorkResponses, 1);
 		}
 	}
 	else
@@ -142,29 +168,27 @@ LV2_Worker_Status Lv2Worker::respond(uint32_t size, const void* data)
 
 
 
-// Let the worker receive work from the audio thread and "work" on it
-void Lv2Worker::workerFunc()
+// Let a pool thread receive work from the audio thread and "work" on it
+void Lv2Worker::processRequests()
 {
-	std::vector<char> buf;
+	assert(m_busy);
 	uint32_t size;
-	while (true) {
-		m_sem.wait();
-		if (m_exit) { break; }
-
+	while (hasRequests())
+	{
 		const std::size_t readSpace = m_requestsReader.read_space();
-		if (readSpace <= sizeof(size)) { continue; } // (should not happen)
-
 		m_requestsReader.read(sizeof(size)).copy((char*)&size, sizeof(size));
 		assert(size <= readSpace - sizeof(size));
-		if(size > buf.size()) { buf.resize(size); }
-		if(size) { m_requestsReader.read(size).copy(buf.data(), size); }
+		if(size) { m_requestsReader.read(size).copy(m_request.data(), size); }
 
 		assert(m_handle);
 		assert(m_interface);
 		m_workLock->wait();
-		m_interface->work(m_handle, staticWorkerRespond, this, size, buf.data());
+		m_interface->work(m_handle, staticWorkerRespond, this, size, m_request.data());
 		m_workLock->post();
+		changeQueueDepth(AudioEngineProfiler::QueueType::Lv2WorkRequests, -1);
 	}
+
+	m_busy = false;
 }
 
 
@@ -181,10 +205,11 @@ LV2_Worker_Status Lv2Worker::scheduleWork(uint32_t size, const void *data)
 		}
 		else
 		{
-			// Schedule a request to be executed by the worker thread
+			// Schedule a request to be executed by the worker pool
 			m_requests.write((const char*)&size, sizeof(size));
 			if(size && data) { m_requests.write((const char*)data, size); }
-			m_sem.post();
+			changeQueueDepth(AudioEngineProfiler::QueueType::Lv2WorkRequests, 1);
+			Lv2WorkerPool::instance().notify();
 		}
 	}
 	else
@@ -208,7 +233,7 @@ void Lv2Worker::emitResponses()
 {
 	std::size_t read_space = m_responsesReader.read_space();
 	uint32_t size;
-	while (read_space > sizeof(size))
+	while (read_space >= sizeof(size))
 	{
 		assert(m_handle);
 		assert(m_interface);
@@ -216,6 +241,103 @@ void Lv2Worker::emitResponses()
 		if(size) { m_responsesReader.read(size).copy(m_response.data(), size); }
 		m_interface->work_response(m_handle, size, m_response.data());
 		read_space -= sizeof(size) + size;
+		changeQueueDepth(AudioEngineProfiler::QueueType::Lv2WorkResponses, -1);
+	}
+}
+
+
+
+
+Lv2WorkerPool& Lv2WorkerPool::instance()
+{
+	// worker requests are usually file loads, so a few threads are enough
+	static auto s_pool = Lv2WorkerPool{std::clamp(std::thread::hardware_concurrency() / 2, 1u, 4u)};
+	return s_pool;
+}
+
+
+
+
+Lv2WorkerPool::Lv2WorkerPool(std::size_t numThreads) :
+	m_sem(0)
+{
+	for (std::size_t i = 0; i < numThreads; ++i)
+	{
+		m_threads.emplace_back(&Lv2WorkerPool::threadFunc, this);
+	}
+}
+
+
+
+
+Lv2WorkerPool::~Lv2WorkerPool()
+{
+	m_exit = true;
+	for (std::size_t i = 0; i < m_threads.size(); ++i) { m_sem.post(); }
+	for (auto& thread : m_threads) { thread.join(); }
+}
+
+
+
+
+void Lv2WorkerPool::addWorker(Lv2Worker* worker)
+{
+	const auto lock = std::lock_guard{m_workersMutex};
+	m_workers.push_back(worker);
+}
+
+
+
+
+void Lv2WorkerPool::removeWorker(Lv2Worker* worker)
+{
+	{
+		const auto lock = std::lock_guard{m_workersMutex};
+		m_workers.erase(std::find(m_workers.begin(), m_workers.end(), worker));
+	}
+	// wait for a pool thread that is still processing our requests
+	while (worker->m_busy) { std::this_thread::yield(); }
+}
+
+
+
+
+Lv2Worker* Lv2WorkerPool::claimPendingWorker(std::size_t& next)
+{
+	const auto lock = std::lock_guard{m_workersMutex};
+	const std::size_t count = m_workers.size();
+	for (std::size_t i = 0; i < count; ++i)
+	{
+		const std::size_t index = (next + i) % count;
+		Lv2Worker* worker = m_workers[index];
+		// only one thread may read the requests of a worker, so they are processed in order
+		// claiming it under the lock makes removeWorker() wait for us
+		if (worker->hasRequests() && !worker->m_busy.exchange(true))
+		{
+			next = index + 1;
+			return worker;
+		}
+	}
+	return nullptr;
+}
+
+
+
+
+void Lv2WorkerPool::threadFunc()
+{
+	while (true)
+	{
+		m_sem.wait();
+		if (m_exit) { break; }
+
+		// Scan all workers again after each one, so none is skipped if removeWorker() shifts the list.
+		// This also picks up requests that arrived while a different thread found the worker busy.
+		std::size_t next = 0;
+		while (Lv2Worker* worker = claimPendingWorker(next))
+		{
+			worker->processRequests();
+		}
 	}
 }
 
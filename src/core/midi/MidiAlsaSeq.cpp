@@ -515,7 +515,8 @@ void MidiAlsaSeq::run()
 						m_portIDs.values()[i][1] == ev->source.port ) ||
 							m_portIDs.values()[i][0] == ev->source.port )
 				{
-					source = &ev->source;
+					const int key = ev->source.client << 8 | ev->source.port;
+					source = &m_sourceAddresses.insert(key, ev->source).value();
 				}
 			}
 
@@ -527,7 +528,7 @@ void MidiAlsaSeq::run()
 			switch( ev->type )
 			{
 				case SND_SEQ_EVENT_NOTEON:
-					dest->processInEvent( MidiEvent( MidiNoteOn,
+					dest->queueInEvent( MidiEvent( MidiNoteOn,
 								ev->data.note.channel,
 								ev->data.note.note,
 								ev->data.note.velocity,
@@ -537,7 +538,7 @@ void MidiAlsaSeq::run()
 					break;
 
 				case SND_SEQ_EVENT_NOTEOFF:
-					dest->processInEvent( MidiEvent( MidiNoteOff,
+					dest->queueInEvent( MidiEvent( MidiNoteOff,
 								ev->data.note.channel,
 								ev->data.note.note,
 								ev->data.note.velocity,
@@ -547,7 +548,7 @@ void MidiAlsaSeq::run()
 					break;
 
 				case SND_SEQ_EVENT_KEYPRESS:
-					dest->processInEvent( MidiEvent(
+					dest->queueInEvent( MidiEvent(
 									MidiKeyPressure,
 								ev->data.note.channel,
 								ev->data.note.note,
@@ -557,7 +558,7 @@ void MidiAlsaSeq::run()
 					break;
 
 				case SND_SEQ_EVENT_CONTROLLER:
-					dest->processInEvent( MidiEvent(
+					dest->queueInEvent( MidiEvent(
 							MidiControlChange,
 							ev->data.control.channel,
 							ev->data.control.param,
@@ -566,7 +567,7 @@ void MidiAlsaSeq::run()
 					break;
 
 				case SND_SEQ_EVENT_PGMCHANGE:
-					dest->processInEvent( MidiEvent(
+					dest->queueInEvent( MidiEvent(
 							MidiProgramChange,
 							ev->data.control.channel,
 							ev->data.control.value,	0,
@@ -575,7 +576,7 @@ void MidiAlsaSeq::run()
 					break;
 
 				case SND_SEQ_EVENT_CHANPRESS:
-					dest->processInEvent( MidiEvent(
+					dest->queueInEvent( MidiEvent(
 								MidiChannelPressure,
 							ev->data.control.channel,
 							ev->data.control.param,
@@ -584,7 +585,7 @@ void MidiAlsaSeq::run()
 					break;
 
 				case SND_SEQ_EVENT_PITCHBEND:
-					dest->processInEvent( MidiEvent( MidiPitchBend,
+					dest->queueInEvent( MidiEvent( MidiPitchBend,
 							ev->data.control.channel,
 							ev->data.control.value + 8192, 0, source ),
 									TimePos() );
@@ -541,7 +541,7 @@ void MidiApple::notifyMidiPortList( MidiPortList l, MidiEvent event )
 {
 	for( MidiPortList::ConstIterator it = l.begin(); it != l.end(); ++it )
 	{
-		( *it )->processInEvent( event);
+		( *it )->queueInEvent( event );
 	}
 }
 
@@ -27,11 +27,29 @@
 
 #include <array>
 
+#include "AudioEngine.h"
+#include "Engine.h"
 #include "MidiPort.h"
 
 namespace lmms
 {
 
+namespace
+{
+
+//! The audio thread iterates the ports while processing their input, this keeps it from doing so
+AudioEngine::RequestChangesGuard lockPorts()
+{
+	// ports may still be destroyed while the engine is shut down
+	const auto audioEngine = Engine::audioEngine();
+	return audioEngine ? audioEngine->requestChangesGuard() : AudioEngine::RequestChangesGuard{};
+}
+
+} // namespace
+
+
+
+
 MidiClient::~MidiClient()
 {
 	//TODO: noteOffAll(); / clear all ports
@@ -60,6 +78,7 @@ void MidiClient::applyPortName( MidiPort* )
 
 void MidiClient::addPort( MidiPort* port )
 {
+	const auto guard = lockPorts();
 	m_midiPorts.push_back( port );
 }
 
@@ -73,6 +92,7 @@ void MidiClient::removePort( MidiPort* port )
 		return;
 	}
 
+	const auto guard = lockPorts();
 	auto it = std::find(m_midiPorts.begin(), m_midiPorts.end(), port);
 	if( it != m_midiPorts.end() )
 	{
@@ -83,6 +103,17 @@ void MidiClient::removePort( MidiPort* port )
 
 
 
+void MidiClient::processQueuedInEvents(const MidiInputQueue::Period& period)
+{
+	for (MidiPort* port : m_midiPorts)
+	{
+		port->processQueuedInEvents(period);
+	}
+}
+
+
+
+
 void MidiClient::subscribeReadablePort( MidiPort*, const QString& , bool )
 {
 }
@@ -100,8 +131,10 @@ void MidiClient::subscribeWritablePort( MidiPort* , const QString& , bool )
 
 
 
-void MidiClientRaw::parseData( const unsigned char c )
+void MidiClientRaw::parseData( const unsigned char c, MidiInputQueue::Clock::time_point timestamp )
 {
+	m_midiParseData.m_timestamp = timestamp;
+
 	/*********************************************************************/
 	/* 'Process' system real-time messages                               */
 	/*********************************************************************/
@@ -240,7 +273,7 @@ void MidiClientRaw::processParsedEvent()
 {
 	for (const auto& midiPort : m_midiPorts)
 	{
-		midiPort->processInEvent(m_midiParseData.m_midiEvent);
+		midiPort->queueInEvent(m_midiParseData.m_midiEvent, TimePos(), m_midiParseData.m_timestamp);
 	}
 }
 
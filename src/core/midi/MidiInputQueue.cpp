@@ -0,0 +1,74 @@
+/*
+ * MidiInputQueue.cpp
+ *
+ * Copyright (c) 2026 LMMS Developers
+ *
+ * This file is part of LMMS - https://lmms.io
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public
+ * License along with this program (see COPYING); if not, write to the
+ * Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA 02110-1301 USA.
+ *
+ */
+
+#include "MidiInputQueue.h"
+
+#include <algorithm>
+
+namespace lmms
+{
+
+MidiInputQueue::MidiInputQueue(std::size_t capacity) :
+	m_buffer(capacity),
+	m_reader(m_buffer)
+{
+	m_buffer.touch(); // reserve storage space before realtime operation starts
+}
+
+
+
+
+bool MidiInputQueue::push(const MidiEvent& event, const TimePos& time, Clock::time_point timestamp)
+{
+	const auto entry = Entry{event, time, timestamp};
+	return m_buffer.write(&entry, 1) == 1;
+}
+
+
+
+
+bool MidiInputQueue::pop(Entry& entry)
+{
+	if (m_reader.read_space() == 0) { return false; }
+
+	entry = m_reader.read(1)[0];
+	return true;
+}
+
+
+
+
+f_cnt_t MidiInputQueue::frameOffset(Clock::time_point timestamp, const Period& period)
+{
+	if (period.previousStart == Clock::time_point{} || timestamp <= period.previousStart)
+	{
+		return 0;
+	}
+
+	const double frames = std::chrono::duration<double>(timestamp - period.previousStart).count() * period.sampleRate;
+	// events arriving late, e.g. because the last period took too long to render, keep their order
+	return static_cast<f_cnt_t>(std::min(frames, static_cast<double>(period.frames - 1)));
+}
+
+} // namespace lmms
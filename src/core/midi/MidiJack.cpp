@@ -184,6 +184,10 @@ void MidiJack::JackMidiRead(jack_nframes_t nframes)
 	jack_nframes_t event_index = 0;
 	jack_nframes_t event_count = jack_midi_get_event_count(port_buf);
 
+	// the events were received during the last cycle, so their arrival time is derived from their frame in it
+	const auto cycleEnd = MidiInputQueue::Clock::now();
+	const double sampleRate = jack_get_sample_rate(jackClient());
+
 	int rval = jack_midi_event_get(&in_event, port_buf, 0);
 	if (rval == 0 /* 0 = success */)
 	{
@@ -193,8 +197,10 @@ void MidiJack::JackMidiRead(jack_nframes_t nframes)
 			{
 				// lmms is setup to parse bytes coming from a device
 				// parse it byte by byte as it expects
+				const auto timestamp = cycleEnd - std::chrono::duration_cast<MidiInputQueue::Clock::duration>(
+					std::chrono::duration<double>((nframes - in_event.time) / sampleRate));
 				for (unsigned int b = 0; b < in_event.size; b++)
-					parseData( *(in_event.buffer + b) );
+					parseData( *(in_event.buffer + b), timestamp );
 
 				event_index++;
 				if(event_index < event_count)
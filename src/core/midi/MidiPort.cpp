@@ -127,7 +127,7 @@ void MidiPort::setMode( Mode mode )
 
 
 
-void MidiPort::processInEvent( const MidiEvent& event, const TimePos& time )
+void MidiPort::processInEvent( const MidiEvent& event, const TimePos& time, f_cnt_t offset )
 {
 	// mask event
 	if( isInputEnabled() &&
@@ -149,7 +149,31 @@ void MidiPort::processInEvent( const MidiEvent& event, const TimePos& time )
 			}
 		}
 
-		m_midiEventProcessor->processInEvent( inEvent, time );
+		m_midiEventProcessor->processInEvent( inEvent, time, offset );
+	}
+}
+
+
+
+
+void MidiPort::queueInEvent(const MidiEvent& event, const TimePos& time, MidiInputQueue::Clock::time_point timestamp)
+{
+	if (!m_inputQueue.push(event, time, timestamp))
+	{
+		// process it right away rather than dropping it, e.g. while the audio engine is stopped
+		processInEvent(event, time);
+	}
+}
+
+
+
+
+void MidiPort::processQueuedInEvents(const MidiInputQueue::Period& period)
+{
+	auto entry = MidiInputQueue::Entry{};
+	while (m_inputQueue.pop(entry))
+	{
+		processInEvent(entry.event, entry.time, MidiInputQueue::frameOffset(entry.timestamp, period));
 	}
 }
 
@@ -203,6 +203,10 @@ void MidiWinMM::handleInputEvent( HMIDIIN hm, DWORD ev )
 		return;
 	}
 
+	// the events refer to their source until the audio thread has processed them,
+	// so they point to the handle stored in the device map
+	const HMIDIIN* source = &m_inputDevices.constFind(hm).key();
+
 	const MidiPortList & l = m_inputSubs[d];
 	for (MidiPortList::ConstIterator it = l.begin(); it != l.end(); ++it)
 	{
@@ -214,11 +218,11 @@ void MidiWinMM::handleInputEvent( HMIDIIN hm, DWORD ev )
 			case MidiControlChange:
 			case MidiProgramChange:
 			case MidiChannelPressure:
-				(*it)->processInEvent(MidiEvent(cmdtype, chan, par1, par2 & 0xff, &hm));
+				(*it)->queueInEvent(MidiEvent(cmdtype, chan, par1, par2 & 0xff, source));
 				break;
 
 			case MidiPitchBend:
-				(*it)->processInEvent(MidiEvent(cmdtype, chan, par1 + par2 * 128, 0, &hm));
+				(*it)->queueInEvent(MidiEvent(cmdtype, chan, par1 + par2 * 128, 0, source));
 				break;
 
 			default:
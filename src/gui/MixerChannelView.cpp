@@ -36,6 +36,7 @@
 #include <QStackedWidget>
 #include <QVBoxLayout>
 
+#include "AudioEngine.h"
 #include "AutomatableButton.h"
 #include "CaptionMenu.h"
 #include "ColorChooser.h"
@@ -139,6 +140,11 @@ MixerChannelView::MixerChannelView(QWidget* parent, MixerView* mixerView, int ch
 	m_peakIndicator = new PeakIndicator(this);
 	connect(m_fader, &Fader::peakChanged, m_peakIndicator, &PeakIndicator::updatePeak);
 
+	m_latencyLabel = new QLabel{this};
+	m_latencyLabel->setFont(adjustedToPixelSize(font(), SMALL_FONT_SIZE));
+	m_latencyLabel->setAlignment(Qt::AlignHCenter);
+	m_latencyLabel->hide();
+
 	m_effectRackView = new EffectRackView{&mixerChannel->m_fxChain, mixerView->m_racksWidget};
 	m_effectRackView->setFixedWidth(EffectRackView::DEFAULT_WIDTH);
 
@@ -153,6 +159,7 @@ MixerChannelView::MixerChannelView(QWidget* parent, MixerView* mixerView, int ch
 	mainLayout->addWidget(m_renameLineEditView, 0, Qt::AlignHCenter);
 	mainLayout->addLayout(soloMuteLayout);
 	mainLayout->addWidget(m_peakIndicator);
+	mainLayout->addWidget(m_latencyLabel);
 	mainLayout->addWidget(m_fader, 1, Qt::AlignHCenter);
 
 	connect(m_renameLineEdit, &QLineEdit::editingFinished, this, &MixerChannelView::renameFinished);
@@ -191,6 +198,24 @@ void MixerChannelView::contextMenuEvent(QContextMenuEvent*)
 	colorMenu.addAction(tr("Pick random"), this, &MixerChannelView::randomizeColor);
 	contextMenu->addMenu(&colorMenu);
 
+	// channels can be sent to the rear or side speakers of a surround output instead of the master channel,
+	// which then only applies its fader to them and not its effects
+	auto speakersMenu = QMenu{tr("Speakers"), this};
+	const int speakerPairs = speakerPairCount(static_cast<ChannelLayout>(Engine::audioEngine()->outputChannels()));
+	if (!isMasterChannel() && speakerPairs > 1)
+	{
+		IntModel* model = &mixerChannel()->m_speakerPairModel;
+		const QString names[MaxSpeakerPairs] = {tr("Sends (main output)"), tr("Rear speakers only"),
+			tr("Side speakers only")};
+		for (int pair = 0; pair < speakerPairs; ++pair)
+		{
+			QAction* action = speakersMenu.addAction(names[pair], [model, pair] { model->setValue(pair); });
+			action->setCheckable(true);
+			action->setChecked(model->value() == pair);
+		}
+		contextMenu->addMenu(&speakersMenu);
+	}
+
 	contextMenu->exec(QCursor::pos());
 	delete contextMenu;
 }
@@ -409,4 +434,23 @@ void MixerChannelView::reset()
 	m_peakIndicator->resetPeakToMinusInf();
 }
 
+void MixerChannelView::updateLatency()
+{
+	const f_cnt_t latency = mixerChannel()->latency();
+	if (latency == m_displayedLatency) { return; }
+	m_displayedLatency = latency;
+
+	if (latency == 0)
+	{
+		m_latencyLabel->hide();
+		return;
+	}
+
+	const float ms = latency * 1000.f / Engine::audioEngine()->outputSampleRate();
+	m_latencyLabel->setText(tr("%1 ms").arg(ms, 0, 'f', 1));
+	m_latencyLabel->setToolTip(tr("Latency of the plugins up to this channel: %1 frames. "
+		"Channels and tracks with less latency are delayed to stay in sync.").arg(latency));
+	m_latencyLabel->show();
+}
+
 } // namespace lmms::gui
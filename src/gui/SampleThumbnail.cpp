@@ -32,7 +32,6 @@
 
 namespace {
 	constexpr auto MaxSampleThumbnailCacheSize = 32;
-	constexpr auto AggregationPerZoomStep = 10;
 }
 
 namespace lmms {
@@ -77,32 +76,53 @@ SampleThumbnail::SampleThumbnail(const Sample& sample)
 	auto entry = SampleThumbnailEntry{sample.sampleFile(), QFileInfo{sample.sampleFile()}.lastModified()};
 	if (!entry.filePath.isEmpty())
 	{
+		const auto lock = std::lock_guard{s_sampleThumbnailCacheMutex};
 		const auto it = s_sampleThumbnailCacheMap.find(entry);
 		if (it != s_sampleThumbnailCacheMap.end())
 		{
 			m_thumbnailCache = it->second;
 			return;
 		}
-
-		if (s_sampleThumbnailCacheMap.size() == MaxSampleThumbnailCacheSize)
-		{
-			const auto leastUsed = std::min_element(s_sampleThumbnailCacheMap.begin(), s_sampleThumbnailCacheMap.end(),
-				[](const auto& a, const auto& b) { return a.second.use_count() < b.second.use_count(); });
-			s_sampleThumbnailCacheMap.erase(leastUsed->first);
-		}
-
-		s_sampleThumbnailCacheMap[std::move(entry)] = m_thumbnailCache;
 	}
 
 	const auto flatBuffer = m_buffer->data()->data();
 	const auto flatBufferSize = m_buffer->size() * DEFAULT_CHANNELS;
 	m_thumbnailCache->emplace_back(flatBuffer, flatBufferSize, flatBufferSize / AggregationPerZoomStep);
+	addZoomedOutThumbnails(*m_thumbnailCache);
 
-	while (m_thumbnailCache->back().width() >= AggregationPerZoomStep)
+	if (!entry.filePath.isEmpty()) { addToCacheMap(std::move(entry), m_thumbnailCache); }
+}
+
+void SampleThumbnail::cachePeaks(const QString& filePath, std::vector<Peak> peaks)
+{
+	auto thumbnailCache = std::make_shared<ThumbnailCache>();
+	thumbnailCache->emplace_back(std::move(peaks), static_cast<double>(AggregationPerZoomStep));
+	addZoomedOutThumbnails(*thumbnailCache);
+
+	addToCacheMap(SampleThumbnailEntry{filePath, QFileInfo{filePath}.lastModified()}, std::move(thumbnailCache));
+}
+
+void SampleThumbnail::addZoomedOutThumbnails(ThumbnailCache& thumbnailCache)
+{
+	while (thumbnailCache.back().width() >= AggregationPerZoomStep)
+	{
+		auto zoomedOutThumbnail = thumbnailCache.back().zoomOut(AggregationPerZoomStep);
+		thumbnailCache.emplace_back(std::move(zoomedOutThumbnail));
+	}
+}
+
+void SampleThumbnail::addToCacheMap(SampleThumbnailEntry entry, std::shared_ptr<ThumbnailCache> thumbnailCache)
+{
+	const auto lock = std::lock_guard{s_sampleThumbnailCacheMutex};
+	if (s_sampleThumbnailCacheMap.size() == MaxSampleThumbnailCacheSize
+		&& s_sampleThumbnailCacheMap.find(entry) == s_sampleThumbnailCacheMap.end())
 	{
-		auto zoomedOutThumbnail = m_thumbnailCache->back().zoomOut(AggregationPerZoomStep);
-		m_thumbnailCache->emplace_back(std::move(zoomedOutThumbnail));
+		const auto leastUsed = std::min_element(s_sampleThumbnailCacheMap.begin(), s_sampleThumbnailCacheMap.end(),
+			[](const auto& a, const auto& b) { return a.second.use_count() < b.second.use_count(); });
+		s_sampleThumbnailCacheMap.erase(leastUsed->first);
 	}
+
+	s_sampleThumbnailCacheMap[std::move(entry)] = std::move(thumbnailCache);
 }
 
 void SampleThumbnail::visualize(VisualizeParameters parameters, QPainter& painter) const
@@ -164,7 +184,7 @@ void SampleThumbnail::visualize(VisualizeParameters parameters, QPainter& painte
 			{
 				const auto beginAggregationAt = finerThumbnail->data() + beginIndex;
 				const auto endAggregationAt = finerThumbnail->data() + endIndex;
-				const auto peak = std::accumulate(beginAggregationAt, endAggregationAt, Thumbnail::Peak{});
+				const auto peak = std::accumulate(beginAggregationAt, endAggregationAt, Peak{});
 				minPeak = peak.min;
 				maxPeak = peak.max;
 			}
@@ -34,6 +34,7 @@
 #include "PathUtil.h"
 #include "SampleClip.h"
 #include "SampleLoader.h"
+#include "SampleRecordWriter.h"
 #include "SampleThumbnail.h"
 #include "Song.h"
 #include "StringPairDrag.h"
@@ -58,6 +59,11 @@ SampleClipView::SampleClipView( SampleClip * _clip, TrackView * _tv ) :
 
 	connect(m_clip, SIGNAL(wasReversed()), this, SLOT(update()));
 
+	// a finished recording brings the peaks it collected while being written
+	connect(m_clip, &SampleClip::recordingFinished, this, [](SampleRecordWriter* writer) {
+		SampleThumbnail::cachePeaks(writer->fileName(), std::move(writer->peaks()));
+	});
+
 	setStyle( QApplication::style() );
 }
 
@@ -25,12 +25,14 @@
 
 #include <QCheckBox>
 #include <QComboBox>
+#include <QFormLayout>
 #include <QGroupBox>
 #include <QImageReader>
 #include <QLabel>
 #include <QLayout>
 #include <QLineEdit>
 #include <QScrollArea>
+#include <QSpinBox>
 
 #include "AudioEngine.h"
 #include "embed.h"
@@ -139,12 +141,19 @@ SetupDialog::SetupDialog(ConfigTab tab_to_open) :
 			"ui", "vstalwaysontop").toInt()),
 	m_disableAutoQuit(ConfigManager::inst()->value(
 			"ui", "disableautoquit", "1").toInt()),
+	m_pipelineRemotePlugins(ConfigManager::inst()->value(
+			"audioengine", "pipelineremoteplugins", "0").toInt()),
 	m_NaNHandler(ConfigManager::inst()->value(
 			"app", "nanhandler", "1").toInt()),
 	m_bufferSize(ConfigManager::inst()->value(
 			"audioengine", "framesperaudiobuffer").toInt()),
+	m_ditherOutput(ConfigManager::inst()->value(
+			"audioengine", "dither", "0").toInt()),
+	m_outputChannels(ConfigManager::inst()->value(
+			"audioengine", "outputchannels", "2").toInt()),
 	m_sampleRate(ConfigManager::inst()->value(
 			"audioengine", "samplerate").toInt()),
+	m_schedulingSettings(ThreadScheduling::loadSettings()),
 	m_midiAutoQuantize(ConfigManager::inst()->value(
 			"midi", "autoquantize", "0").toInt() != 0),
 	m_workingDir(QDir::toNativeSeparators(ConfigManager::inst()->workingDir())),
@@ -449,6 +458,9 @@ SetupDialog::SetupDialog(ConfigTab tab_to_open) :
 	addCheckBox(tr("Keep effects running even without input"), pluginsBox, pluginsLayout,
 		m_disableAutoQuit, SLOT(toggleDisableAutoQuit(bool)), false);
 
+	addCheckBox(tr("Run VST and ZynAddSubFX plugins in parallel (adds one buffer of latency)"), pluginsBox,
+		pluginsLayout, m_pipelineRemotePlugins, SLOT(togglePipelineRemotePlugins(bool)), true);
+
 
 	// Performance layout ordering.
 	performance_layout->addWidget(autoSaveBox);
@@ -553,6 +565,36 @@ SetupDialog::SetupDialog(ConfigTab tab_to_open) :
 	connect(m_audioInterfaces, SIGNAL(activated(const QString&)),
 			this, SLOT(audioInterfaceChanged(const QString&)));
 
+	auto ditherCheckBox = new QCheckBox(tr("Dither integer output (TPDF)"), audioInterfaceBox);
+	ditherCheckBox->setChecked(m_ditherOutput);
+	ditherCheckBox->setToolTip(tr("Add triangular noise before reducing the output to 16, 24 or 32 bit integers"));
+	audioInterfaceLayout->addWidget(ditherCheckBox);
+	connect(ditherCheckBox, &QCheckBox::toggled, this, [this](bool enabled) {
+		m_ditherOutput = enabled;
+		showRestartWarning();
+	});
+
+	auto outputLayoutLayout = new QHBoxLayout();
+	auto outputLayoutComboBox = new QComboBox(audioInterfaceBox);
+	outputLayoutComboBox->addItem(tr("Mono"), channelCount(ChannelLayout::Mono));
+	outputLayoutComboBox->addItem(tr("Stereo"), channelCount(ChannelLayout::Stereo));
+	outputLayoutComboBox->addItem(tr("Quadraphonic"), channelCount(ChannelLayout::Quad));
+	outputLayoutComboBox->addItem(tr("5.1 surround"), channelCount(ChannelLayout::Surround51));
+	outputLayoutComboBox->addItem(tr("7.1 surround"), channelCount(ChannelLayout::Surround71));
+	const int outputLayoutIndex = outputLayoutComboBox->findData(m_outputChannels);
+	outputLayoutComboBox->setCurrentIndex(outputLayoutIndex < 0 ? 1 : outputLayoutIndex);
+	outputLayoutComboBox->setToolTip(
+		tr("Speakers of the output. Mixer channels can be sent to the speakers besides the front pair, "
+			"JACK, WAV and FLAC output all of them."));
+	outputLayoutLayout->addWidget(new QLabel(tr("Speaker layout:"), audioInterfaceBox));
+	outputLayoutLayout->addWidget(outputLayoutComboBox, 1);
+	audioInterfaceLayout->addLayout(outputLayoutLayout);
+	connect(outputLayoutComboBox, qOverload<int>(&QComboBox::currentIndexChanged), this,
+		[this, outputLayoutComboBox](int index) {
+			m_outputChannels = outputLayoutComboBox->itemData(index).toInt();
+			showRestartWarning();
+		});
+
 	// Advanced setting, hidden for now
 	// // TODO Handle or remove.
 	// auto useNaNHandler = new LedCheckBox(tr("Use built-in NaN handler"), audio_w);
@@ -634,12 +676,78 @@ SetupDialog::SetupDialog(ConfigTab tab_to_open) :
 
 	setBufferSize(m_bufferSizeSlider->value());
 
+	// Audio threads group
+	auto threadsBox = new QGroupBox{tr("Audio threads"), audio_w};
+	auto threadsLayout = new QFormLayout{threadsBox};
+
+	auto renderThreadsSpinBox = new QSpinBox{threadsBox};
+	renderThreadsSpinBox->setRange(0, 64);
+	renderThreadsSpinBox->setSpecialValueText(tr("Automatic"));
+	renderThreadsSpinBox->setValue(m_schedulingSettings.renderThreads);
+	renderThreadsSpinBox->setToolTip(tr("Number of threads rendering audio in parallel"));
+	threadsLayout->addRow(tr("Threads:"), renderThreadsSpinBox);
+	connect(renderThreadsSpinBox, qOverload<int>(&QSpinBox::valueChanged), this, [this](int value) {
+		m_schedulingSettings.renderThreads = value;
+		showRestartWarning();
+	});
+
+	auto renderInCallbackCheckBox = new QCheckBox{tr("Render in the audio device's thread"), threadsBox};
+	renderInCallbackCheckBox->setChecked(m_schedulingSettings.renderInCallback);
+	renderInCallbackCheckBox->setToolTip(tr("Lowers the latency with JACK and ALSA, "
+		"but editing the project while playing is more likely to cause dropouts"));
+	threadsLayout->addRow(renderInCallbackCheckBox);
+	connect(renderInCallbackCheckBox, &QCheckBox::toggled, this, [this](bool enabled) {
+		m_schedulingSettings.renderInCallback = enabled;
+		showRestartWarning();
+	});
+
+#ifdef LMMS_HAVE_PTHREAD_H
+	auto policyComboBox = new QComboBox{threadsBox};
+	policyComboBox->addItem(tr("Default"), static_cast<int>(ThreadScheduling::Policy::Default));
+	policyComboBox->addItem(tr("Realtime (SCHED_FIFO)"), static_cast<int>(ThreadScheduling::Policy::Fifo));
+	policyComboBox->addItem(tr("Realtime, round robin (SCHED_RR)"),
+		static_cast<int>(ThreadScheduling::Policy::RoundRobin));
+	policyComboBox->setCurrentIndex(policyComboBox->findData(static_cast<int>(m_schedulingSettings.policy)));
+	threadsLayout->addRow(tr("Scheduling:"), policyComboBox);
+
+	auto prioritySpinBox = new QSpinBox{threadsBox};
+	prioritySpinBox->setRange(1, 99);
+	prioritySpinBox->setValue(m_schedulingSettings.priority);
+	prioritySpinBox->setEnabled(m_schedulingSettings.policy != ThreadScheduling::Policy::Default);
+	prioritySpinBox->setToolTip(tr("Realtime priority, limited by the RLIMIT_RTPRIO of your user"));
+	threadsLayout->addRow(tr("Priority:"), prioritySpinBox);
+
+	connect(policyComboBox, qOverload<int>(&QComboBox::currentIndexChanged), this,
+		[this, policyComboBox, prioritySpinBox](int index) {
+			m_schedulingSettings.policy = static_cast<ThreadScheduling::Policy>(policyComboBox->itemData(index).toInt());
+			prioritySpinBox->setEnabled(m_schedulingSettings.policy != ThreadScheduling::Policy::Default);
+			showRestartWarning();
+		});
+	connect(prioritySpinBox, qOverload<int>(&QSpinBox::valueChanged), this, [this](int value) {
+		m_schedulingSettings.priority = value;
+		showRestartWarning();
+	});
+#endif
+
+#ifdef LMMS_BUILD_LINUX
+	auto cpusLineEdit = new QLineEdit{ThreadScheduling::cpuListToString(m_schedulingSettings.cpus), threadsBox};
+	cpusLineEdit->setPlaceholderText(tr("All"));
+	cpusLineEdit->setToolTip(tr("CPUs to run the audio threads on, e.g. \"2-3\" for a set of isolated cores"));
+	threadsLayout->addRow(tr("CPUs:"), cpusLineEdit);
+	connect(cpusLineEdit, &QLineEdit::editingFinished, this, [this, cpusLineEdit] {
+		m_schedulingSettings.cpus = ThreadScheduling::parseCpuList(cpusLineEdit->text());
+		cpusLineEdit->setText(ThreadScheduling::cpuListToString(m_schedulingSettings.cpus));
+		showRestartWarning();
+	});
+#endif
+
 
 	// Audio layout ordering.
 	audio_layout->addWidget(audioInterfaceBox);
 	audio_layout->addWidget(as_w);
 	audio_layout->addWidget(sampleRateBox);
 	audio_layout->addWidget(bufferSizeBox);
+	audio_layout->addWidget(threadsBox);
 	audio_layout->addStretch();
 
 
@@ -999,6 +1107,8 @@ void SetupDialog::accept()
 					QString::number(m_vstAlwaysOnTop));
 	ConfigManager::inst()->setValue("ui", "disableautoquit",
 					QString::number(m_disableAutoQuit));
+	ConfigManager::inst()->setValue("audioengine", "pipelineremoteplugins",
+					QString::number(m_pipelineRemotePlugins));
 	ConfigManager::inst()->setValue("audioengine", "audiodev",
 					m_audioIfaceNames[m_audioInterfaces->currentText()]);
 	ConfigManager::inst()->setValue("app", "nanhandler",
@@ -1007,6 +1117,11 @@ void SetupDialog::accept()
 					QString::number(m_sampleRate));
 	ConfigManager::inst()->setValue("audioengine", "framesperaudiobuffer",
 					QString::number(m_bufferSize));
+	ConfigManager::inst()->setValue("audioengine", "dither",
+					QString::number(m_ditherOutput));
+	ConfigManager::inst()->setValue("audioengine", "outputchannels",
+					QString::number(m_outputChannels));
+	ThreadScheduling::saveSettings(m_schedulingSettings);
 	ConfigManager::inst()->setValue("audioengine", "mididev",
 					m_midiIfaceNames[m_midiInterfaces->currentText()]);
 	ConfigManager::inst()->setValue("midi", "midiautoassign",
@@ -1205,6 +1320,12 @@ void SetupDialog::toggleDisableAutoQuit(bool enabled)
 	m_disableAutoQuit = enabled;
 }
 
+
+void SetupDialog::togglePipelineRemotePlugins(bool enabled)
+{
+	m_pipelineRemotePlugins = enabled;
+}
+
 void SetupDialog::audioInterfaceChanged(const QString & iface)
 {
 	for(AswMap::iterator it = m_audioIfaceSetupWidgets.begin();
@@ -31,6 +31,7 @@
 #include "CPULoadWidget.h"
 #include "embed.h"
 #include "Engine.h"
+#include "lmmsconfig.h"
 
 
 namespace lmms::gui
@@ -103,7 +104,14 @@ void CPULoadWidget::updateCpuLoad()
 			+ tr(" - Notes and setup: %1%").arg(engine->detailLoad(AudioEngineProfiler::DetailType::NoteSetup)) + "\n"
 			+ tr(" - Instruments: %1%").arg(engine->detailLoad(AudioEngineProfiler::DetailType::Instruments)) + "\n"
 			+ tr(" - Effects: %1%").arg(engine->detailLoad(AudioEngineProfiler::DetailType::Effects)) + "\n"
-			+ tr(" - Mixing: %1%").arg(engine->detailLoad(AudioEngineProfiler::DetailType::Mixing))
+			+ tr(" - Mixing: %1%").arg(engine->detailLoad(AudioEngineProfiler::DetailType::Mixing)) + "\n"
+			+ tr("Silent tracks and channels skipped: %1").arg(engine->profiler().skippedNodes()) + "\n"
+			+ tr("Thread scheduling: %1").arg(ThreadScheduling::policyName(engine->profiler().schedulingPolicy()))
+#ifdef LMMS_HAVE_LV2
+			+ "\n" + tr("LV2 worker queues: %1 requests, %2 responses")
+				.arg(engine->profiler().queueDepth(AudioEngineProfiler::QueueType::Lv2WorkRequests))
+				.arg(engine->profiler().queueDepth(AudioEngineProfiler::QueueType::Lv2WorkResponses))
+#endif
 		);
 		m_currentLoad = new_load;
 		m_changed = true;
@@ -221,26 +221,27 @@ InstrumentTrack::~InstrumentTrack()
 
 
 
-void InstrumentTrack::processAudioBuffer( SampleFrame* buf, const fpp_t frames, NotePlayHandle* n )
+bool InstrumentTrack::processAudioBuffer( SampleFrame* buf, const fpp_t frames, NotePlayHandle* n )
 {
 	// we must not play the sound if this InstrumentTrack is muted...
 	if( isMuted() || ( Engine::getSong()->playMode() != Song::PlayMode::MidiClip &&
 				n && n->isPatternTrackMuted() ) || ! m_instrument )
 	{
-		return;
+		return true;
 	}
 
 	// Test for silent input data if instrument provides a single stream only (i.e. driven by InstrumentPlayHandle)
 	// We could do that in all other cases as well but the overhead for silence test is bigger than
 	// what we potentially save. While playing a note, a NotePlayHandle-driven instrument will produce sound in
 	// 99 of 100 cases so that test would be a waste of time.
-	if (m_instrument->isSingleStreamed() && MixHelpers::isSilent(buf, frames))
+	const bool silent = m_instrument->isSingleStreamed() && MixHelpers::isSilent(buf, frames);
+	if (silent)
 	{
 		// at least pass one silent buffer to allow
 		if( m_silentBuffersProcessed )
 		{
 			// skip further processing
-			return;
+			return false;
 		}
 		m_silentBuffersProcessed = true;
 	}
@@ -278,6 +279,8 @@ void InstrumentTrack::processAudioBuffer( SampleFrame* buf, const fpp_t frames,
 			}
 		}
 	}
+
+	return !silent;
 }
 
 
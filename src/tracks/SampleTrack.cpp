@@ -35,6 +35,7 @@
 #include "SampleClip.h"
 #include "SamplePlayHandle.h"
 #include "SampleRecordHandle.h"
+#include "SampleRecordWriter.h"
 #include "SampleTrackView.h"
 #include "Song.h"
 #include "volume.h"
@@ -147,7 +148,13 @@ bool SampleTrack::play( const TimePos & _start, const fpp_t _frames,
 				{
 					return played_a_note;
 				}
-				auto smpHandle = new SampleRecordHandle(st);
+				// The writer of the previous take may not have finished yet
+				SampleRecordWriter* writer = st->recordWriter();
+				if (!writer || writer->isStopped())
+				{
+					continue;
+				}
+				auto smpHandle = new SampleRecordHandle(st, writer);
 				handle = smpHandle;
 			}
 			else
@@ -0,0 +1,79 @@
+# RenderDemos.cmake - renders the demo projects with the realtime checks
+# enabled and fails if a project causes more violations than recorded in the
+# baseline. A project without a baseline entry fails as well, so new demos and
+# an empty baseline cannot pass unnoticed.
+#
+# Expects LMMS (path to the lmms executable), PROJECTS_DIR, BASELINE and
+# WORK_DIR. Pass -DUPDATE_BASELINE=ON to rewrite the baseline with the
+# current counts instead of comparing against it; the update-realtime-baseline
+# target does this.
+
+file(MAKE_DIRECTORY "${WORK_DIR}")
+
+# Baseline lines have the form "<violations> <project file>"
+if(EXISTS "${BASELINE}")
+	file(STRINGS "${BASELINE}" baseline_lines REGEX "^[0-9]+ ")
+	foreach(line IN LISTS baseline_lines)
+		string(REGEX MATCH "^([0-9]+) (.+)$" _ "${line}")
+		set("baseline_${CMAKE_MATCH_2}" "${CMAKE_MATCH_1}")
+	endforeach()
+endif()
+
+file(GLOB_RECURSE projects RELATIVE "${PROJECTS_DIR}" "${PROJECTS_DIR}/*.mmp" "${PROJECTS_DIR}/*.mmpz")
+list(SORT projects)
+
+set(failed)
+set(new_baseline "# Realtime violations per demo project, see RenderDemos.cmake\n")
+foreach(project IN LISTS projects)
+	set(report "${WORK_DIR}/report.txt")
+	file(REMOVE "${report}")
+
+	execute_process(
+		COMMAND "${CMAKE_COMMAND}" -E env "LMMS_REALTIME_REPORT=${report}"
+			"${LMMS}" --allowroot render "${PROJECTS_DIR}/${project}" -o "${WORK_DIR}/render.wav"
+		RESULT_VARIABLE result
+		OUTPUT_QUIET
+		ERROR_QUIET
+	)
+	if(NOT result EQUAL 0)
+		message(SEND_ERROR "${project}: rendering failed (${result})")
+		list(APPEND failed "${project}")
+		continue()
+	endif()
+
+	file(STRINGS "${report}" summary REGEX "violation\\(s\\) in total")
+	string(REGEX MATCH "([0-9]+) violation" _ "${summary}")
+	set(count "${CMAKE_MATCH_1}")
+	string(APPEND new_baseline "${count} ${project}\n")
+
+	if(UPDATE_BASELINE)
+		message(STATUS "${project}: ${count} violation(s)")
+		continue()
+	endif()
+
+	if(NOT DEFINED "baseline_${project}")
+		message(SEND_ERROR "${project}: ${count} violation(s), not in the baseline, "
+			"record it with the update-realtime-baseline target")
+		list(APPEND failed "${project}")
+		continue()
+	endif()
+
+	set(allowed "${baseline_${project}}")
+	if(count GREATER allowed)
+		# Keep the report of the regressed project for inspection
+		string(MAKE_C_IDENTIFIER "${project}" report_name)
+		file(RENAME "${report}" "${WORK_DIR}/${report_name}.txt")
+		message(SEND_ERROR "${project}: ${count} violation(s), baseline is ${allowed}, "
+			"see ${WORK_DIR}/${report_name}.txt")
+		list(APPEND failed "${project}")
+	else()
+		message(STATUS "${project}: ${count} violation(s), baseline is ${allowed}")
+	endif()
+endforeach()
+
+if(UPDATE_BASELINE)
+	file(WRITE "${BASELINE}" "${new_baseline}")
+elseif(failed)
+	list(LENGTH failed failed_count)
+	message(FATAL_ERROR "${failed_count} project(s) failed to render, regressed or have no baseline")
+endif()
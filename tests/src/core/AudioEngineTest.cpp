@@ -0,0 +1,210 @@
+/*
+ * AudioEngineTest.cpp
+ *
+ * Copyright (c) 2026 LMMS Developers
+ *
+ * This file is part of LMMS - https://lmms.io
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public
+ * License along with this program (see COPYING); if not, write to the
+ * Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA 02110-1301 USA.
+ *
+ */
+
+#include <QtTest>
+
+#include <algorithm>
+#include <chrono>
+#include <future>
+#include <thread>
+#include <vector>
+
+#include "AudioDevice.h"
+#include "AudioEngine.h"
+#include "ConfigManager.h"
+#include "Engine.h"
+
+namespace {
+
+//! Fetches its periods like the realtime callback of a JACK or ALSA device
+class CallbackDevice : public lmms::AudioDevice
+{
+public:
+	static constexpr lmms::fpp_t Frames = 256;
+
+	CallbackDevice(lmms::AudioEngine* audioEngine, bool renderInCallback) :
+		AudioDevice(lmms::DEFAULT_CHANNELS, audioEngine),
+		m_renderInCallback(renderInCallback),
+		m_left(Frames),
+		m_right(Frames)
+	{
+	}
+
+	bool canRenderInCallback() const override { return m_renderInCallback; }
+
+	lmms::fpp_t callback()
+	{
+		float* const out[] = {m_left.data(), m_right.data()};
+		return readPlanar(out, Frames);
+	}
+
+	bool isSilent() const
+	{
+		const auto silent = [](float sample) { return sample == 0.f; };
+		return std::all_of(m_left.begin(), m_left.end(), silent)
+			&& std::all_of(m_right.begin(), m_right.end(), silent);
+	}
+
+private:
+	const bool m_renderInCallback;
+	std::vector<float> m_left;
+	std::vector<float> m_right;
+};
+
+} // namespace
+
+class AudioEngineTest : public QObject
+{
+	Q_OBJECT
+private:
+	void addModeRows()
+	{
+		QTest::addColumn<bool>("renderInCallback");
+		QTest::newRow("fifo writer") << false;
+		QTest::newRow("callback") << true;
+	}
+
+	/*! Replaces the engine's device by a realtime CallbackDevice, which renders in its callback or reads
+	 *  from the fifo writer thread. Without @p needsFifo, it is pulled like by an offline renderer.
+	 */
+	CallbackDevice* startCallbackDevice(bool renderInCallback, bool needsFifo = true)
+	{
+		using namespace lmms;
+		const auto audioEngine = Engine::audioEngine();
+		auto device = new CallbackDevice(audioEngine, renderInCallback);
+		audioEngine->storeAudioDevice();
+		audioEngine->setAudioDevice(device, audioEngine->currentQualitySettings(), needsFifo, true);
+		return device;
+	}
+
+private slots:
+	void initTestCase()
+	{
+		using namespace lmms;
+		// the devices decide whether they render in their callback
+		ConfigManager::inst()->setValue("audioengine", "renderincallback", "1");
+		Engine::init(true);
+	}
+
+	void cleanupTestCase()
+	{
+		using namespace lmms;
+		Engine::destroy();
+	}
+
+	//! Without the fifo writer, the periods are rendered in the device's thread and there is no latency in between
+	void RendersInCallback_data() { addModeRows(); }
+	void RendersInCallback()
+	{
+		using namespace lmms;
+		QFETCH(bool, renderInCallback);
+		const auto audioEngine = Engine::audioEngine();
+
+		auto device = startCallbackDevice(renderInCallback);
+		QCOMPARE(audioEngine->hasFifoWriter(), !renderInCallback);
+		QCOMPARE(audioEngine->fifoLatency() == 0, renderInCallback);
+		for (int i = 0; i < 10; ++i)
+		{
+			QCOMPARE(device->callback(), CallbackDevice::Frames);
+		}
+		audioEngine->restoreAudioDevice();
+	}
+
+	//! A callback that renders directly must not wait while the model is being changed
+	void CallbackDoesNotWaitForChanges()
+	{
+		using namespace lmms;
+		const auto audioEngine = Engine::audioEngine();
+
+		auto device = startCallbackDevice(true);
+		audioEngine->requestChangeInModel();
+		auto callback = std::async(std::launch::async, [device] { return device->callback(); });
+		const bool finished = callback.wait_for(std::chrono::seconds{5}) == std::future_status::ready;
+		audioEngine->doneChangeInModel();
+
+		QVERIFY(finished);
+		QCOMPARE(callback.get(), CallbackDevice::Frames);
+		QVERIFY(device->isSilent());
+		audioEngine->restoreAudioDevice();
+	}
+
+	//! An offline renderer, like the project export, must wait for changes instead of skipping a period
+	void OfflineRenderingWaitsForChanges()
+	{
+		using namespace lmms;
+		const auto audioEngine = Engine::audioEngine();
+
+		startCallbackDevice(true, false);
+		QVERIFY(!audioEngine->hasFifoWriter());
+		audioEngine->requestChangeInModel();
+		auto render = std::async(std::launch::async, [audioEngine] { return audioEngine->nextBuffer(); });
+		const bool finishedEarly = render.wait_for(std::chrono::milliseconds{200}) == std::future_status::ready;
+		audioEngine->doneChangeInModel();
+
+		QVERIFY(!finishedEarly);
+		QVERIFY(render.get() != nullptr);
+		audioEngine->restoreAudioDevice();
+	}
+
+	/*! Calls the device at the pace of a real device and benchmarks a single callback.
+	 *
+	 *  This does not measure the latency or xruns of a real device: the latency printed is the one the engine
+	 *  adds by design, computed from fifoLatency(), and the late callbacks are counted in a thread with normal
+	 *  priority, so they include scheduling delays that a realtime thread would not see.
+	 */
+	void BenchmarkCallback_data() { addModeRows(); }
+	void BenchmarkCallback()
+	{
+		using namespace lmms;
+		using Clock = std::chrono::steady_clock;
+		QFETCH(bool, renderInCallback);
+		const auto audioEngine = Engine::audioEngine();
+
+		auto device = startCallbackDevice(renderInCallback);
+
+		const auto period = std::chrono::microseconds{
+			1000000 * CallbackDevice::Frames / audioEngine->outputSampleRate()};
+		const int callbacks = 200;
+		int lateCallbacks = 0;
+		auto deadline = Clock::now() + period;
+		for (int i = 0; i < callbacks; ++i)
+		{
+			device->callback();
+			if (Clock::now() > deadline) { ++lateCallbacks; }
+			std::this_thread::sleep_until(deadline);
+			deadline += period;
+		}
+		qInfo("expected latency: %d frames, late callbacks in a non-realtime thread: %d of %d",
+			static_cast<int>(audioEngine->fifoLatency() + CallbackDevice::Frames), lateCallbacks, callbacks);
+
+		QBENCHMARK
+		{
+			device->callback();
+		}
+		audioEngine->restoreAudioDevice();
+	}
+};
+
+QTEST_GUILESS_MAIN(AudioEngineTest)
+#include "AudioEngineTest.moc"
@@ -0,0 +1,142 @@
+/*
+ * AudioFileDeviceTest.cpp
+ *
+ * Copyright (c) 2026 LMMS Developers
+ *
+ * This file is part of LMMS - https://lmms.io
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public
+ * License along with this program (see COPYING); if not, write to the
+ * Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA 02110-1301 USA.
+ *
+ */
+
+#include <QTemporaryDir>
+#include <QtTest>
+
+#include <sndfile.h>
+
+#include "AudioEngine.h"
+#include "AudioFileDevice.h"
+#include "Engine.h"
+#include "ProjectRenderer.h"
+
+Q_DECLARE_METATYPE(lmms::ProjectRenderer::ExportFileFormat)
+Q_DECLARE_METATYPE(lmms::OutputSettings::BitDepth)
+
+class AudioFileDeviceTest : public QObject
+{
+	Q_OBJECT
+private:
+	//! Creates a file device and makes it the engine's device, which renders the periods it processes
+	lmms::AudioFileDevice* startFileDevice(lmms::ProjectRenderer::ExportFileFormat format,
+		lmms::OutputSettings::BitDepth bitDepth, const QString& fileName)
+	{
+		using namespace lmms;
+		const auto audioEngine = Engine::audioEngine();
+		const auto settings = OutputSettings{audioEngine->outputSampleRate(), 160, bitDepth};
+		bool successful = false;
+		const auto& encoder = ProjectRenderer::fileEncodeDevices[static_cast<std::size_t>(format)];
+		auto device = encoder.m_getDevInst(fileName, settings, DEFAULT_CHANNELS, audioEngine, successful);
+		if (!successful)
+		{
+			delete device;
+			return nullptr;
+		}
+
+		audioEngine->storeAudioDevice();
+		audioEngine->setAudioDevice(device, audioEngine->currentQualitySettings(), false, true);
+		return device;
+	}
+
+private slots:
+	void initTestCase()
+	{
+		using namespace lmms;
+		Engine::init(true);
+	}
+
+	void cleanupTestCase()
+	{
+		using namespace lmms;
+		Engine::destroy();
+	}
+
+	//! Frames which do not fill a whole batch must be written when the device is destroyed
+	void WritesIncompleteBatch()
+	{
+		using namespace lmms;
+		const auto audioEngine = Engine::audioEngine();
+		QTemporaryDir dir;
+		const auto fileName = dir.filePath("export.wav");
+
+		auto device = startFileDevice(ProjectRenderer::ExportFileFormat::Wave, OutputSettings::BitDepth::Depth32Bit,
+			fileName);
+		QVERIFY(device);
+		const auto periods = AudioFileDevice::BatchFrames / audioEngine->framesPerPeriod() * 3 / 2;
+		for (fpp_t i = 0; i < periods; ++i)
+		{
+			device->processNextBuffer();
+		}
+		audioEngine->restoreAudioDevice();
+
+		auto info = SF_INFO{};
+		SNDFILE* file = sf_open(fileName.toUtf8().constData(), SFM_READ, &info);
+		QVERIFY(file);
+		QCOMPARE(info.frames, static_cast<sf_count_t>(periods * audioEngine->framesPerPeriod()));
+		QCOMPARE(info.channels, static_cast<int>(DEFAULT_CHANNELS));
+		sf_close(file);
+	}
+
+	void BenchmarkExport_data()
+	{
+		using namespace lmms;
+		using Format = ProjectRenderer::ExportFileFormat;
+		using BitDepth = OutputSettings::BitDepth;
+		QTest::addColumn<Format>("format");
+		QTest::addColumn<BitDepth>("bitDepth");
+
+		QTest::newRow("wav 16 bit") << Format::Wave << BitDepth::Depth16Bit;
+		QTest::newRow("wav 24 bit") << Format::Wave << BitDepth::Depth24Bit;
+		QTest::newRow("wav 32 bit") << Format::Wave << BitDepth::Depth32Bit;
+		QTest::newRow("flac 16 bit") << Format::Flac << BitDepth::Depth16Bit;
+		QTest::newRow("flac 24 bit") << Format::Flac << BitDepth::Depth24Bit;
+		QTest::newRow("ogg") << Format::Ogg << BitDepth::Depth16Bit;
+		QTest::newRow("mp3") << Format::MP3 << BitDepth::Depth16Bit;
+	}
+
+	//! Time to render and encode a single period, including the share of the batches written to disk
+	void BenchmarkExport()
+	{
+		using namespace lmms;
+		QFETCH(ProjectRenderer::ExportFileFormat, format);
+		QFETCH(OutputSettings::BitDepth, bitDepth);
+		if (!ProjectRenderer::fileEncodeDevices[static_cast<std::size_t>(format)].isAvailable())
+		{
+			QSKIP("Format not available in this build");
+		}
+
+		QTemporaryDir dir;
+		auto device = startFileDevice(format, bitDepth, dir.filePath("export"));
+		QVERIFY(device);
+		QBENCHMARK
+		{
+			device->processNextBuffer();
+		}
+		Engine::audioEngine()->restoreAudioDevice();
+	}
+};
+
+QTEST_GUILESS_MAIN(AudioFileDeviceTest)
+#include "AudioFileDeviceTest.moc"
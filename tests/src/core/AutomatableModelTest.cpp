@@ -26,7 +26,9 @@
 #include <QtTest>
 #include "AutomatableModel.h"
 #include "ComboBoxModel.h"
+#include "ControllerConnection.h"
 #include "Engine.h"
+#include "LfoController.h"
 
 class AutomatableModelTest : public QObject
 {
@@ -114,6 +116,52 @@ private slots: // tests
 		QVERIFY(m2.value());
 		QVERIFY(!m3.value());
 	}
+
+	void ValueBufferTests()
+	{
+		using namespace lmms;
+
+		FloatModel m(0.f, 0.f, 1.f, 0.01f);
+		QVERIFY(!m.valueBuffer()); // no change, no sample-exact data
+
+		// the first request registers the model, later periods are computed in advance
+		m.setValue(0.5f);
+		AutomatableModel::incrementPeriodCounter();
+		QVERIFY(m.valueBuffer());
+		QCOMPARE(m.valueBuffer()->value(0), 0.f);
+
+		AutomatableModel::incrementPeriodCounter();
+		AutomatableModel::updateValueBuffers();
+		QVERIFY(!m.valueBuffer());
+
+		m.setValue(1.f);
+		AutomatableModel::incrementPeriodCounter();
+		AutomatableModel::updateValueBuffers();
+		m.setValue(0.f); // must not change the buffer of the current period
+		QVERIFY(m.valueBuffer());
+		QCOMPARE(m.valueBuffer()->value(0), 0.5f);
+		QVERIFY(m.valueBuffer()->value(m.valueBuffer()->length() - 1) > 0.5f);
+	}
+
+	void LfoControlledValueBufferTests()
+	{
+		using namespace lmms;
+
+		// the LFO asks for its amount model's buffer while the target's buffer is computed
+		LfoController lfo(nullptr);
+		FloatModel m(0.f, 0.f, 1.f, 0.01f);
+		m.setControllerConnection(new ControllerConnection(&lfo));
+
+		AutomatableModel::incrementPeriodCounter();
+		Controller::triggerFrameCounter();
+		QVERIFY(m.valueBuffer());
+
+		AutomatableModel::incrementPeriodCounter();
+		Controller::triggerFrameCounter();
+		AutomatableModel::updateValueBuffers();
+		QVERIFY(m.valueBuffer());
+		QCOMPARE(m.valueBuffer()->length(), lfo.valueBuffer()->length());
+	}
 };
 
 QTEST_GUILESS_MAIN(AutomatableModelTest)
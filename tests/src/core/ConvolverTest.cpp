@@ -0,0 +1,122 @@
+/*
+ * ConvolverTest.cpp
+ *
+ * Copyright (c) 2026 LMMS Developers
+ *
+ * This file is part of LMMS - https://lmms.io
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public
+ * License along with this program (see COPYING); if not, write to the
+ * Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA 02110-1301 USA.
+ *
+ */
+
+
+#include <QtTest>
+
+#include <cmath>
+#include <random>
+#include <vector>
+
+#include "Convolver.h"
+
+class ConvolverTest : public QObject
+{
+	Q_OBJECT
+private:
+	static constexpr lmms::fpp_t HeadBlockSize = 64;
+	static constexpr lmms::fpp_t TailBlockSize = 1024;
+
+	static std::vector<lmms::SampleFrame> noise(lmms::f_cnt_t frames, unsigned seed)
+	{
+		using namespace lmms;
+		auto generator = std::mt19937{seed};
+		auto distribution = std::uniform_real_distribution<float>{-1.f, 1.f};
+		auto buffer = std::vector<SampleFrame>(frames);
+		for (auto& frame : buffer) { frame = SampleFrame(distribution(generator), distribution(generator)); }
+		return buffer;
+	}
+
+private slots:
+	//! The result must not depend on how the impulse response is split or how many frames are processed at once
+	void MatchesDirectConvolution_data()
+	{
+		QTest::addColumn<int>("impulseLength");
+		QTest::newRow("empty") << 0;
+		QTest::newRow("single frame") << 1;
+		QTest::newRow("head only") << 700;
+		QTest::newRow("head and first tail block") << 1500;
+		QTest::newRow("all stages") << 9000;
+	}
+	void MatchesDirectConvolution()
+	{
+		using namespace lmms;
+		QFETCH(int, impulseLength);
+
+		const auto impulse = noise(impulseLength, 1);
+		const auto input = noise(TailBlockSize * 12, 2);
+		auto output = input;
+
+		auto convolver = Convolver(impulse.data(), impulse.size(), HeadBlockSize, TailBlockSize);
+		QCOMPARE(convolver.impulseLength(), f_cnt_t(impulseLength));
+
+		// odd sizes so that calls do not line up with the partitions, processed in place
+		const fpp_t sizes[] = {1, 37, 256, 100, 64, 500};
+		for (f_cnt_t done = 0, call = 0; done < output.size(); ++call)
+		{
+			const auto frames = std::min<f_cnt_t>(sizes[call % std::size(sizes)], output.size() - done);
+			convolver.process(output.data() + done, output.data() + done, frames);
+			done += frames;
+		}
+
+		for (f_cnt_t f = 0; f < output.size(); f += 7)
+		{
+			double left = 0., right = 0.;
+			for (f_cnt_t i = 0; i < impulse.size() && i <= f; ++i)
+			{
+				left += input[f - i].left() * impulse[i].left();
+				right += input[f - i].right() * impulse[i].right();
+			}
+			QVERIFY(std::abs(output[f].left() - left) < 1e-3);
+			QVERIFY(std::abs(output[f].right() - right) < 1e-3);
+		}
+	}
+
+	//! CPU time per period depending on the length of the impulse response
+	void BenchmarkProcess_data()
+	{
+		QTest::addColumn<double>("seconds");
+		for (double seconds : {0.1, 0.5, 1., 2., 5., 10.})
+		{
+			QTest::newRow(qPrintable(QString("%1 s").arg(seconds))) << seconds;
+		}
+	}
+	void BenchmarkProcess()
+	{
+		using namespace lmms;
+		QFETCH(double, seconds);
+
+		const auto impulse = noise(static_cast<f_cnt_t>(seconds * 48000), 1);
+		auto convolver = Convolver(impulse.data(), impulse.size());
+		const auto input = noise(256, 2);
+		auto output = std::vector<SampleFrame>(input.size());
+		QBENCHMARK
+		{
+			convolver.process(input.data(), output.data(), input.size());
+		}
+	}
+};
+
+QTEST_GUILESS_MAIN(ConvolverTest)
+#include "ConvolverTest.moc"
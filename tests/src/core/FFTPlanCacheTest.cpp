@@ -0,0 +1,133 @@
+/*
+ * FFTPlanCacheTest.cpp
+ *
+ * Copyright (c) 2026 LMMS Developers
+ *
+ * This file is part of LMMS - https://lmms.io
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public
+ * License along with this program (see COPYING); if not, write to the
+ * Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA 02110-1301 USA.
+ *
+ */
+
+#include <QtTest>
+
+#include <cmath>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+#include "FFTPlanCache.h"
+
+class FFTPlanCacheTest : public QObject
+{
+	Q_OBJECT
+private:
+	//! Transforms a test signal forth and back and returns the largest error
+	static float roundTripError(const lmms::FFTPlan& forward, const lmms::FFTPlan& inverse)
+	{
+		using namespace lmms;
+		const int size = forward.size();
+		auto input = FFTBuffer<float>(size);
+		auto spectrum = FFTBuffer<fftwf_complex>(size / 2 + 1);
+		auto output = FFTBuffer<float>(size);
+		for (int i = 0; i < size; ++i) { input[i] = std::sin(0.1f * i) + 0.5f * std::cos(0.37f * i); }
+
+		forward.forward(input.data(), spectrum.data());
+		inverse.inverse(spectrum.data(), output.data());
+
+		float error = 0.f;
+		for (int i = 0; i < size; ++i) { error = std::max(error, std::abs(output[i] / size - input[i])); }
+		return error;
+	}
+
+private slots:
+	void SharesPlans()
+	{
+		using namespace lmms;
+		auto& cache = FFTPlanCache::instance();
+		const auto forward = cache.plan(1024, FFTPlanCache::Direction::Forward);
+		QVERIFY(forward.isValid());
+		QCOMPARE(forward.size(), 1024);
+		QVERIFY(forward == cache.plan(1024, FFTPlanCache::Direction::Forward));
+		QVERIFY(forward != cache.plan(1024, FFTPlanCache::Direction::Inverse));
+		QVERIFY(forward != cache.plan(2048, FFTPlanCache::Direction::Forward));
+	}
+
+	//! Plans must give the same results while estimated and after being measured
+	void RoundTrip_data()
+	{
+		QTest::addColumn<int>("size");
+		for (int size : {8, 64, 1000, 4096, 16384})
+		{
+			QTest::newRow(qPrintable(QString::number(size))) << size;
+		}
+	}
+	void RoundTrip()
+	{
+		using namespace lmms;
+		QFETCH(int, size);
+		auto& cache = FFTPlanCache::instance();
+		const auto forward = cache.plan(size, FFTPlanCache::Direction::Forward);
+		const auto inverse = cache.plan(size, FFTPlanCache::Direction::Inverse);
+
+		QVERIFY(roundTripError(forward, inverse) < 1e-4f);
+		cache.waitForMeasurements();
+		QVERIFY(roundTripError(forward, inverse) < 1e-4f);
+	}
+
+	void ConcurrentRequests()
+	{
+		using namespace lmms;
+		constexpr int Threads = 8;
+		auto plans = std::vector<std::vector<FFTPlan>>(Threads);
+		auto threads = std::vector<std::thread>();
+		for (auto& threadPlans : plans)
+		{
+			threads.emplace_back([&threadPlans] {
+				for (int size = 32; size <= 8192; size *= 2)
+				{
+					threadPlans.push_back(FFTPlanCache::instance().plan(size, FFTPlanCache::Direction::Forward));
+				}
+			});
+		}
+		for (auto& thread : threads) { thread.join(); }
+
+		for (const auto& threadPlans : plans)
+		{
+			QCOMPARE(threadPlans.size(), plans[0].size());
+			for (std::size_t i = 0; i < threadPlans.size(); ++i)
+			{
+				QVERIFY(threadPlans[i].isValid());
+				QVERIFY(threadPlans[i] == plans[0][i]);
+			}
+		}
+	}
+
+	void BuffersAreAlignedAndZeroed()
+	{
+		using namespace lmms;
+		for (std::size_t size : {1, 3, 100, 4097})
+		{
+			const auto buffer = FFTBuffer<float>(size);
+			QCOMPARE(buffer.size(), size);
+			QCOMPARE(reinterpret_cast<std::uintptr_t>(buffer.data()) % 16, std::uintptr_t{0});
+			for (float value : buffer) { QCOMPARE(value, 0.f); }
+		}
+	}
+};
+
+QTEST_GUILESS_MAIN(FFTPlanCacheTest)
+#include "FFTPlanCacheTest.moc"
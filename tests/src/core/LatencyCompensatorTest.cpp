@@ -0,0 +1,132 @@
+/*
+ * LatencyCompensatorTest.cpp
+ *
+ * Copyright (c) 2026 LMMS Developers
+ *
+ * This file is part of LMMS - https://lmms.io
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public
+ * License along with this program (see COPYING); if not, write to the
+ * Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA 02110-1301 USA.
+ *
+ */
+
+#include <QtTest>
+
+#include <array>
+
+#include "LatencyCompensator.h"
+#include "SampleFrame.h"
+
+class LatencyCompensatorTest : public QObject
+{
+	Q_OBJECT
+private:
+	static constexpr lmms::fpp_t Frames = 64;
+
+	static void silence(std::array<lmms::SampleFrame, Frames>& buf)
+	{
+		lmms::zeroSampleFrames(buf.data(), Frames);
+	}
+
+	static void impulse(std::array<lmms::SampleFrame, Frames>& buf, lmms::fpp_t position)
+	{
+		silence(buf);
+		buf[position] = lmms::SampleFrame{1.f, -1.f};
+	}
+
+private slots:
+	void DelaysByWholePeriods()
+	{
+		using namespace lmms;
+		LatencyCompensator compensator;
+		compensator.setDelay(100);
+
+		auto buf = std::array<SampleFrame, Frames>{};
+		impulse(buf, 10);
+		QVERIFY(compensator.process(buf.data(), buf.data(), Frames, true));
+		QCOMPARE(buf[10].left(), 0.f);
+
+		// the impulse leaves the line 100 frames later, i.e. at frame 110 = 64 + 46
+		silence(buf);
+		QVERIFY(compensator.process(buf.data(), buf.data(), Frames, false));
+		for (fpp_t f = 0; f < Frames; ++f)
+		{
+			QCOMPARE(buf[f].left(), f == 46 ? 1.f : 0.f);
+			QCOMPARE(buf[f].right(), f == 46 ? -1.f : 0.f);
+		}
+	}
+
+	void StopsAfterTail()
+	{
+		using namespace lmms;
+		LatencyCompensator compensator;
+		compensator.setDelay(100);
+
+		auto in = std::array<SampleFrame, Frames>{};
+		auto out = std::array<SampleFrame, Frames>{};
+		impulse(in, 0);
+		QVERIFY(compensator.process(in.data(), out.data(), Frames, true));
+
+		// 100 frames of delay need two more periods to be played out
+		silence(in);
+		QVERIFY(compensator.process(in.data(), out.data(), Frames, false));
+		QVERIFY(compensator.process(in.data(), out.data(), Frames, false));
+		QVERIFY(!compensator.process(in.data(), out.data(), Frames, false));
+	}
+
+	void IgnoresInputWithoutSignal()
+	{
+		using namespace lmms;
+		LatencyCompensator compensator;
+		compensator.setDelay(10);
+
+		auto in = std::array<SampleFrame, Frames>{};
+		auto out = std::array<SampleFrame, Frames>{};
+		impulse(in, Frames - 5);
+		QVERIFY(compensator.process(in.data(), out.data(), Frames, true));
+
+		// the input buffer is left uncleared by silent senders, only the tail may be played out
+		impulse(in, 0);
+		QVERIFY(compensator.process(in.data(), out.data(), Frames, false));
+		for (fpp_t f = 0; f < Frames; ++f)
+		{
+			QCOMPARE(out[f].left(), f == 5 ? 1.f : 0.f);
+		}
+	}
+
+	void ZeroDelayPassesThrough()
+	{
+		using namespace lmms;
+		LatencyCompensator compensator;
+
+		auto in = std::array<SampleFrame, Frames>{};
+		auto out = std::array<SampleFrame, Frames>{};
+		impulse(in, 5);
+		QVERIFY(compensator.process(in.data(), out.data(), Frames, true));
+		QCOMPARE(out[5].left(), 1.f);
+		QVERIFY(!compensator.process(in.data(), out.data(), Frames, false));
+	}
+
+	void ClampsToMaxDelay()
+	{
+		using namespace lmms;
+		LatencyCompensator compensator;
+		compensator.setDelay(LatencyCompensator::MaxDelay + 1);
+		QCOMPARE(compensator.delay(), LatencyCompensator::MaxDelay);
+	}
+};
+
+QTEST_GUILESS_MAIN(LatencyCompensatorTest)
+#include "LatencyCompensatorTest.moc"
@@ -0,0 +1,145 @@
+/*
+ * Lv2ControlBaseTest.cpp
+ *
+ * Copyright (c) 2026 LMMS Developers
+ *
+ * This file is part of LMMS - https://lmms.io
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public
+ * License along with this program (see COPYING); if not, write to the
+ * Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA 02110-1301 USA.
+ *
+ */
+
+#include <QtTest>
+
+#include <memory>
+#include <vector>
+
+#include "Engine.h"
+#include "Lv2ControlBase.h"
+#include "Lv2Manager.h"
+#include "Model.h"
+#include "SampleFrame.h"
+
+namespace
+{
+
+//! Mono amplifier from the LV2 examples, run as two processors like every mono plugin
+constexpr auto AmpUri = "http://lv2plug.in/plugins/eg-amp";
+
+class Lv2Controls : public lmms::Model, public lmms::Lv2ControlBase
+{
+public:
+	Lv2Controls(const QString& uri) :
+		Model(nullptr),
+		Lv2ControlBase(this, uri)
+	{
+	}
+
+	using Lv2ControlBase::copyModelsFromLmms;
+	using Lv2ControlBase::runPlanar;
+};
+
+} // namespace
+
+class Lv2ControlBaseTest : public QObject
+{
+	Q_OBJECT
+private:
+	static constexpr lmms::fpp_t Frames = 256;
+
+	void requireAmp()
+	{
+		using namespace lmms;
+		if (!Engine::getLv2Manager()->getPlugin(QString(AmpUri)))
+		{
+			QSKIP("The eg-amp example plugin is not installed");
+		}
+	}
+
+private slots:
+	void initTestCase()
+	{
+		using namespace lmms;
+		Engine::init(true);
+	}
+
+	void cleanupTestCase()
+	{
+		using namespace lmms;
+		Engine::destroy();
+	}
+
+	//! Both channels must pass through their own processor of a mono plugin with unity gain
+	void RunPlanarKeepsChannelsApart()
+	{
+		using namespace lmms;
+		requireAmp();
+
+		Lv2Controls controls(AmpUri);
+		auto buffer = std::vector<SampleFrame>(Frames);
+		for (fpp_t f = 0; f < Frames; ++f)
+		{
+			buffer[f] = SampleFrame(0.5f, -0.25f);
+		}
+
+		controls.copyModelsFromLmms();
+		const auto out = controls.runPlanar(buffer.data(), Frames);
+		for (fpp_t f = 0; f < Frames; ++f)
+		{
+			QCOMPARE(out[0][f], 0.5f);
+			QCOMPARE(out[1][f], -0.25f);
+		}
+	}
+
+	//! Runs a chain of plugins with their ports connected directly to the planar buffers
+	void BenchmarkRunPlanar_data()
+	{
+		QTest::addColumn<int>("plugins");
+		QTest::newRow("1 plugin") << 1;
+		QTest::newRow("30 plugins") << 30;
+	}
+	void BenchmarkRunPlanar()
+	{
+		using namespace lmms;
+		QFETCH(int, plugins);
+		requireAmp();
+
+		auto chain = std::vector<std::unique_ptr<Lv2Controls>>{};
+		for (int p = 0; p < plugins; ++p)
+		{
+			chain.push_back(std::make_unique<Lv2Controls>(AmpUri));
+			chain.back()->copyModelsFromLmms();
+		}
+		auto buffer = std::vector<SampleFrame>(Frames, SampleFrame(0.5f, -0.25f));
+
+		QBENCHMARK
+		{
+			for (const auto& controls : chain)
+			{
+				// mix the output back like Lv2Effect does with a fully wet signal
+				const auto out = controls->runPlanar(buffer.data(), Frames);
+				for (fpp_t f = 0; f < Frames; ++f)
+				{
+					buffer[f][0] = out[0][f];
+					buffer[f][1] = out[1][f];
+				}
+			}
+		}
+	}
+};
+
+QTEST_GUILESS_MAIN(Lv2ControlBaseTest)
+#include "Lv2ControlBaseTest.moc"
@@ -0,0 +1,160 @@
+/*
+ * MidiInputQueueTest.cpp
+ *
+ * Copyright (c) 2026 LMMS Developers
+ *
+ * This file is part of LMMS - https://lmms.io
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public
+ * License along with this program (see COPYING); if not, write to the
+ * Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA 02110-1301 USA.
+ *
+ */
+
+#include <QtTest>
+
+#include <algorithm>
+#include <atomic>
+#include <thread>
+
+#include "MidiInputQueue.h"
+
+class MidiInputQueueTest : public QObject
+{
+	Q_OBJECT
+private:
+	using Clock = lmms::MidiInputQueue::Clock;
+
+	static constexpr lmms::sample_rate_t SampleRate = 48000;
+
+	static Clock::duration frames(double count)
+	{
+		return std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(count / SampleRate));
+	}
+
+private slots:
+	void OffsetFollowsArrivalTime()
+	{
+		using namespace lmms;
+		const auto start = Clock::time_point{} + std::chrono::seconds{1};
+		const auto period = MidiInputQueue::Period{start, 256, SampleRate};
+
+		QCOMPARE(MidiInputQueue::frameOffset(start - frames(10), period), f_cnt_t{0});
+		QCOMPARE(MidiInputQueue::frameOffset(start + frames(100.5), period), f_cnt_t{100});
+		// events arriving after a late period are played at its end
+		QCOMPARE(MidiInputQueue::frameOffset(start + frames(1000), period), f_cnt_t{255});
+		// without a previous period there is no reference
+		const auto first = MidiInputQueue::Period{Clock::time_point{}, 256, SampleRate};
+		QCOMPARE(MidiInputQueue::frameOffset(start, first), f_cnt_t{0});
+	}
+
+	void KeepsOrderUntilFull()
+	{
+		using namespace lmms;
+		auto queue = MidiInputQueue{4};
+		int pushed = 0;
+		while (queue.push(MidiEvent(MidiNoteOn, 0, pushed, 100), TimePos{})) { ++pushed; }
+		QVERIFY(pushed >= 4);
+
+		auto entry = MidiInputQueue::Entry{};
+		for (int key = 0; key < pushed; ++key)
+		{
+			QVERIFY(queue.pop(entry));
+			QCOMPARE(entry.event.key(), key);
+		}
+		QVERIFY(!queue.pop(entry));
+	}
+
+	/*! Sends events from a second thread at irregular times, as a MIDI loopback would, while periods are
+	 *  rendered at the pace of a device, and checks the latency of the events at the offsets they are played at.
+	 *
+	 *  A period starting d frames late makes the events of the next period d frames early, so the latency may
+	 *  only vary by the measured scheduling jitter of the period starts, not by the period length.
+	 */
+	void LoopbackJitter()
+	{
+		using namespace lmms;
+		constexpr fpp_t Frames = 256;
+		constexpr int Periods = 100;
+
+		auto queue = MidiInputQueue{};
+		std::atomic<bool> stop = false;
+		int sent = 0;
+		auto sender = std::thread{[&]
+		{
+			unsigned int random = 1;
+			while (!stop)
+			{
+				if (queue.push(MidiEvent{MidiNoteOn, 0, 60, 100}, TimePos{})) { ++sent; }
+				random = random * 1103515245 + 12345;
+				std::this_thread::sleep_for(std::chrono::microseconds{300 + (random >> 16) % 3000});
+			}
+		}};
+
+		const auto origin = Clock::now();
+		auto previousStart = Clock::time_point{};
+		double minDelay = 1e9, maxDelay = -1e9;
+		double minLatency = 1e9, maxLatency = -1e9, minLatencyAtBoundary = 1e9, maxLatencyAtBoundary = -1e9;
+		int received = 0;
+		auto lastTimestamp = Clock::time_point{};
+		for (int period = 0; period <= Periods; ++period)
+		{
+			if (period == Periods)
+			{
+				// the last period collects what is left
+				stop = true;
+				sender.join();
+			}
+			std::this_thread::sleep_until(origin + frames(period * Frames));
+
+			// as done by AudioEngine::renderNextBuffer()
+			const auto start = Clock::now();
+			const double delay = std::chrono::duration<double>(start - origin).count() * SampleRate - period * Frames;
+			minDelay = std::min(minDelay, delay);
+			maxDelay = std::max(maxDelay, delay);
+
+			auto entry = MidiInputQueue::Entry{};
+			while (queue.pop(entry))
+			{
+				++received;
+				QVERIFY(entry.timestamp >= lastTimestamp);
+				lastTimestamp = entry.timestamp;
+				if (period == 0) { continue; } // nothing to measure against yet
+
+				const double arrival = std::chrono::duration<double>(entry.timestamp - origin).count() * SampleRate;
+				const auto offset = MidiInputQueue::frameOffset(entry.timestamp, {previousStart, Frames, SampleRate});
+				QVERIFY(offset < Frames);
+				// the position in the output stream, which runs at a constant rate
+				const double played = static_cast<double>(period) * Frames + offset;
+				minLatency = std::min(minLatency, played - arrival);
+				maxLatency = std::max(maxLatency, played - arrival);
+				minLatencyAtBoundary = std::min(minLatencyAtBoundary, period * Frames - arrival);
+				maxLatencyAtBoundary = std::max(maxLatencyAtBoundary, period * Frames - arrival);
+			}
+			previousStart = start;
+		}
+
+		QCOMPARE(received, sent);
+		QVERIFY(sent > Periods);
+		qInfo("period start jitter: %.1f frames, latency jitter: %.1f frames, at the period boundary: %.1f frames",
+			maxDelay - minDelay, maxLatency - minLatency, maxLatencyAtBoundary - minLatencyAtBoundary);
+		// playing everything at the period boundary jitters by about a whole period
+		QVERIFY(maxLatencyAtBoundary - minLatencyAtBoundary > Frames / 2);
+		// with timestamps, only the jitter of the period starts remains, plus rounding the offsets down
+		QVERIFY(maxLatency - minLatency <= maxDelay - minDelay + 2);
+	}
+};
+
+QTEST_GUILESS_MAIN(MidiInputQueueTest)
+#include "MidiInputQueueTest.moc"
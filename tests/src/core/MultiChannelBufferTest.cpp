@@ -0,0 +1,150 @@
+/*
+ * MultiChannelBufferTest.cpp
+ *
+ * Copyright (c) 2026 LMMS Developers
+ *
+ * This file is part of LMMS - https://lmms.io
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public
+ * License along with this program (see COPYING); if not, write to the
+ * Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA 02110-1301 USA.
+ *
+ */
+
+#include <QtTest>
+
+#include <vector>
+
+#include "MixHelpers.h"
+#include "MultiChannelBuffer.h"
+#include "SampleFrame.h"
+
+class MultiChannelBufferTest : public QObject
+{
+	Q_OBJECT
+private:
+	static constexpr lmms::fpp_t Frames = 256;
+
+	void addLayoutRows()
+	{
+		using namespace lmms;
+		QTest::addColumn<int>("channels");
+		QTest::newRow("stereo") << static_cast<int>(channelCount(ChannelLayout::Stereo));
+		QTest::newRow("quad") << static_cast<int>(channelCount(ChannelLayout::Quad));
+		QTest::newRow("5.1") << static_cast<int>(channelCount(ChannelLayout::Surround51));
+		QTest::newRow("7.1") << static_cast<int>(channelCount(ChannelLayout::Surround71));
+		QTest::newRow("3 channels (generic)") << 3;
+	}
+
+	static std::vector<lmms::SampleFrame> ramp()
+	{
+		auto frames = std::vector<lmms::SampleFrame>(Frames);
+		for (lmms::fpp_t f = 0; f < Frames; ++f)
+		{
+			frames[f] = lmms::SampleFrame(f * 0.001f, -f * 0.002f);
+		}
+		return frames;
+	}
+
+private slots:
+	//! Speaker pairs skip center and LFE, so "rear" is rear in every layout, and unknown pairs fall back to the front
+	void MapsSpeakerPairsToLayout()
+	{
+		using namespace lmms;
+		QCOMPARE(speakerPairCount(ChannelLayout::Stereo), 1);
+		QCOMPARE(speakerPairOffset(ChannelLayout::Stereo, 1), ch_cnt_t{0});
+
+		QCOMPARE(speakerPairCount(ChannelLayout::Quad), 2);
+		QCOMPARE(speakerPairOffset(ChannelLayout::Quad, 1), ch_cnt_t{2});
+
+		QCOMPARE(speakerPairCount(ChannelLayout::Surround51), 2);
+		QCOMPARE(speakerPairOffset(ChannelLayout::Surround51, 1), ch_cnt_t{4});
+		QCOMPARE(speakerPairOffset(ChannelLayout::Surround51, 2), ch_cnt_t{0});
+
+		QCOMPARE(speakerPairCount(ChannelLayout::Surround71), 3);
+		QCOMPARE(speakerPairOffset(ChannelLayout::Surround71, 1), ch_cnt_t{4});
+		QCOMPARE(speakerPairOffset(ChannelLayout::Surround71, 2), ch_cnt_t{6});
+	}
+
+	//! Each pair has to end up at its own speakers, added to what they held before, and leave the others alone
+	void AddsPairToItsSpeakers_data() { addLayoutRows(); }
+	void AddsPairToItsSpeakers()
+	{
+		using namespace lmms;
+		QFETCH(int, channels);
+
+		const auto src = ramp();
+		for (int first = 0; first + 1 < channels; first += 2)
+		{
+			auto bus = MultiChannelBuffer(static_cast<ch_cnt_t>(channels), Frames);
+			std::fill_n(bus.data(), bus.samples(), 1.f);
+			MixHelpers::addToBus(bus, static_cast<ch_cnt_t>(first), src.data(), 0.5f, Frames);
+
+			for (fpp_t f = 0; f < Frames; ++f)
+			{
+				for (int channel = 0; channel < channels; ++channel)
+				{
+					const float expected = channel == first ? 1.f + src[f].left() * 0.5f
+						: channel == first + 1 ? 1.f + src[f].right() * 0.5f
+						: 1.f;
+					QCOMPARE(bus.frame(f)[channel], expected);
+				}
+			}
+		}
+	}
+
+	void DownmixesToMono()
+	{
+		using namespace lmms;
+		const auto src = ramp();
+		auto bus = MultiChannelBuffer(channelCount(ChannelLayout::Mono), Frames);
+		bus.clear();
+		MixHelpers::addToBus(bus, 0, src.data(), 2.f, Frames);
+		for (fpp_t f = 0; f < Frames; ++f)
+		{
+			QCOMPARE(bus.data()[f], src[f].left() + src[f].right());
+		}
+	}
+
+	void FramesViewMatchesBuffer()
+	{
+		using namespace lmms;
+		auto bus = MultiChannelBuffer(channelCount(ChannelLayout::Surround51), Frames);
+		bus.clear();
+		bus.frames<6>()[3][4] = 1.f;
+		QCOMPARE(bus.frame(3)[4], 1.f);
+		QCOMPARE(bus.data()[3 * 6 + 4], 1.f);
+	}
+
+	void BenchmarkAddToBus_data() { addLayoutRows(); }
+	void BenchmarkAddToBus()
+	{
+		using namespace lmms;
+		QFETCH(int, channels);
+
+		const auto src = ramp();
+		auto bus = MultiChannelBuffer(static_cast<ch_cnt_t>(channels), Frames);
+		bus.clear();
+		QBENCHMARK
+		{
+			for (int first = 0; first + 1 < channels; first += 2)
+			{
+				MixHelpers::addToBus(bus, static_cast<ch_cnt_t>(first), src.data(), 0.5f, Frames);
+			}
+		}
+	}
+};
+
+QTEST_GUILESS_MAIN(MultiChannelBufferTest)
+#include "MultiChannelBufferTest.moc"
@@ -0,0 +1,280 @@
+/*
+ * OscillatorTest.cpp
+ *
+ * Copyright (c) 2026 LMMS Developers
+ *
+ * This file is part of LMMS - https://lmms.io
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public
+ * License along with this program (see COPYING); if not, write to the
+ * Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA 02110-1301 USA.
+ *
+ */
+
+#include <QtTest>
+
+#include <memory>
+#include <vector>
+
+#include "AutomatableModel.h"
+#include "Engine.h"
+#include "Oscillator.h"
+#include "OscillatorBank.h"
+
+class OscillatorTest : public QObject
+{
+	Q_OBJECT
+private:
+	static constexpr lmms::fpp_t Frames = 256;
+
+	void addWaveShapeRows()
+	{
+		using namespace lmms;
+		QTest::addColumn<int>("waveShape");
+		QTest::addColumn<bool>("useWaveTable");
+
+		const char* names[] = {"sine", "triangle", "saw", "square", "moogsaw", "exponential"};
+		for (int shape = 0; shape <= static_cast<int>(Oscillator::WaveShape::Exponential); ++shape)
+		{
+			QTest::newRow(names[shape]) << shape << false;
+			QTest::newRow(QByteArray(names[shape]) + " (wavetable)") << shape << true;
+		}
+	}
+
+	void addVoiceCountRows()
+	{
+		QTest::addColumn<int>("voices");
+		for (int voices : {1, 8, 32, 64})
+		{
+			QTest::newRow(QByteArray::number(voices) + " voices") << voices;
+		}
+	}
+
+private slots:
+	void initTestCase()
+	{
+		using namespace lmms;
+		Engine::init(true);
+	}
+
+	void cleanupTestCase()
+	{
+		using namespace lmms;
+		Engine::destroy();
+	}
+
+	//! The single pass stereo rendering must produce the same output as rendering both channels separately
+	void StereoMatchesMono_data() { addWaveShapeRows(); }
+	void StereoMatchesMono()
+	{
+		using namespace lmms;
+		QFETCH(int, waveShape);
+		QFETCH(bool, useWaveTable);
+
+		IntModel shapeModel(waveShape, 0, Oscillator::NumWaveShapes - 1);
+		IntModel algoModel(static_cast<int>(Oscillator::ModulationAlgo::PhaseModulation), 0,
+			Oscillator::NumModulationAlgos - 1);
+		const float freq = 440.f;
+		const float detuningLeft = 1.f / Engine::audioEngine()->outputSampleRate();
+		const float detuningRight = 1.003f / Engine::audioEngine()->outputSampleRate();
+		const float phaseLeft = 0.25f, phaseRight = 0.f, volume = 0.5f;
+
+		auto makePair = [&](Oscillator*& left, Oscillator*& right)
+		{
+			left = new Oscillator(&shapeModel, &algoModel, freq, detuningLeft, phaseLeft, volume,
+				new Oscillator(&shapeModel, &algoModel, freq, detuningLeft, phaseLeft, volume));
+			right = new Oscillator(&shapeModel, &algoModel, freq, detuningRight, phaseRight, volume,
+				new Oscillator(&shapeModel, &algoModel, freq, detuningRight, phaseRight, volume));
+			left->setUseWaveTable(useWaveTable);
+			right->setUseWaveTable(useWaveTable);
+		};
+
+		Oscillator *monoLeft, *monoRight, *stereoLeft, *stereoRight;
+		makePair(monoLeft, monoRight);
+		makePair(stereoLeft, stereoRight);
+
+		auto mono = std::vector<SampleFrame>(Frames);
+		auto stereo = std::vector<SampleFrame>(Frames);
+		// render an odd number of frames first so that the following periods do not start on a block boundary
+		for (fpp_t frames : {Frames - 3, Frames, Frames})
+		{
+			monoLeft->update(mono.data(), frames, 0);
+			monoRight->update(mono.data(), frames, 1);
+			Oscillator::updateStereo(stereoLeft, stereoRight, stereo.data(), frames);
+			for (fpp_t f = 0; f < frames; ++f)
+			{
+				QCOMPARE(stereo[f].left(), mono[f].left());
+				QCOMPARE(stereo[f].right(), mono[f].right());
+			}
+		}
+
+		delete monoLeft;
+		delete monoRight;
+		delete stereoLeft;
+		delete stereoRight;
+	}
+
+	void BenchmarkMono_data() { addWaveShapeRows(); }
+	void BenchmarkMono()
+	{
+		using namespace lmms;
+		QFETCH(int, waveShape);
+		QFETCH(bool, useWaveTable);
+
+		IntModel shapeModel(waveShape, 0, Oscillator::NumWaveShapes - 1);
+		IntModel algoModel(static_cast<int>(Oscillator::ModulationAlgo::SignalMix), 0,
+			Oscillator::NumModulationAlgos - 1);
+		const float freq = 440.f, phase = 0.f, volume = 0.5f;
+		const float detuning = 1.f / Engine::audioEngine()->outputSampleRate();
+		Oscillator left(&shapeModel, &algoModel, freq, detuning, phase, volume);
+		Oscillator right(&shapeModel, &algoModel, freq, detuning, phase, volume);
+		left.setUseWaveTable(useWaveTable);
+		right.setUseWaveTable(useWaveTable);
+
+		auto buffer = std::vector<SampleFrame>(Frames);
+		QBENCHMARK
+		{
+			left.update(buffer.data(), Frames, 0);
+			right.update(buffer.data(), Frames, 1);
+		}
+	}
+
+	void BenchmarkStereo_data() { addWaveShapeRows(); }
+	void BenchmarkStereo()
+	{
+		using namespace lmms;
+		QFETCH(int, waveShape);
+		QFETCH(bool, useWaveTable);
+
+		IntModel shapeModel(waveShape, 0, Oscillator::NumWaveShapes - 1);
+		IntModel algoModel(static_cast<int>(Oscillator::ModulationAlgo::SignalMix), 0,
+			Oscillator::NumModulationAlgos - 1);
+		const float freq = 440.f, phase = 0.f, volume = 0.5f;
+		const float detuning = 1.f / Engine::audioEngine()->outputSampleRate();
+		Oscillator left(&shapeModel, &algoModel, freq, detuning, phase, volume);
+		Oscillator right(&shapeModel, &algoModel, freq, detuning, phase, volume);
+		left.setUseWaveTable(useWaveTable);
+		right.setUseWaveTable(useWaveTable);
+
+		auto buffer = std::vector<SampleFrame>(Frames);
+		QBENCHMARK
+		{
+			Oscillator::updateStereo(&left, &right, buffer.data(), Frames);
+		}
+	}
+
+	//! A bank must render every voice like a separate oscillator with the same settings
+	void BankMatchesOscillators_data() { addWaveShapeRows(); }
+	void BankMatchesOscillators()
+	{
+		using namespace lmms;
+		QFETCH(int, waveShape);
+		QFETCH(bool, useWaveTable);
+
+		IntModel shapeModel(waveShape, 0, Oscillator::NumWaveShapes - 1);
+		IntModel algoModel(static_cast<int>(Oscillator::ModulationAlgo::SignalMix), 0,
+			Oscillator::NumModulationAlgos - 1);
+		const float detuning = 1.f / Engine::audioEngine()->outputSampleRate();
+		const auto freqs = std::vector<float>{110.f, 440.f, 1234.5f};
+		const auto phases = std::vector<float>{0.f, 0.25f, 0.7f};
+		const auto volumes = std::vector<float>{1.f, 0.5f, 0.25f};
+
+		auto oscs = std::vector<std::unique_ptr<Oscillator>>{};
+		auto bank = OscillatorBank(static_cast<Oscillator::WaveShape>(waveShape), useWaveTable);
+		auto expected = std::vector<std::vector<SampleFrame>>{};
+		auto actual = std::vector<std::vector<SampleFrame>>{};
+		auto buffers = std::vector<SampleFrame*>{};
+		for (std::size_t v = 0; v < freqs.size(); ++v)
+		{
+			oscs.push_back(std::make_unique<Oscillator>(&shapeModel, &algoModel, freqs[v], detuning, phases[v],
+				volumes[v]));
+			oscs.back()->setUseWaveTable(useWaveTable);
+			bank.setPhaseIncrement(bank.addVoice(phases[v], volumes[v]), freqs[v] * detuning);
+			expected.emplace_back(Frames);
+			actual.emplace_back(Frames);
+		}
+		for (auto& buffer : actual) { buffers.push_back(buffer.data()); }
+
+		// render an odd number of frames first so that the following periods do not start on a block boundary
+		for (fpp_t frames : {Frames - 3, Frames, Frames})
+		{
+			bank.update(buffers.data(), frames, 0);
+			for (std::size_t v = 0; v < oscs.size(); ++v)
+			{
+				oscs[v]->update(expected[v].data(), frames, 0);
+				for (fpp_t f = 0; f < frames; ++f)
+				{
+					QCOMPARE(actual[v][f].left(), expected[v][f].left());
+				}
+			}
+		}
+	}
+
+	//! Renders one oscillator per voice, like an instrument without a voice bank
+	void BenchmarkVoices_data() { addVoiceCountRows(); }
+	void BenchmarkVoices()
+	{
+		using namespace lmms;
+		QFETCH(int, voices);
+
+		IntModel shapeModel(static_cast<int>(Oscillator::WaveShape::Saw), 0, Oscillator::NumWaveShapes - 1);
+		IntModel algoModel(static_cast<int>(Oscillator::ModulationAlgo::SignalMix), 0,
+			Oscillator::NumModulationAlgos - 1);
+		const float detuning = 1.f / Engine::audioEngine()->outputSampleRate();
+		const float phase = 0.f, volume = 0.5f;
+		auto freqs = std::vector<float>(voices);
+		auto oscs = std::vector<std::unique_ptr<Oscillator>>{};
+		auto buffers = std::vector<std::vector<SampleFrame>>(voices, std::vector<SampleFrame>(Frames));
+		for (int v = 0; v < voices; ++v)
+		{
+			freqs[v] = 110.f + 10.f * v;
+			oscs.push_back(std::make_unique<Oscillator>(&shapeModel, &algoModel, freqs[v], detuning, phase, volume));
+			oscs.back()->setUseWaveTable(true);
+		}
+
+		QBENCHMARK
+		{
+			for (int v = 0; v < voices; ++v)
+			{
+				oscs[v]->update(buffers[v].data(), Frames, 0);
+			}
+		}
+	}
+
+	//! Renders the same voices as BenchmarkVoices with a single voice bank
+	void BenchmarkBank_data() { addVoiceCountRows(); }
+	void BenchmarkBank()
+	{
+		using namespace lmms;
+		QFETCH(int, voices);
+
+		const float detuning = 1.f / Engine::audioEngine()->outputSampleRate();
+		auto bank = OscillatorBank(Oscillator::WaveShape::Saw, true);
+		auto buffers = std::vector<std::vector<SampleFrame>>(voices, std::vector<SampleFrame>(Frames));
+		auto bufferPointers = std::vector<SampleFrame*>{};
+		for (int v = 0; v < voices; ++v)
+		{
+			bank.setPhaseIncrement(bank.addVoice(0.f, 0.5f), (110.f + 10.f * v) * detuning);
+			bufferPointers.push_back(buffers[v].data());
+		}
+
+		QBENCHMARK
+		{
+			bank.update(bufferPointers.data(), Frames, 0);
+		}
+	}
+};
+
+QTEST_GUILESS_MAIN(OscillatorTest)
+#include "OscillatorTest.moc"
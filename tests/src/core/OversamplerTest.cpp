@@ -0,0 +1,184 @@
+/*
+ * OversamplerTest.cpp
+ *
+ * Copyright (c) 2026 LMMS Developers
+ *
+ * This file is part of LMMS - https://lmms.io
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public
+ * License along with this program (see COPYING); if not, write to the
+ * Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA 02110-1301 USA.
+ *
+ */
+
+
+#include <QtTest>
+
+#include <cmath>
+#include <numbers>
+#include <vector>
+
+#include "Oversampler.h"
+
+Q_DECLARE_METATYPE(lmms::Oversampler::Phase)
+
+class OversamplerTest : public QObject
+{
+	Q_OBJECT
+private:
+	static constexpr lmms::fpp_t Frames = 256;
+	static constexpr float SampleRate = 48000.f;
+
+	void addFactorRows(bool withPassthrough = false)
+	{
+		using lmms::Oversampler;
+		QTest::addColumn<int>("factor");
+		QTest::addColumn<Oversampler::Phase>("phase");
+
+		if (withPassthrough) { QTest::newRow("1x") << 1 << Oversampler::Phase::Linear; }
+		for (int factor : {2, 4, 8})
+		{
+			QTest::newRow(qPrintable(QString("%1x linear").arg(factor))) << factor << Oversampler::Phase::Linear;
+			QTest::newRow(qPrintable(QString("%1x minimum").arg(factor))) << factor << Oversampler::Phase::Minimum;
+		}
+	}
+
+	//! Runs a sine of @p freq through @p periods periods of upsampling and downsampling
+	static std::vector<lmms::SampleFrame> roundTrip(lmms::Oversampler& oversampler, float freq, int periods)
+	{
+		using namespace lmms;
+		auto buffer = std::vector<SampleFrame>(Frames * periods);
+		for (f_cnt_t f = 0; f < buffer.size(); ++f)
+		{
+			const auto s = static_cast<float>(std::sin(2 * std::numbers::pi * freq * f / SampleRate));
+			buffer[f] = SampleFrame(s, s);
+		}
+		for (int period = 0; period < periods; ++period)
+		{
+			oversampler.process(buffer.data() + period * Frames, Frames, [](SampleFrame*, fpp_t) {});
+		}
+		return buffer;
+	}
+
+private slots:
+	void FactorOneIsPassthrough()
+	{
+		using namespace lmms;
+		auto oversampler = Oversampler(Frames);
+		QCOMPARE(oversampler.latency(), f_cnt_t{0});
+
+		const auto buffer = roundTrip(oversampler, 1000.f, 1);
+		for (f_cnt_t f = 0; f < Frames; ++f)
+		{
+			const auto s = static_cast<float>(std::sin(2 * std::numbers::pi * 1000.f * f / SampleRate));
+			QCOMPARE(buffer[f].left(), s);
+		}
+	}
+
+	//! After the reported latency the output has to match the input for frequencies well inside the passband
+	void DelaysByLatency_data() { addFactorRows(); }
+	void DelaysByLatency()
+	{
+		using namespace lmms;
+		QFETCH(int, factor);
+		QFETCH(Oversampler::Phase, phase);
+
+		auto oversampler = Oversampler(Frames, factor, phase);
+		const f_cnt_t latency = oversampler.latency();
+		const auto buffer = roundTrip(oversampler, 500.f, 8);
+		for (f_cnt_t f = Frames * 4; f < buffer.size(); ++f)
+		{
+			const auto expected = static_cast<float>(std::sin(2 * std::numbers::pi * 500.f * (f - latency) / SampleRate));
+			QVERIFY(std::abs(buffer[f].left() - expected) < 0.05f);
+			QCOMPARE(buffer[f].left(), buffer[f].right());
+		}
+	}
+
+	void PreservesPassband_data() { addFactorRows(); }
+	void PreservesPassband()
+	{
+		using namespace lmms;
+		QFETCH(int, factor);
+		QFETCH(Oversampler::Phase, phase);
+
+		for (float freq : {1000.f, 15000.f})
+		{
+			auto oversampler = Oversampler(Frames, factor, phase);
+			const auto buffer = roundTrip(oversampler, freq, 16);
+			double power = 0.;
+			for (f_cnt_t f = Frames * 4; f < buffer.size(); ++f)
+			{
+				power += buffer[f].left() * buffer[f].left();
+			}
+			const double gain = 10. * std::log10(power / (buffer.size() - Frames * 4) * 2.);
+			QVERIFY(std::abs(gain) < 0.05);
+		}
+	}
+
+	//! Content above the engine's Nyquist frequency must not fold back into the output
+	void RejectsAliases_data() { addFactorRows(); }
+	void RejectsAliases()
+	{
+		using namespace lmms;
+		QFETCH(int, factor);
+		QFETCH(Oversampler::Phase, phase);
+
+		auto oversampler = Oversampler(Frames, factor, phase);
+		auto buffer = std::vector<SampleFrame>(Frames);
+		const double increment = 2 * std::numbers::pi * 0.6 / factor;
+		double sinePhase = 0.;
+		double power = 0.;
+		for (int period = 0; period < 16; ++period)
+		{
+			oversampler.process(buffer.data(), Frames, [&](SampleFrame* upsampled, fpp_t frames)
+			{
+				for (fpp_t f = 0; f < frames; ++f, sinePhase += increment)
+				{
+					const auto s = static_cast<float>(std::sin(sinePhase));
+					upsampled[f] = SampleFrame(s, s);
+				}
+			});
+			if (period >= 4)
+			{
+				for (const auto& frame : buffer) { power += frame.left() * frame.left(); }
+			}
+		}
+		const double level = 10. * std::log10(power / (Frames * 12) * 2.);
+		QVERIFY(level < -80.);
+	}
+
+	void BenchmarkProcess_data() { addFactorRows(true); }
+	void BenchmarkProcess()
+	{
+		using namespace lmms;
+		QFETCH(int, factor);
+		QFETCH(Oversampler::Phase, phase);
+
+		auto oversampler = Oversampler(Frames, factor, phase);
+		auto buffer = roundTrip(oversampler, 1000.f, 1);
+		QBENCHMARK
+		{
+			oversampler.process(buffer.data(), Frames, [](SampleFrame* upsampled, fpp_t frames)
+			{
+				for (fpp_t f = 0; f < frames; ++f)
+				{
+					upsampled[f] = SampleFrame(std::tanh(upsampled[f].left() * 4.f), std::tanh(upsampled[f].right() * 4.f));
+				}
+			});
+		}
+	}
+};
+
+QTEST_GUILESS_MAIN(OversamplerTest)
+#include "OversamplerTest.moc"
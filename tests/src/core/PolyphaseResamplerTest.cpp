@@ -0,0 +1,124 @@
+/*
+ * PolyphaseResamplerTest.cpp
+ *
+ * Copyright (c) 2026 LMMS Developers
+ *
+ * This file is part of LMMS - https://lmms.io
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public
+ * License along with this program (see COPYING); if not, write to the
+ * Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA 02110-1301 USA.
+ *
+ */
+
+
+#include <QtTest>
+
+#include <cmath>
+#include <numbers>
+#include <vector>
+
+#include "PolyphaseResampler.h"
+#include "SampleFrame.h"
+
+class PolyphaseResamplerTest : public QObject
+{
+	Q_OBJECT
+private:
+	static constexpr lmms::f_cnt_t Frames = 256;
+
+	static void addRatioRows()
+	{
+		QTest::addColumn<int>("inRate");
+		QTest::addColumn<int>("outRate");
+		QTest::newRow("48000 -> 44100") << 48000 << 44100;
+		QTest::newRow("44100 -> 48000") << 44100 << 48000;
+		QTest::newRow("192000 -> 88200") << 192000 << 88200;
+		QTest::newRow("96000 -> 48000") << 96000 << 48000;
+	}
+
+private slots:
+	//! Over many periods, the number of output frames must follow the ratio exactly
+	void KeepsRatio_data() { addRatioRows(); }
+	void KeepsRatio()
+	{
+		using namespace lmms;
+		QFETCH(int, inRate);
+		QFETCH(int, outRate);
+		PolyphaseResampler resampler(inRate, outRate);
+
+		auto in = std::vector<SampleFrame>(Frames);
+		auto out = std::vector<SampleFrame>(resampler.maxOutputFrames(Frames));
+		const f_cnt_t periods = 200;
+		f_cnt_t total = 0;
+		for (f_cnt_t p = 0; p < periods; ++p)
+		{
+			const f_cnt_t written = resampler.process(in.data(), Frames, out.data());
+			QVERIFY(written <= resampler.maxOutputFrames(Frames));
+			total += written;
+		}
+		const double expected = static_cast<double>(periods * Frames) * outRate / inRate;
+		QVERIFY(std::abs(total - expected) <= 1.0);
+	}
+
+	void PassesDc_data() { addRatioRows(); }
+	void PassesDc()
+	{
+		using namespace lmms;
+		QFETCH(int, inRate);
+		QFETCH(int, outRate);
+		PolyphaseResampler resampler(inRate, outRate);
+
+		auto in = std::vector<SampleFrame>(Frames, SampleFrame{0.5f, -0.25f});
+		auto out = std::vector<SampleFrame>(resampler.maxOutputFrames(Frames));
+		resampler.process(in.data(), Frames, out.data());
+		const f_cnt_t written = resampler.process(in.data(), Frames, out.data());
+		for (f_cnt_t f = 0; f < written; ++f)
+		{
+			QVERIFY(std::abs(out[f].left() - 0.5f) < 1e-4f);
+			QVERIFY(std::abs(out[f].right() + 0.25f) < 1e-4f);
+		}
+	}
+
+	//! A tone well below both Nyquist frequencies must keep its level
+	void PassesLowTone_data() { addRatioRows(); }
+	void PassesLowTone()
+	{
+		using namespace lmms;
+		QFETCH(int, inRate);
+		QFETCH(int, outRate);
+		PolyphaseResampler resampler(inRate, outRate);
+
+		const double freq = 1000.0;
+		auto in = std::vector<SampleFrame>(Frames);
+		auto out = std::vector<SampleFrame>(resampler.maxOutputFrames(Frames));
+		f_cnt_t pos = 0;
+		float peak = 0.f;
+		for (int p = 0; p < 20; ++p)
+		{
+			for (auto& frame : in)
+			{
+				frame = SampleFrame{static_cast<float>(std::sin(2 * std::numbers::pi * freq * pos++ / inRate))};
+			}
+			const f_cnt_t written = resampler.process(in.data(), Frames, out.data());
+			// skip the transient at the start
+			if (p < 2) { continue; }
+			for (f_cnt_t f = 0; f < written; ++f) { peak = std::max(peak, std::abs(out[f].left())); }
+		}
+		QVERIFY(std::abs(peak - 1.f) < 0.01f);
+	}
+};
+
+QTEST_GUILESS_MAIN(PolyphaseResamplerTest)
+#include "PolyphaseResamplerTest.moc"
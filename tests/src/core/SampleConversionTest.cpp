@@ -0,0 +1,140 @@
+/*
+ * SampleConversionTest.cpp
+ *
+ * Copyright (c) 2026 LMMS Developers
+ *
+ * This file is part of LMMS - https://lmms.io
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public
+ * License along with this program (see COPYING); if not, write to the
+ * Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA 02110-1301 USA.
+ *
+ */
+
+#include <QtTest>
+
+#include <cmath>
+#include <vector>
+
+#include "SampleConversion.h"
+#include "SampleFrame.h"
+
+class SampleConversionTest : public QObject
+{
+	Q_OBJECT
+private slots:
+	//! Integer conversions must round to the nearest value and clip to the target range
+	void RoundsAndClips()
+	{
+		using namespace lmms;
+		const auto input = std::vector<SampleFrame>{{0.f, 1.f}, {-1.f, 2.f}, {-2.f, 0.6f / 32767.f},
+			{1.4f / 32767.f, -1.6f / 32767.f}};
+		const auto frames = input.size();
+
+		auto s16 = std::vector<std::int16_t>(frames * 2);
+		SampleConversion::toS16(input.data(), s16.data(), frames);
+		QCOMPARE(s16, (std::vector<std::int16_t>{0, 32767, -32767, 32767, -32768, 1, 1, -2}));
+
+		auto s24 = std::vector<std::int32_t>(frames * 2);
+		SampleConversion::toS24(input.data(), s24.data(), frames);
+		QCOMPARE(s24[1], 8388607);
+		QCOMPARE(s24[2], -8388607);
+		QCOMPARE(s24[4], -8388608);
+
+		auto s32 = std::vector<std::int32_t>(frames * 2);
+		SampleConversion::toS32(input.data(), s32.data(), frames);
+		// the largest float below 2^31
+		QCOMPARE(s32[1], 2147483520);
+		QCOMPARE(s32[3], 2147483520);
+		QCOMPARE(s32[4], -2147483647 - 1);
+	}
+
+	//! TPDF dither must stay within one LSB, have no DC offset and make quantization of tiny signals linear
+	void DitherIsTriangular()
+	{
+		using namespace lmms;
+		constexpr auto Count = lmms::f_cnt_t{1 << 16};
+		auto dither = SampleConversion::TpdfDither{};
+		auto noise = std::vector<float>(Count);
+		dither.generate(noise.data(), Count);
+
+		auto sum = 0.0;
+		auto inner = 0;
+		for (const auto value : noise)
+		{
+			QVERIFY(value > -1.f && value < 1.f);
+			sum += value;
+			if (std::abs(value) < 0.5f) { ++inner; }
+		}
+		QVERIFY(std::abs(sum / Count) < 0.01);
+		// three quarters of a triangular distribution lie within half its width
+		QVERIFY(std::abs(static_cast<double>(inner) / Count - 0.75) < 0.01);
+
+		// a constant a quarter LSB above zero rounds to zero without dither, but averages to it with dither
+		const auto input = std::vector<SampleFrame>(Count / 2, SampleFrame{0.25f / 32767.f});
+		auto output = std::vector<std::int16_t>(Count);
+		SampleConversion::toS16(input.data(), output.data(), input.size(), &dither);
+		auto outputSum = 0.0;
+		for (const auto value : output) { outputSum += value; }
+		QVERIFY(std::abs(outputSum / Count - 0.25) < 0.02);
+	}
+
+	void SplitsIntoPlanarBuffers()
+	{
+		using namespace lmms;
+		const auto input = std::vector<SampleFrame>{{1.f, -1.f}, {2.f, -2.f}, {3.f, -3.f}};
+		auto left = std::vector<float>(3);
+		auto right = std::vector<float>(3);
+		float* planar[] = {left.data(), right.data()};
+		SampleConversion::toPlanar(input.data(), planar, input.size());
+		QCOMPARE(left, (std::vector<float>{1.f, 2.f, 3.f}));
+		QCOMPARE(right, (std::vector<float>{-1.f, -2.f, -3.f}));
+	}
+
+	void SwapsEndianness()
+	{
+		using namespace lmms;
+		const auto input = std::vector<SampleFrame>{{1.f, -1.f}};
+		auto s16 = std::vector<std::int16_t>(2);
+		SampleConversion::convert(input.data(), s16.data(), 1, SampleConversion::Format::S16, nullptr, true);
+		QCOMPARE(s16[0], static_cast<std::int16_t>(0xff7f));
+		QCOMPARE(s16[1], static_cast<std::int16_t>(0x0180));
+
+		auto s32 = std::vector<std::int32_t>(2);
+		SampleConversion::convert(input.data(), s32.data(), 1, SampleConversion::Format::S32, nullptr, true);
+		QCOMPARE(s32[0], static_cast<std::int32_t>(0x80ffff7f));
+	}
+
+	void BenchmarkToS16()
+	{
+		using namespace lmms;
+		auto input = std::vector<SampleFrame>(1024);
+		for (auto i = std::size_t{0}; i < input.size(); ++i) { input[i] = SampleFrame{std::sin(i * 0.01f)}; }
+		auto output = std::vector<std::int16_t>(input.size() * 2);
+		QBENCHMARK { SampleConversion::toS16(input.data(), output.data(), input.size()); }
+	}
+
+	void BenchmarkToS16Dithered()
+	{
+		using namespace lmms;
+		auto input = std::vector<SampleFrame>(1024);
+		for (auto i = std::size_t{0}; i < input.size(); ++i) { input[i] = SampleFrame{std::sin(i * 0.01f)}; }
+		auto output = std::vector<std::int16_t>(input.size() * 2);
+		auto dither = SampleConversion::TpdfDither{};
+		QBENCHMARK { SampleConversion::toS16(input.data(), output.data(), input.size(), &dither); }
+	}
+};
+
+QTEST_GUILESS_MAIN(SampleConversionTest)
+#include "SampleConversionTest.moc"
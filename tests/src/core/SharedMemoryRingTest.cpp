@@ -0,0 +1,174 @@
+/*
+ * SharedMemoryRingTest.cpp
+ *
+ * Copyright (c) 2026 LMMS Developers
+ *
+ * This file is part of LMMS - https://lmms.io
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public
+ * License along with this program (see COPYING); if not, write to the
+ * Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA 02110-1301 USA.
+ *
+ */
+
+#include <QtTest>
+
+#include <csignal>
+#include <future>
+#include <memory>
+#include <numeric>
+#include <thread>
+#include <vector>
+
+#include <sys/socket.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include "SharedMemoryRing.h"
+
+class SharedMemoryRingTest : public QObject
+{
+	Q_OBJECT
+private:
+	static constexpr int Quit = -1;
+
+	//! Runs a dummy remote client that answers every int with the same int
+	template<typename Read, typename Write>
+	static std::thread startEchoClient(Read read, Write write)
+	{
+		return std::thread{[=]() mutable
+		{
+			int value = 0;
+			while (read(&value) && value != Quit)
+			{
+				write(&value);
+			}
+		}};
+	}
+
+private slots:
+	void TransfersMoreThanCapacity()
+	{
+		using namespace lmms;
+		auto data = std::make_unique<SharedMemoryRing::Data>();
+		auto writer = SharedMemoryRing{data.get()};
+		auto reader = SharedMemoryRing{data.get()};
+
+		auto sent = std::vector<int>(SharedMemoryRing::Data::Size / sizeof(int) * 3 + 7);
+		std::iota(sent.begin(), sent.end(), 0);
+		auto thread = std::thread{[&] { writer.write(sent.data(), sent.size() * sizeof(int)); }};
+
+		auto received = std::vector<int>(sent.size());
+		QVERIFY(reader.read(received.data(), received.size() * sizeof(int)));
+		thread.join();
+		QCOMPARE(received, sent);
+		QVERIFY(reader.empty());
+	}
+
+	void CloseWakesReader()
+	{
+		using namespace lmms;
+		auto data = std::make_unique<SharedMemoryRing::Data>();
+		auto ring = SharedMemoryRing{data.get()};
+
+		auto thread = std::thread{[&] { std::this_thread::sleep_for(std::chrono::milliseconds{10}); ring.close(); }};
+		int value = 0;
+		QVERIFY(!ring.read(&value, sizeof(value)));
+		thread.join();
+	}
+
+	//! A plugin waiting for its host must notice when the host process dies
+	void DeadPeerClosesRing()
+	{
+		using namespace lmms;
+		int fds[2];
+		QCOMPARE(socketpair(AF_UNIX, SOCK_STREAM, 0, fds), 0);
+		const pid_t host = fork();
+		QVERIFY(host != -1);
+		if (host == 0)
+		{
+			// the host only holds its end of the socket until it is killed
+			::close(fds[0]);
+			pause();
+			_exit(0);
+		}
+		::close(fds[1]);
+
+		auto data = std::make_unique<SharedMemoryRing::Data>();
+		auto ring = SharedMemoryRing{data.get()};
+		ring.watchPeer(fds[0]);
+		auto reader = std::async(std::launch::async, [&] { int value = 0; return ring.read(&value, sizeof(value)); });
+		QVERIFY(reader.wait_for(std::chrono::milliseconds{300}) == std::future_status::timeout);
+
+		kill(host, SIGKILL);
+		waitpid(host, nullptr, 0);
+		const bool noticed = reader.wait_for(std::chrono::seconds{5}) == std::future_status::ready;
+		if (!noticed) { ring.close(); }
+		QVERIFY(noticed);
+		QVERIFY(!reader.get());
+		QVERIFY(ring.isClosed());
+		::close(fds[0]);
+	}
+
+	//! Round trip per period as done by RemotePlugin::process()
+	void BenchmarkRoundTripRing()
+	{
+		using namespace lmms;
+		auto data = std::make_unique<SharedMemoryRing::Data[]>(2);
+		auto toClient = SharedMemoryRing{&data[0]};
+		auto toHost = SharedMemoryRing{&data[1]};
+
+		auto client = startEchoClient(
+			[=](int* value) mutable { return toClient.read(value, sizeof(int)); },
+			[=](int* value) mutable { return toHost.write(value, sizeof(int)); });
+
+		int period = 0;
+		QBENCHMARK
+		{
+			toClient.write(&period, sizeof(period));
+			toHost.read(&period, sizeof(period));
+			++period;
+		}
+
+		toClient.write(&Quit, sizeof(Quit));
+		client.join();
+	}
+
+	//! The same round trip over the socket used before
+	void BenchmarkRoundTripSocket()
+	{
+		int fds[2];
+		QCOMPARE(socketpair(AF_UNIX, SOCK_STREAM, 0, fds), 0);
+
+		auto client = startEchoClient(
+			[=](int* value) { return ::read(fds[1], value, sizeof(int)) == sizeof(int); },
+			[=](int* value) { return ::write(fds[1], value, sizeof(int)) == sizeof(int); });
+
+		int period = 0;
+		QBENCHMARK
+		{
+			QCOMPARE(::write(fds[0], &period, sizeof(period)), static_cast<ssize_t>(sizeof(period)));
+			QCOMPARE(::read(fds[0], &period, sizeof(period)), static_cast<ssize_t>(sizeof(period)));
+			++period;
+		}
+
+		QCOMPARE(::write(fds[0], &Quit, sizeof(Quit)), static_cast<ssize_t>(sizeof(Quit)));
+		client.join();
+		close(fds[0]);
+		close(fds[1]);
+	}
+};
+
+QTEST_GUILESS_MAIN(SharedMemoryRingTest)
+#include "SharedMemoryRingTest.moc"
@@ -0,0 +1,59 @@
+/*
+ * ThreadPoolTest.cpp
+ *
+ * Copyright (c) 2026 LMMS Developers
+ *
+ * This file is part of LMMS - https://lmms.io
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public
+ * License along with this program (see COPYING); if not, write to the
+ * Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA 02110-1301 USA.
+ *
+ */
+
+#include <QtTest>
+
+#include <stdexcept>
+
+#include "ThreadPool.h"
+
+class ThreadPoolTest : public QObject
+{
+	Q_OBJECT
+private slots:
+	void ReturnsResults()
+	{
+		using namespace lmms;
+		auto sum = ThreadPool::instance().enqueue([](int a, int b) { return a + b; }, 2, 3);
+		QCOMPARE(sum.get(), 5);
+	}
+
+	void PassesExceptionsToTheFuture()
+	{
+		using namespace lmms;
+		auto& pool = ThreadPool::instance();
+
+		auto failed = pool.enqueue([] { throw std::runtime_error{"failed"}; });
+		QVERIFY_EXCEPTION_THROWN(failed.get(), std::runtime_error);
+
+		auto failedValue = pool.enqueue([]() -> int { throw std::runtime_error{"failed"}; });
+		QVERIFY_EXCEPTION_THROWN(failedValue.get(), std::runtime_error);
+
+		// the workers are still alive
+		QCOMPARE(pool.enqueue([] { return 42; }).get(), 42);
+	}
+};
+
+QTEST_GUILESS_MAIN(ThreadPoolTest)
+#include "ThreadPoolTest.moc"
@@ -0,0 +1,68 @@
+/*
+ * ThreadSchedulingTest.cpp
+ *
+ * Copyright (c) 2026 LMMS Developers
+ *
+ * This file is part of LMMS - https://lmms.io
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public
+ * License along with this program (see COPYING); if not, write to the
+ * Free Software Foundation, Inc., 51 Franklin Street, Fifth Floor,
+ * Boston, MA 02110-1301 USA.
+ *
+ */
+
+#include <QtTest>
+
+#include "ThreadScheduling.h"
+
+class ThreadSchedulingTest : public QObject
+{
+	Q_OBJECT
+private slots:
+	void ParsesCpuLists()
+	{
+		using namespace lmms;
+		QCOMPARE(ThreadScheduling::parseCpuList(""), std::vector<int>{});
+		QCOMPARE(ThreadScheduling::parseCpuList("3"), std::vector<int>{3});
+		QCOMPARE(ThreadScheduling::parseCpuList("2-4, 8,0"), (std::vector<int>{0, 2, 3, 4, 8}));
+		QCOMPARE(ThreadScheduling::parseCpuList("1,1-2"), (std::vector<int>{1, 2}));
+	}
+
+	void IgnoresInvalidRanges()
+	{
+		using namespace lmms;
+		QCOMPARE(ThreadScheduling::parseCpuList("a,3-1,2-x,-1,1-2-3,5"), std::vector<int>{5});
+	}
+
+	void BoundsRanges()
+	{
+		using namespace lmms;
+		// must neither run out of memory nor overflow
+		const auto cpus = ThreadScheduling::parseCpuList("1-2147483647");
+		QVERIFY(!cpus.empty());
+		QVERIFY(cpus.size() <= 4096);
+		QCOMPARE(cpus.front(), 1);
+		QCOMPARE(ThreadScheduling::parseCpuList("2000000000,3"), std::vector<int>{3});
+	}
+
+	void WritesRanges()
+	{
+		using namespace lmms;
+		QCOMPARE(ThreadScheduling::cpuListToString({}), QString{});
+		QCOMPARE(ThreadScheduling::cpuListToString({0, 2, 3, 4, 8}), QString{"0,2-4,8"});
+	}
+};
+
+QTEST_GUILESS_MAIN(ThreadSchedulingTest)
+#include "ThreadSchedulingTest.moc"